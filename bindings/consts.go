@@ -4,16 +4,19 @@ const CInt32Max = int(^uint32(0) >> 1)
 
 // public go consts from type_consts.h and reindexer_ctypes.h
 const (
-	ANY    = 0
-	EQ     = 1
-	LT     = 2
-	LE     = 3
-	GT     = 4
-	GE     = 5
-	RANGE  = 6
-	SET    = 7
-	ALLSET = 8
-	EMPTY  = 9
+	ANY     = 0
+	EQ      = 1
+	LT      = 2
+	LE      = 3
+	GT      = 4
+	GE      = 5
+	RANGE   = 6
+	SET     = 7
+	ALLSET  = 8
+	EMPTY   = 9
+	DWITHIN = 10
+	INBOX   = 11
+	LIKE    = 12
 
 	ERROR   = 1
 	WARNING = 2
@@ -106,6 +109,7 @@ const (
 	IndexOptDense      = 1 << 5
 	IndexOptAppendable = 1 << 4
 	IndexOptSparse     = 1 << 3
+	IndexOptBloom      = 1 << 2
 
 	StorageOptEnabled               = 1
 	StorageOptDropOnFileFormatError = 1 << 1
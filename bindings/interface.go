@@ -16,9 +16,11 @@ type IndexDef struct {
 	IsArray     bool        `json:"is_array"`
 	IsDense     bool        `json:"is_dense"`
 	IsSparse    bool        `json:"is_sparse"`
+	IsBloom     bool        `json:"is_bloom,omitempty"`
 	CollateMode string      `json:"collate_mode"`
 	SortOrder   string      `json:"sort_order_letters"`
 	Config      interface{} `json:"config"`
+	Filter      string      `json:"filter,omitempty"`
 }
 
 type StorageOpts struct {
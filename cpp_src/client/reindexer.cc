@@ -28,6 +28,8 @@ Error Reindexer::AddIndex(string_view nsName, const IndexDef& idx) { return impl
 Error Reindexer::UpdateIndex(string_view nsName, const IndexDef& idx) { return impl_->UpdateIndex(nsName, idx); }
 Error Reindexer::DropIndex(string_view nsName, const IndexDef& index) { return impl_->DropIndex(nsName, index); }
 Error Reindexer::EnumNamespaces(vector<NamespaceDef>& defs, bool bEnumAll) { return impl_->EnumNamespaces(defs, bEnumAll); }
+Error Reindexer::Backup(const string& dir) { return impl_->Backup(dir); }
+Error Reindexer::Restore(const string& dir) { return impl_->Restore(dir); }
 Error Reindexer::SubscribeUpdates(IUpdatesObserver* observer, bool subscribe) { return impl_->SubscribeUpdates(observer, subscribe); }
 
 }  // namespace client
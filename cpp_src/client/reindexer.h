@@ -126,6 +126,12 @@ public:
 	/// @param nsName - Name of namespace
 	/// @param keys - std::vector filled with meta keys
 	Error EnumMeta(string_view nsName, vector<string> &keys);
+	/// Make online backup of all namespaces of database on server side
+	/// @param dir - path to directory for backup files on server
+	Error Backup(const string &dir);
+	/// Restore namespaces of database from backup on server side
+	/// @param dir - path to directory with backup files on server
+	Error Restore(const string &dir);
 	// Subsribe to updates of database
 	// @param observer - Observer interface, which will receive updates
 	// @param subsctibe - true: subsribe, false: unsubsrcibe
@@ -211,6 +211,10 @@ Error RPCClient::PutMeta(string_view nsName, const string& key, const string_vie
 	return getConn()->Call(cproto::kCmdPutMeta, nsName, key, data).Status();
 }
 
+Error RPCClient::Backup(const string& dir) { return getConn()->Call(cproto::kCmdBackup, dir).Status(); }
+
+Error RPCClient::Restore(const string& dir) { return getConn()->Call(cproto::kCmdRestore, dir).Status(); }
+
 Error RPCClient::EnumMeta(string_view nsName, vector<string>& keys) {
 	try {
 		auto ret = getConn()->Call(cproto::kCmdEnumMeta, nsName);
@@ -57,6 +57,8 @@ public:
 	Error PutMeta(string_view nsName, const string &key, const string_view &data);
 	Error EnumMeta(string_view nsName, vector<string> &keys);
 	Error SubscribeUpdates(IUpdatesObserver *observer, bool subscribe);
+	Error Backup(const string &dir);
+	Error Restore(const string &dir);
 
 private:
 	Error modifyItem(string_view nsName, Item &item, int mode, Completion);
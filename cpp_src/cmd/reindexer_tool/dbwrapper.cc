@@ -415,6 +415,26 @@ Error DBWrapper<_DB>::commandSubscribe(const string& command) {
 	return db_.SubscribeUpdates(this, on);
 }
 
+template <typename _DB>
+Error DBWrapper<_DB>::commandBackup(const string& command) {
+	LineParser parser(command);
+	parser.NextToken();
+
+	string dir = parser.NextToken().ToString();
+	if (dir.empty()) return Error(errParams, "Backup directory is not specified");
+	return db_.Backup(dir);
+}
+
+template <typename _DB>
+Error DBWrapper<_DB>::commandRestore(const string& command) {
+	LineParser parser(command);
+	parser.NextToken();
+
+	string dir = parser.NextToken().ToString();
+	if (dir.empty()) return Error(errParams, "Backup directory is not specified");
+	return db_.Restore(dir);
+}
+
 template <typename _DB>
 void DBWrapper<_DB>::OnWALUpdate(int64_t lsn, string_view nsName, const reindexer::WALRecord& wrec) {
 	WrSerializer ser;
@@ -47,6 +47,8 @@ protected:
 	Error commandSet(const string& command);
 	Error commandBench(const string& command);
 	Error commandSubscribe(const string& command);
+	Error commandBackup(const string& command);
+	Error commandRestore(const string& command);
 
 	void OnWALUpdate(int64_t lsn, string_view nsName, const reindexer::WALRecord& wrec) override final;
 	void OnConnectionState(const Error& err) override;
@@ -127,6 +129,16 @@ protected:
 	Syntax:
 		\subscribe <on|off>
 		)help"},
+		{"\\backup",	"Make online backup of database",&DBWrapper::commandBackup,R"help(
+	Syntax:
+		\backup <directory>
+		Backup files are written to directory on database side (on server for remote database)
+		)help"},
+		{"\\restore",	"Restore database from backup",&DBWrapper::commandRestore,R"help(
+	Syntax:
+		\restore <directory>
+		Existing namespaces with the same names are replaced with namespaces from backup
+		)help"},
 		{"\\quit",		"Exit from tool",&DBWrapper::commandQuit,""},
 		{"\\help",		"Show help",&DBWrapper::commandHelp,""}
 	};
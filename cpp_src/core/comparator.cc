@@ -9,11 +9,12 @@ Comparator::Comparator() : fields_(), cmpComposite(payloadType_, fields_), cmpEq
 Comparator::~Comparator() {}
 
 Comparator::Comparator(CondType cond, KeyValueType type, const VariantArray &values, bool isArray, bool distinct, PayloadType payloadType,
-					   const FieldsSet &fields, void *rawData, const CollateOpts &collateOpts)
+					   const FieldsSet &fields, void *rawData, const CollateOpts &collateOpts, int rawDataSize)
 	: cond_(cond),
 	  type_(type),
 	  isArray_(isArray),
 	  rawData_(reinterpret_cast<uint8_t *>(rawData)),
+	  rawDataSize_(rawDataSize),
 	  collateOpts_(collateOpts),
 	  payloadType_(payloadType),
 	  fields_(fields),
@@ -22,6 +23,10 @@ Comparator::Comparator(CondType cond, KeyValueType type, const VariantArray &val
 	  dist_(distinct ? new fast_hash_set<Variant> : nullptr) {
 	if (type == KeyValueComposite) assert(fields_.size() > 0);
 	if (cond_ == CondEq && values.size() != 1) cond_ = CondSet;
+	if (isGeoCondition(cond_)) {
+		geoArea_ = GeoArea(cond_, values);
+		return;
+	}
 	setValues(values);
 }
 
@@ -31,7 +36,7 @@ void Comparator::setValues(const VariantArray &values) {
 		cmpBool.SetValues(cond_, values);
 		cmpInt64.SetValues(cond_, values);
 		cmpDouble.SetValues(cond_, values);
-		cmpString.SetValues(cond_, values);
+		cmpString.SetValues(cond_, values, CollateMode(collateOpts_.mode));
 		cmpComposite.SetValues(cond_, values);
 	} else {
 		switch (type_) {
@@ -48,7 +53,7 @@ void Comparator::setValues(const VariantArray &values) {
 				cmpDouble.SetValues(cond_, values);
 				break;
 			case KeyValueString:
-				cmpString.SetValues(cond_, values);
+				cmpString.SetValues(cond_, values, CollateMode(collateOpts_.mode));
 				break;
 			case KeyValueComposite:
 				cmpComposite.SetValues(cond_, values);
@@ -83,7 +88,33 @@ void Comparator::BindEqualPosition(const TagsPath &tagsPath, const VariantArray
 	equalPositionMode = true;
 }
 
+IdBitmap::Ptr Comparator::ScanColumn() const {
+	if (!rawData_ || isArray_ || dist_ || equalPositionMode || fields_.getTagsPathsLength() > 0) return nullptr;
+
+	auto res = std::make_shared<IdBitmap>();
+	bool scanned = false;
+	switch (type_) {
+		case KeyValueBool:
+			scanned = cmpBool.ScanColumn(cond_, reinterpret_cast<const bool *>(rawData_), rawDataSize_, *res);
+			break;
+		case KeyValueInt:
+			scanned = cmpInt.ScanColumn(cond_, reinterpret_cast<const int *>(rawData_), rawDataSize_, *res);
+			break;
+		case KeyValueInt64:
+			scanned = cmpInt64.ScanColumn(cond_, reinterpret_cast<const int64_t *>(rawData_), rawDataSize_, *res);
+			break;
+		case KeyValueDouble:
+			scanned = cmpDouble.ScanColumn(cond_, reinterpret_cast<const double *>(rawData_), rawDataSize_, *res);
+			break;
+		default:
+			break;
+	}
+	return scanned ? res : nullptr;
+}
+
 bool Comparator::Compare(const PayloadValue &data, int rowId) {
+	if (isGeoCondition(cond_)) return geoArea_.Contains(GetGeoPoint(ConstPayload(payloadType_, data), fields_));
+
 	if (fields_.getTagsPathsLength() > 0) {
 		VariantArray rhs;
 		Payload pl(payloadType_, const_cast<PayloadValue &>(data));
@@ -2,6 +2,7 @@
 
 #include "comparatorimpl.h"
 #include "compositearraycomparator.h"
+#include "core/geo.h"
 #include "estl/fast_hash_set.h"
 
 namespace reindexer {
@@ -11,10 +12,13 @@ class Comparator {
 public:
 	Comparator();
 	Comparator(CondType cond, KeyValueType type, const VariantArray &values, bool isArray, bool distinct, PayloadType payloadType,
-			   const FieldsSet &fields, void *rawData = nullptr, const CollateOpts &collateOpts = CollateOpts());
+			   const FieldsSet &fields, void *rawData = nullptr, const CollateOpts &collateOpts = CollateOpts(), int rawDataSize = 0);
 	~Comparator();
 
 	bool Compare(const PayloadValue &lhs, int rowId);
+	/// Checks all the rows of index column at once
+	/// @return bitmap of matched row ids, or nullptr if comparator has no column or condition is not supported
+	IdBitmap::Ptr ScanColumn() const;
 	void Bind(PayloadType type, int field);
 	void BindEqualPosition(int field, const VariantArray &val, CondType cond);
 	void BindEqualPosition(const TagsPath &tagsPath, const VariantArray &val, CondType cond);
@@ -80,6 +84,7 @@ protected:
 	size_t sizeof_ = 0;
 	bool isArray_ = false;
 	uint8_t *rawData_ = nullptr;
+	int rawDataSize_ = 0;
 	CollateOpts collateOpts_;
 
 	PayloadType payloadType_;
@@ -87,6 +92,7 @@ protected:
 	ComparatorImpl<PayloadValue> cmpComposite;
 	CompositeArrayComparator cmpEqualPosition;
 	shared_ptr<fast_hash_set<Variant>> dist_;
+	GeoArea geoArea_;
 	bool equalPositionMode = false;
 };
 
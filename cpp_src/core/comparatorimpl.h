@@ -2,9 +2,12 @@
 
 #include <memory.h>
 #include <list>
+#include "core/idbitmap.h"
 #include "core/index/payload_map.h"
 #include "core/keyvalue/p_string.h"
 #include "core/payload/fieldsset.h"
+#include "estl/fast_hash_set.h"
+#include "tools/customhash.h"
 
 namespace reindexer {
 
@@ -12,15 +15,29 @@ using std::unordered_set;
 using std::reference_wrapper;
 using std::shared_ptr;
 
+// Hash and equality of strings by collate rules. Hash is consistent with equality for all collate modes, except numeric and custom
+struct hash_collate_sv {
+	size_t operator()(const string_view &s) const { return collateHash(s, collateMode); }
+	CollateMode collateMode;
+};
+struct equal_collate_sv {
+	bool operator()(const string_view &lhs, const string_view &rhs) const { return collateCompare(lhs, rhs, collateOpts) == 0; }
+	CollateOpts collateOpts;
+};
+typedef fast_hash_set<string_view, hash_collate_sv, equal_collate_sv> collate_string_set;
+
 template <class T>
 class ComparatorImpl {
 public:
 	ComparatorImpl() {}
-	void SetValues(CondType cond, const VariantArray &values) {
+	// @param collateMode - collate of compared strings. Set of strings is hashed by collate rules
+	void SetValues(CondType cond, const VariantArray &values, CollateMode collateMode = CollateNone) {
 		if (cond == CondSet) {
-			valuesS_.reset(new unordered_set<T>());
+			valuesS_.reset(new fast_hash_set<T>());
+			valuesS_->reserve(values.size());
 		}
 		convertedStrings_.reset();
+		collateValuesS_.reset();
 		values_.clear();
 
 		KeyValueType thisType = type();
@@ -61,6 +78,7 @@ public:
 				}
 			}
 		}
+		if (cond == CondSet) setCollateValues(collateMode, std::is_same<T, key_string>());
 	}
 
 	bool Compare(CondType cond, const T &lhs) {
@@ -83,6 +101,7 @@ public:
 			case CondAny:
 				return true;
 			case CondEmpty:
+			case CondLike:
 				return false;
 			default:
 				abort();
@@ -106,8 +125,10 @@ public:
 				return collateCompare(string_view(lhs), string_view(*rhs), collateOpts) >= 0 &&
 					   collateCompare(string_view(lhs), string_view(*values_[1]), collateOpts) <= 0;
 			case CondSet:
-				// if (collateOpts.mode == CollateNone) return valuesS_->find(lhs) != valuesS_->end();
-				for (auto it : *valuesS_) {
+				if (collateValuesS_ && collateOpts.mode == collateValuesS_->hash_function().collateMode) {
+					return collateValuesS_->find(string_view(lhs)) != collateValuesS_->end();
+				}
+				for (auto &it : *valuesS_) {
 					if (!collateCompare(string_view(lhs), string_view(*it), collateOpts)) return true;
 				}
 				return false;
@@ -115,16 +136,76 @@ public:
 				return true;
 			case CondEmpty:
 				return false;
+			case CondLike:
+				return matchLikePattern(string_view(lhs), string_view(*rhs), CollateMode(collateOpts.mode));
 			default:
 				abort();
 		}
 	}
 
+	// Checks whole column of values and stores result to bitmap
+	// @return false, if condition is not supported by column scan
+	bool ScanColumn(CondType cond, const T *data, int count, IdBitmap &res) const {
+		const T lo = values_.size() ? values_[0] : T(), hi = values_.size() > 1 ? values_[1] : T();
+		switch (cond) {
+			case CondEq:
+				scanColumn(data, count, res, [lo](const T &lhs) { return lhs == lo; });
+				return true;
+			case CondGe:
+				scanColumn(data, count, res, [lo](const T &lhs) { return lhs >= lo; });
+				return true;
+			case CondLe:
+				scanColumn(data, count, res, [lo](const T &lhs) { return lhs <= lo; });
+				return true;
+			case CondLt:
+				scanColumn(data, count, res, [lo](const T &lhs) { return lhs < lo; });
+				return true;
+			case CondGt:
+				scanColumn(data, count, res, [lo](const T &lhs) { return lhs > lo; });
+				return true;
+			case CondRange:
+				scanColumn(data, count, res, [lo, hi](const T &lhs) { return lhs >= lo && lhs <= hi; });
+				return true;
+			case CondSet: {
+				const fast_hash_set<T> &set = *valuesS_;
+				scanColumn(data, count, res, [&set](const T &lhs) { return set.find(lhs) != set.end(); });
+				return true;
+			}
+			default:
+				return false;
+		}
+	}
+
 	h_vector<T, 2> values_;
-	shared_ptr<unordered_set<T>> valuesS_;
+	shared_ptr<fast_hash_set<T>> valuesS_;
 	shared_ptr<std::list<string>> convertedStrings_;
+	// Views of strings of valuesS_, hashed by collate rules. Without it each string is compared with all values of set
+	shared_ptr<collate_string_set> collateValuesS_;
 
 private:
+	void setCollateValues(CollateMode collateMode, std::true_type) {
+		if (collateMode == CollateNumeric || collateMode == CollateCustom) return;
+		collateValuesS_.reset(new collate_string_set(valuesS_->size(), hash_collate_sv{collateMode}, equal_collate_sv{CollateOpts(collateMode)}));
+		for (const key_string &value : *valuesS_) collateValuesS_->emplace(*value);
+	}
+	void setCollateValues(CollateMode, std::false_type) {}
+
+	// Each 64 rows are packed into a word without branches, so the inner loop is vectorized by compiler
+	template <typename Pred>
+	static void scanColumn(const T *data, int count, IdBitmap &res, Pred pred) {
+		int i = 0;
+		for (; i + 64 <= count; i += 64) {
+			uint64_t word = 0;
+			for (int j = 0; j < 64; ++j) word |= uint64_t(pred(data[i + j])) << j;
+			res.AppendWord(word);
+		}
+		if (i < count) {
+			uint64_t word = 0;
+			for (int j = 0; i + j < count; ++j) word |= uint64_t(pred(data[i + j])) << j;
+			res.AppendWord(word);
+		}
+	}
+
 	KeyValueType type() {
 		if (std::is_same<T, key_string>::value) return KeyValueString;
 		if (std::is_same<T, int>::value) return KeyValueInt;
@@ -16,8 +16,17 @@ static CacheMode str2cacheMode(const string &mode) {
 	throw Error(errParams, "Unknown cache mode %s", mode);
 }
 
+static StorageFlushMode str2flushMode(const string &mode) {
+	if (mode == "async" || mode == "") return StorageFlushAsync;
+	if (mode == "periodic") return StorageFlushPeriodic;
+	if (mode == "per_commit") return StorageFlushPerCommit;
+
+	throw Error(errParams, "Unknown storage flush mode %s", mode);
+}
+
 Error DBConfigProvider::FromJSON(JsonValue &v) {
 	try {
+		std::function<void()> storageHandler;
 		smart_lock<shared_timed_mutex> lk(mtx_, true);
 		for (auto elem : v) {
 			JsonValue &jvalue = elem->value;
@@ -53,6 +62,9 @@ Error DBConfigProvider::FromJSON(JsonValue &v) {
 						parseJsonField("unload_idle_threshold", data.noQueryIdleThreshold, subelem);
 						parseJsonField("log_level", logLevel, subelem);
 						parseJsonField("join_cache_mode", cmode, subelem);
+						parseJsonField("storage_compression", data.storageCompression, subelem);
+						parseJsonField("documents_memory_limit", data.documentsMemoryLimit, subelem);
+						parseJsonField("online_index_build", data.onlineIndexBuild, subelem);
 					}
 					data.logLevel = logLevelFromString(logLevel);
 					namespacesData_.emplace(name, std::move(data));
@@ -60,6 +72,20 @@ Error DBConfigProvider::FromJSON(JsonValue &v) {
 				}
 				auto it = handlers_.find(NamespaceDataConf);
 				if (it != handlers_.end()) (it->second)();
+			} else if (!strcmp(elem->key, "storage")) {
+				if (jvalue.getTag() != JSON_OBJECT) return Error(errParseJson, "Expected object in 'storage' key");
+
+				string flushMode;
+				storageData_ = {};
+				for (auto elem : jvalue) {
+					parseJsonField("flush_mode", flushMode, elem);
+					parseJsonField("sync_interval_ms", storageData_.syncIntervalMs, elem, 1, INT_MAX);
+				}
+				storageData_.flushMode = str2flushMode(flushMode);
+
+				// Storage handler reads config back, so it is called after the lock is released
+				auto it = handlers_.find(StorageConf);
+				if (it != handlers_.end()) storageHandler = it->second;
 			} else if (!strcmp(elem->key, "replication")) {
 				if (jvalue.getTag() != JSON_OBJECT) return Error(errParseJson, "Expected object in 'replication' key");
 				auto err = replicationData_.FromJSON(jvalue);
@@ -69,6 +95,8 @@ Error DBConfigProvider::FromJSON(JsonValue &v) {
 				if (it != handlers_.end()) (it->second)();
 			}
 		}
+		lk.unlock();
+		if (storageHandler) storageHandler();
 		return errOK;
 	} catch (const Error &err) {
 		return err;
@@ -94,9 +122,16 @@ ReplicationConfigData DBConfigProvider::GetReplicationConfig() {
 	return replicationData_;
 }
 
+StorageConfigData DBConfigProvider::GetStorageConfig() {
+	smart_lock<shared_timed_mutex> lk(mtx_, false);
+	return storageData_;
+}
+
 bool DBConfigProvider::GetNamespaceConfig(const string &nsName, NamespaceConfigData &data) {
 	smart_lock<shared_timed_mutex> lk(mtx_, false);
 	auto it = namespacesData_.find(nsName);
+	// Config of namespace "*" is applied to namespaces without their own config
+	if (it == namespacesData_.end()) it = namespacesData_.find("*");
 	if (it == namespacesData_.end()) {
 		data = {};
 		return false;
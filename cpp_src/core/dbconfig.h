@@ -14,7 +14,7 @@ union JsonValue;
 namespace reindexer {
 class JsonBuilder;
 
-enum ConfigType { ProfilingConf, NamespaceDataConf, ReplicationConf };
+enum ConfigType { ProfilingConf, NamespaceDataConf, ReplicationConf, StorageConf };
 
 struct ProfilingConfigData {
 	bool queriesPerfStats = false;
@@ -28,6 +28,23 @@ struct NamespaceConfigData {
 	int noQueryIdleThreshold = 0;
 	LogLevel logLevel = LogNone;
 	CacheMode cacheMode = CacheModeOn;
+	// Compress stored documents with shared dictionary, trained on namespace data
+	bool storageCompression = false;
+	// Memory limit for non-indexed contents of documents. When it is exceeded, contents of documents are evicted
+	// from memory and loaded from storage on demand. 0 or negative - unlimited
+	int64_t documentsMemoryLimit = 0;
+	// Build added and updated indexes from snapshot of documents without blocking of namespace. Documents, modified during
+	// the build, are reindexed before switch to the new index
+	bool onlineIndexBuild = false;
+};
+
+enum StorageFlushMode { StorageFlushAsync, StorageFlushPeriodic, StorageFlushPerCommit };
+
+struct StorageConfigData {
+	// Durability policy of database storage writer
+	StorageFlushMode flushMode = StorageFlushAsync;
+	// Max interval between fsyncs of storage in periodic mode
+	int syncIntervalMs = 1000;
 };
 
 enum ReplicationRole { ReplicationNone, ReplicationMaster, ReplicationSlave };
@@ -64,11 +81,13 @@ public:
 
 	ProfilingConfigData GetProfilingConfig();
 	ReplicationConfigData GetReplicationConfig();
+	StorageConfigData GetStorageConfig();
 	bool GetNamespaceConfig(const string &nsName, NamespaceConfigData &data);
 
 private:
 	ProfilingConfigData profilingData_;
 	ReplicationConfigData replicationData_;
+	StorageConfigData storageData_;
 	std::unordered_map<string, NamespaceConfigData> namespacesData_;
 	std::unordered_map<int, std::function<void()>> handlers_;
 	shared_timed_mutex mtx_;
@@ -24,4 +24,10 @@ inline double bm25score(double termCountInDoc, double mostFreqWordCountInDoc, do
 	auto termFreq = TF(termCountInDoc, mostFreqWordCountInDoc, wordsInDoc);
 	return termFreq * (kKeofBm25k1 + 1.0) / (termFreq + kKeofBm25k1 * (1.0 - kKeofBm25b + kKeofBm25b * wordsInDoc / avgDocLen));
 }
+
+// Upper bound of bm25score for term, which is found in document not more than maxTermCountInDoc times
+inline double bm25scoreMax(double maxTermCountInDoc) {
+	// score is maximal for the shortest document
+	return maxTermCountInDoc * (kKeofBm25k1 + 1.0) / (maxTermCountInDoc + kKeofBm25k1 * (1.0 - kKeofBm25b));
+}
 }  // namespace reindexer
@@ -35,9 +35,14 @@ void FtFastConfig::parse(char *json) {
 		parseJsonField("min_relevancy", minRelevancy, elem, 0, 1);
 		parseJsonField("max_typos_in_word", maxTyposInWord, elem, 0, 2);
 		parseJsonField("max_typo_len", maxTypoLen, elem, 0, 100);
+		parseJsonField("compact_typos", compactTypos, elem);
+		parseJsonField("fst_terms", fstTerms, elem);
+		parseJsonField("select_threads", selectThreads, elem, 1, 256);
 
 		parseJsonField("max_rebuild_steps", maxRebuildSteps, elem, 1, 500);
 		parseJsonField("max_step_size", maxStepSize, elem, 5, std::numeric_limits<double>::max());
+		parseJsonField("enable_background_commit", enableBackgroundCommit, elem);
+		parseJsonField("read_your_writes", readYourWrites, elem);
 
 		parseBase(elem);
 	}
@@ -20,9 +20,24 @@ struct FtFastConfig : public BaseFTConfig {
 
 	int maxTyposInWord = 1;
 	int maxTypoLen = 15;
+	// Store typos as 64-bit hashes instead of strings: typos take several times less memory and are built faster
+	bool compactTypos = false;
+
+	// Find words with finite state transducers of words and reversed words instead of suffix array: dictionary takes several times
+	// less memory, but '*' matches only prefix or suffix of word, not the middle of word
+	bool fstTerms = false;
+
+	// Maximum count of threads of select: terms are searched in parallel, and large results are merged by ranges of documents in parallel.
+	// Threads are shared by all the selects
+	int selectThreads = 1;
 
 	int maxRebuildSteps = 50;
 	int maxStepSize = 4000;
+
+	// Build fulltext data in background thread. Selects use previous built data, until the new data are ready
+	bool enableBackgroundCommit = false;
+	// With background commit selects wait for fulltext data, which contain all the index updates
+	bool readYourWrites = false;
 };
 
 }  // namespace reindexer
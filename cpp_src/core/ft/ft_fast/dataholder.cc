@@ -1,129 +1,144 @@
 ﻿#include "dataholder.h"
+#include <algorithm>
+#include "dataprocessor.h"
 
 namespace reindexer {
 
-vector<PackedWordEntry>& DataHolder::GetWords() { return words_; }
-suffix_map<string, WordIdType>& DataHolder::GetSuffix() { return steps.back().suffixes_; }
-
-flat_str_multimap<string, WordIdType>& DataHolder::GetTypos() { return steps.back().typos_; }
-
-WordIdType DataHolder::findWord(const string& word) {
-	WordIdType id;
-	id.setEmpty();
-	if (steps.size() <= 1) return id;
-
-	for (auto step = steps.begin(); step != steps.end() - 1; ++step) {
-		auto it = step->suffixes_.lower_bound(word);
-		if (it != step->suffixes_.end() && size_t(step->suffixes_.word_len_at(GetSuffixWordId(it->second, *step))) == word.size()) {
-			return it->second;
-		}
-	}
-
-	return id;
-}
-size_t DataHolder::GetWordsSize() {
-	size_t res = 0;
-	for (auto step = steps.begin(); step != steps.end() - 1; ++step) {
-		res += step->suffixes_.word_size();
-	}
-	return res;
-}
+// Step is merged with the new one, while it's not larger than kStepsMergeRatio * (documents of the newer steps)
+const size_t kStepsMergeRatio = 2;
 
 size_t DataHolder::GetMemStat() {
-	size_t res = 0;
+	size_t res = vdocs_.capacity() * sizeof(VDocEntry);
 	for (auto& step : steps) {
-		res += step.typos_.heap_size() + step.suffixes_.heap_size();
-
-		for (auto& w : words_) {
-			res += sizeof(w) + w.vids_.heap_size();
-		}
-		res += vdocs_.capacity() * sizeof(VDocEntry);
+		res += step.typos_.heap_size() + step.hashedTypos_.heap_size() + step.suffixes_.heap_size() + step.fstTerms_.heap_size() +
+			   step.words_.capacity() * sizeof(PackedWordEntry);
+		for (auto& w : step.words_) res += w.vids_.heap_size();
 	}
 	return res;
 }
 
-void DataHolder::SetWordsOffset(uint32_t word_offset) {
-	assert(!steps.empty());
-	if (status_ == CreateNew) steps.back().wordOffset_ = word_offset;
-}
-uint32_t DataHolder::GetWordsOffset() {
-	assert(!steps.empty());
-	return steps.back().wordOffset_;
-}
 WordIdType DataHolder::BuildWordId(uint32_t id) {
 	WordIdType wId;
 	assert(id < kWordIdMaxIdVal);
-	assert(steps.size() - 1 < kWordIdMaxStepVal);
 
 	wId.b.id = id;
-	wId.b.step_num = steps.size() - 1;
+	wId.b.step_num = 0;
 
 	return wId;
 }
-bool DataHolder::NeedClear(bool complte_updated) {
-	if (NeedRebuild(complte_updated) || steps.back().suffixes_.word_size() > size_t(cfg_->maxStepSize)) return true;
-	return false;
-}
 
-uint32_t DataHolder::GetSuffixWordId(WordIdType id, const CommitStep& step) {
-	assert(!id.isEmpty());
-	assert(id.b.step_num < steps.size());
-
-	assert(id.b.id >= step.wordOffset_);
-	assert(id.b.id - step.wordOffset_ < step.suffixes_.word_size());
-	return id.b.id - step.wordOffset_;
+WordIdType DataHolder::GlobalWordId(WordIdType id, size_t stepNum) {
+	assert(stepNum < kWordIdMaxStepVal);
+	id.b.step_num = stepNum;
+	return id;
 }
 
-uint32_t DataHolder::GetSuffixWordId(WordIdType id) { return GetSuffixWordId(id, steps.back()); }
+DataHolder::CommitStep& DataHolder::GetDocStep(VDocIdType vdocId) {
+	auto it = std::upper_bound(steps.begin(), steps.end(), vdocId,
+							   [](VDocIdType id, const CommitStep& step) { return id < step.vdocsOffset_; });
+	assert(it != steps.begin());
+	return *(it - 1);
+}
 
-DataHolder::CommitStep& DataHolder::GetStep(WordIdType id) {
-	assert(id.b.step_num < steps.size());
-	return steps[id.b.step_num];
+size_t DataHolder::GetDocsCount() const {
+	size_t res = 0;
+	for (auto& step : steps) res += step.docsCount_ + step.deletedCount_;
+	return res;
 }
 
-PackedWordEntry& DataHolder::getWordById(WordIdType id) {
-	assert(!id.isEmpty());
-	assert(id.b.id < words_.size());
-	return words_[id.b.id];
+void DataHolder::MarkDeleted(VDocIdType vdocId) {
+	assert(vdocId < vdocs_.size());
+	vdocs_[vdocId].keyEntry = nullptr;
+	auto& step = GetDocStep(vdocId);
+	assert(step.docsCount_);
+	--step.docsCount_;
+	++step.deletedCount_;
 }
 
 void DataHolder::Clear() {
-	steps.resize(1);
-	steps.front().clear();
+	// Memory of data with deleted documents is released
+	steps.clear();
+	steps.emplace_back();
 	avgWordsCount_.clear();
-	words_.clear();
-	vdocs_.clear();
+	vector<VDocEntry>().swap(vdocs_);
 	vdocsTexts.clear();
 	vodcsOffset_ = 0;
 	szCnt = 0;
 }
+
 void DataHolder::StartCommit(bool complte_updated) {
 	if (NeedRebuild(complte_updated)) {
 		status_ = FullRebuild;
-
 		Clear();
-	} else if (steps.back().suffixes_.word_size() < size_t(cfg_->maxStepSize)) {
-		status_ = RecommitLast;
-		words_.erase(words_.begin() + steps.back().wordOffset_, words_.end());
-
-		for (auto& word : words_) {
-			word.vids_.erase_back(word.cur_step_pos_);
-		}
-
-		steps.back().clear();
 	} else {
 		status_ = CreateNew;
 		steps.emplace_back(CommitStep{});
+		steps.back().vdocsOffset_ = vdocs_.size();
 	}
-	return;
-}  // namespace reindexer
-bool DataHolder::NeedRebuild(bool complte_updated) {
-	return ((steps.size() == 1 && steps.front().suffixes_.word_size() < size_t(cfg_->maxStepSize)) || steps.empty() ||
-			steps.size() >= size_t(cfg_->maxRebuildSteps) || complte_updated);
 }
-void DataHolder::SetConfig(FtFastConfig* cfg) {
-	cfg_ = cfg;
-	steps.reserve(cfg_->maxRebuildSteps + 1);
+
+bool DataHolder::NeedRebuild(bool complte_updated) const {
+	if (complte_updated || steps.empty()) return true;
+	if (steps.size() == 1 && steps.front().words_.size() < size_t(cfg_->maxStepSize)) return true;
+	if (steps.size() >= std::min(size_t(cfg_->maxRebuildSteps), size_t(kWordIdMaxStepVal))) return true;
+	return MostDeleted();
+}
+
+bool DataHolder::MostDeleted() const {
+	size_t liveDocs = 0;
+	for (auto& step : steps) liveDocs += step.docsCount_;
+	return vdocs_.size() > 2 * liveDocs;
+}
+
+size_t DataHolder::StepsToMerge(size_t stepsCount, size_t docsCount) const {
+	assert(stepsCount <= steps.size());
+	size_t from = stepsCount;
+	while (from > 0) {
+		const CommitStep& prev = steps[from - 1];
+		// Small steps and steps with more deleted documents, than live ones, are merged regardless of size
+		if (prev.words_.size() >= size_t(cfg_->maxStepSize) && prev.docsCount_ > kStepsMergeRatio * docsCount &&
+			prev.deletedCount_ <= prev.docsCount_) {
+			break;
+		}
+		docsCount += prev.docsCount_;
+		--from;
+	}
+	return from;
+}
+
+void DataHolder::MergeSteps(size_t from) {
+	assert(from < steps.size());
+	VDocIdType offset = steps[from].vdocsOffset_;
+	vector<bool> deleted(vdocs_.size() - offset);
+	for (size_t i = offset; i < vdocs_.size(); ++i) deleted[i - offset] = !vdocs_[i].keyEntry;
+
+	vector<const CommitStep*> src;
+	uint32_t docsCount = 0;
+	for (size_t i = from; i < steps.size(); ++i) {
+		src.push_back(&steps[i]);
+		docsCount += steps[i].docsCount_;
+	}
+	CommitStep merged = DataProcessor::MergeSteps(src, deleted, *cfg_);
+	merged.vdocsOffset_ = offset;
+	merged.docsCount_ = docsCount;
+
+	steps.erase(steps.begin() + from, steps.end());
+	steps.emplace_back(std::move(merged));
 }
 
+void DataHolder::UpdateAvgWordsCount(size_t fieldsCount) {
+	avgWordsCount_.assign(fieldsCount, 0.0);
+	size_t liveDocs = 0;
+	for (auto& vdoc : vdocs_) {
+		if (!vdoc.keyEntry) continue;
+		for (size_t i = 0; i < fieldsCount; i++) avgWordsCount_[i] += vdoc.wordsCount[i];
+		++liveDocs;
+	}
+	if (liveDocs) {
+		for (size_t i = 0; i < fieldsCount; i++) avgWordsCount_[i] /= liveDocs;
+	}
+}
+
+void DataHolder::SetConfig(FtFastConfig* cfg) { cfg_ = cfg; }
+
 }  // namespace reindexer
@@ -4,13 +4,16 @@
 #include "core/ft/config/ftfastconfig.h"
 #include "core/ft/ft_fuzzy/searchers/isearcher.h"
 #include "core/ft/idrelset.h"
+#include "core/ft/packedidrelset.h"
 #include "core/ft/stemmer.h"
 #include "deque"
 #include "estl/fast_hash_map.h"
 #include "estl/flat_str_map.h"
 #include "estl/suffix_map.h"
 #include "ftfastkeyentry.h"
+#include "hashedtypos.h"
 #include "indextexttypes.h"
+#include "termsfst.h"
 
 using std::unique_ptr;
 using std::vector;
@@ -34,79 +37,99 @@ struct VDocEntry {
 class PackedWordEntry {
 public:
 	PackedIdRelSet vids_;
-	size_t cur_step_pos_ = 0;
 };
 class WordEntry {
 public:
 	IdRelSet vids_;
 	bool virtualWord = false;
 };
-enum ProcessStatus { FullRebuild, RecommitLast, CreateNew };
+enum ProcessStatus { FullRebuild, CreateNew };
 
+// Fulltext data are stored in segments (steps). Each commit builds new segment from the updated documents only, segments are immutable.
+// Deleted documents are marked in vdocs, their words stay in segments, until segments are merged.
+// Segments are merged by tiers: small tail segments are merged with the new one, so count of segments grows by logarithm of documents
 class DataHolder {
 public:
 	typedef fast_hash_map<WordIdType, pair<size_t, size_t>, WordIdTypeHash, WordIdTypequal> FondWordsType;
 	struct CommitStep {
-		CommitStep() : wordOffset_(0) {}
+		CommitStep() = default;
 
 		CommitStep(const CommitStep&) = delete;
 		CommitStep& operator=(const CommitStep&) = delete;
 		CommitStep(CommitStep&& /*rhs*/) noexcept = default;
 		CommitStep& operator=(CommitStep&& /*rhs*/) = default;
 
-		// Suffix map. suffix <-> original word id
+		// Suffix map. suffix <-> word id in step
 		suffix_map<string, WordIdType> suffixes_;
-		// Typos map. typo string <-> original word id
+		// Words lookup by prefix and suffix. It's used instead of suffix array of suffixes_ with fst terms config
+		FstTermsDict fstTerms_;
+		// Typos map. typo string <-> word id in step
 		flat_str_multimap<string, WordIdType> typos_;
-		uint32_t wordOffset_;
+		// Typos of words as hashes. It's used instead of typos_ with compact typos config
+		HashedTypos hashedTypos_;
+		// Words of step. Addressable by word id in step
+		vector<PackedWordEntry> words_;
+		// Step contains documents with vdoc ids [vdocsOffset_, vdocsOffset_ of next step)
+		VDocIdType vdocsOffset_ = 0;
+		// Count of live documents of step
+		uint32_t docsCount_ = 0;
+		// Count of deleted documents, which words are still in step
+		uint32_t deletedCount_ = 0;
 
 		void clear() {
 			suffixes_.clear();
+			fstTerms_.clear();
 			typos_.clear();
+			hashedTypos_.clear();
+			words_.clear();
+			docsCount_ = 0;
+			deletedCount_ = 0;
 		}
 	};
-	vector<PackedWordEntry>& GetWords();
-	suffix_map<std::string, WordIdType>& GetSuffix();
 	void SetConfig(FtFastConfig* cfg);
 
-	flat_str_multimap<string, WordIdType>& GetTypos();
-	// returns id and found or not found
-	WordIdType findWord(const string& word);
-	WordIdType BuildWordId(uint32_t id);
-	PackedWordEntry& getWordById(WordIdType id);
+	static WordIdType BuildWordId(uint32_t id);
+	// Word id with step number, which is unique between all the steps
+	static WordIdType GlobalWordId(WordIdType id, size_t stepNum);
 
 	size_t GetMemStat();
-	void SetWordsOffset(uint32_t word_offset);
-	uint32_t GetWordsOffset();
 
-	CommitStep& GetStep(WordIdType id);
-	size_t GetWordsSize();
+	// Step, which contains document
+	CommitStep& GetDocStep(VDocIdType vdocId);
+	// Count of documents, which words are in steps
+	size_t GetDocsCount() const;
+	// Marks document deleted
+	void MarkDeleted(VDocIdType vdocId);
+	// Most of vdocs are deleted
+	bool MostDeleted() const;
 
-	uint32_t GetSuffixWordId(WordIdType id);
-	uint32_t GetSuffixWordId(WordIdType id, const CommitStep& step);
 	void StartCommit(bool complte_updated);
-	bool NeedRebuild(bool complte_updated);
-	bool NeedClear(bool complte_updated);
+	bool NeedRebuild(bool complte_updated) const;
+	// Returns number of the first step, which has to be merged with new step of docsCount documents.
+	// New step follows steps [0, stepsCount). Returns stepsCount, if there is nothing to merge
+	size_t StepsToMerge(size_t stepsCount, size_t docsCount) const;
+	// Merges last steps, starting from step 'from'
+	void MergeSteps(size_t from);
+	// Calculates avg words count per document for bm25 calculation
+	void UpdateAvgWordsCount(size_t fieldsCount);
 	void Clear();
 
 	vector<CommitStep> steps;
 	vector<double> avgWordsCount_;
-	vector<PackedWordEntry> words_;
 
 	// Virtual documents, merged. Addresable by VDocIdType
 	// Temp data for build
 	vector<h_vector<pair<string_view, uint32_t>, 8>> vdocsTexts;
-	size_t vodcsOffset_;
-	size_t szCnt;
+	size_t vodcsOffset_ = 0;
+	size_t szCnt = 0;
 	unordered_map<string, stemmer> stemmers_;
-	ProcessStatus status_;
+	ProcessStatus status_ = FullRebuild;
 
 	vector<search_engine::ISeacher::Ptr> searchers_;
 
 	vector<VDocEntry> vdocs_;
 	vector<unique_ptr<string>> bufStrs_;
-	size_t cur_vdoc_pos_ = 0;
 
-	FtFastConfig* cfg_;
+	FtFastConfig* cfg_ = nullptr;
 };
 }  // namespace reindexer
@@ -1,5 +1,6 @@
 ﻿
 #include "dataprocessor.h"
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <thread>
@@ -24,60 +25,41 @@ const int kDigitUtfSizeof = 1;
 void DataProcessor::Process(bool multithread) {
 	multithread_ = multithread;
 
+	auto &step = holder_.steps.back();
+	step.docsCount_ = holder_.vdocsTexts.size();
+	step.deletedCount_ = 0;
+
 	fast_hash_map<string, WordEntry> words_um;
 	auto tm0 = high_resolution_clock::now();
 	size_t szCnt = buildWordsMap(words_um);
 	auto tm2 = high_resolution_clock::now();
-	auto &words = holder_.GetWords();
-
-	holder_.SetWordsOffset(words.size());
-	size_t wrdOffset = words.size();
 
-	auto found = BuildSuffix(words_um, holder_);
-	auto getWordByIdFunc = bind(&DataHolder::getWordById, &holder_, _1);
+	BuildSuffix(words_um, step);
 
 	// Step 4: Commit suffixes array. It runs in parallel with next step
-	auto &suffixes = holder_.GetSuffix();
+	auto &suffixes = step.suffixes_;
 	auto tm3 = high_resolution_clock::now(), tm4 = high_resolution_clock::now();
-	thread sufBuildThread([&suffixes, &tm3]() {
-		suffixes.build();
+	const FtFastConfig &cfg = *holder_.cfg_;
+	thread sufBuildThread([&step, &cfg, &tm3]() {
+		buildTermsIndex(step, cfg);
 		tm3 = high_resolution_clock::now();
 	});
 
 	// Step 5: Normalize and sort idrelsets. It runs in parallel with next step
 	size_t idsetcnt = 0;
 
-	auto wIt = words.begin() + wrdOffset;
-	auto status = holder_.status_;
-
-	thread idrelsetCommitThread([&wIt, &found, getWordByIdFunc, &tm4, &idsetcnt, &words_um, status]() {
-		uint32_t i = 0;
-		for (auto keyIt = words_um.begin(); keyIt != words_um.end(); keyIt++, i++) {
-			// Pack idrelset
-
-			PackedWordEntry *word;
-
-			if (found.size() && !found[i].isEmpty()) {
-				word = &getWordByIdFunc(found[i]);
-			} else {
-				word = &(*wIt);
-				++wIt;
-				idsetcnt += sizeof(*wIt);
-			}
-
-			if (status == CreateNew) {
-				word->cur_step_pos_ = word->vids_.end().pos();
-			}
-			word->vids_.insert(word->vids_.end(), keyIt->second.vids_.begin(), keyIt->second.vids_.end());
-
-			if (status == FullRebuild) {
-				word->cur_step_pos_ = word->vids_.end().pos();
-			}
-
-			word->vids_.shrink_to_fit();
+	auto &words = step.words_;
+	thread idrelsetCommitThread([&words, &tm4, &idsetcnt, &words_um]() {
+		auto wIt = words.begin();
+		for (auto keyIt = words_um.begin(); keyIt != words_um.end(); keyIt++, wIt++) {
+			// Pack idrelset. Documents of word are unordered, when they are merged from several threads
+			auto &vids = keyIt->second.vids_;
+			std::sort(vids.begin(), vids.end(), [](const IdRelType &lhs, const IdRelType &rhs) { return lhs.id < rhs.id; });
+			wIt->vids_.insert(wIt->vids_.end(), vids.begin(), vids.end());
+			wIt->vids_.shrink_to_fit();
 
 			keyIt->second.vids_.clear();
-			idsetcnt += word->vids_.heap_size();
+			idsetcnt += sizeof(*wIt) + wIt->vids_.heap_size();
 		}
 		tm4 = high_resolution_clock::now();
 	});
@@ -89,13 +71,14 @@ void DataProcessor::Process(bool multithread) {
 	idrelsetCommitThread.join();
 
 	// Step 6: Build typos hash map
-	buildTyposMap(wrdOffset, found);
+	buildTyposMap(step, *holder_.cfg_);
 	// print(words_um);
 
 	auto tm5 = high_resolution_clock::now();
 
 	logPrintf(LogInfo, "FastIndexText[%d] built with [%d uniq words, %d typos, %dKB text size, %dKB suffixarray size, %dKB idrelsets size]",
-			  holder_.steps.size(), words_um.size(), holder_.GetTypos().size(), szCnt / 1024, suffixes.heap_size() / 1024, idsetcnt / 1024);
+			  holder_.steps.size(), words_um.size(), step.typos_.size() + step.hashedTypos_.size(), szCnt / 1024,
+			  (suffixes.heap_size() + step.fstTerms_.heap_size()) / 1024, idsetcnt / 1024);
 
 	logPrintf(LogInfo,
 			  "DataProcessor::Process elapsed %d ms total [ build words %d ms, build typos %d ms | build suffixarry %d ms | sort "
@@ -105,39 +88,73 @@ void DataProcessor::Process(bool multithread) {
 			  duration_cast<milliseconds>(tm4 - tm2).count());
 }
 
-vector<WordIdType> DataProcessor::BuildSuffix(fast_hash_map<std::string, WordEntry> &words_um, DataHolder &holder) {
-	auto &words = holder.GetWords();
-
-	auto &suffix = holder.GetSuffix();
+DataHolder::CommitStep DataProcessor::MergeSteps(const vector<const DataHolder::CommitStep *> &steps, const vector<bool> &deleted,
+												 const FtFastConfig &cfg) {
+	assert(!steps.empty());
+	auto tm0 = high_resolution_clock::now();
+	VDocIdType offset = steps.front()->vdocsOffset_;
+	DataHolder::CommitStep merged;
 
-	suffix.reserve(words_um.size() * 20, words_um.size());
+	size_t wordsCount = 0, textSize = 0;
+	for (auto step : steps) {
+		wordsCount += step->words_.size();
+		textSize += step->suffixes_.text().size();
+	}
+	merged.suffixes_.reserve(textSize, wordsCount);
+	merged.words_.reserve(wordsCount);
+
+	// Word id in merged step by word. The same word can be in several steps
+	fast_hash_map<string, uint32_t> ids;
+	ids.reserve(wordsCount);
+	vector<IdRelType> vids;
+	for (auto step : steps) {
+		auto &suffixes = step->suffixes_;
+		for (size_t i = 0; i < step->words_.size(); ++i) {
+			vids.clear();
+			for (auto &relid : step->words_[i].vids_) {
+				assert(relid.id - offset < deleted.size());
+				if (!deleted[relid.id - offset]) vids.emplace_back(std::move(relid));
+			}
+			if (vids.empty()) continue;
 
-	vector<WordIdType> found;
+			string word(suffixes.word_at(i), suffixes.word_len_at(i));
+			auto res = ids.emplace(word, merged.words_.size());
+			if (res.second) {
+				merged.suffixes_.insert(word, DataHolder::BuildWordId(merged.words_.size()), suffixes.virtual_word_len(i));
+				merged.words_.emplace_back();
+			}
+			auto &mergedVids = merged.words_[res.first->second].vids_;
+			mergedVids.insert(mergedVids.end(), vids.begin(), vids.end());
+		}
+	}
+	for (auto &word : merged.words_) word.vids_.shrink_to_fit();
+	merged.words_.shrink_to_fit();
 
-	found.reserve(words_um.size());
+	buildTermsIndex(merged, cfg);
+	buildTyposMap(merged, cfg);
 
-	for (auto keyIt = words_um.begin(); keyIt != words_um.end(); keyIt++) {
-		// if we still haven't whis word we add it to new suffix tree else we will only add info to current word
+	logPrintf(LogInfo, "DataProcessor::MergeSteps merged %d steps to step with %d uniq words, elapsed %d ms", steps.size(),
+			  merged.words_.size(), duration_cast<milliseconds>(high_resolution_clock::now() - tm0).count());
+	return merged;
+}
 
-		auto id = words.size();
-		// keyIt->second.vids_.Commit();
-		WordIdType pos;
-		pos = holder_.findWord(keyIt->first);
-		found.push_back(pos);
+void DataProcessor::BuildSuffix(fast_hash_map<std::string, WordEntry> &words_um, DataHolder::CommitStep &step) {
+	auto &words = step.words_;
+	auto &suffix = step.suffixes_;
 
-		if (!pos.isEmpty()) {
-			continue;
-		}
+	suffix.reserve(words_um.size() * 20, words_um.size());
+	words.reserve(words_um.size());
 
+	for (auto keyIt = words_um.begin(); keyIt != words_um.end(); keyIt++) {
+		// Each step has own words, so the same word can be in several steps
+		auto pos = DataHolder::BuildWordId(words.size());
 		words.emplace_back(PackedWordEntry());
-		pos = holder_.BuildWordId(id);
 		if (holder_.cfg_->enableNumbersSearch && keyIt->second.virtualWord) {
 			suffix.insert(keyIt->first, pos, kDigitUtfSizeof);
 		} else {
 			suffix.insert(keyIt->first, pos);
 		}
 	}
-	return found;
 }
 
 size_t DataProcessor::buildWordsMap(fast_hash_map<string, WordEntry> &words_um) {
@@ -158,23 +175,26 @@ size_t DataProcessor::buildWordsMap(fast_hash_map<string, WordEntry> &words_um)
 	// int fieldscount = std::max(1, int(this->fields_.size()));
 	int fieldscount = fieldSize_;
 	size_t offset = holder_.vodcsOffset_;
+	// Documents of step have ids from vdocsOffset_ of step. It can differ from their position in vdocs, if step is built separately
+	VDocIdType idOffset = holder_.steps.back().vdocsOffset_;
 	// build words map parallel in maxIndexWorkers threads
-	auto worker = [this, &ctxs, &vdocsTexts, offset, maxIndexWorkers, fieldscount, &cfg, &vdocs](int i) {
+	auto worker = [this, &ctxs, &vdocsTexts, offset, idOffset, maxIndexWorkers, fieldscount, &cfg, &vdocs](int i) {
 		auto ctx = &ctxs[i];
 		string word, str;
 		vector<const char *> wrds;
 		std::vector<string> virtualWords;
 		for (VDocIdType j = i; j < VDocIdType(vdocsTexts.size()); j += maxIndexWorkers) {
-			size_t vdocId = offset + j;
-			vdocs[vdocId].wordsCount.insert(vdocs[vdocId].wordsCount.begin(), fieldscount, 0.0);
-			vdocs[vdocId].mostFreqWordCount.insert(vdocs[vdocId].mostFreqWordCount.begin(), fieldscount, 0.0);
+			VDocIdType vdocId = idOffset + j;
+			auto &vdoc = vdocs[offset + j];
+			vdoc.wordsCount.insert(vdoc.wordsCount.begin(), fieldscount, 0.0);
+			vdoc.mostFreqWordCount.insert(vdoc.mostFreqWordCount.begin(), fieldscount, 0.0);
 
 			for (size_t field = 0; field < vdocsTexts[j].size(); ++field) {
 				split(vdocsTexts[j][field].first, str, wrds, cfg->extraWordSymbols);
 				int rfield = vdocsTexts[j][field].second;
 				assert(rfield < fieldscount);
 
-				vdocs[vdocId].wordsCount[rfield] = wrds.size();
+				vdoc.wordsCount[rfield] = wrds.size();
 
 				int insertPos = -1;
 				for (auto w : wrds) {
@@ -188,12 +208,12 @@ size_t DataProcessor::buildWordsMap(fast_hash_map<string, WordEntry> &words_um)
 						// idxIt->second.vids_.reserve(16);
 					}
 					int mfcnt = idxIt->second.vids_.Add(vdocId, insertPos, rfield);
-					if (mfcnt > vdocs[vdocId].mostFreqWordCount[rfield]) {
-						vdocs[vdocId].mostFreqWordCount[rfield] = mfcnt;
+					if (mfcnt > vdoc.mostFreqWordCount[rfield]) {
+						vdoc.mostFreqWordCount[rfield] = mfcnt;
 					}
 
 					if (cfg->enableNumbersSearch && is_number(word)) {
-						buildVirtualWord(word, ctx->words_um, vdocId, field, insertPos, virtualWords);
+						buildVirtualWord(word, ctx->words_um, vdoc, vdocId, field, insertPos, virtualWords);
 					}
 				}
 			}
@@ -224,17 +244,6 @@ size_t DataProcessor::buildWordsMap(fast_hash_map<string, WordEntry> &words_um)
 		}
 	}
 
-	// Calculate avg words count per document for bm25 calculation
-	if (vdocs.size()) {
-		holder_.avgWordsCount_.resize(fieldscount);
-		for (int i = 0; i < fieldscount; i++) holder_.avgWordsCount_[i] = 0;
-
-		for (auto &vdoc : vdocs) {
-			for (int i = 0; i < fieldscount; i++) holder_.avgWordsCount_[i] += vdoc.wordsCount[i];
-		}
-		for (int i = 0; i < fieldscount; i++) holder_.avgWordsCount_[i] /= vdocs.size();
-	}
-
 	// Check and print potential stop words
 	if (holder_.cfg_->logLevel >= LogInfo) {
 		string str;
@@ -249,17 +258,14 @@ size_t DataProcessor::buildWordsMap(fast_hash_map<string, WordEntry> &words_um)
 	return szCnt;
 }
 
-void DataProcessor::buildVirtualWord(const string &word, fast_hash_map<string, WordEntry> &words_um, VDocIdType docType, int rfield,
-									 size_t insertPos, std::vector<string> &output) {
-	auto &vdocs = holder_.vdocs_;
-
-	auto &vdoc(vdocs[docType]);
+void DataProcessor::buildVirtualWord(const string &word, fast_hash_map<string, WordEntry> &words_um, VDocEntry &vdoc, VDocIdType vdocId,
+									 int rfield, size_t insertPos, std::vector<string> &output) {
 	NumToText::convert(word, output);
 	for (const string &numberWord : output) {
 		WordEntry wentry;
 		wentry.virtualWord = true;
 		auto idxIt = words_um.emplace(numberWord, std::move(wentry)).first;
-		int mfcnt = idxIt->second.vids_.Add(docType, insertPos, rfield);
+		int mfcnt = idxIt->second.vids_.Add(vdocId, insertPos, rfield);
 		if (mfcnt > vdoc.mostFreqWordCount[rfield]) {
 			vdoc.mostFreqWordCount[rfield] = mfcnt;
 		}
@@ -268,27 +274,42 @@ void DataProcessor::buildVirtualWord(const string &word, fast_hash_map<string, W
 	}
 }
 
-void DataProcessor::buildTyposMap(uint32_t startPos, const vector<WordIdType> &found) {
-	if (!holder_.cfg_->maxTyposInWord) {
+void DataProcessor::buildTermsIndex(DataHolder::CommitStep &step, const FtFastConfig &cfg) {
+	if (!cfg.fstTerms) {
+		step.suffixes_.build();
+		return;
+	}
+	step.fstTerms_.build(step.suffixes_);
+	step.suffixes_.build(false);
+}
+
+void DataProcessor::buildTyposMap(DataHolder::CommitStep &step, const FtFastConfig &cfg) {
+	if (!cfg.maxTyposInWord) {
 		return;
 	}
 
 	typos_context tctx[kMaxTyposInWord];
-	auto &typos = holder_.GetTypos();
-	auto &words_ = holder_.GetWords();
-	size_t wordsSize = !found.empty() ? found.size() : words_.size() - startPos;
+	size_t wordsSize = step.words_.size();
+
+	if (cfg.compactTypos) {
+		auto &typos = step.hashedTypos_;
+		typos.reserve(wordsSize * 5 * (10 >> (cfg.maxTyposInWord - 1)));
+		for (size_t i = 0; i < wordsSize; ++i) {
+			auto wordId = DataHolder::BuildWordId(i);
+			mktypos(tctx, step.suffixes_.word_at(i), cfg.maxTyposInWord, cfg.maxTypoLen,
+					[&typos, wordId](const string &typo, int) { typos.emplace(typo, wordId); });
+		}
+		typos.commit();
+		return;
+	}
 
-	typos.reserve(wordsSize * (10 >> (holder_.cfg_->maxTyposInWord - 1)) / 2, wordsSize * 5 * (10 >> (holder_.cfg_->maxTyposInWord - 1)));
+	auto &typos = step.typos_;
+	typos.reserve(wordsSize * (10 >> (cfg.maxTyposInWord - 1)) / 2, wordsSize * 5 * (10 >> (cfg.maxTyposInWord - 1)));
 
 	for (size_t i = 0; i < wordsSize; ++i) {
-		if (!found.empty() && !found[i].isEmpty()) {
-			continue;
-		}
-
-		auto wordId = holder_.BuildWordId(startPos);
-		mktypos(tctx, holder_.GetSuffix().word_at(holder_.GetSuffixWordId(wordId)), holder_.cfg_->maxTyposInWord, holder_.cfg_->maxTypoLen,
+		auto wordId = DataHolder::BuildWordId(i);
+		mktypos(tctx, step.suffixes_.word_at(i), cfg.maxTyposInWord, cfg.maxTypoLen,
 				[&typos, wordId](const string &typo, int) { typos.emplace(typo, wordId); });
-		startPos++;
 	}
 
 	typos.shrink_to_fit();
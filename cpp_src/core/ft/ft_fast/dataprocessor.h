@@ -18,7 +18,12 @@ class DataProcessor {
 public:
 	DataProcessor(DataHolder& holder, size_t fieldSize) : holder_(holder), fieldSize_(fieldSize) {}
 
+	// Builds the last step of holder from texts of new documents
 	void Process(bool multithread);
+	// Merges steps to the new step without parsing of documents texts. Words of documents, which are marked in 'deleted', are dropped.
+	// 'deleted' is addressable by (vdoc id - vdocsOffset_ of the first step)
+	static DataHolder::CommitStep MergeSteps(const vector<const DataHolder::CommitStep*>& steps, const vector<bool>& deleted,
+											 const FtFastConfig& cfg);
 
 private:
 	typedef pair<key_string, reindexer::KeyEntry<IdSetPlain>> BasePair;
@@ -26,12 +31,14 @@ private:
 
 	size_t buildWordsMap(fast_hash_map<string, WordEntry>& m);
 
-	void buildVirtualWord(const string& word, fast_hash_map<string, WordEntry>& words_um, VDocIdType docType, int rfield, size_t insertPos,
-						  std::vector<string>& output);
+	void buildVirtualWord(const string& word, fast_hash_map<string, WordEntry>& words_um, VDocEntry& vdoc, VDocIdType vdocId, int rfield,
+						  size_t insertPos, std::vector<string>& output);
 
-	void buildTyposMap(uint32_t startPos, const vector<WordIdType>& found);
+	static void buildTyposMap(DataHolder::CommitStep& step, const FtFastConfig& cfg);
+	// Builds suffix array or finite state transducers of words
+	static void buildTermsIndex(DataHolder::CommitStep& step, const FtFastConfig& cfg);
 
-	vector<WordIdType> BuildSuffix(fast_hash_map<string, WordEntry>& words_um, DataHolder& holder);
+	void BuildSuffix(fast_hash_map<string, WordEntry>& words_um, DataHolder::CommitStep& step);
 
 	// typename Data::value_type::first_type& GetFirst(typename Data::value_type& val);
 	const BasePair& GetPair(const BasePair& pair) { return pair; }
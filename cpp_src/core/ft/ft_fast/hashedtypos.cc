@@ -0,0 +1,63 @@
+#include "hashedtypos.h"
+#include <algorithm>
+#include "vendor/murmurhash/MurmurHash3.h"
+
+namespace reindexer {
+
+// Average count of hashes in bucket
+const size_t kHashesPerBucket = 4;
+
+uint64_t HashedTypos::hash(const std::string &typo) {
+	uint64_t hash[2];
+	MurmurHash3_x64_128(typo.data(), typo.size(), 0, &hash);
+	return hash[0];
+}
+
+void HashedTypos::commit() {
+	std::sort(build_.begin(), build_.end(), [](const std::pair<uint64_t, WordIdType> &lhs, const std::pair<uint64_t, WordIdType> &rhs) {
+		return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second.data < rhs.second.data);
+	});
+	// The same typo of word is made by deletions of different letters
+	build_.erase(std::unique(build_.begin(), build_.end(),
+							 [](const std::pair<uint64_t, WordIdType> &lhs, const std::pair<uint64_t, WordIdType> &rhs) {
+								 return lhs.first == rhs.first && lhs.second.data == rhs.second.data;
+							 }),
+				 build_.end());
+
+	hashes_.resize(build_.size());
+	words_.resize(build_.size());
+	for (size_t i = 0; i < build_.size(); ++i) {
+		hashes_[i] = build_[i].first;
+		words_[i] = build_[i].second;
+	}
+	std::vector<std::pair<uint64_t, WordIdType>>().swap(build_);
+
+	bucketBits_ = 0;
+	while (bucketBits_ < 32 && (kHashesPerBucket << (bucketBits_ + 1)) <= hashes_.size()) ++bucketBits_;
+	buckets_.assign((size_t(1) << bucketBits_) + 1, 0);
+	for (uint64_t h : hashes_) ++buckets_[bucket(h) + 1];
+	for (size_t i = 1; i < buckets_.size(); ++i) buckets_[i] += buckets_[i - 1];
+}
+
+std::pair<HashedTypos::iterator, HashedTypos::iterator> HashedTypos::equal_range(const std::string &typo) const {
+	if (buckets_.empty()) return {words_.end(), words_.end()};
+	uint64_t h = hash(typo);
+	size_t b = bucket(h);
+	auto rng = std::equal_range(hashes_.begin() + buckets_[b], hashes_.begin() + buckets_[b + 1], h);
+	return {words_.begin() + (rng.first - hashes_.begin()), words_.begin() + (rng.second - hashes_.begin())};
+}
+
+size_t HashedTypos::heap_size() const {
+	return build_.capacity() * sizeof(build_[0]) + hashes_.capacity() * sizeof(uint64_t) + words_.capacity() * sizeof(WordIdType) +
+		   buckets_.capacity() * sizeof(uint32_t);
+}
+
+void HashedTypos::clear() {
+	build_.clear();
+	hashes_.clear();
+	words_.clear();
+	buckets_.clear();
+	bucketBits_ = 0;
+}
+
+}  // namespace reindexer
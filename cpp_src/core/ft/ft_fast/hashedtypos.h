@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "indextexttypes.h"
+
+namespace reindexer {
+
+// Compact map of typos to words. Typos are stored as sorted 64-bit hashes with ids of their words, and hashes are addressed
+// by table of buckets by the high bits of hash. Typo takes ~13 bytes instead of typo string and node of hash map
+class HashedTypos {
+public:
+	typedef std::vector<WordIdType>::const_iterator iterator;
+
+	void reserve(size_t size) { build_.reserve(size); }
+	void emplace(const std::string &typo, WordIdType wordId) { build_.emplace_back(hash(typo), wordId); }
+	// Sorts added typos and builds table of buckets. Typos can't be added after commit
+	void commit();
+	// Words with typo. Different typos have the same hash with probability ~ 2^-64
+	std::pair<iterator, iterator> equal_range(const std::string &typo) const;
+
+	size_t size() const { return hashes_.size(); }
+	size_t heap_size() const;
+	void clear();
+
+protected:
+	static uint64_t hash(const std::string &typo);
+	size_t bucket(uint64_t hash) const { return bucketBits_ ? hash >> (64 - bucketBits_) : 0; }
+
+	std::vector<std::pair<uint64_t, WordIdType>> build_;
+	std::vector<uint64_t> hashes_;
+	std::vector<WordIdType> words_;
+	// Offsets of the first hashes of buckets
+	std::vector<uint32_t> buckets_;
+	unsigned bucketBits_ = 0;
+};
+
+}  // namespace reindexer
@@ -3,7 +3,8 @@
 namespace reindexer {
 
 const uint32_t kWordIdMaxIdVal = 0x7FFFFFF;
-const uint32_t kWordIdMaxStepVal = 0x7F;
+// Step number is stored in 4 bits of word id
+const uint32_t kWordIdMaxStepVal = 0xF;
 
 struct WordIdTypeBit {
 	uint32_t step_num : 4;
@@ -1,8 +1,12 @@
 #include "selecter.h"
+#include <algorithm>
+#include <numeric>
 #include "core/ft/bm25.h"
 #include "core/ft/ft_fuzzy/dataholder/smardeque.h"
 #include "core/ft/typos.h"
+#include "termscache.h"
 #include "tools/logger.h"
+#include "tools/workerpool.h"
 namespace reindexer {
 // Relevancy procent of full word match
 const int kFullMatchProc = 100;
@@ -18,6 +22,8 @@ const int kTypoProc = 85;
 const int kTypoStepProc = 15;
 // Decrease procent of relevancy if pattern found by word stem
 const int kStemProcDecrease = 15;
+// Minimum count of found ids, which are merged by ranges of documents in parallel
+const int kMinParallelMergeIds = 10000;
 
 void Selecter::prepareVariants(FtSelectContext &ctx, FtDSLEntry &term, std::vector<string> &langs) {
 	ctx.variants.clear();
@@ -61,72 +67,76 @@ void Selecter::prepareVariants(FtSelectContext &ctx, FtDSLEntry &term, std::vect
 }
 
 Selecter::MergeData Selecter::Process(FtDSLQuery &dsl) {
-	FtSelectContext ctx;
 	// STEP 2: Search dsl terms for each variant
-	for (auto &term : dsl) {
-		ctx.rawResults.push_back(TextSearchResults());
-		TextSearchResults &res = ctx.rawResults.back();
-		res.term = term;
-
-		// Prepare term variants (original + translit + stemmed + kblayout)
-		this->prepareVariants(ctx, term, holder_.cfg_->stemmers);
-
-		if (holder_.cfg_->logLevel >= LogInfo) {
-			string vars;
-			for (auto &variant : ctx.variants) {
-				if (&variant != &*ctx.variants.begin()) vars += ", ";
-				vars += variant.pattern;
-			}
-			vars += "], typos: [";
-			typos_context tctx[kMaxTyposInWord];
-			if (term.opts.typos)
-				mktypos(tctx, term.pattern, holder_.cfg_->maxTyposInWord, holder_.cfg_->maxTypoLen, [&vars](const string &typo, int) {
-					vars += typo;
-					vars += ", ";
-				});
-			logPrintf(LogInfo, "Variants: [%s]", vars);
+	vector<TextSearchResults> rawResults(dsl.size());
+	WorkerPool::Instance().Run(dsl.size(), holder_.cfg_->selectThreads, [&](size_t i) { processTerm(dsl[i], rawResults[i]); });
+
+	return mergeResults(rawResults);
+}
+
+void Selecter::processTerm(FtDSLEntry &term, TextSearchResults &res) {
+	FtTermsCacheKey cacheKey(term);
+	FtTermsCache::Iterator cached;
+	if (termsCache_) {
+		cached = termsCache_->Get(cacheKey);
+		if (cached.key && cached.val.res) {
+			res = *cached.val.res;
+			res.term = term;
+			return;
 		}
+	}
 
-		processVariants(ctx);
-		if (term.opts.typos) {
-			// Lookup typos from typos_ map and fill results
-			processTypos(ctx, term);
+	FtSelectContext ctx;
+	ctx.rawResults.push_back(TextSearchResults());
+	ctx.rawResults.back().term = term;
+
+	// Prepare term variants (original + translit + stemmed + kblayout)
+	this->prepareVariants(ctx, term, holder_.cfg_->stemmers);
+
+	if (holder_.cfg_->logLevel >= LogInfo) {
+		string vars;
+		for (auto &variant : ctx.variants) {
+			if (&variant != &*ctx.variants.begin()) vars += ", ";
+			vars += variant.pattern;
 		}
+		vars += "], typos: [";
+		typos_context tctx[kMaxTyposInWord];
+		if (term.opts.typos)
+			mktypos(tctx, term.pattern, holder_.cfg_->maxTyposInWord, holder_.cfg_->maxTypoLen, [&vars](const string &typo, int) {
+				vars += typo;
+				vars += ", ";
+			});
+		logPrintf(LogInfo, "Variants: [%s]", vars);
 	}
 
-	return mergeResults(ctx.rawResults);
+	processVariants(ctx);
+	if (term.opts.typos) {
+		// Lookup typos from typos_ map and fill results
+		processTypos(ctx, term);
+	}
+	calcDocsCount(ctx.rawResults.back());
+	res = std::move(ctx.rawResults.back());
+	if (termsCache_ && cached.key) termsCache_->Put(cacheKey, FtTermsCacheVal(std::make_shared<TextSearchResults>(res)));
 }
 
-void Selecter::processStepVariants(FtSelectContext &ctx, DataHolder::CommitStep &step, const FtVariantEntry &variant,
+void Selecter::processStepVariants(FtSelectContext &ctx, DataHolder::CommitStep &step, size_t stepNum, const FtVariantEntry &variant,
 								   TextSearchResults &res) {
 	if (variant.opts.op == OpAnd) {
 		ctx.foundWords.clear();
 	}
 	auto &tmpstr = variant.pattern;
 	auto &suffixes = step.suffixes_;
-	//  Lookup current variant in suffixes array
-	auto keyIt = suffixes.lower_bound(tmpstr);
-
-	int matched = 0, skipped = 0, vids = 0;
-	bool withPrefixes = (variant.opts.pref || variant.opts.suff);
-	bool withSuffixes = variant.opts.suff;
-
-	// Walk current variant in suffixes array and fill results
-	do {
-		if (keyIt == suffixes.end()) break;
+	int matched = 0, skipped = 0, vidsCnt = 0;
+	int matchLen = tmpstr.length();
 
-		WordIdType glbwordId = keyIt->second;
-
-		uint32_t suffixWordId = holder_.GetSuffixWordId(glbwordId, step);
+	// Adds word, which contains variant at position of pattern
+	auto addWord = [&](uint32_t suffixWordId, const char *pattern) {
+		WordIdType glbwordId = DataHolder::GlobalWordId(DataHolder::BuildWordId(suffixWordId), stepNum);
 		const string::value_type *word = suffixes.word_at(suffixWordId);
+		auto &vids = step.words_[suffixWordId].vids_;
 
 		int16_t wordLength = suffixes.word_len_at(suffixWordId);
-
-		ptrdiff_t suffixLen = keyIt->first - word;
-		int matchLen = tmpstr.length();
-
-		if (!withSuffixes && suffixLen) continue;
-		if (!withPrefixes && wordLength != matchLen) break;
+		ptrdiff_t suffixLen = pattern - word;
 
 		int matchDif = std::abs(long(wordLength - matchLen + suffixLen));
 		int proc =
@@ -134,23 +144,57 @@ void Selecter::processStepVariants(FtSelectContext &ctx, DataHolder::CommitStep
 
 		auto it = ctx.foundWords.find(glbwordId);
 		if (it == ctx.foundWords.end() || it->second.first != ctx.rawResults.size() - 1) {
-			res.push_back({&holder_.getWordById(glbwordId).vids_, keyIt->first, proc, suffixes.virtual_word_len(suffixWordId)});
-			res.idsCnt_ += holder_.getWordById(glbwordId).vids_.size();
+			res.push_back({&vids, pattern, proc, suffixes.virtual_word_len(suffixWordId), word, 0});
+			res.idsCnt_ += vids.size();
 			ctx.foundWords[glbwordId] = std::make_pair(ctx.rawResults.size() - 1, res.size() - 1);
 			if (holder_.cfg_->logLevel >= LogTrace)
-				logPrintf(LogTrace, " matched %s '%s' of word '%s', %d vids, %d%%", suffixLen ? "suffix" : "prefix", keyIt->first, word,
-						  holder_.getWordById(glbwordId).vids_.size(), proc);
+				logPrintf(LogTrace, " matched %s '%s' of word '%s', %d vids, %d%%", suffixLen ? "suffix" : "prefix", pattern, word,
+						  vids.size(), proc);
 			matched++;
-			vids += holder_.getWordById(glbwordId).vids_.size();
+			vidsCnt += vids.size();
 		} else {
 			if (ctx.rawResults[it->second.first][it->second.second].proc_ < proc)
 				ctx.rawResults[it->second.first][it->second.second].proc_ = proc;
 			skipped++;
 		}
-	} while ((keyIt++).lcp() >= int(tmpstr.length()));
+	};
+
+	if (!step.fstTerms_.empty()) {
+		// Lookup current variant in transducers. They find words by prefix or by suffix, but not by the middle of word
+		if (!variant.opts.pref && !variant.opts.suff) {
+			int wordId = step.fstTerms_.find(tmpstr);
+			if (wordId >= 0) addWord(wordId, suffixes.word_at(wordId));
+		}
+		if (variant.opts.pref) {
+			auto rng = step.fstTerms_.with_prefix(tmpstr);
+			for (auto it = rng.first; it != rng.second; ++it) addWord(*it, suffixes.word_at(*it));
+		}
+		if (variant.opts.suff) {
+			auto rng = step.fstTerms_.with_suffix(tmpstr);
+			for (auto it = rng.first; it != rng.second; ++it) addWord(*it, suffixes.word_at(*it) + suffixes.word_len_at(*it) - matchLen);
+		}
+	} else {
+		//  Lookup current variant in suffixes array
+		auto keyIt = suffixes.lower_bound(tmpstr);
+		bool withPrefixes = (variant.opts.pref || variant.opts.suff);
+		bool withSuffixes = variant.opts.suff;
+
+		// Walk current variant in suffixes array and fill results
+		do {
+			if (keyIt == suffixes.end()) break;
+
+			uint32_t suffixWordId = keyIt->second.b.id;
+			ptrdiff_t suffixLen = keyIt->first - suffixes.word_at(suffixWordId);
+
+			if (!withSuffixes && suffixLen) continue;
+			if (!withPrefixes && suffixes.word_len_at(suffixWordId) != matchLen) break;
+
+			addWord(suffixWordId, keyIt->first);
+		} while ((keyIt++).lcp() >= matchLen);
+	}
 	if (holder_.cfg_->logLevel >= LogInfo)
-		logPrintf(LogInfo, "Lookup variant '%s' (%d%%), matched %d suffixes, with %d vids, skiped %d", tmpstr, variant.proc, matched, vids,
-				  skipped);
+		logPrintf(LogInfo, "Lookup variant '%s' (%d%%), matched %d suffixes, with %d vids, skiped %d", tmpstr, variant.proc, matched,
+				  vidsCnt, skipped);
 }
 
 void Selecter::processVariants(FtSelectContext &ctx) {
@@ -160,8 +204,8 @@ void Selecter::processVariants(FtSelectContext &ctx) {
 		if (variant.opts.op == OpAnd) {
 			ctx.foundWords.clear();
 		}
-		for (auto &step : holder_.steps) {
-			processStepVariants(ctx, step, variant, res);
+		for (size_t i = 0; i < holder_.steps.size(); ++i) {
+			processStepVariants(ctx, holder_.steps[i], i, variant, res);
 		}
 	}
 }
@@ -169,44 +213,67 @@ void Selecter::processVariants(FtSelectContext &ctx) {
 void Selecter::processTypos(FtSelectContext &ctx, FtDSLEntry &term) {
 	TextSearchResults &res = ctx.rawResults.back();
 
-	for (auto &step : holder_.steps) {
+	for (size_t stepNum = 0; stepNum < holder_.steps.size(); ++stepNum) {
+		auto &step = holder_.steps[stepNum];
 		typos_context tctx[kMaxTyposInWord];
 		auto &typos = step.typos_;
 		int matched = 0, skiped = 0, vids = 0;
+		auto addWord = [&](WordIdType wordId, const char *typo, int tcount) {
+			WordIdType wordIdglb = DataHolder::GlobalWordId(wordId, stepNum);
+			auto wordIdSfx = wordId.b.id;
+			auto &wordVids = step.words_[wordIdSfx].vids_;
+
+			// bool virtualWord = suffixes_.is_word_virtual(wordId);
+			uint8_t wordLength = step.suffixes_.word_len_at(wordIdSfx);
+			int proc = kTypoProc - tcount * kTypoStepProc / std::max((wordLength - tcount) / 3, 1);
+			auto it = ctx.foundWords.find(wordIdglb);
+			if (it == ctx.foundWords.end()) {
+				res.push_back({&wordVids, typo, proc, step.suffixes_.virtual_word_len(wordIdSfx), step.suffixes_.word_at(wordIdSfx), 0});
+				res.idsCnt_ += wordVids.size();
+				ctx.foundWords.emplace(wordIdglb, std::make_pair(ctx.rawResults.size() - 1, res.size() - 1));
+
+				if (holder_.cfg_->logLevel >= LogTrace)
+					logPrintf(LogTrace, " matched typo '%s' of word '%s', %d ids, %d%%", typo, step.suffixes_.word_at(wordIdSfx),
+							  wordVids.size(), proc);
+				++matched;
+				vids += wordVids.size();
+			} else
+				++skiped;
+		};
 		mktypos(tctx, term.pattern, holder_.cfg_->maxTyposInWord, holder_.cfg_->maxTypoLen, [&](const string &typo, int tcount) {
-			auto typoRng = typos.equal_range(typo);
 			tcount = holder_.cfg_->maxTyposInWord - tcount;
-			for (auto typoIt = typoRng.first; typoIt != typoRng.second; typoIt++) {
-				WordIdType wordIdglb = typoIt->second;
-				auto &step = holder_.GetStep(wordIdglb);
-
-				auto wordIdSfx = holder_.GetSuffixWordId(wordIdglb, step);
-
-				// bool virtualWord = suffixes_.is_word_virtual(wordId);
-				uint8_t wordLength = step.suffixes_.word_len_at(wordIdSfx);
-				int proc = kTypoProc - tcount * kTypoStepProc / std::max((wordLength - tcount) / 3, 1);
-				auto it = ctx.foundWords.find(wordIdglb);
-				if (it == ctx.foundWords.end()) {
-					res.push_back({&holder_.getWordById(wordIdglb).vids_, typoIt->first, proc, step.suffixes_.virtual_word_len(wordIdSfx)});
-					res.idsCnt_ += holder_.getWordById(wordIdglb).vids_.size();
-					ctx.foundWords.emplace(wordIdglb, std::make_pair(ctx.rawResults.size() - 1, res.size() - 1));
-
-					if (holder_.cfg_->logLevel >= LogTrace)
-						logPrintf(LogTrace, " matched typo '%s' of word '%s', %d ids, %d%%", typoIt->first,
-								  step.suffixes_.word_at(wordIdSfx), holder_.getWordById(wordIdglb).vids_.size(), proc);
-					++matched;
-					vids += holder_.getWordById(wordIdglb).vids_.size();
-				} else
-					++skiped;
-			}
+			auto typoRng = typos.equal_range(typo);
+			for (auto typoIt = typoRng.first; typoIt != typoRng.second; typoIt++) addWord(typoIt->second, typoIt->first, tcount);
+			// Hashed typos don't store strings of typos, so the word itself is the pattern of result
+			auto hashedRng = step.hashedTypos_.equal_range(typo);
+			for (auto wordIt = hashedRng.first; wordIt != hashedRng.second; wordIt++)
+				addWord(*wordIt, step.suffixes_.word_at(wordIt->b.id), tcount);
 		});
 		if (holder_.cfg_->logLevel >= LogInfo)
 			logPrintf(LogInfo, "Lookup typos, matched %d typos, with %d vids, skiped %d", matched, vids, skiped);
 	}
 }
 
+void Selecter::calcDocsCount(TextSearchResults &res) {
+	if (holder_.steps.size() < 2) {
+		for (auto &r : res) r.docsCount_ = r.vids_->size();
+		return;
+	}
+	// Word can be in several steps: idf of word is calculated by count of it's documents in all the steps
+	fast_hash_map<string, int> docsCount;
+	for (auto &r : res) docsCount[r.word_] += r.vids_->size();
+	for (auto &r : res) r.docsCount_ = docsCount[r.word_];
+}
+
 double bound(double k, double weight, double boost) { return (1.0 - weight) + k * boost * weight; }
 
+double Selecter::rankBound(const TextSearchResults &rawRes, const TextSearchResult &r, double idf, double termLenBoost, int maxWords) {
+	double fboost = 0;
+	for (auto b : rawRes.term.opts.fieldsBoost) fboost = std::max<double>(fboost, b);
+	auto normBm25 = bound(idf * bm25scoreMax(maxWords), holder_.cfg_->bm25Weight, holder_.cfg_->bm25Boost);
+	return fboost * r.proc_ * normBm25 * rawRes.term.opts.boost * termLenBoost;
+}
+
 void Selecter::debugMergeStep(const char *msg, int vid, float normBm25, float normDist, int finalRank, int prevRank) {
 #ifdef REINDEX_FT_EXTRA_DEBUG
 	if (holder_.cfg_->logLevel < LogTrace) return;
@@ -231,133 +298,213 @@ void Selecter::debugMergeStep(const char *msg, int vid, float normBm25, float no
 }
 
 void Selecter::mergeItaration(TextSearchResults &rawRes, vector<bool> &exists, vector<MergeInfo> &merged, vector<MergedIdRel> &merged_rd,
-							  h_vector<int16_t> &idoffsets) {
+							  h_vector<int16_t> &idoffsets, TopK &topK, const MergeRange &range) {
 	auto &vdocs = holder_.vdocs_;
 
-	int totalDocsCount = vdocs.size();
+	// Documents of steps, including deleted ones, which words are not removed from steps yet
+	int totalDocsCount = holder_.GetDocsCount();
 	bool simple = idoffsets.size() == 0;
 	auto op = rawRes.term.opts.op;
 
-	vector<bool> curExists(simple ? 0 : totalDocsCount, false);
+	vector<bool> curExists(simple ? 0 : range.to - range.from, false);
 
 	for (auto &m_rd : merged_rd) {
-		if (m_rd.next.pos.size()) m_rd.cur = std::move(m_rd.next);
-	}
-
-	for (auto &r : rawRes) {
-		auto idf = IDF(totalDocsCount, r.vids_->size());
-		auto termLenBoost = bound(rawRes.term.opts.boost, holder_.cfg_->termLenWeight, holder_.cfg_->termLenBoost);
-		if (holder_.cfg_->logLevel >= LogTrace) {
-			logPrintf(LogTrace, "Pattern %s, idf %f, termLenBoost %f", r.pattern, idf, termLenBoost);
+		if (m_rd.next.pos.size()) {
+			m_rd.cur = std::move(m_rd.next);
+			m_rd.qpos = rawRes.term.opts.qpos - 1;
 		}
+	}
 
-		for (auto &relid : *r.vids_) {
-			int vid = relid.id;
-
-			// Do not calc anithing if
-			if (op == OpAnd && !exists[vid]) {
-				continue;
-			}
-
-			assert(vid < int(exists.size()));
-
-			int field = relid.pos[0].field();
-			assert(field < int(vdocs[vid].wordsCount.size()));
-			assert(field < int(rawRes.term.opts.fieldsBoost.size()));
-
-			auto fboost = rawRes.term.opts.fieldsBoost[field];
-			if (!fboost) {
-				// TODO: search another fields
-				continue;
-			};
-
-			// raw bm25
-			auto bm25 = idf * bm25score(relid.wordsInField(field), vdocs[vid].mostFreqWordCount[field], vdocs[vid].wordsCount[field],
-										holder_.avgWordsCount_[field]);
-
-			// normalized bm25
-			auto normBm25 = bound(bm25, holder_.cfg_->bm25Weight, holder_.cfg_->bm25Boost);
-
-			// final term rank calculation
-			double termRank = fboost * r.proc_ * normBm25 * rawRes.term.opts.boost * termLenBoost;
+	auto mergeEntry = [&](const TextSearchResult &r, PackedIdRelSet::iterator &it, double idf, double termLenBoost) {
+		int vid = it.Id();
+		// Document was deleted after build of step
+		if (!vdocs[vid].keyEntry) return;
 
-			if (!simple) {
-				auto moffset = idoffsets[vid];
-				if (exists[vid]) {
-					assert(relid.pos.size());
-					assert(merged_rd[moffset].cur.pos.size());
+		int offset = vid - range.from;
+		// Do not calc anithing if
+		if (op == OpAnd && !exists[offset]) {
+			return;
+		}
 
-					// match of 2-rd, and next terms
-					if (op == OpNot) {
-						merged[moffset].proc = 0;
-						exists[vid] = false;
-					} else {
-						// Calculate words distance
-						int distance = 0;
-						float normDist = 1;
+		assert(offset < int(exists.size()));
+
+		int field = it.Field();
+		assert(field < int(vdocs[vid].wordsCount.size()));
+		assert(field < int(rawRes.term.opts.fieldsBoost.size()));
+
+		auto fboost = rawRes.term.opts.fieldsBoost[field];
+		if (!fboost) {
+			// TODO: search another fields
+			return;
+		};
+
+		// raw bm25
+		auto bm25 = idf * bm25score(it.WordsInField(), vdocs[vid].mostFreqWordCount[field], vdocs[vid].wordsCount[field],
+									holder_.avgWordsCount_[field]);
+
+		// normalized bm25
+		auto normBm25 = bound(bm25, holder_.cfg_->bm25Weight, holder_.cfg_->bm25Boost);
+
+		// final term rank calculation
+		double termRank = fboost * r.proc_ * normBm25 * rawRes.term.opts.boost * termLenBoost;
+
+		if (!simple) {
+			auto moffset = idoffsets[offset];
+			if (exists[offset]) {
+				assert(merged_rd[moffset].cur.pos.size());
+
+				// match of 2-rd, and next terms
+				if (op == OpNot) {
+					merged[moffset].proc = 0;
+					exists[offset] = false;
+				} else {
+					auto &m_rd = merged_rd[moffset];
+					// Positions are decoded only for distance and areas
+					auto &relid = *it;
+					// Calculate words distance
+					int distance = 0;
+					float normDist = 1;
+					bool sameTerm = m_rd.qpos == rawRes.term.opts.qpos;
+
+					if (!sameTerm) {
+						distance = m_rd.cur.distance(relid, INT_MAX);
+
+						// Normaized distance
+						normDist =
+							bound(1.0 / double(std::max(distance, 1)), holder_.cfg_->distanceWeight, holder_.cfg_->distanceBoost);
+					}
+					int finalRank = normDist * termRank;
 
-						if (merged_rd[moffset].qpos != rawRes.term.opts.qpos) {
-							distance = merged_rd[moffset].cur.distance(relid, INT_MAX);
+					// Term of phrase or 'NEAR' operator is found only near the previous term: the rest positions of term are skipped
+					bool near = true;
+					if (rawRes.term.opts.distance != INT_MAX) {
+						near = m_rd.qpos == rawRes.term.opts.qpos - 1 &&
+							   relid.filterNear(m_rd.cur, rawRes.term.opts.distance, rawRes.term.opts.ordered);
+					}
 
-							// Normaized distance
-							normDist =
-								bound(1.0 / double(std::max(distance, 1)), holder_.cfg_->distanceWeight, holder_.cfg_->distanceBoost);
+					if (near && (!curExists[offset] || finalRank > m_rd.rank)) {
+						// distance and rank is better, than prev. update rank
+						if (curExists[offset]) {
+							merged[moffset].proc -= m_rd.rank;
+							debugMergeStep("merged better score ", vid, normBm25, normDist, finalRank, m_rd.rank);
+						} else {
+							debugMergeStep("merged new ", vid, normBm25, normDist, finalRank, m_rd.rank);
 						}
-						int finalRank = normDist * termRank;
-
-						if (distance <= rawRes.term.opts.distance && (!curExists[vid] || finalRank > merged_rd[moffset].rank)) {
-							// distance and rank is better, than prev. update rank
-							if (curExists[vid]) {
-								merged[moffset].proc -= merged_rd[moffset].rank;
-								debugMergeStep("merged better score ", vid, normBm25, normDist, finalRank, merged_rd[moffset].rank);
-							} else {
-								debugMergeStep("merged new ", vid, normBm25, normDist, finalRank, merged_rd[moffset].rank);
-							}
-							merged[moffset].proc += finalRank;
-							if (needArea_) {
-								for (auto pos : relid.pos) {
-									if (!merged[moffset].holder->AddWord(pos.pos(), r.wordLen_, pos.field())) {
-										break;
-									}
+						merged[moffset].proc += finalRank;
+						if (needArea_) {
+							for (auto pos : relid.pos) {
+								if (!merged[moffset].holder->AddWord(pos.pos(), r.wordLen_, pos.field())) {
+									break;
 								}
 							}
-							merged_rd[moffset].rank = finalRank;
-							merged_rd[moffset].next = std::move(relid);
-							curExists[vid] = true;
+						}
+						m_rd.rank = finalRank;
+					} else {
+						debugMergeStep("skiped ", vid, normBm25, normDist, finalRank, m_rd.rank);
+					}
+					if (near) {
+						// Positions of all the found words of term are used for distance to the next term
+						if (sameTerm) {
+							m_rd.cur.mergePositions(relid);
+						} else if (curExists[offset]) {
+							m_rd.next.mergePositions(relid);
 						} else {
-							debugMergeStep("skiped ", vid, normBm25, normDist, finalRank, merged_rd[moffset].rank);
+							m_rd.next = std::move(relid);
 						}
+						curExists[offset] = true;
 					}
 				}
 			}
-			if (int(merged.size()) < holder_.cfg_->mergeLimit && op == OpOr && !exists[vid]) {
-				// match of 1-st term
-				MergeInfo info;
-				info.id = vid;
-				info.proc = termRank;
-				if (needArea_) {
-					info.holder.reset(new AreaHolder);
-					info.holder->ReserveField(fieldSize_);
-					for (auto pos : relid.pos) {
-						info.holder->AddWord(pos.pos(), r.wordLen_, pos.field());
-					}
+		}
+		if (int(merged.size()) < range.limit && op == OpOr && !exists[offset]) {
+			if (topK.prune && topK.Full() && termRank + topK.nextTermsBound <= topK.Threshold()) {
+				// Document can't get into the best documents. Document of single term gets rank of it's first found word
+				if (simple) exists[offset] = true;
+				return;
+			}
+			// match of 1-st term
+			MergeInfo info;
+			info.id = vid;
+			info.proc = termRank;
+			if (topK.prune) topK.Push(info.proc);
+			if (needArea_) {
+				info.holder.reset(new AreaHolder);
+				info.holder->ReserveField(fieldSize_);
+				for (auto pos : it->pos) {
+					info.holder->AddWord(pos.pos(), r.wordLen_, pos.field());
 				}
-				merged.push_back(std::move(info));
-				exists[vid] = true;
-				if (simple) continue;
-				// prepare for intersect with next terms
-				merged_rd.push_back({IdRelType(std::move(relid)), IdRelType(), int(termRank), rawRes.term.opts.qpos});
-				curExists[vid] = true;
-				idoffsets[vid] = merged.size() - 1;
 			}
+			merged.push_back(std::move(info));
+			exists[offset] = true;
+			if (simple) return;
+			// prepare for intersect with next terms
+			merged_rd.push_back({IdRelType(std::move(*it)), IdRelType(), int(termRank), rawRes.term.opts.qpos});
+			curExists[offset] = true;
+			idoffsets[offset] = merged.size() - 1;
+		}
+	};
+
+	// Terms with 'and' and 'not' operations change only found documents: other documents of term are skipped by blocks
+	vector<VDocIdType> found;
+	if (op == OpAnd || op == OpNot) {
+		for (auto &info : merged) {
+			if (exists[info.id - range.from]) found.push_back(info.id);
+		}
+		std::sort(found.begin(), found.end());
+	}
+
+	auto termLenBoost = bound(rawRes.term.opts.boost, holder_.cfg_->termLenWeight, holder_.cfg_->termLenBoost);
+	// Words of single term are sorted by proc, but their rank bounds depend on idf too: bounds of the next words are maximums
+	vector<double> nextWordsBound;
+	if (topK.prune && simple) {
+		nextWordsBound.resize(rawRes.size() + 1, 0);
+		for (size_t i = rawRes.size(); i > 0; --i) {
+			auto &r = rawRes[i - 1];
+			nextWordsBound[i - 1] =
+				std::max(nextWordsBound[i], rankBound(rawRes, r, IDF(totalDocsCount, r.docsCount_), termLenBoost, INT_MAX));
+		}
+	}
+
+	for (size_t i = 0; i < rawRes.size(); ++i) {
+		auto &r = rawRes[i];
+		auto idf = IDF(totalDocsCount, r.docsCount_);
+		if (holder_.cfg_->logLevel >= LogTrace) {
+			logPrintf(LogTrace, "Pattern %s, idf %f, termLenBoost %f", r.pattern, idf, termLenBoost);
+		}
+
+		if (op == OpAnd || op == OpNot) {
+			auto it = r.vids_->begin();
+			for (auto vid : found) {
+				if (!it.SkipTo(vid)) break;
+				if (it.Id() == vid) mergeEntry(r, it, idf, termLenBoost);
+			}
+		} else if (!nextWordsBound.empty()) {
+			if (topK.Full() && nextWordsBound[i] <= topK.Threshold()) break;
+			auto it = r.vids_->begin(), end = r.vids_->end();
+			if (!it.SkipTo(range.from)) continue;
+			while (it != end && it.Id() < range.to) {
+				// Documents of block are skipped, if the next words can't get them into the best documents too
+				if (topK.Full() && nextWordsBound[i + 1] <= topK.Threshold() &&
+					rankBound(rawRes, r, idf, termLenBoost, it.BlockMaxWords()) <= topK.Threshold()) {
+					it.NextBlock();
+					continue;
+				}
+				do {
+					mergeEntry(r, it, idf, termLenBoost);
+				} while (++it != end && !it.BlockStart() && it.Id() < range.to);
+			}
+		} else {
+			auto it = r.vids_->begin(), end = r.vids_->end();
+			if (!it.SkipTo(range.from)) continue;
+			for (; it != end && it.Id() < range.to; ++it) mergeEntry(r, it, idf, termLenBoost);
 		}
 	}
 	if (op == OpAnd) {
 		for (auto &info : merged) {
-			auto vid = info.id;
-			if (exists[vid] && !curExists[vid]) {
+			auto offset = info.id - range.from;
+			if (exists[offset] && !curExists[offset]) {
 				info.proc = 0;
-				exists[vid] = false;
+				exists[offset] = false;
 			}
 		}
 	}
@@ -369,33 +516,92 @@ Selecter::MergeData Selecter::mergeResults(vector<TextSearchResults> &rawResults
 
 	if (!rawResults.size() || !vdocs.size()) return merged;
 
-	vector<bool> exists(vdocs.size(), false);
-	vector<MergedIdRel> merged_rd;
-	h_vector<int16_t> idoffsets;
-
 	int idsMaxCnt = 0;
 	for (auto &rawRes : rawResults) {
 		std::sort(rawRes.begin(), rawRes.end(),
 				  [](const TextSearchResult &lhs, const TextSearchResult &rhs) { return lhs.proc_ > rhs.proc_; });
 		if (rawRes.term.opts.op == OpOr || !idsMaxCnt) idsMaxCnt += rawRes.idsCnt_;
 	}
+	rawResults[0].term.opts.op = OpOr;
 
-	merged.reserve(std::min(holder_.cfg_->mergeLimit, idsMaxCnt));
+	bool prune = topK_ && std::all_of(rawResults.begin(), rawResults.end(),
+									  [](const TextSearchResults &rawRes) { return rawRes.term.opts.op == OpOr; });
+	// Upper bounds of ranks, which terms add to documents. They are calculated only for pruning by ranks
+	vector<double> termsBound;
+	if (prune) {
+		termsBound.resize(rawResults.size(), 0);
+		int totalDocsCount = holder_.GetDocsCount();
+		double distanceBound = std::max(1.0, bound(1.0, holder_.cfg_->distanceWeight, holder_.cfg_->distanceBoost));
+		for (size_t i = 0; i < rawResults.size(); ++i) {
+			auto &rawRes = rawResults[i];
+			auto termLenBoost = bound(rawRes.term.opts.boost, holder_.cfg_->termLenWeight, holder_.cfg_->termLenBoost);
+			for (auto &r : rawRes) {
+				termsBound[i] = std::max(
+					termsBound[i], distanceBound * rankBound(rawRes, r, IDF(totalDocsCount, r.docsCount_), termLenBoost, INT_MAX));
+			}
+		}
+	}
 
-	if (rawResults.size() > 1) {
-		idoffsets.resize(vdocs.size());
-		merged_rd.reserve(std::min(holder_.cfg_->mergeLimit, idsMaxCnt));
+	// Large results are merged by ranges of documents in parallel. Merge limit is divided between ranges by their sizes
+	size_t rangesCount = idsMaxCnt >= kMinParallelMergeIds ? std::min<size_t>(holder_.cfg_->selectThreads, vdocs.size()) : 1;
+	vector<MergeData> rangesMerged(rangesCount);
+	WorkerPool::Instance().Run(rangesCount, rangesCount, [&](size_t i) {
+		MergeRange range;
+		range.from = vdocs.size() * i / rangesCount;
+		range.to = vdocs.size() * (i + 1) / rangesCount;
+		range.limit = rangesCount == 1 ? holder_.cfg_->mergeLimit
+									   : std::max<int>(1, int64_t(holder_.cfg_->mergeLimit) * (range.to - range.from) / vdocs.size());
+		mergeRange(rawResults, termsBound, idsMaxCnt, range, rangesMerged[i]);
+	});
+
+	merged = std::move(rangesMerged[0]);
+	for (size_t i = 1; i < rangesCount; ++i) {
+		merged.insert(merged.end(), std::make_move_iterator(rangesMerged[i].begin()), std::make_move_iterator(rangesMerged[i].end()));
+	}
+	if (holder_.cfg_->logLevel >= LogInfo)
+		logPrintf(LogInfo, "Complex merge (%d patterns, %d ranges): out %d vids", rawResults.size(), rangesCount, merged.size());
+
+	auto byRank = [](const MergeInfo &lhs, const MergeInfo &rhs) { return lhs.proc > rhs.proc; };
+	if (topK_ && merged.size() > topK_) {
+		// Only the best documents are requested
+		std::partial_sort(merged.begin(), merged.begin() + topK_, merged.end(), byRank);
+		merged.erase(merged.begin() + topK_, merged.end());
+	} else {
+		std::sort(merged.begin(), merged.end(), byRank);
 	}
-	rawResults[0].term.opts.op = OpOr;
-	for (auto &rawRes : rawResults) {
-		mergeItaration(rawRes, exists, merged, merged_rd, idoffsets);
 
-		if (rawRes.term.opts.op != OpNot) merged.mergeCnt++;
+	return merged;
+}
+
+void Selecter::mergeRange(vector<TextSearchResults> &rawResults, const vector<double> &termsBound, int idsMaxCnt,
+						  const MergeRange &range, MergeData &merged) {
+	vector<bool> exists(range.to - range.from, false);
+	vector<MergedIdRel> merged_rd;
+	h_vector<int16_t> idoffsets;
+
+	merged.reserve(std::min(range.limit, idsMaxCnt));
+
+	if (rawResults.size() > 1) {
+		idoffsets.resize(range.to - range.from);
+		merged_rd.reserve(std::min(range.limit, idsMaxCnt));
 	}
-	if (holder_.cfg_->logLevel >= LogInfo) logPrintf(LogInfo, "Complex merge (%d patterns): out %d vids", rawResults.size(), merged.size());
 
-	std::sort(merged.begin(), merged.end(), [](const MergeInfo &lhs, const MergeInfo &rhs) { return lhs.proc > rhs.proc; });
+	TopK topK(topK_);
+	topK.prune = !termsBound.empty();
+
+	for (size_t i = 0; i < rawResults.size(); ++i) {
+		auto &rawRes = rawResults[i];
+		if (topK.prune) {
+			topK.nextTermsBound = std::accumulate(termsBound.begin() + i + 1, termsBound.end(), 0.0);
+			if (i) {
+				// Ranks of found documents are increased by the previous terms
+				topK.ranks = decltype(topK.ranks)();
+				for (auto &info : merged) topK.Push(info.proc);
+			}
+		}
+		mergeItaration(rawRes, exists, merged, merged_rd, idoffsets, topK, range);
 
-	return merged;
+		if (rawRes.term.opts.op != OpNot) merged.mergeCnt++;
+	}
 }
 }  // namespace reindexer
@@ -1,4 +1,5 @@
 #pragma once
+#include <queue>
 #include "core/ft/config/ftfastconfig.h"
 #include "core/ft/ftdsl.h"
 #include "core/ft/idrelset.h"
@@ -9,15 +10,21 @@
 using std::vector;
 namespace reindexer {
 
+class FtTermsCache;
+
 class Selecter {
 public:
-	Selecter(DataHolder& holder, size_t fieldSize, bool needArea) : holder_(holder), fieldSize_(fieldSize), needArea_(needArea) {}
+	Selecter(DataHolder& holder, size_t fieldSize, bool needArea, size_t topK, FtTermsCache* termsCache = nullptr)
+		: holder_(holder), fieldSize_(fieldSize), needArea_(needArea), topK_(topK), termsCache_(termsCache) {}
 
 	struct TextSearchResult {
 		const PackedIdRelSet* vids_;
 		const char* pattern;
 		int proc_;
 		int16_t wordLen_;
+		const char* word_;
+		// Count of documents with the word in all the steps
+		int docsCount_;
 	};
 
 	struct MergeInfo {
@@ -32,9 +39,12 @@ public:
 	};
 
 	struct MergedIdRel {
+		// Positions of the last found previous term
 		IdRelType cur;
+		// Positions of current term
 		IdRelType next;
 		int rank;
+		// Query position of term of cur
 		int qpos;
 	};
 	struct FtVariantEntry {
@@ -48,6 +58,29 @@ public:
 		FtDSLEntry term;
 	};
 
+	// Ranks of the best topK_ found documents. Documents, which can't get into them, are not merged
+	struct TopK {
+		explicit TopK(size_t k) : k(k) {}
+		bool Full() const { return k && ranks.size() >= k; }
+		int Threshold() const { return ranks.top(); }
+		void Push(int rank) {
+			if (ranks.size() < k) {
+				ranks.push(rank);
+			} else if (rank > ranks.top()) {
+				ranks.pop();
+				ranks.push(rank);
+			}
+		}
+
+		size_t k;
+		// Lower bounds of ranks of different documents
+		std::priority_queue<int, vector<int>, std::greater<int>> ranks;
+		// Upper bound of rank, which document can get from the next terms
+		double nextTermsBound = 0;
+		// Documents are skipped by rank bounds only if all the terms are 'or' terms: 'and' and 'not' terms decrease ranks
+		bool prune = false;
+	};
+
 	MergeData Process(FtDSLQuery& dsl);
 	struct FtSelectContext {
 		vector<FtVariantEntry> variants;
@@ -55,20 +88,40 @@ public:
 		typename DataHolder::FondWordsType foundWords;
 		vector<TextSearchResults> rawResults;
 	};
+	// Documents with vdoc ids [from, to) are merged, but not more than limit documents.
+	// Vectors of merge state are addressable by (vdoc id - from)
+	struct MergeRange {
+		VDocIdType from;
+		VDocIdType to;
+		int limit;
+	};
+
+	// Searches words of term. Terms are searched independently, so they can be searched in parallel
+	void processTerm(FtDSLEntry& term, TextSearchResults& res);
 	MergeData mergeResults(vector<TextSearchResults>& rawResults);
+	void mergeRange(vector<TextSearchResults>& rawResults, const vector<double>& termsBound, int idsMaxCnt, const MergeRange& range,
+					MergeData& merged);
 	void mergeItaration(TextSearchResults& rawRes, vector<bool>& exists, vector<MergeInfo>& merged, vector<MergedIdRel>& merged_rd,
-						h_vector<int16_t>& idoffsets);
+						h_vector<int16_t>& idoffsets, TopK& topK, const MergeRange& range);
+	// Upper bound of rank of word of term in documents, where word is found not more than maxWords times in field
+	double rankBound(const TextSearchResults& rawRes, const TextSearchResult& r, double idf, double termLenBoost, int maxWords);
 
 	void debugMergeStep(const char* msg, int vid, float normBm25, float normDist, int finalRank, int prevRank);
 	void processVariants(FtSelectContext&);
 	void prepareVariants(FtSelectContext&, FtDSLEntry&, std::vector<string>& langs);
-	void processStepVariants(FtSelectContext& ctx, DataHolder::CommitStep& step, const FtVariantEntry& variant, TextSearchResults& res);
+	void processStepVariants(FtSelectContext& ctx, DataHolder::CommitStep& step, size_t stepNum, const FtVariantEntry& variant,
+							 TextSearchResults& res);
 
 	void processTypos(FtSelectContext&, FtDSLEntry&);
+	void calcDocsCount(TextSearchResults& res);
 
 	DataHolder& holder_;
 	size_t fieldSize_;
 	bool needArea_;
+	// Count of the best documents, which are requested. 0 - all the found documents are requested
+	size_t topK_;
+	// Found words of terms, which were searched by the previous selects. Can be nullptr
+	FtTermsCache* termsCache_;
 };
 
 }  // namespace reindexer
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/lrucache.h"
+#include "selecter.h"
+
+namespace reindexer {
+
+const size_t kFtTermsCacheSizeLimit = 1024 * 1024 * 32;
+
+// Found words of term depend only on pattern and options of lookup: boosts, fields and distances are applied by merge
+struct FtTermsCacheKey {
+	FtTermsCacheKey(const FtDSLEntry &term)
+		: pattern(term.pattern),
+		  suff(term.opts.suff),
+		  pref(term.opts.pref),
+		  typos(term.opts.typos),
+		  exact(term.opts.exact),
+		  number(term.opts.number),
+		  opAnd(term.opts.op == OpAnd) {}
+	size_t Size() const { return sizeof(FtTermsCacheKey) + pattern.capacity() * sizeof(wchar_t); }
+	int Flags() const { return suff | (pref << 1) | (typos << 2) | (exact << 3) | (number << 4) | (opAnd << 5); }
+
+	std::wstring pattern;
+	bool suff, pref, typos, exact, number;
+	// Words of variants of 'and' term are not deduplicated
+	bool opAnd;
+};
+
+struct FtTermsCacheVal {
+	FtTermsCacheVal() = default;
+	FtTermsCacheVal(const std::shared_ptr<const Selecter::TextSearchResults> &r) : res(r) {}
+	size_t Size() const { return res ? sizeof(*res) + res->heap_size() : 0; }
+
+	std::shared_ptr<const Selecter::TextSearchResults> res;
+};
+
+struct equal_ft_terms_cache_key {
+	bool operator()(const FtTermsCacheKey &lhs, const FtTermsCacheKey &rhs) const {
+		return lhs.Flags() == rhs.Flags() && lhs.pattern == rhs.pattern;
+	}
+};
+struct hash_ft_terms_cache_key {
+	size_t operator()(const FtTermsCacheKey &k) const { return std::hash<std::wstring>()(k.pattern) ^ (size_t(k.Flags()) << 24); }
+};
+
+// Found words of terms of fast fulltext selects. Results point to data of steps, so cache is cleared, when steps are changed by commit
+class FtTermsCache : public LRUCache<FtTermsCacheKey, FtTermsCacheVal, hash_ft_terms_cache_key, equal_ft_terms_cache_key> {
+public:
+	FtTermsCache() : LRUCache(kFtTermsCacheSizeLimit) {}
+};
+
+}  // namespace reindexer
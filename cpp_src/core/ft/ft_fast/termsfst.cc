@@ -0,0 +1,168 @@
+#include "termsfst.h"
+#include <string.h>
+#include <algorithm>
+#include <numeric>
+
+namespace reindexer {
+
+void TermsFst::add(const char *word, size_t len) {
+	if (path_.empty()) path_.emplace_back();
+	size_t common = 0;
+	while (common < len && common < prev_.size() && prev_[common] == word[common]) ++common;
+	freezePath(common);
+	for (size_t i = common; i < len; ++i) {
+		path_.back().nextLabel = word[i];
+		path_.emplace_back();
+	}
+	path_.back().final = true;
+	prev_.assign(word, len);
+}
+
+void TermsFst::commit() {
+	if (path_.empty()) return;
+	freezePath(0);
+	root_ = freeze(path_[0]);
+	first_.push_back(labels_.size());
+
+	std::vector<PathState>().swap(path_);
+	std::string().swap(prev_);
+	fast_hash_map<std::string, uint32_t>().swap(register_);
+	first_.shrink_to_fit();
+	labels_.shrink_to_fit();
+	targets_.shrink_to_fit();
+	outputs_.shrink_to_fit();
+	counts_.shrink_to_fit();
+	finals_.shrink_to_fit();
+}
+
+// Freezes states of path after prefix of len letters
+void TermsFst::freezePath(size_t len) {
+	while (path_.size() > len + 1) {
+		uint32_t id = freeze(path_.back());
+		path_.pop_back();
+		path_.back().trans.emplace_back(path_.back().nextLabel, id);
+	}
+}
+
+// Returns id of the equal frozen state or adds the new one
+uint32_t TermsFst::freeze(const PathState &state) {
+	std::string key(1, state.final ? '\1' : '\0');
+	key.reserve(1 + state.trans.size() * 5);
+	for (auto &t : state.trans) {
+		key += char(t.first);
+		key.append(reinterpret_cast<const char *>(&t.second), sizeof(t.second));
+	}
+	auto res = register_.emplace(std::move(key), counts_.size());
+	if (!res.second) return res.first->second;
+
+	first_.push_back(labels_.size());
+	uint32_t count = state.final ? 1 : 0;
+	for (auto &t : state.trans) {
+		labels_.push_back(t.first);
+		targets_.push_back(t.second);
+		outputs_.push_back(count);
+		count += counts_[t.second];
+	}
+	counts_.push_back(count);
+	finals_.push_back(state.final);
+	return res.first->second;
+}
+
+int TermsFst::walk(const std::string &prefix, uint32_t &rank) const {
+	if (empty()) return -1;
+	uint32_t state = root_;
+	for (char c : prefix) {
+		auto from = labels_.begin() + first_[state], to = labels_.begin() + first_[state + 1];
+		auto it = std::lower_bound(from, to, uint8_t(c));
+		if (it == to || *it != uint8_t(c)) return -1;
+		size_t t = it - labels_.begin();
+		rank += outputs_[t];
+		state = targets_[t];
+	}
+	return state;
+}
+
+int TermsFst::find(const std::string &word) const {
+	uint32_t rank = 0;
+	int state = walk(word, rank);
+	return (state >= 0 && finals_[state]) ? int(rank) : -1;
+}
+
+std::pair<uint32_t, uint32_t> TermsFst::prefix_range(const std::string &prefix) const {
+	uint32_t rank = 0;
+	int state = walk(prefix, rank);
+	if (state < 0) return {0, 0};
+	return {rank, rank + counts_[state]};
+}
+
+size_t TermsFst::heap_size() const {
+	return (first_.capacity() + targets_.capacity() + outputs_.capacity() + counts_.capacity()) * sizeof(uint32_t) + labels_.capacity() +
+		   finals_.capacity() / 8;
+}
+
+void TermsFst::clear() {
+	first_.clear();
+	labels_.clear();
+	targets_.clear();
+	outputs_.clear();
+	counts_.clear();
+	finals_.clear();
+	root_ = 0;
+	path_.clear();
+	prev_.clear();
+	register_.clear();
+}
+
+void FstTermsDict::build(const suffix_map<std::string, WordIdType> &words) {
+	clear();
+	ids_.resize(words.word_size());
+	std::iota(ids_.begin(), ids_.end(), 0);
+	std::sort(ids_.begin(), ids_.end(),
+			  [&words](uint32_t lhs, uint32_t rhs) { return strcmp(words.word_at(lhs), words.word_at(rhs)) < 0; });
+	for (uint32_t id : ids_) fst_.add(words.word_at(id), words.word_len_at(id));
+	fst_.commit();
+
+	std::vector<std::pair<std::string, uint32_t>> reversed;
+	reversed.reserve(ids_.size());
+	for (uint32_t id : ids_) {
+		const char *word = words.word_at(id);
+		reversed.emplace_back(std::string(word, word + words.word_len_at(id)), id);
+		std::reverse(reversed.back().first.begin(), reversed.back().first.end());
+	}
+	// std::string compares chars as unsigned, as automaton does
+	std::sort(reversed.begin(), reversed.end());
+	reversedIds_.reserve(reversed.size());
+	for (auto &w : reversed) {
+		reversedFst_.add(w.first.data(), w.first.size());
+		reversedIds_.push_back(w.second);
+	}
+	reversedFst_.commit();
+}
+
+int FstTermsDict::find(const std::string &word) const {
+	int rank = fst_.find(word);
+	return rank < 0 ? -1 : int(ids_[rank]);
+}
+
+std::pair<FstTermsDict::iterator, FstTermsDict::iterator> FstTermsDict::with_prefix(const std::string &prefix) const {
+	auto rng = fst_.prefix_range(prefix);
+	return {ids_.begin() + rng.first, ids_.begin() + rng.second};
+}
+
+std::pair<FstTermsDict::iterator, FstTermsDict::iterator> FstTermsDict::with_suffix(const std::string &suffix) const {
+	auto rng = reversedFst_.prefix_range(std::string(suffix.rbegin(), suffix.rend()));
+	return {reversedIds_.begin() + rng.first, reversedIds_.begin() + rng.second};
+}
+
+size_t FstTermsDict::heap_size() const {
+	return fst_.heap_size() + reversedFst_.heap_size() + (ids_.capacity() + reversedIds_.capacity()) * sizeof(uint32_t);
+}
+
+void FstTermsDict::clear() {
+	fst_.clear();
+	reversedFst_.clear();
+	ids_.clear();
+	reversedIds_.clear();
+}
+
+}  // namespace reindexer
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "estl/fast_hash_map.h"
+#include "estl/suffix_map.h"
+#include "indextexttypes.h"
+
+namespace reindexer {
+
+// Minimal acyclic automaton of sorted words. Output of transition is count of words, which are less than words through transition,
+// so sum of outputs on path is rank of word, and words with the same prefix have sequential ranks.
+// The same prefixes and suffixes of words are stored once, transition takes 9 bytes
+class TermsFst {
+public:
+	// Words have to be added in sorted order without duplicates. Words can't be added after commit
+	void add(const char *word, size_t len);
+	void commit();
+
+	// Rank of word or -1, if there is no such word
+	int find(const std::string &word) const;
+	// Ranks [first, second) of words, which start with prefix
+	std::pair<uint32_t, uint32_t> prefix_range(const std::string &prefix) const;
+
+	bool empty() const { return counts_.empty(); }
+	size_t heap_size() const;
+	void clear();
+
+protected:
+	// State, which can still get transitions. The last transition leads to the next state of path
+	struct PathState {
+		bool final = false;
+		std::vector<std::pair<uint8_t, uint32_t>> trans;
+		uint8_t nextLabel = 0;
+	};
+
+	// State after prefix or -1. Adds outputs of transitions to rank
+	int walk(const std::string &prefix, uint32_t &rank) const;
+	void freezePath(size_t len);
+	uint32_t freeze(const PathState &state);
+
+	// Transitions of state s are [first_[s], first_[s + 1]), sorted by label
+	std::vector<uint32_t> first_;
+	std::vector<uint8_t> labels_;
+	std::vector<uint32_t> targets_;
+	std::vector<uint32_t> outputs_;
+	// Count of words, which are accepted from state
+	std::vector<uint32_t> counts_;
+	std::vector<bool> finals_;
+	uint32_t root_ = 0;
+
+	// Temp data for build
+	std::vector<PathState> path_;
+	std::string prev_;
+	fast_hash_map<std::string, uint32_t> register_;
+};
+
+// Dictionary of words of step. Finds words by exact match, by prefix and by suffix with automaton of reversed words.
+// Words are stored in suffix_map, which is built without suffix array
+class FstTermsDict {
+public:
+	typedef std::vector<uint32_t>::const_iterator iterator;
+
+	void build(const suffix_map<std::string, WordIdType> &words);
+
+	// Id of word in step or -1
+	int find(const std::string &word) const;
+	// Ids of words, which start with prefix
+	std::pair<iterator, iterator> with_prefix(const std::string &prefix) const;
+	// Ids of words, which end with suffix
+	std::pair<iterator, iterator> with_suffix(const std::string &suffix) const;
+
+	bool empty() const { return ids_.empty(); }
+	size_t heap_size() const;
+	void clear();
+
+protected:
+	TermsFst fst_, reversedFst_;
+	// Ids of words by their ranks in fst_ and reversedFst_
+	std::vector<uint32_t> ids_, reversedIds_;
+};
+
+}  // namespace reindexer
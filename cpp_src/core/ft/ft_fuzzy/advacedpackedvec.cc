@@ -1,14 +1,85 @@
 #include "advacedpackedvec.h"
-#include "core/ft/idrelset.h"
+#include <algorithm>
+#include "tools/varint.h"
 namespace reindexer {
 
-AdvacedPackedVec::AdvacedPackedVec(IdRelSet&& data) {
-	data.SimpleCommit();
+// Position is rotated, so field takes the low byte, and small positions in small fields are packed to small values
+static uint32_t rotatePos(uint32_t fpos) { return (fpos << 8) | (fpos >> IdRelType::PosType::posBits); }
+static uint32_t unrotatePos(uint32_t v) { return (v >> 8) | (v << IdRelType::PosType::posBits); }
 
-	insert(end(), data.begin(), data.end());
+static uint32_t unpackVarint(const uint8_t *&p, const uint8_t *end) {
+	unsigned l = scan_varint(end - p, p);
+	assert(l != 0);
+	uint32_t v = parse_uint32(l, p);
+	p += l;
+	return v;
+}
+
+void AdvacedPackedVec::iterator::unpack() {
+	if (p_ == end_) return;
+	auto p = p_;
+	cur_.id += unpackVarint(p, end_);
+	cur_.pos.resize(unpackVarint(p, end_));
+	uint32_t last = 0;
+	for (auto &pos : cur_.pos) {
+		last += unpackVarint(p, end_);
+		pos.fpos = unrotatePos(last);
+	}
+	next_ = p;
+}
+
+void AdvacedPackedVec::Add(VDocIdType id, int pos, int field) {
+	if (lastPos_.size() && lastId_ != id) packLast();
+	if (int(id) > max_id_) max_id_ = id;
+	if (int(id) < min_id_) min_id_ = id;
+	lastId_ = id;
+	lastPos_.push_back({pos, field});
+}
+
+void AdvacedPackedVec::Append(AdvacedPackedVec &&other) {
+	if (lastPos_.size()) packLast();
+	if (other.lastPos_.size()) other.packLast();
+	const auto &otherData = other.data_;
+	if (otherData.size()) {
+		// Id of the first document of other vector is packed as delta from 0
+		const uint8_t *p = otherData.begin();
+		VDocIdType firstId = unpackVarint(p, otherData.end());
+		assert(firstId >= packedId_);
+		data_.grow(data_.size() + 5 + (otherData.end() - p));
+		data_.resize(data_.size() + uint32_pack(firstId - packedId_, data_.end()));
+		data_.insert(data_.end(), p, otherData.end());
+		packedId_ = other.packedId_;
+	}
+	size_ += other.size_;
+	max_id_ = std::max(max_id_, other.max_id_);
+	min_id_ = std::min(min_id_, other.min_id_);
+	other = AdvacedPackedVec();
+}
+
+void AdvacedPackedVec::Commit() {
+	if (lastPos_.size()) packLast();
+	lastPos_ = h_vector<IdRelType::PosType, 3>();
+	data_.shrink_to_fit();
+}
 
-	max_id_ = data.max_id_;
-	min_id_ = data.min_id_;
-	data.clear();
+void AdvacedPackedVec::packLast() {
+	for (auto &pos : lastPos_) pos.fpos = rotatePos(pos.fpos);
+	if (lastPos_.size() > 1) {
+		std::sort(lastPos_.begin(), lastPos_.end(), [](IdRelType::PosType lhs, IdRelType::PosType rhs) { return lhs.fpos < rhs.fpos; });
+	}
+	// Data grows exponentially, as documents are packed one by one
+	data_.grow(data_.size() + (lastPos_.size() + 2) * 5);
+	uint8_t *p = data_.end();
+	p += uint32_pack(lastId_ - packedId_, p);
+	p += uint32_pack(lastPos_.size(), p);
+	uint32_t last = 0;
+	for (auto pos : lastPos_) {
+		p += uint32_pack(pos.fpos - last, p);
+		last = pos.fpos;
+	}
+	data_.resize(p - data_.begin());
+	packedId_ = lastId_;
+	size_++;
+	lastPos_.clear();
 }
 }  // namespace reindexer
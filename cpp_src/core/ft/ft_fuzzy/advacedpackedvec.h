@@ -1,15 +1,56 @@
 #pragma once
 #include <limits.h>
-#include "estl/packed_vector.h"
+#include "core/ft/idrelset.h"
+#include "estl/h_vector.h"
 namespace reindexer {
-class IdRelSet;
-struct IdRelType;
 
-class AdvacedPackedVec : public packed_vector<IdRelType> {
+// Packed documents of gram. Documents are added in ascending order of ids, and positions of document are packed,
+// when the next document is added. Document is packed as delta of id, count of positions and deltas of positions,
+// which are rotated to (pos, field), so most of documents take a few bytes
+class AdvacedPackedVec {
 public:
-	AdvacedPackedVec(IdRelSet &&data);
+	class iterator {
+	public:
+		iterator(const uint8_t *p, const uint8_t *end) : p_(p), end_(end) { unpack(); }
+		iterator &operator++() {
+			p_ = next_;
+			unpack();
+			return *this;
+		}
+		const IdRelType *operator->() const { return &cur_; }
+		const IdRelType &operator*() const { return cur_; }
+		bool operator!=(const iterator &rhs) const { return p_ != rhs.p_; }
+		bool operator==(const iterator &rhs) const { return p_ == rhs.p_; }
 
-	int max_id_;
-	int min_id_;
+	protected:
+		void unpack();
+
+		const uint8_t *p_, *next_, *end_;
+		IdRelType cur_;
+	};
+
+	iterator begin() const { return iterator(data_.begin(), data_.end()); }
+	iterator end() const { return iterator(data_.end(), data_.end()); }
+	size_t size() const { return size_; }
+	size_t heap_size() const { return data_.capacity() + lastPos_.heap_size(); }
+
+	void Add(VDocIdType id, int pos, int field);
+	// Appends documents of other vector, ids of which are greater than ids of this one
+	void Append(AdvacedPackedVec &&other);
+	// Packs the last document and frees unused memory
+	void Commit();
+
+	int max_id_ = 0;
+	int min_id_ = INT_MAX;
+
+protected:
+	void packLast();
+
+	h_vector<uint8_t, 0> data_;
+	unsigned size_ = 0;
+	// Id of the last packed document, id of the next one is packed as delta
+	VDocIdType packedId_ = 0;
+	VDocIdType lastId_ = 0;
+	h_vector<IdRelType::PosType, 3> lastPos_;
 };
 }  // namespace reindexer
@@ -1,46 +1,79 @@
 #include "basebuildedholder.h"
+#include "tools/workerpool.h"
 
 namespace search_engine {
 using std::move;
 
-DIt BaseHolder::GetData(const wchar_t *key) {
+data_key BaseHolder::makeKey(const wchar_t *key) const {
 #ifndef DEBUG_FT
-	return data_.find(wstring(key, cfg_.bufferSize));
+	return wstring(key, cfg_.bufferSize);
 #else
-	return data_.find(reindexer::HashTreGram(key));
+	return reindexer::HashTreGram(key);
 #endif
 }
-void BaseHolder::SetSize(uint32_t size, VDocIdType id, int field) { words_[id][field] += size; }
-void BaseHolder::AddDada(const wchar_t *key, VDocIdType id, int pos, int field) {
-#ifndef DEBUG_FT
-	wstring wkey(key, cfg_.bufferSize);
-	auto it = tmp_data_.find(wkey);
-	if (it == tmp_data_.end()) {
-		auto res = tmp_data_.emplace(wkey, IdRelSet());
-		it = res.first;
-	}
 
-	it->second.Add(id, pos, field);
+const AdvacedPackedVec *BaseHolder::GetData(const wchar_t *key) {
+	if (data_.empty()) return nullptr;
+	data_key wkey = makeKey(key);
+	size_t hash = DataStructHash()(wkey);
+	auto &data = data_[partition(hash)];
+	auto it = data.find(wkey, hash);
+	return it == data.end() ? nullptr : &it->second;
+}
+
+void BaseHolder::StartCommit(size_t ranges, VDocIdType maxId) {
+	Clear();
+	words_.resize(maxId + 1);
+	data_.resize(ranges);
+	tmp_data_.resize(ranges, vector<data_map<AdvacedPackedVec>>(ranges));
+}
 
-#else
-	uint32_t current_hash = reindexer::HashTreGram(key);
-	auto it = tmp_data_.find(current_hash);
-	if (it == tmp_data_.end()) {
-		auto res = tmp_data_.emplace(current_hash, IdRelSet());
+void BaseHolder::SetSize(uint32_t size, VDocIdType id, int field) {
+	auto &sizes = words_[id];
+	if (sizes.size() <= unsigned(field)) sizes.resize(field + 1);
+	sizes[field] += size;
+}
+
+void BaseHolder::AddDada(const wchar_t *key, VDocIdType id, int pos, int field, size_t range) {
+	data_key wkey = makeKey(key);
+	size_t hash = DataStructHash()(wkey);
+	auto &data = tmp_data_[range][partition(hash)];
+	auto it = data.find(wkey, hash);
+	if (it == data.end()) {
+		auto res = data.emplace(move(wkey), AdvacedPackedVec());
 		it = res.first;
 	}
-	it->second.Add(id, pos, field);
-#endif
+	it.value().Add(id, pos, field);
 }
 
 void BaseHolder::Commit() {
-	data_.reserve(tmp_data_.size());
-	data_.clear();
-	for (auto &val : tmp_data_) {
-		data_.insert(std::make_pair(val.first, AdvacedPackedVec(move(val.second))));
-	}
-
+	WorkerPool::Instance().Run(data_.size(), data_.size(), [this](size_t part) {
+		auto &data = data_[part];
+		// Ranges are merged in ascending order of ids of their documents
+		for (auto &rangeData : tmp_data_) {
+			for (auto val = rangeData[part].begin(); val != rangeData[part].end(); ++val) {
+				auto it = data.find(val->first);
+				if (it == data.end()) {
+					data.emplace(val->first, move(val.value()));
+				} else {
+					it.value().Append(move(val.value()));
+				}
+			}
+			data_map<AdvacedPackedVec>().swap(rangeData[part]);
+		}
+		for (auto it = data.begin(); it != data.end(); ++it) it.value().Commit();
+	});
 	ClearTemp();
 }
 
+size_t BaseHolder::GetMemStat() {
+	size_t res = words_.capacity() * sizeof(word_size_map::value_type);
+	for (auto &w : words_) res += w.heap_size();
+	for (auto &data : data_) {
+		res += data.bucket_count() * sizeof(data_map<AdvacedPackedVec>::value_type);
+		for (auto &val : data) res += val.second.heap_size();
+	}
+	return res;
+}
+
 }  // namespace search_engine
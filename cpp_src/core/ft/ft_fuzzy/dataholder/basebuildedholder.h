@@ -35,6 +35,7 @@ struct DataStructEQ {
 template <typename T1>
 using data_map = fast_hash_map<wstring, T1, DataStructHash, DataStructEQ>;
 typedef fast_hash_set<wstring, DataStructHash, DataStructEQ> data_set;
+typedef wstring data_key;
 
 #else
 struct DataStructHash {
@@ -44,9 +45,10 @@ struct DataStructHash {
 template <typename T1>
 using data_map = fast_hash_map<uint32_t, T1, DataStructHash>;
 typedef fast_hash_set<uint32_t, DataStructHash> data_set;
+typedef uint32_t data_key;
 #endif
-typedef data_map<AdvacedPackedVec>::iterator DIt;
-typedef fast_hash_map<int, fast_hash_map<int, uint32_t>> word_size_map;
+// Count of grams in fields of documents, indexed by vdoc id
+typedef vector<h_vector<uint32_t, 2>> word_size_map;
 
 class BaseHolder {
 public:
@@ -59,26 +61,39 @@ public:
 	BaseHolder &operator=(BaseHolder &&) noexcept = delete;
 
 	void ClearTemp() {
-		data_map<IdRelSet> tmp_data;
+		vector<vector<data_map<AdvacedPackedVec>>> tmp_data;
 		tmp_data_.swap(tmp_data);
 	}
-	DIt end() { return data_.end(); }
 
 	void Clear() {
 		ClearTemp();
 		data_.clear();
+		words_.clear();
 	}
 	void SetConfig(const unique_ptr<FtFuzzyConfig> &cfg) { cfg_ = *cfg.get(); }
-	DIt GetData(const wchar_t *key);
+	// Returns documents of gram, or nullptr if gram is not found
+	const AdvacedPackedVec *GetData(const wchar_t *key);
+	// Prepares build of documents with ids up to maxId. Ranges of documents are built in parallel, and grams are
+	// partitioned by hash, so partitions of grams of all the ranges are merged in parallel too
+	void StartCommit(size_t ranges, VDocIdType maxId);
 	void SetSize(uint32_t size, VDocIdType id, int filed);
-	void AddDada(const wchar_t *key, VDocIdType id, int pos, int field);
+	// Adds gram of document from range. Documents of range are added in ascending order of ids
+	void AddDada(const wchar_t *key, VDocIdType id, int pos, int field, size_t range);
 	void Commit();
+	size_t GetMemStat();
 
 public:
-	data_map<IdRelSet> tmp_data_;
-	data_map<AdvacedPackedVec> data_;
+	// Documents of grams of ranges of documents: [range][partition]
+	vector<vector<data_map<AdvacedPackedVec>>> tmp_data_;
+	// Documents of grams: [partition]
+	vector<data_map<AdvacedPackedVec>> data_;
 	word_size_map words_;
 	FtFuzzyConfig cfg_;
+
+protected:
+	data_key makeKey(const wchar_t *key) const;
+	// Hash maps of partitions use low bits of hash, so partition is selected by high bits
+	size_t partition(size_t hash) const { return (hash >> 20) % data_.size(); }
 };
 
 }  // namespace search_engine
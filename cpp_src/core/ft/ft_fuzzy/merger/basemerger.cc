@@ -19,9 +19,9 @@ void MergedData::Add(const IDCtx& ctx) {
 	double max_dst_dist = ctx.cfg.maxDstProc;
 	for (size_t i = 0; i < ctx.data->size(); ++i) {
 		size_t size = 1;
-		auto it = size_it_->second.find(ctx.data->at(i).field());
-		if (it != size_it_->second.end()) {
-			size = it->second;
+		unsigned field = ctx.data->at(i).field();
+		if (field < sizes_->size() && (*sizes_)[field]) {
+			size = (*sizes_)[field];
 		}
 		double src_dst = abs(ctx.data->at(i).pos() - ctx.pos);
 		if (src_dst > ctx.total_size) {
@@ -32,10 +32,10 @@ struct ResultMerger {
 class MergedData {
 public:
 	MergedData(size_t id, const IDCtx &ctx) : id_(id) {
-		size_it_ = ctx.sizes->find(id_);
-		if (size_it_ == ctx.sizes->end()) {
+		if (id_ >= ctx.sizes->size()) {
 			abort();
 		}
+		sizes_ = &(*ctx.sizes)[id_];
 		Add(ctx);
 	}
 
@@ -47,7 +47,7 @@ public:
 private:
 	bool first_ = true;
 	ResultMerger prev_;
-	word_size_map::iterator size_it_;
+	const word_size_map::value_type *sizes_;
 };
 struct SearchResult {
 	std::shared_ptr<std::vector<MergedData>> data_;
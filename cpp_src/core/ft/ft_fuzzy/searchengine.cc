@@ -16,22 +16,19 @@ SearchEngine::SearchEngine() {
 	seacher_.AddSeacher(ISeacher::Ptr(new KbLayout));
 	last_max_id_ = 0;
 	holder_ = make_shared<BaseHolder>();
-	commited_ = false;
 }
 void SearchEngine::SetConfig(const unique_ptr<FtFuzzyConfig>& cfg) { holder_->SetConfig(cfg); }
 
 void SearchEngine::Rebuild() { holder_.reset(new BaseHolder); }
 void SearchEngine::AddData(const reindexer::string_view& src_data, const IdType id, int field, const string& extraWordSymbols) {
-	if (commited_) {
-		commited_ = false;
-		holder_->Clear();
-	}
-	seacher_.AddIndex(holder_, src_data, id, field, extraWordSymbols);
+	docs_.push_back({src_data, id, field});
+	extraWordSymbols_ = extraWordSymbols;
 }
-void SearchEngine::Commit() {
-	commited_ = true;
-	seacher_.Commit(holder_);
+void SearchEngine::Commit(size_t threads) {
+	seacher_.Build(holder_, docs_, extraWordSymbols_, threads);
+	vector<DocField>().swap(docs_);
 }
+size_t SearchEngine::GetMemStat() { return holder_->GetMemStat(); }
 
 SearchResult SearchEngine::Search(const FtDSLQuery& dsl) { return seacher_.Compare(holder_, dsl); }
 
@@ -8,10 +8,6 @@
 #include "dataholder/basebuildedholder.h"
 #include "searchers/base_searcher/baseseacher.h"
 
-namespace reindexer {
-class string_view;
-}
-
 namespace search_engine {
 
 using std::shared_ptr;
@@ -30,13 +26,17 @@ public:
 
 	SearchResult Search(const FtDSLQuery &dsl);
 	void Rebuild();
+	// Adds field of document to the next build. Data must be valid until Commit
 	void AddData(const reindexer::string_view &src_data, const IdType id, int field, const string &extraWordSymbols);
-	void Commit();
+	// Rebuilds data of all the added documents with not more than threads threads
+	void Commit(size_t threads);
+	size_t GetMemStat();
 
 private:
 	BaseHolder::Ptr holder_;
 	BaseSearcher seacher_;
 	size_t last_max_id_;
-	bool commited_;
+	vector<DocField> docs_;
+	string extraWordSymbols_;
 };
 }  // namespace search_engine
@@ -8,6 +8,7 @@
 #include "core/ft/ftdsl.h"
 #include "tools/customhash.h"
 #include "tools/stringstools.h"
+#include "tools/workerpool.h"
 namespace search_engine {
 
 using std::make_shared;
@@ -17,7 +18,8 @@ using namespace reindexer;
 
 void BaseSearcher::AddSeacher(ISeacher::Ptr seacher) { searchers_.push_back(seacher); }
 
-pair<bool, size_t> BaseSearcher::GetData(BaseHolder::Ptr holder, unsigned int i, wchar_t *buf, const wchar_t *src_data, size_t data_size) {
+pair<bool, size_t> BaseSearcher::GetData(const BaseHolder::Ptr &holder, unsigned int i, wchar_t *buf, const wchar_t *src_data,
+										 size_t data_size) {
 	size_t counter = 0;
 	size_t final_counter = 0;
 
@@ -48,8 +50,8 @@ pair<bool, size_t> BaseSearcher::GetData(BaseHolder::Ptr holder, unsigned int i,
 	return make_pair(cont, counter + final_counter);
 }
 
-size_t BaseSearcher::ParseData(BaseHolder::Ptr holder, const wstring &src_data, int &max_id, int &min_id, std::vector<FirstResult> &rusults,
-							   const FtDslOpts &opts, double proc) {
+size_t BaseSearcher::ParseData(const BaseHolder::Ptr &holder, const wstring &src_data, int &max_id, int &min_id,
+							   std::vector<FirstResult> &rusults, const FtDslOpts &opts, double proc) {
 	wchar_t res_buf[maxFuzzyFTBufferSize];
 	size_t total_size = 0;
 	size_t size = src_data.size();
@@ -58,14 +60,14 @@ size_t BaseSearcher::ParseData(BaseHolder::Ptr holder, const wstring &src_data,
 	do {
 		cont = GetData(holder, i, res_buf, src_data.c_str(), size);
 		total_size++;
-		auto it = holder->GetData(res_buf);
+		auto data = holder->GetData(res_buf);
 
-		if (it != holder->end()) {
-			if (it->second.max_id_ > max_id) max_id = it->second.max_id_;
-			if (it->second.min_id_ < min_id) min_id = it->second.min_id_;
+		if (data) {
+			if (data->max_id_ > max_id) max_id = data->max_id_;
+			if (data->min_id_ < min_id) min_id = data->min_id_;
 			double final_proc = double(holder->cfg_.bufferSize * holder->cfg_.startDecreeseBoost - cont.second) /
 								double(holder->cfg_.bufferSize * holder->cfg_.startDecreeseBoost);
-			rusults.push_back(FirstResult{&it->second, &opts, static_cast<int>(i), proc * final_proc});
+			rusults.push_back(FirstResult{data, &opts, static_cast<int>(i), proc * final_proc});
 		}
 		i++;
 	} while (cont.first);
@@ -122,8 +124,8 @@ SearchResult BaseSearcher::Compare(BaseHolder::Ptr holder, const FtDSLQuery &dsl
 	return res;
 }
 
-void BaseSearcher::AddIndex(BaseHolder::Ptr holder, const reindexer::string_view &src_data, const IdType id, int field,
-							const string &extraWordSymbols) {
+void BaseSearcher::AddIndex(const BaseHolder::Ptr &holder, const reindexer::string_view &src_data, const IdType id, int field,
+							const string &extraWordSymbols, size_t range) {
 #ifdef FULL_LOG_FT
 	words.push_back(std::make_pair(id, *src_data));
 #endif
@@ -142,7 +144,7 @@ void BaseSearcher::AddIndex(BaseHolder::Ptr holder, const reindexer::string_view
 		pair<bool, size_t> cont;
 		do {
 			cont = GetData(holder, i, res_buf, term.c_str(), term.size());
-			holder->AddDada(res_buf, id, i, field);
+			holder->AddDada(res_buf, id, i, field, range);
 			i++;
 			total_size++;
 
@@ -151,5 +153,25 @@ void BaseSearcher::AddIndex(BaseHolder::Ptr holder, const reindexer::string_view
 	holder->SetSize(total_size, id, field);
 }
 
-void BaseSearcher::Commit(BaseHolder::Ptr holder) { holder->Commit(); }
+void BaseSearcher::Build(BaseHolder::Ptr holder, const vector<DocField> &docs, const string &extraWordSymbols, size_t threads) {
+	size_t ranges = std::max<size_t>(std::min(threads, docs.size() / kMinDocsPerRange), 1);
+	// Fields of document are in the same range, so documents of range are added to grams in ascending order of ids
+	vector<size_t> bounds(1, 0);
+	for (size_t r = 1; r < ranges; ++r) {
+		size_t bound = std::max(docs.size() * r / ranges, bounds.back());
+		while (bound < docs.size() && bound > 0 && docs[bound].id == docs[bound - 1].id) ++bound;
+		bounds.push_back(bound);
+	}
+	bounds.push_back(docs.size());
+
+	VDocIdType maxId = 0;
+	for (auto &doc : docs) maxId = std::max<VDocIdType>(maxId, doc.id);
+	holder->StartCommit(ranges, maxId);
+	WorkerPool::Instance().Run(ranges, ranges, [&](size_t range) {
+		for (size_t i = bounds[range]; i < bounds[range + 1]; ++i) {
+			AddIndex(holder, docs[i].data, docs[i].id, docs[i].field, extraWordSymbols, range);
+		}
+	});
+	holder->Commit();
+}
 }  // namespace search_engine
@@ -4,36 +4,45 @@
 #include "core/ft/ft_fuzzy/merger/basemerger.h"
 #include "core/ft/ft_fuzzy/searchers/isearcher.h"
 #include "core/ft/ftdsl.h"
+#include "estl/string_view.h"
 
 #include <string>
 #include <vector>
 
-namespace reindexer {
-class string_view;
-}
-
 namespace search_engine {
 using std::vector;
 using std::wstring;
 using std::pair;
 
+// Text of field of document
+struct DocField {
+	reindexer::string_view data;
+	IdType id;
+	int field;
+};
+
 class BaseSearcher {
 public:
 	void AddSeacher(ISeacher::Ptr seacher);
-	void AddIndex(BaseHolder::Ptr holder, const reindexer::string_view &src_data, const IdType id, int field,
-				  const string &extraWordSymbols);
 	SearchResult Compare(BaseHolder::Ptr holder, const reindexer::FtDSLQuery &dsl);
 
-	void Commit(BaseHolder::Ptr holder);
+	// Builds data of documents with not more than threads threads. Documents are sorted by ids
+	void Build(BaseHolder::Ptr holder, const vector<DocField> &docs, const string &extraWordSymbols, size_t threads);
 
 private:
+	// Minimal count of fields of documents, which are built by separate thread
+	static const size_t kMinDocsPerRange = 1000;
+
+	void AddIndex(const BaseHolder::Ptr &holder, const reindexer::string_view &src_data, const IdType id, int field,
+				  const string &extraWordSymbols, size_t range);
+
 #ifdef FULL_LOG_FT
 	std::vector<std::pair<size_t, std::string>> words;
 #endif
 
-	pair<bool, size_t> GetData(BaseHolder::Ptr holder, unsigned int i, wchar_t *buf, const wchar_t *src_data, size_t data_size);
+	pair<bool, size_t> GetData(const BaseHolder::Ptr &holder, unsigned int i, wchar_t *buf, const wchar_t *src_data, size_t data_size);
 
-	size_t ParseData(BaseHolder::Ptr holder, const wstring &src_data, int &max_id, int &min_id, std::vector<FirstResult> &rusults,
+	size_t ParseData(const BaseHolder::Ptr &holder, const wstring &src_data, int &max_id, int &min_id, std::vector<FirstResult> &rusults,
 					 const FtDslOpts &opts, double proc);
 
 	void AddIdToInfo(Info *info, const IdType id, pair<PosType, ProcType> pos, uint32_t total_size);
@@ -21,9 +21,24 @@ void FtDSLQuery::parse(const string &q) {
 	utf8_to_utf16(q, utf16str);
 	parse(utf16str);
 }
+// Proximity operator 'NEAR/N' between terms. Returns distance N, or 0, if there is no operator at it
+static int parseNear(wstring &utf16str, wstring::iterator &it) {
+	static const wstring kNear = L"NEAR/";
+	if (size_t(utf16str.end() - it) <= kNear.size() || !std::equal(kNear.begin(), kNear.end(), it) || !IsDigit(it[kNear.size()])) return 0;
+	wchar_t *end = nullptr, *start = &*(it + kNear.size());
+	int distance = wcstol(start, &end, 10);
+	it += kNear.size() + (end - start);
+	if (distance < 1) throw Error(errParseDSL, "Distance of 'NEAR' operator in search query DSL has to be positive");
+	return distance;
+}
+
 void FtDSLQuery::parse(wstring &utf16str) {
 	int groupcnt = 0;
 	bool ingroup = false;
+	// Counts of stop words, which are skipped before terms of phrase
+	h_vector<int, 8> groupGaps;
+	int stopWordsGap = 0;
+	int nearDistance = 0;
 	int maxPatternLen = 1;
 	h_vector<float, 8> fieldsBoost;
 	fieldsBoost.insert(fieldsBoost.end(), std::max(int(fields_.size()), 1), 1.0);
@@ -37,6 +52,12 @@ void FtDSLQuery::parse(wstring &utf16str) {
 			continue;
 		}
 
+		if (int distance = parseNear(utf16str, it)) {
+			if (empty() || ingroup) throw Error(errParseDSL, "'NEAR' operator has to be between terms in search query DSL");
+			nearDistance = distance;
+			continue;
+		}
+
 		FtDSLEntry fte;
 		fte.opts.fieldsBoost = fieldsBoost;
 
@@ -53,22 +74,26 @@ void FtDSLQuery::parse(wstring &utf16str) {
 			// closing group
 			if (!ingroup) {
 				int distance = 1;
+				// Words of exact phrase follow each other, words of phrase with distance are found in any order
+				bool ordered = true;
 				if (it != utf16str.end() && *it == '~') {
 					wchar_t *end = nullptr, *start = &*++it;
 					distance = wcstod(start, &end);
 					it += end - start;
 					if (end == start)
 						throw Error(errParseDSL, "Expected digit after '~' operator in phrase, but found '%c' ", char(*start));
+					ordered = false;
 				}
 				assertf(groupcnt <= int(size()), "groupcnt=%d,size=%d", groupcnt, int(size()));
-				if (groupcnt > 1) {
-					auto fteIt = end();
-					while (--groupcnt) {
-						fteIt--;
-						fteIt->opts.distance = distance;
-						fteIt->opts.op = OpAnd;
-					}
+				for (int i = 1; i < groupcnt; ++i) {
+					auto &opts = (*this)[size() - groupcnt + i].opts;
+					opts.distance = distance + groupGaps[i];
+					opts.ordered = ordered;
+					opts.op = OpAnd;
 				}
+				groupcnt = 0;
+				groupGaps.clear();
+				stopWordsGap = 0;
 			}
 		}
 		if (it != utf16str.end() && *it == '=') {
@@ -107,19 +132,33 @@ void FtDSLQuery::parse(wstring &utf16str) {
 			string utf8str = utf16_to_utf8(fte.pattern);
 			if (is_number(utf8str)) fte.opts.number = true;
 			if (stopWords_.find(utf8str) != stopWords_.end()) {
+				// Stop words are not indexed, but they take positions in document
+				if (ingroup && groupcnt) stopWordsGap++;
 				continue;
 			}
 
 			if (int(fte.pattern.length()) > maxPatternLen) {
 				maxPatternLen = fte.pattern.length();
 			}
+			if (nearDistance) {
+				fte.opts.distance = nearDistance;
+				fte.opts.op = OpAnd;
+				nearDistance = 0;
+			}
 			push_back(fte);
-			if (ingroup) groupcnt++;
+			if (ingroup) {
+				groupcnt++;
+				groupGaps.push_back(stopWordsGap);
+				stopWordsGap = 0;
+			}
 		}
 	}
 	if (ingroup) {
 		throw Error(errParseDSL, "No closing quote in full text search query DSL");
 	}
+	if (nearDistance) {
+		throw Error(errParseDSL, "'NEAR' operator has to be between terms in search query DSL");
+	}
 
 	int cnt = 0;
 	for (auto &e : *this) {
@@ -24,7 +24,10 @@ struct FtDslOpts {
 	OpType op = OpOr;
 	float boost = 1.0;
 	float termLenBoost = 1.0;
+	// Maximum distance to positions of the previous term of query in document. Term without distance isn't bound to previous term
 	int distance = INT_MAX;
+	// Term has to follow the previous term in document
+	bool ordered = false;
 	h_vector<float, 8> fieldsBoost;
 	int qpos = 0;
 };
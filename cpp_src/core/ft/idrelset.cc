@@ -1,6 +1,7 @@
 
 #include "idrelset.h"
 #include <algorithm>
+#include <iterator>
 #include "estl/h_vector.h"
 #include "tools/varint.h"
 
@@ -56,7 +57,29 @@ int IdRelType::distance(const IdRelType& other, int max) const {
 	}
 	return max;
 }
-int IdRelType::wordsInField(int field) {
+bool IdRelType::filterNear(const IdRelType& other, int maxDistance, bool ordered) {
+	size_t found = 0;
+	auto j = other.pos.begin();
+	for (auto p : pos) {
+		// Positions contain field, so positions of different fields are far from each other
+		while (j != other.pos.end() && j->fpos + maxDistance < p.fpos) j++;
+		if (j == other.pos.end()) break;
+		if (ordered ? j->fpos < p.fpos : j->fpos <= p.fpos + maxDistance) pos[found++] = p;
+	}
+	pos.resize(found);
+	return found != 0;
+}
+
+void IdRelType::mergePositions(const IdRelType& other) {
+	h_vector<PosType, 3> merged;
+	merged.reserve(pos.size() + other.pos.size());
+	auto less = [](PosType lhs, PosType rhs) { return lhs.fpos < rhs.fpos; };
+	std::merge(pos.begin(), pos.end(), other.pos.begin(), other.pos.end(), std::back_inserter(merged), less);
+	merged.erase(std::unique(merged.begin(), merged.end(), [](PosType lhs, PosType rhs) { return lhs.fpos == rhs.fpos; }), merged.end());
+	pos = std::move(merged);
+}
+
+int IdRelType::wordsInField(int field) const {
 	unsigned i = 0;
 	int wcount = 0;
 	// TODO: optiminize here, binary search or precalculate
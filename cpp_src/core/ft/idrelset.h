@@ -3,7 +3,6 @@
 #include <limits.h>
 #include <algorithm>
 #include "estl/h_vector.h"
-#include "estl/packed_vector.h"
 namespace reindexer {
 
 typedef uint32_t VDocIdType;
@@ -26,8 +25,13 @@ struct IdRelType {
 	int rank() const { return !pos.size() ? 0 : pos2rank(pos.front().pos()) + std::max(10, int(pos.size())); }
 
 	int distance(const IdRelType& other, int max) const;
+	// Leaves only positions, which are not farther than maxDistance from positions of other word, or follow them, if ordered.
+	// Returns false, if there are no such positions
+	bool filterNear(const IdRelType& other, int maxDistance, bool ordered);
+	// Adds positions of other word
+	void mergePositions(const IdRelType& other);
 
-	int wordsInField(int field);
+	int wordsInField(int field) const;
 	// packed_vector callbacks
 	size_t pack(uint8_t* buf) const;
 	size_t unpack(const uint8_t* buf, unsigned len);
@@ -56,6 +60,4 @@ public:
 	VDocIdType min_id_ = INT_MAX;
 };
 
-using PackedIdRelSet = packed_vector<IdRelType>;
-
 }  // namespace reindexer
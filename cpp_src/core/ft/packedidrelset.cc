@@ -0,0 +1,241 @@
+#include "packedidrelset.h"
+#include <string.h>
+#include <algorithm>
+#include "tools/varint.h"
+
+namespace reindexer {
+
+// Values of block are packed to 4 lanes: value i is stored in lane i % 4, each lane contains bits of it's values sequentially.
+// So 4 values are unpacked by the same instructions, and compiler vectorizes unpack loop with SIMD instructions
+static const unsigned kLanes = 4;
+static const unsigned kLaneValues = PackedIdRelSet::kBlockSize / kLanes;
+
+// Size of packed block of values in bytes
+static size_t packedSize(unsigned bits) { return bits * kLanes * sizeof(uint32_t); }
+
+static unsigned bitsCount(uint32_t v) {
+	unsigned bits = 0;
+	while (v) ++bits, v >>= 1;
+	return bits;
+}
+
+static void packBits(const uint32_t *in, unsigned bits, uint32_t *out) {
+	memset(out, 0, packedSize(bits));
+	if (!bits) return;
+	for (unsigned lane = 0; lane < kLanes; ++lane) {
+		unsigned shift = 0, word = 0;
+		for (unsigned j = 0; j < kLaneValues; ++j) {
+			uint32_t v = in[kLanes * j + lane];
+			out[kLanes * word + lane] |= v << shift;
+			if (shift + bits > 32) out[kLanes * (word + 1) + lane] |= v >> (32 - shift);
+			shift += bits;
+			if (shift >= 32) shift -= 32, ++word;
+		}
+	}
+}
+
+static void unpackBits(const uint32_t *in, unsigned bits, uint32_t *out) {
+	if (!bits) {
+		memset(out, 0, PackedIdRelSet::kBlockSize * sizeof(uint32_t));
+		return;
+	}
+	const uint32_t mask = bits == 32 ? ~0U : (1U << bits) - 1;
+	unsigned shift = 0, word = 0;
+	for (unsigned j = 0; j < kLaneValues; ++j) {
+		for (unsigned lane = 0; lane < kLanes; ++lane) {
+			uint32_t v = in[kLanes * word + lane] >> shift;
+			if (shift + bits > 32) v |= in[kLanes * (word + 1) + lane] << (32 - shift);
+			out[kLanes * j + lane] = v & mask;
+		}
+		shift += bits;
+		if (shift >= 32) shift -= 32, ++word;
+	}
+}
+
+static uint32_t readVarint(const h_vector<uint8_t, 0> &data, uint32_t &offset) {
+	unsigned l = scan_varint(data.size() - offset, data.data() + offset);
+	assert(l != 0);
+	uint32_t v = parse_uint32(l, data.data() + offset);
+	offset += l;
+	return v;
+}
+
+PackedIdRelSet::iterator::iterator(const PackedIdRelSet *set, size_t block) : set_(set), ordinal_(set->size_), block_(block) {
+	if (block <= set->blocks_.size()) loadBlock(block);
+}
+
+void PackedIdRelSet::iterator::loadBlock(size_t block) {
+	auto &blocks = set_->blocks_;
+	block_ = block;
+	idx_ = 0;
+	decoded_ = -1;
+	ordinal_ = block * kBlockSize;
+	VDocIdType base = block ? blocks[block - 1].lastId : 0;
+	if (block < blocks.size()) {
+		const Block &b = blocks[block];
+		uint32_t packed[kBlockSize];
+		count_ = kBlockSize;
+		memcpy(packed, set_->data_.data() + b.offset, packedSize(b.idsBits));
+		unpackBits(packed, b.idsBits, ids_);
+		memcpy(packed, set_->data_.data() + b.offset + packedSize(b.idsBits), packedSize(b.metaBits));
+		unpackBits(packed, b.metaBits, meta_);
+		for (unsigned i = 0; i < kBlockSize; ++i) ids_[i] = base += ids_[i];
+		maxWords_ = 0;
+		for (unsigned i = 0; i < kBlockSize; ++i) maxWords_ = std::max(maxWords_, meta_[i] >> kFieldBits);
+		posOffsets_[0] = b.offset + packedSize(b.idsBits) + packedSize(b.metaBits);
+		posKnown_ = 1;
+		return;
+	}
+	// Incomplete block: ids and fields are stored with positions of each entry
+	count_ = set_->size_ - ordinal_;
+	uint32_t offset = set_->tailOffset_;
+	maxWords_ = 0;
+	for (unsigned i = 0; i < count_; ++i) {
+		ids_[i] = base += readVarint(set_->data_, offset);
+		meta_[i] = readVarint(set_->data_, offset);
+		maxWords_ = std::max(maxWords_, meta_[i] >> kFieldBits);
+		posOffsets_[i] = offset;
+		uint32_t len = readVarint(set_->data_, offset);
+		offset += len;
+	}
+	posKnown_ = count_;
+}
+
+PackedIdRelSet::iterator &PackedIdRelSet::iterator::operator++() {
+	++idx_;
+	++ordinal_;
+	decoded_ = -1;
+	if (idx_ == count_ && ordinal_ < set_->size_) loadBlock(block_ + 1);
+	return *this;
+}
+
+IdRelType &PackedIdRelSet::iterator::Value() {
+	assert(ordinal_ < set_->size_);
+	if (decoded_ == int(idx_)) return cur_;
+	while (posKnown_ <= idx_) {
+		uint32_t offset = posOffsets_[posKnown_ - 1];
+		uint32_t len = readVarint(set_->data_, offset);
+		posOffsets_[posKnown_++] = offset + len;
+	}
+	uint32_t offset = posOffsets_[idx_];
+	readVarint(set_->data_, offset);
+	uint32_t count = readVarint(set_->data_, offset);
+	cur_.id = Id();
+	cur_.pos.resize(count);
+	uint32_t last = 0;
+	for (auto &p : cur_.pos) last = p.fpos = last + readVarint(set_->data_, offset);
+	decoded_ = idx_;
+	return cur_;
+}
+
+bool PackedIdRelSet::iterator::SkipTo(VDocIdType id) {
+	size_t size = set_->size_;
+	if (ordinal_ >= size) return false;
+	if (Id() >= id) return true;
+	auto &blocks = set_->blocks_;
+	if (block_ < blocks.size() && blocks[block_].lastId < id) {
+		auto it = std::lower_bound(blocks.begin() + block_ + 1, blocks.end(), id,
+								   [](const Block &b, VDocIdType id) { return b.lastId < id; });
+		size_t block = it - blocks.begin();
+		if (block * kBlockSize >= size) {
+			ordinal_ = size;
+			return false;
+		}
+		loadBlock(block);
+	}
+	while (ordinal_ < size && Id() < id) ++*this;
+	return ordinal_ < size;
+}
+
+bool PackedIdRelSet::iterator::NextBlock() {
+	if ((block_ + 1) * kBlockSize >= set_->size_) {
+		ordinal_ = set_->size_;
+		return false;
+	}
+	loadBlock(block_ + 1);
+	return true;
+}
+
+uint32_t PackedIdRelSet::meta(const IdRelType &entry) {
+	assert(entry.pos.size());
+	int field = entry.pos[0].field();
+	assert(uint32_t(field) <= kFieldMask);
+	return (uint32_t(entry.wordsInField(field)) << kFieldBits) | field;
+}
+
+void PackedIdRelSet::appendVarint(uint32_t v) {
+	size_t p = data_.size();
+	data_.resize(p + 5);
+	data_.resize(p + uint32_pack(v, data_.data() + p));
+}
+
+void PackedIdRelSet::appendPositions(const IdRelType &entry) {
+	h_vector<uint8_t, 64> buf;
+	buf.resize(entry.maxpackedsize());
+	size_t len = uint32_pack(entry.pos.size(), buf.data());
+	uint32_t last = 0;
+	for (auto p : entry.pos) {
+		len += uint32_pack(p.fpos - last, buf.data() + len);
+		last = p.fpos;
+	}
+	appendVarint(len);
+	data_.insert(data_.end(), buf.begin(), buf.begin() + len);
+}
+
+void PackedIdRelSet::appendBlock(const IdRelType *const *entries, VDocIdType base) {
+	uint32_t ids[kBlockSize], meta[kBlockSize];
+	uint32_t maxId = 0, maxMeta = 0;
+	for (unsigned i = 0; i < kBlockSize; ++i) {
+		assert(entries[i]->id >= base);
+		ids[i] = entries[i]->id - base;
+		base = entries[i]->id;
+		meta[i] = PackedIdRelSet::meta(*entries[i]);
+		maxId |= ids[i];
+		maxMeta |= meta[i];
+	}
+	Block b;
+	b.lastId = base;
+	b.idsBits = bitsCount(maxId);
+	b.metaBits = bitsCount(maxMeta);
+	b.offset = data_.size();
+
+	uint32_t packed[kBlockSize];
+	data_.resize(b.offset + packedSize(b.idsBits) + packedSize(b.metaBits));
+	packBits(ids, b.idsBits, packed);
+	memcpy(data_.data() + b.offset, packed, packedSize(b.idsBits));
+	packBits(meta, b.metaBits, packed);
+	memcpy(data_.data() + b.offset + packedSize(b.idsBits), packed, packedSize(b.metaBits));
+	for (unsigned i = 0; i < kBlockSize; ++i) appendPositions(*entries[i]);
+	blocks_.push_back(b);
+}
+
+void PackedIdRelSet::append(const std::vector<const IdRelType *> &entries) {
+	// Entries of incomplete block are packed again with the new ones
+	std::vector<IdRelType> tail;
+	if (size_ > blocks_.size() * kBlockSize) {
+		for (auto it = iterator(this, blocks_.size()); it != end(); ++it) tail.emplace_back(std::move(*it));
+	}
+	std::vector<const IdRelType *> all;
+	all.reserve(tail.size() + entries.size());
+	for (auto &e : tail) all.push_back(&e);
+	all.insert(all.end(), entries.begin(), entries.end());
+
+	data_.resize(tailOffset_);
+	size_ = blocks_.size() * kBlockSize + all.size();
+	VDocIdType base = blocks_.empty() ? 0 : blocks_.back().lastId;
+	size_t i = 0;
+	for (; all.size() - i >= kBlockSize; i += kBlockSize) {
+		appendBlock(&all[i], base);
+		base = blocks_.back().lastId;
+	}
+	tailOffset_ = data_.size();
+	for (; i < all.size(); ++i) {
+		assert(all[i]->id >= base);
+		appendVarint(all[i]->id - base);
+		appendVarint(meta(*all[i]));
+		appendPositions(*all[i]);
+		base = all[i]->id;
+	}
+}
+
+}  // namespace reindexer
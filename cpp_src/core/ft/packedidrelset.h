@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vector>
+#include "estl/h_vector.h"
+#include "idrelset.h"
+
+namespace reindexer {
+
+// Packed list of documents with positions of word. Entries are sorted by document id.
+// Entries are stored in blocks of kBlockSize entries. Full block contains bit-packed deltas of ids and bit-packed fields
+// with words counts, positions are stored after them. So ids are read without positions, and iterator skips blocks by their last ids.
+// Entries of the last incomplete block are stored as varints: most of words are found in a few documents
+class PackedIdRelSet {
+public:
+	static const unsigned kBlockSize = 128;
+
+	class iterator {
+	public:
+		iterator(const PackedIdRelSet *set, size_t block);
+		iterator(iterator &&) = default;
+
+		iterator &operator++();
+		IdRelType &operator*() { return Value(); }
+		IdRelType *operator->() { return &Value(); }
+		bool operator!=(const iterator &rhs) const { return ordinal_ != rhs.ordinal_; }
+		bool operator==(const iterator &rhs) const { return ordinal_ == rhs.ordinal_; }
+
+		VDocIdType Id() const { return ids_[idx_]; }
+		// Field of the first position of word in document
+		int Field() const { return meta_[idx_] & kFieldMask; }
+		// Count of positions of word in this field
+		int WordsInField() const { return meta_[idx_] >> kFieldBits; }
+		// Entry with positions. Positions are decoded only by this call
+		IdRelType &Value();
+		// Moves to the first entry with id >= id. Returns false, if there is no such entry
+		bool SkipTo(VDocIdType id);
+		// Moves to the first entry of the next block. Returns false, if there is no next block
+		bool NextBlock();
+		bool BlockStart() const { return idx_ == 0; }
+		// Maximum count of positions of word in field of entries of current block
+		int BlockMaxWords() const { return maxWords_; }
+
+	protected:
+		void loadBlock(size_t block);
+
+		const PackedIdRelSet *set_;
+		// Number of current entry in set
+		size_t ordinal_;
+		size_t block_;
+		unsigned idx_ = 0, count_ = 0;
+		uint32_t maxWords_ = 0;
+		// Offsets of positions of entries. Offsets of the first posKnown_ entries are known
+		unsigned posKnown_ = 0;
+		int decoded_ = -1;
+		uint32_t ids_[kBlockSize];
+		uint32_t meta_[kBlockSize];
+		uint32_t posOffsets_[kBlockSize];
+		IdRelType cur_;
+	};
+
+	iterator begin() const { return iterator(this, 0); }
+	iterator end() const { return iterator(this, blocks_.size() + 1); }
+
+	// Appends entries. Entries have to be sorted by id, and their ids have to be greater, than ids in set
+	template <typename InputIterator>
+	void insert(const iterator &pos, InputIterator from, InputIterator to) {
+		assert(pos == end());
+		(void)pos;
+		std::vector<const IdRelType *> entries;
+		entries.reserve(to - from);
+		for (auto it = from; it != to; ++it) entries.push_back(&*it);
+		append(entries);
+	}
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	size_t heap_size() const { return blocks_.capacity() * sizeof(Block) + data_.capacity(); }
+	void shrink_to_fit() {
+		blocks_.shrink_to_fit();
+		data_.shrink_to_fit();
+	}
+	void clear() {
+		blocks_.clear();
+		data_.clear();
+		tailOffset_ = 0;
+		size_ = 0;
+	}
+
+protected:
+	static const int kFieldBits = 8;
+	static const uint32_t kFieldMask = (1 << kFieldBits) - 1;
+
+	struct Block {
+		VDocIdType lastId;
+		uint32_t offset;
+		uint8_t idsBits;
+		uint8_t metaBits;
+	};
+
+	void append(const std::vector<const IdRelType *> &entries);
+	void appendBlock(const IdRelType *const *entries, VDocIdType base);
+	void appendPositions(const IdRelType &entry);
+	void appendVarint(uint32_t v);
+	static uint32_t meta(const IdRelType &entry);
+
+	h_vector<Block, 0> blocks_;
+	// Full blocks, then entries of incomplete block from tailOffset_
+	h_vector<uint8_t, 0> data_;
+	uint32_t tailOffset_ = 0;
+	uint32_t size_ = 0;
+};
+
+}  // namespace reindexer
@@ -0,0 +1,130 @@
+#include "core/geo.h"
+#include <algorithm>
+#include <cmath>
+#include "core/query/querywhere.h"
+#include "tools/errors.h"
+
+namespace reindexer {
+
+static const double kEarthRadius = 6371008.8;
+static const double kDegToRad = M_PI / 180.0;
+static const double kRadToDeg = 180.0 / M_PI;
+
+static bool validCoords(double lat, double lon) { return lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0; }
+
+double GeoDistance(const GeoPoint &a, const GeoPoint &b) {
+	double sinLat = sin((b.lat - a.lat) * kDegToRad / 2);
+	double sinLon = sin((b.lon - a.lon) * kDegToRad / 2);
+	double h = sinLat * sinLat + cos(a.lat * kDegToRad) * cos(b.lat * kDegToRad) * sinLon * sinLon;
+	return 2 * kEarthRadius * asin(std::min(1.0, sqrt(h)));
+}
+
+GeoPoint GetGeoPoint(const ConstPayload &pl, const FieldsSet &fields) {
+	GeoPoint p;
+	if (fields.size() != 2) return p;
+
+	double coords[2];
+	VariantArray v;
+	size_t tagPathIdx = 0;
+	for (int i = 0; i < 2; ++i) {
+		if (fields[i] != IndexValueType::SetByJsonPath) {
+			pl.Get(fields[i], v);
+		} else {
+			v = pl.GetByJsonPath(fields.getTagsPath(tagPathIdx++), v, KeyValueUndefined);
+		}
+		if (v.size() != 1) return p;
+		switch (v[0].Type()) {
+			case KeyValueDouble:
+			case KeyValueInt:
+			case KeyValueInt64:
+				coords[i] = v[0].As<double>();
+				break;
+			default:
+				return p;
+		}
+	}
+	if (!validCoords(coords[0], coords[1])) return p;
+	p.lat = coords[0];
+	p.lon = coords[1];
+	p.valid = true;
+	return p;
+}
+
+static double coordValue(const Variant &v, CondType cond) {
+	switch (v.Type()) {
+		case KeyValueDouble:
+		case KeyValueInt:
+		case KeyValueInt64:
+			return v.As<double>();
+		default:
+			throw Error(errParams, "Geo condition %s expects numeric values", cond == CondDWithin ? "DWITHIN" : "INBOX");
+	}
+}
+
+GeoArea::GeoArea(CondType cond, const VariantArray &values) : cond_(cond) {
+	switch (cond) {
+		case CondDWithin: {
+			if (values.size() != 3) {
+				throw Error(errParams, "Condition DWITHIN requires 3 arguments (lat, lon, radius), but provided %d", values.size());
+			}
+			center_.lat = coordValue(values[0], cond);
+			center_.lon = coordValue(values[1], cond);
+			radius_ = coordValue(values[2], cond);
+			if (!validCoords(center_.lat, center_.lon)) throw Error(errParams, "Invalid coordinates of DWITHIN center");
+			if (radius_ < 0) throw Error(errParams, "Radius of DWITHIN can't be negative");
+
+			// Bounding box of circle: latitude is shifted by angular radius,
+			// longitude - by angular radius, scaled by width of parallel
+			double dist = radius_ / kEarthRadius;
+			minLat = center_.lat - dist * kRadToDeg;
+			maxLat = center_.lat + dist * kRadToDeg;
+			if (minLat <= -90.0 || maxLat >= 90.0) {
+				// Circle contains pole
+				minLat = std::max(minLat, -90.0);
+				maxLat = std::min(maxLat, 90.0);
+				minLon = -180.0;
+				maxLon = 180.0;
+			} else {
+				double dLon = asin(std::min(1.0, sin(dist) / cos(center_.lat * kDegToRad))) * kRadToDeg;
+				minLon = center_.lon - dLon;
+				maxLon = center_.lon + dLon;
+				if (maxLon - minLon >= 360.0) {
+					minLon = -180.0;
+					maxLon = 180.0;
+				} else {
+					if (minLon < -180.0) minLon += 360.0;
+					if (maxLon > 180.0) maxLon -= 360.0;
+				}
+			}
+			break;
+		}
+		case CondInBox:
+			if (values.size() != 4) {
+				throw Error(errParams, "Condition INBOX requires 4 arguments (south-west lat, lon, north-east lat, lon), but provided %d",
+							values.size());
+			}
+			minLat = coordValue(values[0], cond);
+			minLon = coordValue(values[1], cond);
+			maxLat = coordValue(values[2], cond);
+			maxLon = coordValue(values[3], cond);
+			if (!validCoords(minLat, minLon) || !validCoords(maxLat, maxLon)) {
+				throw Error(errParams, "Invalid coordinates of INBOX corners");
+			}
+			if (minLat > maxLat) throw Error(errParams, "South-west corner of INBOX must be below north-east corner");
+
+			center_.lat = (minLat + maxLat) / 2;
+			center_.lon = (minLon + maxLon) / 2;
+			if (minLon > maxLon) center_.lon += center_.lon > 0 ? -180.0 : 180.0;
+			break;
+		default:
+			throw Error(errParams, "Condition %d is not geo condition", cond);
+	}
+	center_.valid = true;
+}
+
+bool GeoArea::Contains(const GeoPoint &p) const {
+	if (!p.valid || !inBoundingBox(p)) return false;
+	return cond_ == CondInBox || GeoDistance(center_, p) <= radius_;
+}
+
+}  // namespace reindexer
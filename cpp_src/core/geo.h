@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include "core/keyvalue/variant.h"
+#include "core/payload/payloadiface.h"
+
+namespace reindexer {
+
+/// Point on the Earth surface. Coordinates are in degrees
+struct GeoPoint {
+	double lat = 0.0, lon = 0.0;
+	bool valid = false;
+};
+
+inline bool isGeoCondition(CondType cond) { return cond == CondDWithin || cond == CondInBox; }
+
+/// Great-circle distance between points
+/// @return distance in meters
+double GeoDistance(const GeoPoint &a, const GeoPoint &b);
+
+/// Reads point from payload
+/// @param pl - payload of item
+/// @param fields - fields of geo index: latitude, then longitude
+/// @return point, or invalid point, if item has no coordinates or they are out of range
+GeoPoint GetGeoPoint(const ConstPayload &pl, const FieldsSet &fields);
+
+/// Area of geo condition:
+/// CondDWithin - circle, values are [lat, lon, radius in meters]
+/// CondInBox - box, values are [south-west lat, south-west lon, north-east lat, north-east lon]
+class GeoArea {
+public:
+	GeoArea() = default;
+	GeoArea(CondType cond, const VariantArray &values);
+
+	bool Contains(const GeoPoint &p) const;
+	/// Center of circle or box. Distance sorting is performed from this point
+	const GeoPoint &Center() const { return center_; }
+
+	/// Bounding box of area. If minLon > maxLon, then box crosses the 180th meridian
+	double minLat = 0.0, maxLat = 0.0, minLon = 0.0, maxLon = 0.0;
+
+protected:
+	bool inBoundingBox(const GeoPoint &p) const {
+		if (p.lat < minLat || p.lat > maxLat) return false;
+		return minLon <= maxLon ? (p.lon >= minLon && p.lon <= maxLon) : (p.lon >= minLon || p.lon <= maxLon);
+	}
+
+	CondType cond_ = CondDWithin;
+	GeoPoint center_;
+	double radius_ = 0.0;
+};
+
+}  // namespace reindexer
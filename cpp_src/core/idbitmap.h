@@ -0,0 +1,142 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "core/type_consts.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace reindexer {
+
+using std::vector;
+
+/// Set of row ids, stored as plain bitmap: one bit per row of namespace.
+/// Memory consumption does not depend on count of ids, so it's profitable for keys, which match large part of namespace
+/// (booleans, enums with few values). Set operations are performed on whole 64-bit words.
+class IdBitmap {
+public:
+	typedef std::shared_ptr<IdBitmap> Ptr;
+	typedef std::shared_ptr<const IdBitmap> ConstPtr;
+
+	void Set(IdType id) {
+		size_t word = size_t(id) / kWordBits;
+		if (word >= words_.size()) words_.resize(word + 1, 0);
+		uint64_t mask = uint64_t(1) << (id % kWordBits);
+		if (!(words_[word] & mask)) {
+			words_[word] |= mask;
+			count_++;
+		}
+	}
+	int Reset(IdType id) {
+		size_t word = size_t(id) / kWordBits;
+		if (word >= words_.size()) return 0;
+		uint64_t mask = uint64_t(1) << (id % kWordBits);
+		if (!(words_[word] & mask)) return 0;
+		words_[word] &= ~mask;
+		count_--;
+		return 1;
+	}
+	bool Test(IdType id) const {
+		size_t word = size_t(id) / kWordBits;
+		return word < words_.size() && (words_[word] & (uint64_t(1) << (id % kWordBits)));
+	}
+
+	/// @return count of ids in set
+	int Count() const { return count_; }
+	bool IsEmpty() const { return count_ == 0; }
+	/// @return upper bound of ids, which can be stored without reallocation
+	IdType Capacity() const { return IdType(words_.size() * kWordBits); }
+
+	/// @return least id in set, which is greater or equal to from, or Capacity() if there are no such ids
+	IdType Next(IdType from) const {
+		if (from < 0) from = 0;
+		size_t word = size_t(from) / kWordBits;
+		if (word >= words_.size()) return Capacity();
+		uint64_t bits = words_[word] & (~uint64_t(0) << (from % kWordBits));
+		while (!bits) {
+			if (++word == words_.size()) return Capacity();
+			bits = words_[word];
+		}
+		return IdType(word * kWordBits + ctz(bits));
+	}
+	/// @return greatest id in set, which is less or equal to from, or -1 if there are no such ids
+	IdType Prev(IdType from) const {
+		if (from < 0) return -1;
+		size_t word = size_t(from) / kWordBits;
+		if (word >= words_.size()) {
+			if (words_.empty()) return -1;
+			word = words_.size() - 1;
+			from = IdType(word * kWordBits + kWordBits - 1);
+		}
+		uint64_t bits = words_[word] & (~uint64_t(0) >> (kWordBits - 1 - from % kWordBits));
+		while (!bits) {
+			if (word-- == 0) return -1;
+			bits = words_[word];
+		}
+		return IdType(word * kWordBits + kWordBits - 1 - clz(bits));
+	}
+
+	void Or(const IdBitmap &other) {
+		if (other.words_.size() > words_.size()) words_.resize(other.words_.size(), 0);
+		for (size_t i = 0; i < other.words_.size(); ++i) words_[i] |= other.words_[i];
+		recount();
+	}
+	void And(const IdBitmap &other) {
+		if (words_.size() > other.words_.size()) words_.resize(other.words_.size());
+		for (size_t i = 0; i < words_.size(); ++i) words_[i] &= other.words_[i];
+		recount();
+	}
+	void AndNot(const IdBitmap &other) {
+		size_t size = std::min(words_.size(), other.words_.size());
+		for (size_t i = 0; i < size; ++i) words_[i] &= ~other.words_[i];
+		recount();
+	}
+
+	/// Appends next 64 ids to the end of bitmap
+	/// @param word - bits of ids from Capacity() to Capacity() + 63
+	void AppendWord(uint64_t word) {
+		words_.push_back(word);
+		count_ += popcount(word);
+	}
+
+	void ShrinkToFit() {
+		while (!words_.empty() && !words_.back()) words_.pop_back();
+		words_.shrink_to_fit();
+	}
+	size_t heap_size() const { return words_.capacity() * sizeof(uint64_t); }
+
+protected:
+	static constexpr unsigned kWordBits = 64;
+
+	void recount() {
+		count_ = 0;
+		for (uint64_t w : words_) count_ += popcount(w);
+	}
+
+#ifdef _MSC_VER
+	static int popcount(uint64_t w) { return int(__popcnt64(w)); }
+	static int ctz(uint64_t w) {
+		unsigned long idx;
+		_BitScanForward64(&idx, w);
+		return int(idx);
+	}
+	static int clz(uint64_t w) {
+		unsigned long idx;
+		_BitScanReverse64(&idx, w);
+		return int(kWordBits - 1 - idx);
+	}
+#else
+	static int popcount(uint64_t w) { return __builtin_popcountll(w); }
+	static int ctz(uint64_t w) { return __builtin_ctzll(w); }
+	static int clz(uint64_t w) { return __builtin_clzll(w); }
+#endif
+
+	vector<uint64_t> words_;
+	int count_ = 0;
+};
+
+}  // namespace reindexer
@@ -57,6 +57,7 @@ public:
 	void Commit();
 	bool IsCommited() const { return true; }
 	bool IsEmpty() const { return empty(); }
+	size_t Count() const { return size(); }
 	size_t BTreeSize() const { return 0; }
 	void ReserveForSorted(int sortedIdxCount) { reserve(size() * (sortedIdxCount + 1)); }
 	string Dump();
@@ -153,6 +154,8 @@ public:
 	void Commit();
 	bool IsCommited() const { return !usingBtree_; }
 	bool IsEmpty() const { return empty() && (!set_ || set_->empty()); }
+	// Count of ids in set, which may be not commited
+	size_t Count() const { return set_ ? set_->size() : size(); }
 	size_t BTreeSize() const { return set_ ? sizeof(*set_.get()) + set_->size() * sizeof(int) : 0; }
 	void ReserveForSorted(int sortedIdxCount) { reserve(((set_ ? set_->size() : size())) * (sortedIdxCount + 1)); }
 
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace reindexer {
+
+// Split block Bloom filter: each key sets 8 bits in one 64 bytes block, one bit in each 64 bits word of the block.
+// Check of key touches single cache line. With 12 bits per key false positive rate is about 0.5%.
+// Keys can't be removed: owner rebuilds filter, when it's overfilled with keys or removed keys
+class BloomFilter {
+public:
+	// Clears filter and allocates memory for keysCount keys
+	void Reset(size_t keysCount) {
+		size_t blocksCount = (keysCount * kBitsPerKey + kBlockBits - 1) / kBlockBits;
+		blocks_.assign(blocksCount ? blocksCount : 1, Block());
+		keysCount_ = 0;
+	}
+	void Add(uint64_t hash) {
+		Block &block = blocks_[blockNo(hash)];
+		uint32_t h = uint32_t(hash);
+		for (int i = 0; i < kWordsPerBlock; ++i) block.words[i] |= uint64_t(1) << ((h * salt(i)) >> 26);
+		++keysCount_;
+	}
+	bool MayContain(uint64_t hash) const {
+		const Block &block = blocks_[blockNo(hash)];
+		uint32_t h = uint32_t(hash);
+		for (int i = 0; i < kWordsPerBlock; ++i) {
+			if (!(block.words[i] & (uint64_t(1) << ((h * salt(i)) >> 26)))) return false;
+		}
+		return true;
+	}
+	// Count of keys, which were added after Reset
+	size_t KeysCount() const { return keysCount_; }
+	// Count of keys, which can be added without growth of false positive rate
+	size_t Capacity() const { return blocks_.size() * kBlockBits / kBitsPerKey; }
+	size_t HeapSize() const { return blocks_.capacity() * sizeof(Block); }
+	bool Empty() const { return blocks_.empty(); }
+
+	// Mixes bits of hash: hashes of integer keys are often the keys themselves
+	static uint64_t Mix(uint64_t h) {
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return h;
+	}
+
+protected:
+	static constexpr int kWordsPerBlock = 8;
+	static constexpr size_t kBlockBits = kWordsPerBlock * 64;
+	static constexpr size_t kBitsPerKey = 12;
+
+	struct Block {
+		uint64_t words[kWordsPerBlock] = {0, 0, 0, 0, 0, 0, 0, 0};
+	};
+
+	static uint32_t salt(int i) {
+		static const uint32_t salts[kWordsPerBlock] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+													   0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+		return salts[i];
+	}
+	size_t blockNo(uint64_t hash) const { return ((hash >> 32) * blocks_.size()) >> 32; }
+
+	std::vector<Block> blocks_;
+	size_t keysCount_ = 0;
+};
+
+}  // namespace reindexer
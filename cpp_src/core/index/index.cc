@@ -1,6 +1,9 @@
 #include "index.h"
 #include "core/namespacedef.h"
+#include "indexbitmap.h"
+#include "indexgeo.h"
 #include "indexordered.h"
+#include "indextrigram.h"
 #include "indextext/fastindextext.h"
 #include "indextext/fuzzyindextext.h"
 #include "tools/logger.h"
@@ -11,6 +14,7 @@ Index::Index(const IndexDef& idef, const PayloadType payloadType, const FieldsSe
 	: type_(idef.Type()), name_(idef.name_), opts_(idef.opts_), payloadType_(payloadType), fields_(fields) {
 	logPrintf(LogTrace, "Index::Index ('%s',%s,%s)  %s%s%s", idef.name_, idef.indexType_, idef.fieldType_, idef.opts_.IsPK() ? ",pk" : "",
 			  idef.opts_.IsDense() ? ",dense" : "", idef.opts_.IsArray() ? ",array" : "");
+	if (!idef.filter_.empty()) filter_.reset(new IndexFilter(idef.filter_));
 }
 
 Index::Index(const Index& obj)
@@ -22,11 +26,25 @@ Index::Index(const Index& obj)
 	  payloadType_(obj.payloadType_),
 	  fields_(obj.fields_),
 	  keyType_(obj.keyType_),
-	  selectKeyType_(obj.selectKeyType_) {}
+	  selectKeyType_(obj.selectKeyType_),
+	  filter_(obj.filter_ ? new IndexFilter(*obj.filter_) : nullptr) {}
 
 Index::~Index() {}
 
 Index* Index::New(const IndexDef& idef, const PayloadType payloadType, const FieldsSet& fields) {
+	if (idef.opts_.IsBloom()) {
+		IndexType type = idef.Type();
+		if (type != IndexIntHash && type != IndexInt64Hash && type != IndexStrHash && type != IndexIntBTree && type != IndexInt64BTree &&
+			type != IndexDoubleBTree && type != IndexStrBTree) {
+			throw Error(errParams, "Bloom filter can be used only with hash and tree indexes of scalar fields, but index '%s' has type '%s'",
+						idef.name_, idef.indexType_);
+		}
+		// Hash of string key must be equal for keys, which are equal by collate rules
+		CollateMode collateMode = idef.opts_.GetCollateMode();
+		if (collateMode == CollateNumeric || collateMode == CollateCustom) {
+			throw Error(errParams, "Bloom filter can't be used with numeric or custom collate of index '%s'", idef.name_);
+		}
+	}
 	switch (idef.Type()) {
 		case IndexStrBTree:
 		case IndexIntBTree:
@@ -45,6 +63,15 @@ Index* Index::New(const IndexDef& idef, const PayloadType payloadType, const Fie
 		case IndexDoubleStore:
 		case IndexBool:
 			return IndexStore_New(idef, payloadType, fields);
+		case IndexBoolBitmap:
+		case IndexIntBitmap:
+		case IndexInt64Bitmap:
+		case IndexStrBitmap:
+			return IndexBitmap_New(idef, payloadType, fields);
+		case IndexCompositeGeo:
+			return IndexGeo_New(idef, payloadType, fields);
+		case IndexStrTrigram:
+			return IndexTrigram_New(idef, payloadType, fields);
 		case IndexFastFT:
 		case IndexCompositeFastFT:
 			return FastIndexText_New(idef, payloadType, fields);
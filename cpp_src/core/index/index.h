@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "core/idset.h"
+#include "core/index/indexfilter.h"
 #include "core/index/keyentry.h"
 #include "core/indexdef.h"
 #include "core/indexopts.h"
@@ -34,8 +35,13 @@ public:
 	virtual ~Index();
 	virtual Variant Upsert(const Variant& key, IdType id) = 0;
 	virtual void Delete(const Variant& key, IdType id) = 0;
+	// Holds value of row, which doesn't match filter of partial index, without adding row to index. Returns value to put into payload
+	virtual Variant UpsertUnindexed(const Variant& key, IdType /*id*/) { return key; }
+	virtual void DeleteUnindexed(const Variant& /*key*/, IdType /*id*/) {}
 	virtual void DumpKeys() = 0;
 	virtual IdSetRef Find(const Variant& key) = 0;
+	// Checks, that key may be present in index. False positives are possible, false negatives are not
+	virtual bool MayContain(const Variant& /*key*/) const { return true; }
 
 	virtual SelectKeyResults SelectKey(const VariantArray& keys, CondType condition, SortType stype, ResultType res_type,
 									   BaseFunctionCtx::Ptr ctx) = 0;
@@ -61,6 +67,8 @@ public:
 	virtual void SetOpts(const IndexOpts& opts) { opts_ = opts; }
 	void SetFields(const FieldsSet& fields) { fields_ = fields; }
 	SortType SortId() const { return sortId_; }
+	// Filter of partial index, nullptr for usual index
+	IndexFilter* Filter() const { return filter_.get(); }
 	virtual void SetSortedIdxCount(int sortedIdxCount) { sortedIdxCount_ = sortedIdxCount; }
 
 	PerfStatCounterST& GetSelectPerfCounter() { return selectPerfCounter_; }
@@ -91,6 +99,8 @@ protected:
 	KeyValueType keyType_, selectKeyType_;
 	// Count of sorted indexes in namespace to resereve additional space in idsets
 	int sortedIdxCount_ = 0;
+	// Filter of partial index
+	std::unique_ptr<IndexFilter> filter_;
 };
 
 }  // namespace reindexer
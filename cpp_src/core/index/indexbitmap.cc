@@ -0,0 +1,206 @@
+#include "indexbitmap.h"
+#include "tools/errors.h"
+#include "tools/logger.h"
+
+namespace reindexer {
+
+template <typename T>
+typename vector<typename IndexBitmap<T>::Entry>::iterator IndexBitmap<T>::find(const Variant &key) {
+	return std::find_if(entries_.begin(), entries_.end(),
+						[&](const Entry &entry) { return Variant(entry.key).Compare(key, this->opts_.collateOpts_) == 0; });
+}
+
+template <typename T>
+bool IndexBitmap<T>::match(const Entry &entry, const VariantArray &keys, CondType condition) const {
+	Variant key(entry.key);
+	switch (condition) {
+		case CondAny:
+			return true;
+		case CondEq:
+		case CondSet:
+			for (const Variant &k : keys) {
+				if (key.Compare(k, this->opts_.collateOpts_) == 0) return true;
+			}
+			return false;
+		case CondLt:
+			return key.Compare(keys[0], this->opts_.collateOpts_) < 0;
+		case CondLe:
+			return key.Compare(keys[0], this->opts_.collateOpts_) <= 0;
+		case CondGt:
+			return key.Compare(keys[0], this->opts_.collateOpts_) > 0;
+		case CondGe:
+			return key.Compare(keys[0], this->opts_.collateOpts_) >= 0;
+		case CondRange:
+			return key.Compare(keys[0], this->opts_.collateOpts_) >= 0 && key.Compare(keys[1], this->opts_.collateOpts_) <= 0;
+		case CondLike:
+			return key.Type() == KeyValueString && matchLikePattern(string_view(static_cast<p_string>(key)),
+																	string_view(keys[0].As<string>()), this->opts_.GetCollateMode());
+		default:
+			return false;
+	}
+}
+
+template <typename T>
+Variant IndexBitmap<T>::Upsert(const Variant &key, IdType id) {
+	if (key.Type() == KeyValueNull) {
+		empty_ids_.Set(id);
+		return Variant();
+	}
+
+	auto keyIt = find(key);
+	if (keyIt == entries_.end()) {
+		entries_.push_back({static_cast<T>(key), IdBitmap()});
+		keyIt = entries_.end() - 1;
+	}
+	keyIt->ids.Set(id);
+
+	if (this->KeyType() == KeyValueString && this->opts_.GetCollateMode() != CollateNone) {
+		return IndexStore<T>::Upsert(key, id);
+	}
+	return Variant(keyIt->key);
+}
+
+template <typename T>
+void IndexBitmap<T>::Delete(const Variant &key, IdType id) {
+	if (key.Type() == KeyValueNull) {
+		int delcnt = empty_ids_.Reset(id);
+		assert(delcnt);
+		(void)delcnt;
+		return;
+	}
+
+	auto keyIt = find(key);
+	if (keyIt == entries_.end()) return;
+
+	int delcnt = keyIt->ids.Reset(id);
+	(void)delcnt;
+	assertf(this->opts_.IsArray() || this->Opts().IsSparse() || delcnt, "Delete unexists id from index '%s' id=%d,key=%s",
+			this->name_.c_str(), id, Variant(key).As<string>().c_str());
+
+	if (keyIt->ids.IsEmpty()) entries_.erase(keyIt);
+	if (this->KeyType() == KeyValueString && this->opts_.GetCollateMode() != CollateNone) {
+		IndexStore<T>::Delete(key, id);
+	}
+}
+
+template <typename T>
+SelectKeyResults IndexBitmap<T>::SelectKey(const VariantArray &keys, CondType condition, SortType sortId, Index::ResultType res_type,
+										   BaseFunctionCtx::Ptr ctx) {
+	// Bitmaps are indexed by row ids, so they can't be iterated in order of other index
+	if (res_type == Index::ForceComparator || sortId) return IndexStore<T>::SelectKey(keys, condition, sortId, res_type, ctx);
+
+	SelectKeyResult res;
+	switch (condition) {
+		case CondEmpty:
+			res.push_back(SingleSelectKeyResult(empty_ids_));
+			return SelectKeyResults(res);
+		case CondEq:
+		case CondSet:
+			if (condition == CondEq && keys.size() < 1)
+				throw Error(errParams, "For condition required at least 1 argument, but provided 0");
+			break;
+		case CondLt:
+		case CondLe:
+		case CondGt:
+		case CondGe:
+		case CondLike:
+			if (keys.size() != 1) throw Error(errParams, "For condition required exactly 1 argument, but provided %d", keys.size());
+			break;
+		case CondRange:
+			if (keys.size() != 2) throw Error(errParams, "For ranged query reuqired 2 arguments, but provided %d", keys.size());
+			break;
+		case CondAny:
+			break;
+		case CondAllSet: {
+			// Get set of ids, where all request keys are present
+			auto ids = std::make_shared<IdBitmap>();
+			for (size_t i = 0; i < keys.size(); ++i) {
+				auto keyIt = find(keys[i]);
+				if (keyIt == entries_.end()) return SelectKeyResults(res);
+				if (i == 0) {
+					*ids = keyIt->ids;
+				} else {
+					ids->And(keyIt->ids);
+				}
+			}
+			if (keys.size()) res.push_back(SingleSelectKeyResult(ids));
+			return SelectKeyResults(res);
+		}
+		default:
+			throw Error(errQueryExec, "Unknown query on index '%s'", this->name_);
+	}
+
+	const Entry *single = nullptr;
+	IdBitmap::Ptr merged;
+	for (const Entry &entry : entries_) {
+		if (!match(entry, keys, condition)) continue;
+		if (res_type == Index::ForceIdset) {
+			// Keep separate set for each key, so distinct is able to exclude them
+			res.push_back(SingleSelectKeyResult(entry.ids));
+		} else if (!single) {
+			single = &entry;
+		} else {
+			if (!merged) merged = std::make_shared<IdBitmap>(single->ids);
+			merged->Or(entry.ids);
+		}
+	}
+	if (merged) {
+		res.push_back(SingleSelectKeyResult(merged));
+	} else if (single) {
+		res.push_back(SingleSelectKeyResult(single->ids));
+	}
+	return SelectKeyResults(res);
+}
+
+template <typename T>
+void IndexBitmap<T>::DumpKeys() {
+	fprintf(stderr, "Dumping index: %s,keys=%d\n", this->name_.c_str(), int(entries_.size()));
+	for (auto &entry : entries_) {
+		fprintf(stderr, "%s:%d ids\n", Variant(entry.key).As<string>().c_str(), entry.ids.Count());
+	}
+}
+
+template <typename T>
+void IndexBitmap<T>::Commit() {
+	logPrintf(LogTrace, "IndexBitmap::Commit (%s) %d uniq keys, %d empty", this->name_, entries_.size(), empty_ids_.Count());
+}
+
+template <typename T>
+Index *IndexBitmap<T>::Clone() {
+	return new IndexBitmap<T>(*this);
+}
+
+static size_t keyHeapSize(const key_string &key) { return sizeof(*key.get()) + key->heap_size(); }
+template <typename T>
+static size_t keyHeapSize(const T &) {
+	return 0;
+}
+
+template <typename T>
+IndexMemStat IndexBitmap<T>::GetMemStat() {
+	IndexMemStat ret = IndexStore<T>::GetMemStat();
+	ret.uniqKeysCount = entries_.size();
+	ret.idsetPlainSize = sizeof(empty_ids_) + empty_ids_.heap_size();
+	for (auto &entry : entries_) {
+		ret.dataSize += keyHeapSize(entry.key);
+		ret.idsetPlainSize += sizeof(entry) + entry.ids.heap_size();
+	}
+	return ret;
+}
+
+Index *IndexBitmap_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields) {
+	switch (idef.Type()) {
+		case IndexBoolBitmap:
+			return new IndexBitmap<bool>(idef, payloadType, fields);
+		case IndexIntBitmap:
+			return new IndexBitmap<int>(idef, payloadType, fields);
+		case IndexInt64Bitmap:
+			return new IndexBitmap<int64_t>(idef, payloadType, fields);
+		case IndexStrBitmap:
+			return new IndexBitmap<key_string>(idef, payloadType, fields);
+		default:
+			abort();
+	}
+}
+
+}  // namespace reindexer
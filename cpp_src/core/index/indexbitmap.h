@@ -0,0 +1,45 @@
+#pragma once
+
+#include "core/idbitmap.h"
+#include "core/index/indexstore.h"
+
+namespace reindexer {
+
+// Index for booleans and low-cardinality fields: each distinct key owns a bitmap of row ids.
+// Keys are kept in plain vector and are matched by linear scan, so index is not suitable for fields with many distinct values
+template <typename T>
+class IndexBitmap : public IndexStore<T> {
+public:
+	IndexBitmap(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields) : IndexStore<T>(idef, payloadType, fields) {}
+
+	Variant Upsert(const Variant &key, IdType id) override;
+	void Delete(const Variant &key, IdType id) override;
+	void DumpKeys() override;
+	SelectKeyResults SelectKey(const VariantArray &keys, CondType condition, SortType stype, Index::ResultType res_type,
+							   BaseFunctionCtx::Ptr ctx) override;
+	void Commit() override;
+	void UpdateSortedIds(const UpdateSortedContext &) override {}
+	Index *Clone() override;
+	IndexMemStat GetMemStat() override;
+	size_t Size() const override final { return entries_.size(); }
+
+	IdSetRef Find(const Variant & /*key*/) override {
+		throw Error(errLogic, "IndexBitmap::Find of '%s' is not implemented. Do not use 'bitmap' index as pk!", this->name_);
+	}
+
+protected:
+	struct Entry {
+		T key;
+		IdBitmap ids;
+	};
+
+	typename vector<Entry>::iterator find(const Variant &key);
+	bool match(const Entry &entry, const VariantArray &keys, CondType condition) const;
+
+	vector<Entry> entries_;
+	IdBitmap empty_ids_;
+};
+
+Index *IndexBitmap_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields);
+
+}  // namespace reindexer
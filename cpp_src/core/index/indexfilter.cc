@@ -0,0 +1,83 @@
+#include "indexfilter.h"
+#include "core/query/query.h"
+#include "tools/errors.h"
+
+namespace reindexer {
+
+IndexFilter::IndexFilter(const string &condition) : condition_(condition) {
+	Query q;
+	q.FromSQL("SELECT * FROM filter WHERE " + condition);
+	if (q.entries.empty() || !q.sortingEntries_.empty() || !q.aggregations_.empty() || !q.joinQueries_.empty() ||
+		!q.mergeQueries_.empty() || q.start != 0 || q.count < INT_MAX) {
+		throw Error(errParams, "Filter of partial index must contain only conditions: '%s'", condition);
+	}
+	for (const QueryEntry &qe : q.entries) {
+		if (qe.op != OpAnd || qe.distinct) {
+			throw Error(errParams, "Conditions of partial index filter can be joined only by AND: '%s'", condition);
+		}
+		if (isGeoCondition(qe.condition)) throw Error(errParams, "Geo condition can't be used in filter of partial index: '%s'", condition);
+	}
+	entries_ = std::move(q.entries);
+	bindings_.resize(entries_.size());
+}
+
+void IndexFilter::BindField(size_t entry, KeyValueType keyType, bool isArray, const CollateOpts &collateOpts, const TagsPath &tagsPath) {
+	FieldBinding &binding = bindings_[entry];
+	binding.keyType = keyType;
+	binding.isArray = isArray;
+	binding.collateOpts = collateOpts;
+	binding.tagsPath = tagsPath;
+	for (auto &v : entries_[entry].values) v.convert(keyType);
+}
+
+void IndexFilter::Prepare(const PayloadType &payloadType) {
+	comparators_.clear();
+	for (size_t i = 0; i < entries_.size(); ++i) {
+		const QueryEntry &qe = entries_[i];
+		const FieldBinding &binding = bindings_[i];
+		FieldsSet fields;
+		int field = IndexValueType::SetByJsonPath;
+		if (binding.tagsPath.empty()) {
+			// Field of dropped index is not found: filter of the dropped index is not used anymore
+			if (!payloadType.FieldByName(qe.index, field)) continue;
+			fields.push_back(field);
+		} else {
+			fields.push_back(binding.tagsPath);
+		}
+		comparators_.emplace_back(qe.condition, binding.keyType, qe.values, binding.isArray, false, payloadType, fields, nullptr,
+								  binding.collateOpts);
+		if (field >= 0) comparators_.back().Bind(payloadType, field);
+	}
+}
+
+bool IndexFilter::Match(const PayloadValue &pv) {
+	assert(comparators_.size() == entries_.size());
+	for (Comparator &cmp : comparators_) {
+		if (!cmp.Compare(pv, 0)) return false;
+	}
+	return true;
+}
+
+bool IndexFilter::ImpliedBy(const QueryEntries &entries) const {
+	for (const QueryEntry &fe : entries_) {
+		bool implied = false;
+		for (size_t i = 0; i < entries.size() && !implied; ++i) {
+			const QueryEntry &qe = entries[i];
+			if (qe.op != OpAnd || (i + 1 < entries.size() && entries[i + 1].op == OpOr) || qe.distinct || qe.idxNo < 0 ||
+				qe.index != fe.index) {
+				continue;
+			}
+			if (qe.condition == fe.condition && qe.values == fe.values) {
+				implied = true;
+			} else if ((qe.condition == CondEq || qe.condition == CondSet) && (fe.condition == CondEq || fe.condition == CondSet)) {
+				implied = std::all_of(qe.values.begin(), qe.values.end(), [&fe](const Variant &v) {
+					return std::find(fe.values.begin(), fe.values.end(), v) != fe.values.end();
+				});
+			}
+		}
+		if (!implied) return false;
+	}
+	return true;
+}
+
+}  // namespace reindexer
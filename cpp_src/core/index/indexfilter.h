@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/comparator.h"
+#include "core/query/querywhere.h"
+
+namespace reindexer {
+
+// Filter of partial index: AND-ed conditions on indexed fields in SQL syntax, e.g. "status = 'active' AND deleted = false".
+// Partial index contains only rows, which match the filter
+class IndexFilter {
+public:
+	// Parses filter condition. Throws on syntax error or unsupported condition
+	IndexFilter(const string &condition);
+
+	// Binds condition on field to index of the field
+	// @param entry - number of condition
+	// @param tagsPath - path of sparse index, empty for dense index
+	void BindField(size_t entry, KeyValueType keyType, bool isArray, const CollateOpts &collateOpts, const TagsPath &tagsPath);
+	// Creates comparators for payload type. Must be called after every change of payload type
+	void Prepare(const PayloadType &payloadType);
+	// Checks, that row matches the filter
+	bool Match(const PayloadValue &pv);
+	// Checks, that every row, matching AND-ed query entries, matches the filter.
+	// Query entry implies condition of filter, if it's the same condition, or EQ/SET with subset of values of EQ/SET condition
+	bool ImpliedBy(const QueryEntries &entries) const;
+
+	const string &Condition() const { return condition_; }
+	const QueryEntries &Entries() const { return entries_; }
+
+protected:
+	struct FieldBinding {
+		KeyValueType keyType = KeyValueUndefined;
+		bool isArray = false;
+		CollateOpts collateOpts;
+		TagsPath tagsPath;
+	};
+
+	string condition_;
+	QueryEntries entries_;
+	vector<FieldBinding> bindings_;
+	vector<Comparator> comparators_;
+};
+
+}  // namespace reindexer
@@ -0,0 +1,147 @@
+#include "indexgeo.h"
+#include <limits>
+#include "tools/errors.h"
+#include "tools/logger.h"
+
+namespace reindexer {
+
+// Maximum count of grid cells, which are scanned to cover bounding box of area
+const uint64_t kMaxCoverCells = 16;
+const int kCoordBits = 32;
+
+static uint32_t quantize(double v, double min, double range) {
+	double q = (v - min) / range * 4294967296.0;
+	if (q <= 0) return 0;
+	if (q >= 4294967295.0) return std::numeric_limits<uint32_t>::max();
+	return uint32_t(q);
+}
+
+// Spreads bits of v to even positions of result
+static uint64_t spreadBits(uint32_t v) {
+	uint64_t x = v;
+	x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+	x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+	x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	x = (x | (x << 2)) & 0x3333333333333333ULL;
+	x = (x | (x << 1)) & 0x5555555555555555ULL;
+	return x;
+}
+
+static uint64_t interleave(uint32_t x, uint32_t y) { return (spreadBits(x) << 1) | spreadBits(y); }
+
+IndexGeo::IndexGeo(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields) : Index(idef, payloadType, fields) {
+	keyType_ = KeyValueComposite;
+	selectKeyType_ = KeyValueDouble;
+}
+
+uint64_t IndexGeo::encode(const GeoPoint &p) { return interleave(quantize(p.lon, -180.0, 360.0), quantize(p.lat, -90.0, 180.0)); }
+
+Variant IndexGeo::Upsert(const Variant &key, IdType id) {
+	if (size_t(id) >= points_.size()) points_.resize(id + 1);
+	GeoPoint &point = points_[id];
+	if (point.valid) tree_.erase(Entry(encode(point), id));
+
+	point = GetGeoPoint(ConstPayload(payloadType_, static_cast<const PayloadValue &>(key)), fields_);
+	if (point.valid) tree_.insert(Entry(encode(point), id));
+	return key;
+}
+
+void IndexGeo::Delete(const Variant & /*key*/, IdType id) {
+	if (size_t(id) >= points_.size() || !points_[id].valid) return;
+	int delcnt = tree_.erase(Entry(encode(points_[id]), id));
+	(void)delcnt;
+	assertf(delcnt, "Delete unexists id from index '%s' id=%d", name_.c_str(), id);
+	points_[id] = GeoPoint();
+}
+
+void IndexGeo::selectBox(const GeoArea &area, double minLon, double maxLon, vector<IdType> &ids) const {
+	uint32_t x0 = quantize(minLon, -180.0, 360.0), x1 = quantize(maxLon, -180.0, 360.0);
+	uint32_t y0 = quantize(area.minLat, -90.0, 180.0), y1 = quantize(area.maxLat, -90.0, 180.0);
+
+	// Find the smallest cells, which cover the box with not more than kMaxCoverCells cells
+	int shift = kCoordBits - 1;
+	for (int s = kCoordBits - 2; s >= 0; --s) {
+		uint64_t cells = uint64_t((x1 >> s) - (x0 >> s) + 1) * uint64_t((y1 >> s) - (y0 >> s) + 1);
+		if (cells > kMaxCoverCells) break;
+		shift = s;
+	}
+
+	// Each cell is continuous range of codes. Adjacent ranges are merged to reduce count of btree lookups
+	h_vector<std::pair<uint64_t, uint64_t>, kMaxCoverCells> ranges;
+	for (uint64_t cy = y0 >> shift; cy <= y1 >> shift; ++cy) {
+		for (uint64_t cx = x0 >> shift; cx <= x1 >> shift; ++cx) {
+			uint64_t first = interleave(uint32_t(cx), uint32_t(cy)) << (2 * shift);
+			ranges.push_back({first, first + ((uint64_t(1) << (2 * shift)) - 1)});
+		}
+	}
+	std::sort(ranges.begin(), ranges.end());
+
+	for (size_t i = 0; i < ranges.size();) {
+		uint64_t first = ranges[i].first, last = ranges[i].second;
+		for (++i; i < ranges.size() && ranges[i].first == last + 1; ++i) last = ranges[i].second;
+
+		for (auto it = tree_.lower_bound(Entry(first, std::numeric_limits<IdType>::min())); it != tree_.end() && it->first <= last; ++it) {
+			if (area.Contains(points_[it->second])) ids.push_back(it->second);
+		}
+	}
+}
+
+SelectKeyResults IndexGeo::SelectKey(const VariantArray &keys, CondType condition, SortType sortId, ResultType res_type,
+									 BaseFunctionCtx::Ptr /*ctx*/) {
+	if (!isGeoCondition(condition)) {
+		throw Error(errQueryExec, "Condition %d is not supported by geo index '%s'. Only DWITHIN and INBOX are allowed", condition, name_);
+	}
+	if (res_type == ForceIdset) throw Error(errQueryExec, "Distinct is not supported by geo index '%s'", name_);
+
+	SelectKeyResult res;
+	// Ids of points are row ids, so they can't be iterated in order of other index
+	if (res_type == ForceComparator || sortId) {
+		res.comparators_.push_back(Comparator(condition, KeyType(), keys, false, false, payloadType_, fields_));
+		return SelectKeyResults(res);
+	}
+
+	GeoArea area(condition, keys);
+	vector<IdType> ids;
+	if (area.minLon <= area.maxLon) {
+		selectBox(area, area.minLon, area.maxLon, ids);
+	} else {
+		// Area crosses the 180th meridian
+		selectBox(area, area.minLon, 180.0, ids);
+		selectBox(area, -180.0, area.maxLon, ids);
+	}
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+	auto idset = std::make_shared<IdSet>();
+	idset->reserve(ids.size());
+	for (IdType id : ids) idset->Add(id, IdSet::Unordered, 0);
+	res.push_back(SingleSelectKeyResult(idset));
+	return SelectKeyResults(res);
+}
+
+void IndexGeo::DumpKeys() {
+	fprintf(stderr, "Dumping index: %s,points=%d\n", name_.c_str(), int(tree_.size()));
+	for (auto &entry : tree_) {
+		const GeoPoint &p = points_[entry.second];
+		fprintf(stderr, "%016llx:%d (%f,%f)\n", static_cast<unsigned long long>(entry.first), entry.second, p.lat, p.lon);
+	}
+}
+
+void IndexGeo::Commit() { logPrintf(LogTrace, "IndexGeo::Commit (%s) %d points", name_, tree_.size()); }
+
+Index *IndexGeo::Clone() { return new IndexGeo(*this); }
+
+IndexMemStat IndexGeo::GetMemStat() {
+	IndexMemStat ret;
+	ret.name = name_;
+	ret.uniqKeysCount = tree_.size();
+	ret.idsetBTreeSize = tree_.bytes_used();
+	ret.columnSize = points_.capacity() * sizeof(GeoPoint);
+	return ret;
+}
+
+Index *IndexGeo_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields) {
+	return new IndexGeo(idef, payloadType, fields);
+}
+
+}  // namespace reindexer
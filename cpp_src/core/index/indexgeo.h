@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/geo.h"
+#include "core/index/index.h"
+#include "cpp-btree/btree_set.h"
+
+namespace reindexer {
+
+// Spatial index over pair of fields (latitude+longitude). Points are stored in btree, ordered by geohash-like
+// code (interleaved bits of quantized longitude and latitude), so each cell of geo grid is a continuous range of codes.
+// Circle and box conditions are selected by scan of few cells, which cover bounding box of area
+class IndexGeo : public Index {
+public:
+	IndexGeo(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields);
+
+	Variant Upsert(const Variant &key, IdType id) override;
+	void Delete(const Variant &key, IdType id) override;
+	void DumpKeys() override;
+	SelectKeyResults SelectKey(const VariantArray &keys, CondType condition, SortType stype, ResultType res_type,
+							   BaseFunctionCtx::Ptr ctx) override;
+	void Commit() override;
+	void UpdateSortedIds(const UpdateSortedContext &) override {}
+	Index *Clone() override;
+	IndexMemStat GetMemStat() override;
+	size_t Size() const override final { return tree_.size(); }
+
+	IdSetRef Find(const Variant & /*key*/) override {
+		throw Error(errLogic, "IndexGeo::Find of '%s' is not implemented. Do not use 'geo' index as pk!", this->name_);
+	}
+
+protected:
+	typedef std::pair<uint64_t, IdType> Entry;
+
+	static uint64_t encode(const GeoPoint &p);
+	void selectBox(const GeoArea &area, double minLon, double maxLon, vector<IdType> &ids) const;
+
+	btree::btree_set<Entry> tree_;
+	// Points of rows, indexed by row id. Used for precise check of points in covering cells
+	vector<GeoPoint> points_;
+};
+
+Index *IndexGeo_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields);
+
+}  // namespace reindexer
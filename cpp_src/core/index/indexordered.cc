@@ -16,8 +16,10 @@ Variant IndexOrdered<T>::Upsert(const Variant &key, IdType id) {
 	bool found = false;
 	auto keyIt = lower_bound(key, found);
 
-	if (keyIt == this->idx_map.end() || !found)
+	if (keyIt == this->idx_map.end() || !found) {
 		keyIt = this->idx_map.insert(keyIt, {static_cast<typename T::key_type>(key), typename T::mapped_type()});
+		if (this->opts_.IsBloom()) this->addToBloom(key);
+	}
 	keyIt->second.Unsorted().Add(id, this->opts_.IsPK() ? IdSet::Ordered : IdSet::Auto, this->sortedIdxCount_);
 	this->markUpdated(&*keyIt);
 
@@ -48,6 +50,53 @@ typename T::iterator IndexOrdered<T>::lower_bound(const Variant &key, bool &foun
 	return it;
 }
 
+// Keys, which start with literal prefix of pattern, are continuous range of btree, so only this range is checked by pattern.
+// Patterns, started with wildcard, and collate modes with other order of keys are checked by comparator
+template <typename T>
+template <typename U, typename std::enable_if<is_string_map_key<U>::value>::type *>
+SelectKeyResults IndexOrdered<T>::selectLike(const VariantArray &keys, SortType sortId, Index::ResultType res_type,
+											 BaseFunctionCtx::Ptr ctx) {
+	if (keys.size() != 1) throw Error(errParams, "Condition LIKE requires exactly 1 argument, but provided %d", keys.size());
+	const CollateMode mode = this->opts_.GetCollateMode();
+	const string pattern = keys[0].As<string>();
+	const string_view prefix = likePatternPrefix(pattern);
+	if (prefix.empty() || (mode != CollateNone && mode != CollateASCII && mode != CollateUTF8)) {
+		return IndexStore<typename T::key_type>::SelectKey(keys, CondLike, sortId, res_type, ctx);
+	}
+
+	struct {
+		T *i_map;
+		SortType sortId;
+		CollateMode mode;
+		const string &pattern;
+		string prefixPattern;
+		typename T::iterator startIt;
+	} sctx = {&this->idx_map, sortId, mode, pattern, prefix.ToString() + '%',
+			  this->idx_map.lower_bound(make_key_string(prefix.data(), prefix.size()))};
+
+	auto selector = [&sctx](SelectKeyResult &res) {
+		for (auto it = sctx.startIt; it != sctx.i_map->end(); ++it) {
+			string_view key(*it->first);
+			if (!matchLikePattern(key, sctx.prefixPattern, sctx.mode)) break;
+			if (matchLikePattern(key, sctx.pattern, sctx.mode)) res.push_back(SingleSelectKeyResult(it->second, sctx.sortId));
+		}
+	};
+
+	SelectKeyResult res;
+	if (res_type != Index::ForceIdset && res_type != Index::DisableIdSetCache)
+		this->tryIdsetCache(keys, CondLike, sortId, selector, res);
+	else
+		selector(res);
+	return SelectKeyResults(res);
+}
+
+template <typename T>
+template <typename U, typename std::enable_if<!is_string_map_key<U>::value>::type *>
+SelectKeyResults IndexOrdered<T>::selectLike(const VariantArray &keys, SortType sortId, Index::ResultType res_type,
+											 BaseFunctionCtx::Ptr ctx) {
+	return IndexStore<typename T::key_type>::SelectKey(keys, CondLike, sortId, res_type, ctx);
+}
+
 template <typename T>
 SelectKeyResults IndexOrdered<T>::SelectKey(const VariantArray &keys, CondType condition, SortType sortId, Index::ResultType res_type,
 											BaseFunctionCtx::Ptr ctx) {
@@ -58,6 +107,8 @@ SelectKeyResults IndexOrdered<T>::SelectKey(const VariantArray &keys, CondType c
 	if (condition == CondSet || condition == CondEq || condition == CondAny || condition == CondEmpty)
 		return IndexUnordered<T>::SelectKey(keys, condition, sortId, res_type, ctx);
 
+	if (condition == CondLike) return selectLike(keys, sortId, res_type, ctx);
+
 	if (keys.size() < 1) throw Error(errParams, "For condition required at least 1 argument, but provided 0");
 
 	auto startIt = this->idx_map.begin();
@@ -195,7 +246,8 @@ Index *IndexOrdered<T>::Clone() {
 
 template <typename T>
 bool IndexOrdered<T>::IsOrdered() const {
-	return true;
+	// Partial index has no sort orders: rows, which are not in index, can't be ordered by it
+	return !this->filter_;
 }
 
 template <typename KeyEntryT>
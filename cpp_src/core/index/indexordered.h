@@ -22,6 +22,11 @@ protected:
 	typename T::iterator lower_bound(const Variant &key, bool &found);
 	template <typename U = T, typename std::enable_if<!is_string_map_key<U>::value>::type * = nullptr>
 	typename T::iterator lower_bound(const Variant &key, bool &found);
+
+	template <typename U = T, typename std::enable_if<is_string_map_key<U>::value>::type * = nullptr>
+	SelectKeyResults selectLike(const VariantArray &keys, SortType sortId, Index::ResultType res_type, BaseFunctionCtx::Ptr ctx);
+	template <typename U = T, typename std::enable_if<!is_string_map_key<U>::value>::type * = nullptr>
+	SelectKeyResults selectLike(const VariantArray &keys, SortType sortId, Index::ResultType res_type, BaseFunctionCtx::Ptr ctx);
 };
 
 Index *IndexOrdered_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields);
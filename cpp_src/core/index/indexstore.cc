@@ -8,14 +8,14 @@ namespace reindexer {
 // special implementation for string: avoid allocation string for *_map::find
 // !!!! Not thread safe. Do not use this in Select
 template <>
-unordered_str_map<int>::iterator IndexStore<key_string>::find(const Variant &key) {
+fast_str_map<int>::iterator IndexStore<key_string>::find(const Variant &key) {
 	p_string skey = static_cast<p_string>(key);
 	tmpKeyVal_->assign(skey.data(), skey.length());
 	return str_map.find(tmpKeyVal_);
 }
 
 template <typename T>
-unordered_str_map<int>::iterator IndexStore<T>::find(const Variant & /*key*/) {
+fast_str_map<int>::iterator IndexStore<T>::find(const Variant & /*key*/) {
 	return str_map.end();
 }
 
@@ -58,6 +58,25 @@ Variant IndexStore<T>::Upsert(const Variant &key, IdType id) {
 	return Variant(key);
 }
 
+// Strings of rows, which are not in partial index, are held in the same map with reference counters
+template <>
+Variant IndexStore<key_string>::UpsertUnindexed(const Variant &key, IdType id) {
+	return IndexStore<key_string>::Upsert(key, id);
+}
+
+template <typename T>
+Variant IndexStore<T>::UpsertUnindexed(const Variant &key, IdType /*id*/) {
+	return key;
+}
+
+template <>
+void IndexStore<key_string>::DeleteUnindexed(const Variant &key, IdType id) {
+	IndexStore<key_string>::Delete(key, id);
+}
+
+template <typename T>
+void IndexStore<T>::DeleteUnindexed(const Variant & /*key*/, IdType /*id*/) {}
+
 template <typename T>
 void IndexStore<T>::Commit() {
 	logPrintf(LogTrace, "IndexStore::Commit (%s) %d uniq strings", name_, str_map.size());
@@ -68,7 +87,7 @@ SelectKeyResults IndexStore<T>::SelectKey(const VariantArray &keys, CondType con
 										  BaseFunctionCtx::Ptr /*ctx*/) {
 	SelectKeyResult res;
 	res.comparators_.push_back(Comparator(condition, KeyType(), keys, opts_.IsArray(), res_type == Index::ForceIdset, payloadType_, fields_,
-										  idx_data.size() ? idx_data.data() : nullptr, opts_.collateOpts_));
+										  idx_data.size() ? idx_data.data() : nullptr, opts_.collateOpts_, idx_data.size()));
 	return SelectKeyResults(res);
 }
 
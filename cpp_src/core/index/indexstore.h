@@ -16,6 +16,8 @@ public:
 
 	Variant Upsert(const Variant &key, IdType id) override;
 	void Delete(const Variant &key, IdType id) override;
+	Variant UpsertUnindexed(const Variant &key, IdType id) override;
+	void DeleteUnindexed(const Variant &key, IdType id) override;
 	void DumpKeys() override {}
 	SelectKeyResults SelectKey(const VariantArray &keys, CondType condition, SortType stype, ResultType res_type,
 							   BaseFunctionCtx::Ptr ctx) override;
@@ -29,8 +31,8 @@ public:
 	}
 
 protected:
-	unordered_str_map<int>::iterator find(const Variant &key);
-	unordered_str_map<int> str_map;
+	fast_str_map<int>::iterator find(const Variant &key);
+	fast_str_map<int> str_map;
 	h_vector<T> idx_data;
 
 	key_string tmpKeyVal_ = make_key_string();
@@ -49,7 +49,6 @@ Variant FastIndexText<T>::Upsert(const Variant &key, IdType id) {
 
 template <typename T>
 void FastIndexText<T>::Delete(const Variant &key, IdType id) {
-	this->isBuilt_ = false;
 	int delcnt = 0;
 	if (key.Type() == KeyValueNull) {
 		delcnt = this->empty_ids_.Unsorted().Erase(id);
@@ -68,10 +67,14 @@ void FastIndexText<T>::Delete(const Variant &key, IdType id) {
 
 	if (keyIt->second.Unsorted().IsEmpty()) {
 		this->tracker_.markDeleted(&*keyIt);
-		if (this->holder_.vdocs_.size()) {
-			assert(keyIt->second.vdoc_id_ < this->holder_.vdocs_.size());
-			this->holder_.vdocs_[keyIt->second.vdoc_id_].keyEntry = nullptr;
+		// Entry can be absent in fulltext data, which were built before it's insertion
+		auto &vdocs = this->holder_.vdocs_;
+		if (keyIt->second.vdoc_id_ < vdocs.size() && vdocs[keyIt->second.vdoc_id_].keyEntry == &keyIt->second) {
+			this->holder_.MarkDeleted(keyIt->second.vdoc_id_);
+			// Data without deleted documents are rebuilt by the next commit
+			if (this->holder_.MostDeleted()) this->isBuilt_ = false;
 		}
+		if (commitJob_) commitJob_->erased.insert(&keyIt->second);
 		this->idx_map.erase(keyIt);
 	}
 	if (this->KeyType() == KeyValueString && this->opts_.GetCollateMode() != CollateNone) {
@@ -85,6 +88,7 @@ IndexMemStat FastIndexText<T>::GetMemStat() {
 	auto ret = IndexUnordered<T>::GetMemStat();
 	ret.fulltextSize = this->holder_.GetMemStat();
 	if (this->cache_ft_) ret.idsetCache = this->cache_ft_->GetMemStat();
+	ret.fulltextSize += termsCache_->GetMemStat().totalSize;
 	return ret;
 }
 template <typename T>
@@ -97,7 +101,7 @@ IdSet::Ptr FastIndexText<T>::Select(FtCtx::Ptr fctx, FtDSLQuery &dsl) {
 	fctx->GetData()->extraWordSymbols_ = this->GetConfig()->extraWordSymbols;
 	fctx->GetData()->isWordPositions_ = true;
 
-	auto merdeInfo = Selecter(this->holder_, this->fields_.size(), fctx->NeedArea()).Process(dsl);
+	auto merdeInfo = Selecter(this->holder_, this->fields_.size(), fctx->NeedArea(), fctx->TopK(), termsCache_.get()).Process(dsl);
 	// convert vids(uniq documents id) to ids (real ids)
 	IdSet::Ptr mergedIds = std::make_shared<IdSet>();
 	auto &holder = this->holder_;
@@ -158,83 +162,241 @@ IdSet::Ptr FastIndexText<T>::Select(FtCtx::Ptr fctx, FtDSLQuery &dsl) {
 }
 template <typename T>
 void FastIndexText<T>::commitFulltext() {
-	this->holder_.StartCommit(this->tracker_.isCompleteUpdated());
+	auto &holder = this->holder_;
+	if (!this->tracker_.isCompleteUpdated() && this->tracker_.updated().empty() && !holder.NeedRebuild(false)) {
+		// Documents were only deleted: they are marked in vdocs
+		return;
+	}
+	holder.StartCommit(this->tracker_.isCompleteUpdated());
+	termsCache_->Clear();
 
 	auto tm0 = high_resolution_clock::now();
 
-	if (this->holder_.status_ == FullRebuild) {
-		BuildVdocs(this->idx_map);
+	vector<DocRef> docs;
+	if (holder.status_ == FullRebuild) {
+		docs.reserve(this->idx_map.size());
+		for (auto &doc : this->idx_map) docs.emplace_back(doc.first, &doc.second);
 	} else {
-		BuildVdocs(this->tracker_.updated());
+		docs.reserve(this->tracker_.updated().size());
+		for (auto doc : this->tracker_.updated()) docs.emplace_back(doc->first, &doc->second);
 	}
+	auto gt = this->Getter();
+	BuildVdocs(holder, gt, docs);
+	for (size_t i = 0; i < docs.size(); ++i) docs[i].second->vdoc_id_ = holder.vodcsOffset_ + i;
 	auto tm1 = high_resolution_clock::now();
 
-	DataProcessor dp(this->holder_, this->fields_.size());
+	DataProcessor dp(holder, this->fields_.size());
 	dp.Process(!this->opts_.IsDense());
-	if (this->holder_.NeedClear(this->tracker_.isCompleteUpdated())) {
-		this->tracker_.clear();
+	if (holder.status_ == CreateNew) {
+		size_t from = holder.StepsToMerge(holder.steps.size() - 1, holder.steps.back().docsCount_);
+		if (from + 1 < holder.steps.size()) holder.MergeSteps(from);
 	}
+	holder.UpdateAvgWordsCount(this->fields_.size());
+	this->tracker_.clear();
 	auto tm2 = high_resolution_clock::now();
 
-	logPrintf(LogInfo, "FastIndexText::Commit elapsed %d ms total [ build vdocs %d ms,  process data %d ms ]\n",
+	logPrintf(LogInfo, "FastIndexText::Commit elapsed %d ms total [ build vdocs %d ms,  process data %d ms ], %d steps\n",
 			  duration_cast<milliseconds>(tm2 - tm0).count(), duration_cast<milliseconds>(tm1 - tm0).count(),
-			  duration_cast<milliseconds>(tm2 - tm1).count());
+			  duration_cast<milliseconds>(tm2 - tm1).count(), holder.steps.size());
 }
 
-// hack wothout c++14
-pair<const key_string, FtFastKeyEntry> &GetPair(pair<const key_string, FtFastKeyEntry> &pair) { return pair; }
-pair<const key_string, FtFastKeyEntry> &GetPair(pair<const key_string, FtFastKeyEntry> *pair) { return *pair; }
-pair<const PayloadValue, FtFastKeyEntry> &GetPair(pair<const PayloadValue, FtFastKeyEntry> &pair) { return pair; }
-pair<const PayloadValue, FtFastKeyEntry> &GetPair(pair<const PayloadValue, FtFastKeyEntry> *pair) { return *pair; }
+template <typename T>
+void FastIndexText<T>::Commit() {
+	if (!GetConfig()->enableBackgroundCommit) return;
+	// Namespace commits indexes in background, when updates are finished: start build of fulltext data here,
+	// so selects will not wait for it
+	std::unique_lock<shared_timed_mutex> lck(this->mtx_);
+	if (commitJob_ && commitJob_->done) publishCommitJob();
+	if (!this->isBuilt_ && !commitJob_) startCommitJob();
+}
 
 template <typename T>
-template <class Data>
-void FastIndexText<T>::BuildVdocs(Data &data) {
-	// buffer strings, for printing non text fields
-	auto &bufStrs = this->holder_.bufStrs_;
-	// array with pointers to docs fields text
-	// Prepare vdocs -> addresable array all docs in the index
+bool FastIndexText<T>::needCommit() const {
+	if (!GetConfig()->enableBackgroundCommit) return !this->isBuilt_ || commitJob_;
+	if (commitJob_ && commitJob_->done) return true;
+	// Select waits for the data only on the first build or in read your writes mode
+	if (this->holder_.steps.empty() || GetConfig()->readYourWrites) return !this->isBuilt_ || commitJob_;
+	return !this->isBuilt_ && !commitJob_;
+}
+
+template <typename T>
+void FastIndexText<T>::commitForSelect() {
+	bool wait = !GetConfig()->enableBackgroundCommit || this->holder_.steps.empty() || GetConfig()->readYourWrites;
+	if (commitJob_ && (wait || commitJob_->done)) publishCommitJob();
+	if (this->isBuilt_) return;
+	if (wait) {
+		// Data, which are not built yet, are committed by select itself
+		commitFulltext();
+		this->isBuilt_ = true;
+	} else if (!commitJob_) {
+		startCommitJob();
+	}
+}
 
-	this->holder_.szCnt = 0;
-	auto &vdocs = this->holder_.vdocs_;
-	auto &vdocsTexts = this->holder_.vdocsTexts;
+template <typename T>
+void FastIndexText<T>::configUpdated() {
+	IndexText<T>::configUpdated();
+	// Found words depend on stemmers, typos and terms options
+	termsCache_->Clear();
+}
 
-	vdocs.reserve(vdocs.size() + data.size());
-	vdocsTexts.reserve(data.size());
+template <typename T>
+void FastIndexText<T>::startCommitJob() {
+	auto &holder = this->holder_;
+	unique_ptr<CommitJob> job(new CommitJob);
+	job->payloadType = this->payloadType_;
+	job->rebuild = holder.NeedRebuild(this->tracker_.isCompleteUpdated());
+	if (job->rebuild) {
+		job->docs.reserve(this->idx_map.size());
+		for (auto &doc : this->idx_map) job->docs.emplace_back(doc.first, &doc.second);
+	} else {
+		job->docs.reserve(this->tracker_.updated().size());
+		for (auto doc : this->tracker_.updated()) job->docs.emplace_back(doc->first, &doc->second);
+	}
+	for (auto &doc : job->docs) holdStrings(job->payloadType, doc.first, true);
+	this->tracker_.clear();
+	this->isBuilt_ = true;
+	// Documents were only deleted: they are marked in vdocs
+	if (job->docs.empty() && !job->rebuild) return;
+
+	job->vdocsOffset = holder.vdocs_.size();
+	job->mergeFrom = holder.steps.size();
+	job->deletedCount = 0;
+	if (!job->rebuild) {
+		job->mergeFrom = holder.StepsToMerge(holder.steps.size(), job->docs.size());
+		if (job->mergeFrom < holder.steps.size()) {
+			VDocIdType offset = holder.steps[job->mergeFrom].vdocsOffset_;
+			job->deleted.resize(job->vdocsOffset + job->docs.size() - offset);
+			for (size_t i = offset; i < job->vdocsOffset; ++i) {
+				job->deleted[i - offset] = !holder.vdocs_[i].keyEntry;
+				if (job->deleted[i - offset]) ++job->deletedCount;
+			}
+			for (size_t i = job->mergeFrom; i < holder.steps.size(); ++i) job->mergeSteps.push_back(&holder.steps[i]);
+		}
+	}
+	job->cfg = *GetConfig();
+	job->holder.SetConfig(&job->cfg);
+	job->fields = this->fields_;
+	job->keyType = this->KeyType();
+	job->multithread = !this->opts_.IsDense();
+
+	CommitJob *j = job.get();
+	job->thread = thread([j]() { buildCommitJob(*j); });
+	commitJob_ = std::move(job);
+}
 
-	auto gt = this->Getter();
+template <typename T>
+void FastIndexText<T>::buildCommitJob(CommitJob &job) {
+	auto tm0 = high_resolution_clock::now();
+	try {
+		job.holder.StartCommit(true);
+		if (!job.rebuild) job.holder.steps.back().vdocsOffset_ = job.vdocsOffset;
+		FieldsGetter<T> gt(job.fields, job.payloadType, job.keyType);
+		BuildVdocs(job.holder, gt, job.docs);
+		DataProcessor dp(job.holder, job.fields.size());
+		dp.Process(job.multithread);
+		if (!job.mergeSteps.empty()) {
+			auto steps = job.mergeSteps;
+			steps.push_back(&job.holder.steps.back());
+			auto merged = DataProcessor::MergeSteps(steps, job.deleted, job.cfg);
+			merged.vdocsOffset_ = steps.front()->vdocsOffset_;
+			job.holder.steps.back() = std::move(merged);
+		}
+		if (job.rebuild) job.holder.UpdateAvgWordsCount(job.fields.size());
+	} catch (const Error &err) {
+		job.err = err;
+	} catch (const std::exception &err) {
+		job.err = Error(errLogic, "%s", err.what());
+	} catch (...) {
+		job.err = Error(errLogic, "Unknown exception");
+	}
+	logPrintf(LogInfo, "FastIndexText background commit elapsed %d ms, %d docs, %d merged steps",
+			  duration_cast<milliseconds>(high_resolution_clock::now() - tm0).count(), job.docs.size(), job.mergeSteps.size());
+	job.done = true;
+}
 
-	auto status = this->holder_.status_;
+template <typename T>
+void FastIndexText<T>::publishCommitJob() {
+	unique_ptr<CommitJob> job = std::move(commitJob_);
+	job->thread.join();
+	if (!job->err.ok()) {
+		logPrintf(LogError, "Background commit of fulltext index '%s' failed: %s", this->name_, job->err.what());
+		// Updates, which were taken by the job, are lost: next commit has to rebuild all the data
+		this->tracker_.markCompleteUpdated();
+		this->isBuilt_ = false;
+		return;
+	}
 
-	if (status == CreateNew) {
-		this->holder_.cur_vdoc_pos_ = vdocs.size();
-	} else if (status == RecommitLast) {
-		vdocs.erase(vdocs.begin() + this->holder_.cur_vdoc_pos_, vdocs.end());
+	auto &vdocs = job->holder.vdocs_;
+	for (size_t i = 0; i < job->docs.size(); ++i) {
+		if (job->erased.find(job->docs[i].second) != job->erased.end()) {
+			vdocs[i].keyEntry = nullptr;
+		} else {
+			job->docs[i].second->vdoc_id_ = job->vdocsOffset + i;
+		}
+	}
+	if (job->rebuild) {
+		job->holder.searchers_.swap(this->holder_.searchers_);
+		job->holder.stemmers_.swap(this->holder_.stemmers_);
+		job->holder.SetConfig(GetConfig());
+		this->holder_ = std::move(job->holder);
+		// Documents, which were deleted during build, are counted as deleted ones
+		for (auto &vdoc : this->holder_.vdocs_) {
+			if (!vdoc.keyEntry) {
+				--this->holder_.steps.back().docsCount_;
+				++this->holder_.steps.back().deletedCount_;
+			}
+		}
+	} else {
+		auto &holder = this->holder_;
+		assert(holder.vdocs_.size() == job->vdocsOffset);
+		holder.vdocs_.insert(holder.vdocs_.end(), std::make_move_iterator(vdocs.begin()), std::make_move_iterator(vdocs.end()));
+		holder.steps.erase(holder.steps.begin() + job->mergeFrom, holder.steps.end());
+		holder.steps.emplace_back(std::move(job->holder.steps.back()));
+
+		// Documents of merged steps could be deleted, while step was built
+		auto &step = holder.steps.back();
+		size_t deleted = 0;
+		for (size_t i = step.vdocsOffset_; i < holder.vdocs_.size(); ++i) {
+			if (!holder.vdocs_[i].keyEntry) ++deleted;
+		}
+		step.docsCount_ = holder.vdocs_.size() - step.vdocsOffset_ - deleted;
+		step.deletedCount_ = deleted - job->deletedCount;
+		holder.UpdateAvgWordsCount(this->fields_.size());
 	}
-	this->holder_.vodcsOffset_ = vdocs.size();
+	this->cache_ft_->Clear();
+	termsCache_->Clear();
+}
 
-	for (auto &doc : data) {
-		// if constexpr(std::is_pointer<data>::value_type) - when we go to c++17
-#ifdef REINDEX_FT_EXTRA_DEBUG
+template <typename T>
+void FastIndexText<T>::BuildVdocs(DataHolder &holder, FieldsGetter<T> &gt, const vector<DocRef> &docs) {
+	// buffer strings, for printing non text fields
+	auto &bufStrs = holder.bufStrs_;
+	// array with pointers to docs fields text
+	// Prepare vdocs -> addresable array all docs in the index
 
-		vdocs.push_back({&GetPair(doc).first, &GetPair(doc).second, {}, {}});
-#else
+	holder.szCnt = 0;
+	auto &vdocs = holder.vdocs_;
+	auto &vdocsTexts = holder.vdocsTexts;
 
-		GetPair(doc).second.vdoc_id_ = vdocs.size();
+	vdocs.reserve(vdocs.size() + docs.size());
+	vdocsTexts.reserve(docs.size());
 
-		vdocs.push_back({&GetPair(doc).second, {}, {}});
+	holder.vodcsOffset_ = vdocs.size();
 
+	for (auto &doc : docs) {
+#ifdef REINDEX_FT_EXTRA_DEBUG
+		vdocs.push_back({&doc.first, doc.second, {}, {}});
+#else
+		vdocs.push_back({doc.second, {}, {}});
 #endif
 
-		vdocsTexts.emplace_back(gt.getDocFields(GetPair(doc).first, bufStrs));
+		vdocsTexts.emplace_back(gt.getDocFields(doc.first, bufStrs));
 
-		if (GetConfig()->logLevel <= LogInfo) {
-			for (auto &f : vdocsTexts.back()) this->holder_.szCnt += f.first.length();
+		if (holder.cfg_->logLevel <= LogInfo) {
+			for (auto &f : vdocsTexts.back()) holder.szCnt += f.first.length();
 		}
 	}
-	if (status == FullRebuild) {
-		this->holder_.cur_vdoc_pos_ = vdocs.size();
-	}
 }
 
 template <typename T>
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <thread>
 #include "core/ft/config/ftfastconfig.h"
 #include "core/ft/ft_fast/dataholder.h"
 #include "core/ft/ft_fast/dataprocessor.h"
+#include "core/ft/ft_fast/termscache.h"
 #include "core/ft/typos.h"
 #include "core/selectfunc/ctx/ftctx.h"
 #include "indextext.h"
@@ -22,20 +25,72 @@ public:
 	Index* Clone() override;
 	IdSet::Ptr Select(FtCtx::Ptr fctx, FtDSLQuery& dsl) override final;
 	void commitFulltext() override final;
+	void Commit() override final;
 	IndexMemStat GetMemStat() override;
 	Variant Upsert(const Variant& key, IdType id) override final;
 	void Delete(const Variant& key, IdType id) override final;
 
 protected:
+	// Document of fulltext index: key of index and entry with ids of items
+	typedef pair<typename T::key_type, typename T::mapped_type*> DocRef;
+
+	// Background build of fulltext data. Builder thread owns copies of all the data it uses,
+	// so index can be modified, while data are built. Job either rebuilds all the data,
+	// or builds new step and merges it with the last steps, which are not changed until the job is published
+	struct CommitJob {
+		~CommitJob() {
+			if (thread.joinable()) thread.join();
+			for (auto& doc : docs) holdStrings(payloadType, doc.first, false);
+		}
+
+		vector<DocRef> docs;
+		DataHolder holder;
+		bool rebuild;
+		// Vdoc id of the first new document
+		VDocIdType vdocsOffset;
+		// New step replaces steps [mergeFrom, steps.size()) of index
+		size_t mergeFrom;
+		vector<const DataHolder::CommitStep*> mergeSteps;
+		// Documents of merged steps, which were deleted before the job start
+		vector<bool> deleted;
+		size_t deletedCount;
+		FtFastConfig cfg;
+		PayloadType payloadType;
+		FieldsSet fields;
+		KeyValueType keyType;
+		bool multithread;
+		// Entries, which were erased from index during build
+		fast_hash_set<const void*> erased;
+		std::atomic<bool> done{false};
+		Error err;
+		std::thread thread;
+	};
+
+	bool needCommit() const override final;
+	void commitForSelect() override final;
+	void configUpdated() override final;
+	void startCommitJob();
+	void publishCommitJob();
+	static void buildCommitJob(CommitJob& job);
+
 	FtFastConfig* GetConfig() const;
 	void CreateConfig(const FtFastConfig* cfg = nullptr);
 
-	template <class Data>
-	void BuildVdocs(Data& data);
+	// Strings of composite keys are owned by items of namespace, so background job holds them, while it reads them
+	static void holdStrings(const PayloadType&, key_string&, bool) {}
+	static void holdStrings(const PayloadType& type, PayloadValue& key, bool hold) {
+		Payload pl(type, key);
+		hold ? pl.AddRefStrings() : pl.ReleaseStrings();
+	}
+	static void BuildVdocs(DataHolder& holder, FieldsGetter<T>& gt, const vector<DocRef>& docs);
 
 	void initSearchers();
 
 	const typename T::mapped_type* GetEntry(const void* entry);
+
+	unique_ptr<CommitJob> commitJob_;
+	// Found words of terms point to steps of holder, so cache is cleared, when steps are changed
+	unique_ptr<FtTermsCache> termsCache_{new FtTermsCache};
 };
 
 Index* FastIndexText_New(const IndexDef& idef, const PayloadType payloadType, const FieldsSet& fields);
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <thread>
 
 #include "fuzzyindextext.h"
 #include "tools/customlocal.h"
@@ -41,6 +42,8 @@ IdSet::Ptr FuzzyIndexText<T>::Select(FtCtx::Ptr fctx, FtDSLQuery& dsl) {
 template <typename T>
 void FuzzyIndexText<T>::commitFulltext() {
 	this->cache_ft_->Clear();
+	this->vdocs_.clear();
+	// Texts of documents are built by engine on commit, so buffers live until it
 	vector<unique_ptr<string>> bufStrs;
 	auto gt = this->Getter();
 	for (auto& doc : this->idx_map) {
@@ -54,7 +57,15 @@ void FuzzyIndexText<T>::commitFulltext() {
 			engine_.AddData(r.first, this->vdocs_.size() - 1, r.second, this->cfg_->extraWordSymbols);
 		}
 	}
-	engine_.Commit();
+	engine_.Commit(this->opts_.IsDense() ? 1 : std::thread::hardware_concurrency());
+}
+
+template <typename T>
+IndexMemStat FuzzyIndexText<T>::GetMemStat() {
+	auto ret = IndexUnordered<T>::GetMemStat();
+	ret.fulltextSize = vdocs_.capacity() * sizeof(VDocEntry) + engine_.GetMemStat();
+	if (this->cache_ft_) ret.idsetCache = this->cache_ft_->GetMemStat();
+	return ret;
 }
 template <typename T>
 FtFuzzyConfig* FuzzyIndexText<T>::GetConfig() const {
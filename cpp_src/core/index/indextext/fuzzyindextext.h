@@ -23,6 +23,7 @@ public:
 	Index* Clone() override;
 	IdSet::Ptr Select(FtCtx::Ptr fctx, FtDSLQuery& dsl) override final;
 	void commitFulltext() override final;
+	IndexMemStat GetMemStat() override;
 	Variant Upsert(const Variant& key, IdType id) override final {
 		this->isBuilt_ = false;
 		return IndexText<T>::Upsert(key, id);
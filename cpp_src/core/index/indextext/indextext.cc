@@ -66,6 +66,7 @@ void IndexText<T>::SetOpts(const IndexOpts &opts) {
 	if (oldCfg != opts.config) {
 		auto newCfg = this->opts_.config;
 		cfg_->parse(&newCfg[0]);
+		configUpdated();
 	}
 }
 
@@ -82,7 +83,8 @@ SelectKeyResults IndexText<T>::SelectKey(const VariantArray &keys, CondType cond
 	ftctx->PrepareAreas(ftFields_, this->name_);
 
 	bool need_put = false;
-	auto cache_ft = cache_ft_->Get(IdSetCacheKey{keys, condition, 0});
+	// Results of top K select contain only the best documents: they are cached separately for each K
+	auto cache_ft = cache_ft_->Get(IdSetCacheKey{keys, condition, SortType(ftctx->TopK())});
 	SelectKeyResult res;
 	if (cache_ft.key) {
 		if (!cache_ft.val.ids->size() || (ftctx->NeedArea() && !cache_ft.val.ctx->need_area_)) {
@@ -108,14 +110,13 @@ SelectKeyResults IndexText<T>::SelectKey(const VariantArray &keys, CondType cond
 	dsl.parse(keys[0].As<string>());
 
 	smart_lock<shared_timed_mutex> lck(mtx_);
-	if (!isBuilt_) {
+	if (needCommit()) {
 		// non atomic upgrade mutex to unique
 		lck.unlock();
 		lck = smart_lock<shared_timed_mutex>(mtx_, true);
-		if (!isBuilt_) {
-			commitFulltext();
+		if (needCommit()) {
+			commitForSelect();
 			need_put = false;
-			isBuilt_ = true;
 		}
 	}
 
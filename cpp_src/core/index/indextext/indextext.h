@@ -36,11 +36,20 @@ public:
 	void UpdateSortedIds(const UpdateSortedContext&) override {}
 	virtual IdSet::Ptr Select(FtCtx::Ptr fctx, FtDSLQuery& dsl) = 0;
 	void SetOpts(const IndexOpts& opts) override final;
-	void Commit() override final;
+	void Commit() override;
 	virtual void commitFulltext() = 0;
 	void SetSortedIdxCount(int) override final{};
 
 protected:
+	// Returns true, if fulltext data have to be committed before select. Called with shared lock of mtx_
+	virtual bool needCommit() const { return !isBuilt_; }
+	// Commits fulltext data before select. Called with unique lock of mtx_
+	virtual void commitForSelect() {
+		commitFulltext();
+		isBuilt_ = true;
+	}
+	// Found documents depend on config, so cached results are cleared, when config is changed
+	virtual void configUpdated() { cache_ft_->Clear(); }
 	void initSearchers();
 	FieldsGetter<T> Getter();
 
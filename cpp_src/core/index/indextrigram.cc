@@ -0,0 +1,181 @@
+#include "indextrigram.h"
+#include <algorithm>
+#include "tools/customlocal.h"
+#include "tools/errors.h"
+#include "tools/stringstools.h"
+
+namespace reindexer {
+
+// Trigrams are built from case folded strings, the same way as LIKE pattern matching ignores case
+static string foldCase(string_view str, CollateMode mode) {
+	switch (mode) {
+		case CollateASCII:
+			return lower(str.ToString());
+		case CollateUTF8: {
+			wstring wstr;
+			utf8_to_utf16(str, wstr);
+			ToLower(wstr);
+			return utf16_to_utf8(wstr);
+		}
+		default:
+			return str.ToString();
+	}
+}
+
+// Appends trigrams of bytes of str
+static void addTrigrams(string_view str, h_vector<uint32_t, 16> &trigrams) {
+	for (size_t i = 0; i + 3 <= str.size(); ++i) {
+		trigrams.push_back((uint32_t(uint8_t(str[i])) << 16) | (uint32_t(uint8_t(str[i + 1])) << 8) | uint32_t(uint8_t(str[i + 2])));
+	}
+}
+
+static void sortUnique(h_vector<uint32_t, 16> &trigrams) {
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+TrigramStrMap::iterator IndexTrigram::findKey(const Variant &key) {
+	p_string skey(key);
+	tmpKeyVal_->assign(skey.data(), skey.length());
+	return idx_map.find(tmpKeyVal_);
+}
+
+Variant IndexTrigram::Upsert(const Variant &key, IdType id) {
+	if (key.Type() == KeyValueNull) return IndexUnordered<TrigramStrMap>::Upsert(key, id);
+
+	bool isNew = findKey(key) == idx_map.end();
+	Variant ret = IndexUnordered<TrigramStrMap>::Upsert(key, id);
+	if (isNew) {
+		auto keyIt = findKey(key);
+		addKey(keyIt->second, keyIt->first);
+	}
+	return ret;
+}
+
+void IndexTrigram::Delete(const Variant &key, IdType id) {
+	if (key.Type() == KeyValueNull) return IndexUnordered<TrigramStrMap>::Delete(key, id);
+
+	auto keyIt = findKey(key);
+	if (keyIt == idx_map.end()) return;
+	// Base class may release string of key, so the key is held by own reference
+	key_string keyStr = keyIt->first;
+	uint32_t keyId = keyIt->second.keyId_;
+	IndexUnordered<TrigramStrMap>::Delete(key, id);
+	if (idx_map.find(keyStr) == idx_map.end()) removeKey(keyId);
+}
+
+void IndexTrigram::addKey(TrigramKeyEntry &entry, const key_string &key) {
+	if (freeKeyIds_.size()) {
+		entry.keyId_ = freeKeyIds_.back();
+		freeKeyIds_.pop_back();
+		keys_[entry.keyId_] = key;
+	} else {
+		entry.keyId_ = keys_.size();
+		keys_.push_back(key);
+	}
+
+	h_vector<uint32_t, 16> trigrams;
+	addTrigrams(foldCase(*key, opts_.GetCollateMode()), trigrams);
+	sortUnique(trigrams);
+	for (uint32_t trigram : trigrams) {
+		auto &posting = postings_[trigram];
+		posting.insert(std::lower_bound(posting.begin(), posting.end(), entry.keyId_), entry.keyId_);
+	}
+}
+
+void IndexTrigram::removeKey(uint32_t keyId) {
+	h_vector<uint32_t, 16> trigrams;
+	addTrigrams(foldCase(*keys_[keyId], opts_.GetCollateMode()), trigrams);
+	sortUnique(trigrams);
+	for (uint32_t trigram : trigrams) {
+		auto postingIt = postings_.find(trigram);
+		assertf(postingIt != postings_.end(), "Trigram of key is not indexed in '%s'", name_.c_str());
+		auto &posting = postingIt.value();
+		auto it = std::lower_bound(posting.begin(), posting.end(), keyId);
+		if (it != posting.end() && *it == keyId) posting.erase(it);
+		if (posting.empty()) postings_.erase(postingIt);
+	}
+	keys_[keyId] = key_string();
+	freeKeyIds_.push_back(keyId);
+}
+
+vector<uint32_t> IndexTrigram::candidates(const string &pattern) const {
+	// Trigrams of literal parts between wildcards
+	h_vector<uint32_t, 16> trigrams;
+	string_view rest(pattern);
+	while (rest.size()) {
+		size_t pos = rest.find_first_of("%_", 0);
+		addTrigrams(rest.substr(0, pos), trigrams);
+		if (pos == string_view::npos) break;
+		rest = rest.substr(pos + 1);
+	}
+	sortUnique(trigrams);
+
+	vector<uint32_t> res;
+	if (trigrams.empty()) {
+		// Pattern is too short to use trigrams, all keys are candidates
+		res.reserve(idx_map.size());
+		for (uint32_t keyId = 0; keyId < keys_.size(); ++keyId) {
+			if (keys_[keyId]) res.push_back(keyId);
+		}
+		return res;
+	}
+
+	h_vector<const vector<uint32_t> *, 16> postings;
+	for (uint32_t trigram : trigrams) {
+		auto it = postings_.find(trigram);
+		if (it == postings_.end()) return res;
+		postings.push_back(&it->second);
+	}
+	// Intersection starts from the shortest posting list
+	std::sort(postings.begin(), postings.end(),
+			  [](const vector<uint32_t> *l, const vector<uint32_t> *r) { return l->size() < r->size(); });
+	res = *postings[0];
+	for (size_t i = 1; i < postings.size() && res.size(); ++i) {
+		auto end = std::set_intersection(res.begin(), res.end(), postings[i]->begin(), postings[i]->end(), res.begin());
+		res.erase(end, res.end());
+	}
+	return res;
+}
+
+SelectKeyResults IndexTrigram::SelectKey(const VariantArray &keys, CondType condition, SortType sortId, Index::ResultType res_type,
+										 BaseFunctionCtx::Ptr ctx) {
+	if (condition != CondLike || res_type == Index::ForceComparator) {
+		return IndexUnordered<TrigramStrMap>::SelectKey(keys, condition, sortId, res_type, ctx);
+	}
+	if (keys.size() != 1) throw Error(errParams, "Condition LIKE requires exactly 1 argument, but provided %d", keys.size());
+
+	const CollateMode mode = opts_.GetCollateMode();
+	const string pattern = keys[0].As<string>();
+	auto selector = [this, &pattern, mode, sortId](SelectKeyResult &res) {
+		for (uint32_t keyId : candidates(foldCase(pattern, mode))) {
+			const key_string &key = keys_[keyId];
+			if (!matchLikePattern(*key, pattern, mode)) continue;
+			auto keyIt = idx_map.find(key);
+			assert(keyIt != idx_map.end());
+			res.push_back(SingleSelectKeyResult(keyIt->second, sortId));
+		}
+	};
+
+	SelectKeyResult res;
+	if (res_type != Index::ForceIdset && res_type != Index::DisableIdSetCache)
+		tryIdsetCache(keys, condition, sortId, selector, res);
+	else
+		selector(res);
+	return SelectKeyResults(res);
+}
+
+Index *IndexTrigram::Clone() { return new IndexTrigram(*this); }
+
+IndexMemStat IndexTrigram::GetMemStat() {
+	IndexMemStat ret = IndexUnordered<TrigramStrMap>::GetMemStat();
+	ret.columnSize += keys_.capacity() * sizeof(key_string) + freeKeyIds_.capacity() * sizeof(uint32_t);
+	for (auto &posting : postings_) ret.columnSize += sizeof(posting) + posting.second.capacity() * sizeof(uint32_t);
+	return ret;
+}
+
+Index *IndexTrigram_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields) {
+	return new IndexTrigram(idef, payloadType, fields);
+}
+
+}  // namespace reindexer
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/index/indexunordered.h"
+#include "estl/fast_hash_map.h"
+
+namespace reindexer {
+
+class TrigramKeyEntry : public KeyEntry<IdSet> {
+public:
+	// Id of key in trigram posting lists
+	uint32_t keyId_ = 0;
+};
+
+typedef fast_str_map<TrigramKeyEntry> TrigramStrMap;
+
+// Hash index for strings with additional trigram posting lists over distinct keys.
+// LIKE patterns without literal prefix (substring search) are selected by intersection of posting lists of pattern's trigrams,
+// then only candidate keys are checked by pattern. Other conditions are processed as by usual hash index
+class IndexTrigram : public IndexUnordered<TrigramStrMap> {
+public:
+	IndexTrigram(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields)
+		: IndexUnordered<TrigramStrMap>(idef, payloadType, fields) {}
+
+	Variant Upsert(const Variant &key, IdType id) override;
+	void Delete(const Variant &key, IdType id) override;
+	SelectKeyResults SelectKey(const VariantArray &keys, CondType condition, SortType stype, Index::ResultType res_type,
+							   BaseFunctionCtx::Ptr ctx) override;
+	Index *Clone() override;
+	IndexMemStat GetMemStat() override;
+
+protected:
+	TrigramStrMap::iterator findKey(const Variant &key);
+	void addKey(TrigramKeyEntry &entry, const key_string &key);
+	void removeKey(uint32_t keyId);
+	// Ids of keys, which contain all trigrams of pattern's literal parts
+	vector<uint32_t> candidates(const string &pattern) const;
+
+	// Keys by id. Ids of erased keys are reused
+	vector<key_string> keys_;
+	vector<uint32_t> freeKeyIds_;
+	// Sorted ids of keys, which contain trigram
+	fast_hash_map<uint32_t, vector<uint32_t>> postings_;
+};
+
+Index *IndexTrigram_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields);
+
+}  // namespace reindexer
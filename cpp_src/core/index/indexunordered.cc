@@ -1,10 +1,18 @@
 #include "indexunordered.h"
+#include <cstring>
 #include "core/ft/ft_fast/ftfastkeyentry.h"
+#include "core/index/indextrigram.h"
 #include "core/indexdef.h"
 #include "tools/errors.h"
 #include "tools/logger.h"
 namespace reindexer {
 
+// Sets of keys with more idsets are merged to single idset, if average size of idset is small
+constexpr size_t kMinIdsetsToMerge = 16;
+constexpr size_t kMaxAvgIdsetSizeToMerge = 64;
+// Larger sets of keys are checked by comparator, if their idsets are not merged
+constexpr size_t kMaxKeysToSelectIdsets = 1000;
+
 template <typename T>
 Variant IndexUnordered<T>::Upsert(const Variant &key, IdType id) {
 	// reset cache
@@ -17,6 +25,7 @@ Variant IndexUnordered<T>::Upsert(const Variant &key, IdType id) {
 	auto keyIt = find(key);
 	if (keyIt == this->idx_map.end()) {
 		keyIt = this->idx_map.insert({static_cast<typename T::key_type>(key), typename T::mapped_type()}).first;
+		if (this->opts_.IsBloom()) addToBloom(key);
 	}
 	keyIt->second.Unsorted().Add(id, this->opts_.IsPK() ? IdSet::Ordered : IdSet::Auto, this->sortedIdxCount_);
 	markUpdated(&*keyIt);
@@ -49,6 +58,7 @@ void IndexUnordered<T>::Delete(const Variant &key, IdType id) {
 	if (keyIt->second.Unsorted().IsEmpty()) {
 		this->tracker_.markDeleted(&*keyIt);
 		idx_map.erase(keyIt);
+		if (this->opts_.IsBloom()) removeFromBloom();
 	} else {
 		markUpdated(&*keyIt);
 	}
@@ -75,10 +85,63 @@ typename T::iterator IndexUnordered<T>::find(const Variant &key) {
 
 template <typename T>
 IdSetRef IndexUnordered<T>::Find(const Variant &key) {
+	if (!MayContain(key)) return IdSetRef();
 	auto res = this->find(key);
 	return (res != idx_map.end()) ? res->second.Sorted(0) : IdSetRef();
 }
 
+template <typename T>
+bool IndexUnordered<T>::MayContain(const Variant &key) const {
+	if (!this->opts_.IsBloom() || key.Type() == KeyValueNull) return true;
+	if (bloom_.Empty()) return !idx_map.empty();
+	return bloom_.MayContain(bloomHash(key));
+}
+
+// Hash of key of index type. Keys, which are equal by collate rules, have equal hashes
+template <typename T>
+uint64_t IndexUnordered<T>::bloomHash(const Variant &key) const {
+	switch (key.Type()) {
+		case KeyValueInt:
+		case KeyValueInt64:
+			return BloomFilter::Mix(key.As<int64_t>());
+		case KeyValueDouble: {
+			// +0.0 and -0.0 are equal keys
+			double v = static_cast<double>(key);
+			if (v == 0.0) v = 0.0;
+			uint64_t bits;
+			memcpy(&bits, &v, sizeof(bits));
+			return BloomFilter::Mix(bits);
+		}
+		case KeyValueString:
+			return BloomFilter::Mix(collateHash(string_view(key), this->opts_.GetCollateMode()));
+		default:
+			return BloomFilter::Mix(collateHash(key.As<string>(), CollateNone));
+	}
+}
+
+template <typename T>
+void IndexUnordered<T>::addToBloom(const Variant &key) {
+	if (bloom_.KeysCount() >= bloom_.Capacity()) {
+		rebuildBloom();
+	} else {
+		bloom_.Add(bloomHash(key));
+	}
+}
+
+template <typename T>
+void IndexUnordered<T>::removeFromBloom() {
+	// Deleted keys can't be removed from filter, they only increase false positive rate
+	if (++bloomDeletedCount_ * 2 > bloom_.Capacity()) rebuildBloom();
+}
+
+template <typename T>
+void IndexUnordered<T>::rebuildBloom() {
+	static constexpr size_t kMinBloomKeys = 1024;
+	bloom_.Reset(std::max<size_t>(idx_map.size() * 2, kMinBloomKeys));
+	for (auto &keyIt : idx_map) bloom_.Add(bloomHash(Variant(keyIt.first)));
+	bloomDeletedCount_ = 0;
+}
+
 template <typename T>
 void IndexUnordered<T>::tryIdsetCache(const VariantArray &keys, CondType condition, SortType sortId,
 									  std::function<void(SelectKeyResult &)> selector, SelectKeyResult &res) {
@@ -122,34 +185,56 @@ SelectKeyResults IndexUnordered<T>::SelectKey(const VariantArray &keys, CondType
 			break;
 		// Get set of keys or single key
 		case CondEq:
-		case CondSet:
+		case CondSet: {
 			if (condition == CondEq && keys.size() < 1)
 				throw Error(errParams, "For condition required at least 1 argument, but provided 0");
-			if (keys.size() > 1000 && res_type != Index::ForceIdset) {
-				return IndexStore<typename T::key_type>::SelectKey(keys, condition, sortId, res_type, ctx);
-			} else {
-				struct {
-					T *i_map;
-					const VariantArray &keys;
-					SortType sortId;
-				} ctx = {&this->idx_map, keys, sortId};
-				auto selector = [&ctx](SelectKeyResult &res) {
-					res.reserve(ctx.keys.size());
-					for (auto key : ctx.keys) {
-						auto keyIt = ctx.i_map->find(static_cast<typename T::key_type>(key));
-						if (keyIt != ctx.i_map->end()) {
-							res.push_back(SingleSelectKeyResult(keyIt->second, ctx.sortId));
-						}
+			// Keys, which are absent in bloom filter, are not looked up
+			const VariantArray *presentKeys = &keys;
+			VariantArray bloomKeys;
+			if (this->opts_.IsBloom()) {
+				for (const Variant &key : keys) {
+					if (MayContain(key)) bloomKeys.push_back(key);
+				}
+				if (bloomKeys.empty()) break;
+				if (bloomKeys.size() < keys.size()) presentKeys = &bloomKeys;
+			}
+			const VariantArray &selectKeys = *presentKeys;
+			struct {
+				T *i_map;
+				const VariantArray &keys;
+				SortType sortId;
+				bool mergeIdsets;
+			} sctx = {&this->idx_map, selectKeys, sortId, res_type != Index::ForceIdset};
+			auto selector = [&sctx](SelectKeyResult &res) {
+				res.reserve(sctx.keys.size());
+				size_t idsCount = 0;
+				for (auto key : sctx.keys) {
+					auto keyIt = sctx.i_map->find(static_cast<typename T::key_type>(key));
+					if (keyIt != sctx.i_map->end()) {
+						res.push_back(SingleSelectKeyResult(keyIt->second, sctx.sortId));
+						idsCount += keyIt->second.Unsorted().Count();
 					}
-				};
+				}
+				// Select loop looks for minimal id over all idsets for each row: many small idsets are merged to single idset once
+				if (sctx.mergeIdsets && res.size() > kMinIdsetsToMerge && idsCount <= res.size() * kMaxAvgIdsetSizeToMerge) {
+					res.mergeIdsets();
+				}
+			};
 
+			if (selectKeys.size() > kMaxKeysToSelectIdsets && res_type != Index::ForceIdset) {
+				// Large set of keys with large idsets is cheaper to check by comparator
+				selector(res);
+				if (res.size() > kMinIdsetsToMerge) {
+					return IndexStore<typename T::key_type>::SelectKey(selectKeys, condition, sortId, res_type, ctx);
+				}
+			} else if (res_type != Index::ForceIdset && res_type != Index::DisableIdSetCache && selectKeys.size() > 1) {
 				// Get from cache
-				if (res_type != Index::ForceIdset && res_type != Index::DisableIdSetCache && keys.size() > 1) {
-					tryIdsetCache(keys, condition, sortId, selector, res);
-				} else
-					selector(res);
+				tryIdsetCache(selectKeys, condition, sortId, selector, res);
+			} else {
+				selector(res);
 			}
 			break;
+		}
 		case CondAllSet: {
 			// Get set of key, where all request keys are present
 			SelectKeyResults rslts;
@@ -173,6 +258,7 @@ SelectKeyResults IndexUnordered<T>::SelectKey(const VariantArray &keys, CondType
 		case CondRange:
 		case CondGt:
 		case CondLt:
+		case CondLike:
 			return IndexStore<typename T::key_type>::SelectKey(keys, condition, sortId, res_type, ctx);
 		default:
 			throw Error(errQueryExec, "Unknown query on index '%s'", this->name_);
@@ -244,6 +330,7 @@ IndexMemStat IndexUnordered<T>::GetMemStat() {
 	ret.uniqKeysCount = idx_map.size();
 	ret.sortOrdersSize = this->sortOrders_.capacity();
 	if (cache_) ret.idsetCache = cache_->GetMemStat();
+	ret.bloomFilterSize = bloom_.HeapSize();
 	getMemStat(ret);
 	for (auto &it : idx_map) {
 		ret.idsetPlainSize += sizeof(it.second) + it.second.ids_.heap_size();
@@ -268,13 +355,13 @@ template <typename KeyEntryT>
 static Index *IndexUnordered_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields) {
 	switch (idef.Type()) {
 		case IndexIntHash:
-			return new IndexUnordered<unordered_map<int, KeyEntryT>>(idef, payloadType, fields);
+			return new IndexUnordered<fast_number_map<int, KeyEntryT>>(idef, payloadType, fields);
 		case IndexInt64Hash:
-			return new IndexUnordered<unordered_map<int64_t, KeyEntryT>>(idef, payloadType, fields);
+			return new IndexUnordered<fast_number_map<int64_t, KeyEntryT>>(idef, payloadType, fields);
 		case IndexStrHash:
-			return new IndexUnordered<unordered_str_map<KeyEntryT>>(idef, payloadType, fields);
+			return new IndexUnordered<fast_str_map<KeyEntryT>>(idef, payloadType, fields);
 		case IndexCompositeHash:
-			return new IndexUnordered<unordered_payload_map<KeyEntryT>>(idef, payloadType, fields);
+			return new IndexUnordered<fast_payload_map<KeyEntryT>>(idef, payloadType, fields);
 		default:
 			abort();
 	}
@@ -300,6 +387,9 @@ template class IndexUnordered<str_map<Index::KeyEntry>>;
 template class IndexUnordered<payload_map<Index::KeyEntry>>;
 template class IndexUnordered<FtStrMap>;
 template class IndexUnordered<FtPlMap>;
+template class IndexUnordered<TrigramStrMap>;
+template class IndexUnordered<unordered_str_map<Index::KeyEntryPlain>>;
+template class IndexUnordered<unordered_payload_map<Index::KeyEntryPlain>>;
 
 template typename FtStrMap::iterator IndexUnordered<FtStrMap>::find(const Variant &key);
 template typename FtPlMap::iterator IndexUnordered<FtPlMap>::find(const Variant &key);
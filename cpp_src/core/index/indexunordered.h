@@ -3,7 +3,9 @@
 #include <functional>
 #include <type_traits>
 #include "core/idsetcache.h"
+#include "core/index/bloomfilter.h"
 #include "core/index/indexstore.h"
+#include "core/index/number_map.h"
 #include "core/index/payload_map.h"
 #include "core/index/string_map.h"
 #include "core/index/updatetracker.h"
@@ -58,6 +60,7 @@ public:
 	IndexMemStat GetMemStat() override;
 	size_t Size() const override final { return idx_map.size(); }
 	IdSetRef Find(const Variant &key) override final;
+	bool MayContain(const Variant &key) const override final;
 	void SetSortedIdxCount(int sortedIdxCount) override {
 		if (this->sortedIdxCount_ != sortedIdxCount) {
 			this->sortedIdxCount_ = sortedIdxCount;
@@ -67,6 +70,10 @@ public:
 
 protected:
 	void markUpdated(typename T::value_type *key);
+	uint64_t bloomHash(const Variant &key) const;
+	void addToBloom(const Variant &key);
+	void removeFromBloom();
+	void rebuildBloom();
 	void tryIdsetCache(const VariantArray &keys, CondType condition, SortType sortId, std::function<void(SelectKeyResult &)> selector,
 					   SelectKeyResult &res);
 
@@ -88,6 +95,10 @@ protected:
 	Index::KeyEntry empty_ids_;
 	// Tracker of updates
 	UpdateTracker<T> tracker_;
+	// Bloom filter of keys, is used only with 'bloom' option. Filter is rebuilt, when it's overfilled or contains too many deleted keys
+	BloomFilter bloom_;
+	// Count of keys, which are deleted from index, but are still set in bloom filter
+	size_t bloomDeletedCount_ = 0;
 };
 
 Index *IndexUnordered_New(const IndexDef &idef, const PayloadType payloadType, const FieldsSet &fields);
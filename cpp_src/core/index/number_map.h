@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include "hopscotch/hopscotch_map.h"
+
+namespace reindexer {
+
+// Hash map takes bucket by low bits of hash, so bits of key are mixed: keys like id * 1024 must not get into the same buckets
+struct hash_number {
+	size_t operator()(int64_t v) const noexcept {
+		uint64_t h = v;
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		return h;
+	}
+};
+
+// Open addressing map for int and int64 keys. Insert invalidates references to elements
+template <typename K, typename T1>
+using fast_number_map = tsl::hopscotch_map<K, T1, hash_number>;
+
+}  // namespace reindexer
@@ -6,6 +6,7 @@
 #include "core/payload/fieldsset.h"
 #include "core/payload/payloadiface.h"
 #include "cpp-btree/btree_map.h"
+#include "hopscotch/hopscotch_map.h"
 
 namespace reindexer {
 
@@ -57,11 +58,18 @@ using unordered_payload_map = unordered_map<PayloadValue, T1, hash_composite, eq
 template <typename T1>
 using payload_map = btree_map<PayloadValue, T1, less_composite>;
 using unordered_payload_set = unordered_set<PayloadValue, hash_composite, equal_composite>;
+// Open addressing map. 32 bits of hash are stored in bucket, so hash of composite key is calculated once on insert and once
+// on lookup, and equal_composite is called only for keys with the same hash. Insert invalidates references to elements
+template <typename T1>
+using fast_payload_map =
+	tsl::hopscotch_map<PayloadValue, T1, hash_composite, equal_composite, std::allocator<std::pair<PayloadValue, T1>>, 30, true>;
 
 template <typename T>
 struct is_payload_unord_map_key : std::false_type {};
 template <typename T1>
 struct is_payload_unord_map_key<unordered_payload_map<T1>> : std::true_type {};
+template <typename T1>
+struct is_payload_unord_map_key<fast_payload_map<T1>> : std::true_type {};
 template <typename T>
 struct is_payload_map_key : std::false_type {};
 template <typename T1>
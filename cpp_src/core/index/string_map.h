@@ -4,6 +4,7 @@
 #include "core/keyvalue/key_string.h"
 #include "cpp-btree/btree_map.h"
 #include "estl/intrusive_ptr.h"
+#include "hopscotch/hopscotch_map.h"
 #include "tools/customhash.h"
 #include "tools/customlocal.h"
 #include "tools/errors.h"
@@ -42,11 +43,17 @@ template <typename T1>
 using unordered_str_map = unordered_map<key_string, T1, hash_sptr, equal_sptr>;
 template <typename T1>
 using str_map = btree_map<key_string, T1, comparator_sptr>;
+// Open addressing map. 32 bits of hash are stored in bucket: collate aware equal_sptr is called only for keys with the same hash,
+// and hashes are not recalculated on rehash. Insert invalidates references to elements
+template <typename T1>
+using fast_str_map = tsl::hopscotch_map<key_string, T1, hash_sptr, equal_sptr, std::allocator<std::pair<key_string, T1>>, 30, true>;
 
 template <typename T>
 struct is_string_unord_map_key : std::false_type {};
 template <typename T1>
 struct is_string_unord_map_key<unordered_str_map<T1>> : std::true_type {};
+template <typename T1>
+struct is_string_unord_map_key<fast_str_map<T1>> : std::true_type {};
 template <typename T>
 struct is_string_map_key : std::false_type {};
 template <typename T1>
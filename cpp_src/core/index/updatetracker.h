@@ -21,11 +21,29 @@ struct is_safe_iterators_map<std::unordered_map<K, V, H, E, A>> : std::true_type
 template <typename T1>
 struct is_safe_iterators_map<unordered_str_map<T1>> : std::true_type {};
 
+// Btree composite maps are not tracked: each commit is complete
+template <typename T>
+struct is_untracked_map : is_payload_map_key<T> {};
+
+// Composite keys can't be hashed without payload type. So updated keys of composite maps, which invalidate references on insert,
+// are identified by their payload data: the copy of key holds the data of map entry until commit
+struct hash_payload_data {
+	size_t operator()(const PayloadValue &v) const { return std::hash<const uint8_t *>()(v.Ptr()); }
+};
+struct equal_payload_data {
+	bool operator()(const PayloadValue &lhs, const PayloadValue &rhs) const { return lhs.Ptr() == rhs.Ptr(); }
+};
+
+template <typename T>
+using updated_keys_set = typename std::conditional<is_payload_unord_map_key<T>::value,
+												   fast_hash_set<typename T::key_type, hash_payload_data, equal_payload_data>,
+												   fast_hash_set<typename T::key_type>>::type;
+
 template <typename T>
 class UpdateTracker {
 public:
-	using hash_map = typename std::conditional<is_safe_iterators_map<T>::value || is_payload_map_key<T>::value,
-											   fast_hash_set<typename T::value_type *>, fast_hash_set<typename T::key_type>>::type;
+	using hash_map = typename std::conditional<is_safe_iterators_map<T>::value || is_untracked_map<T>::value,
+											   fast_hash_set<typename T::value_type *>, updated_keys_set<T>>::type;
 
 	UpdateTracker() = default;
 	UpdateTracker(const UpdateTracker<T> &other) : completeUpdate_(other.updated_.size() || other.completeUpdate_) {}
@@ -38,7 +56,7 @@ public:
 	// Safe iterators implementation:
 	// Store pointers to keys, which already in the index map
 
-	template <typename U = T, typename std::enable_if<is_safe_iterators_map<U>::value && !is_payload_map_key<T>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<is_safe_iterators_map<U>::value && !is_untracked_map<T>::value>::type * = nullptr>
 	void markUpdated(T &idx_map, typename T::value_type *k) {
 		if (completeUpdate_) return;
 		if (updated_.size() > idx_map.size() / 2) {
@@ -51,7 +69,7 @@ public:
 
 	// Unsafe iterators implementation:
 	// Store copy key values
-	template <typename U = T, typename std::enable_if<!is_safe_iterators_map<U>::value && !is_payload_map_key<U>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<!is_safe_iterators_map<U>::value && !is_untracked_map<U>::value>::type * = nullptr>
 	void markUpdated(T &idx_map, typename T::value_type *k) {
 		if (completeUpdate_) return;
 		if (updated_.size() > static_cast<size_t>(idx_map.size() / 8)) {
@@ -62,12 +80,12 @@ public:
 		updated_.emplace(k->first);
 	}
 
-	template <typename U = T, typename std::enable_if<is_payload_map_key<U>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<is_untracked_map<U>::value>::type * = nullptr>
 	void markUpdated(T &, typename T::value_type *) {
 		completeUpdate_ = true;
 	}
 
-	template <typename U = T, typename std::enable_if<is_safe_iterators_map<U>::value && !is_payload_map_key<U>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<is_safe_iterators_map<U>::value && !is_untracked_map<U>::value>::type * = nullptr>
 	void commitUpdated(T &) {
 		for (auto keyIt : updated_) {
 			keyIt->second.Unsorted().Commit();
@@ -75,7 +93,7 @@ public:
 		}
 	}
 
-	template <typename U = T, typename std::enable_if<!is_safe_iterators_map<U>::value && !is_payload_map_key<U>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<!is_safe_iterators_map<U>::value && !is_untracked_map<U>::value>::type * = nullptr>
 	void commitUpdated(T &idx_map) {
 		for (auto valIt : updated_) {
 			auto keyIt = idx_map.find(valIt);
@@ -85,22 +103,27 @@ public:
 		}
 	}
 
-	template <typename U = T, typename std::enable_if<is_payload_map_key<U>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<is_untracked_map<U>::value>::type * = nullptr>
 	void commitUpdated(T &) {}
 
-	template <typename U = T, typename std::enable_if<is_safe_iterators_map<U>::value && !is_payload_map_key<T>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<is_safe_iterators_map<U>::value && !is_untracked_map<T>::value>::type * = nullptr>
 	void markDeleted(typename T::value_type *k) {
 		updated_.erase(k);
 	}
 
-	template <typename U = T, typename std::enable_if<!is_safe_iterators_map<U>::value && !is_payload_map_key<U>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<!is_safe_iterators_map<U>::value && !is_untracked_map<U>::value>::type * = nullptr>
 	void markDeleted(typename T::value_type *k) {
 		updated_.erase(k->first);
 	}
 
-	template <typename U = T, typename std::enable_if<is_payload_map_key<U>::value>::type * = nullptr>
+	template <typename U = T, typename std::enable_if<is_untracked_map<U>::value>::type * = nullptr>
 	void markDeleted(typename T::value_type *) {}
 
+	void markCompleteUpdated() {
+		updated_.clear();
+		completeUpdate_ = true;
+	}
+
 	bool isUpdated() const { return !updated_.empty() || completeUpdate_; }
 	bool isCompleteUpdated() const { return completeUpdate_; }
 	void clear() {
@@ -18,25 +18,33 @@ struct IndexInfo {
 };
 
 const vector<string> condsUsual = {"SET", "EQ", "ANY", "EMPTY", "LT", "LE", "GT", "GE", "RANGE"};
+const vector<string> condsStr = {"SET", "EQ", "ANY", "EMPTY", "LT", "LE", "GT", "GE", "RANGE", "LIKE"};
 const vector<string> condsText = {"MATCH"};
 const vector<string> condsBool = {"SET", "EQ", "ANY", "EMPTY"};
+const vector<string> condsGeo = {"DWITHIN", "INBOX"};
 
 // clang-format off
 std::unordered_map<IndexType, IndexInfo,std::hash<int>,std::equal_to<int> > availableIndexes = {
 	{IndexIntHash,		    {"int",       "hash",    condsUsual,CapSortable}},
 	{IndexInt64Hash,	    {"int64",     "hash",    condsUsual,CapSortable}},
-	{IndexStrHash,		    {"string",    "hash",    condsUsual,CapSortable}},
+	{IndexStrHash,		    {"string",    "hash",    condsStr,  CapSortable}},
 	{IndexCompositeHash,    {"composite", "hash",    condsUsual,CapSortable|CapComposite}},
 	{IndexIntBTree,		    {"int",       "tree",    condsUsual,CapSortable}},
 	{IndexInt64BTree,	    {"int64",     "tree",    condsUsual,CapSortable}},
 	{IndexDoubleBTree,	    {"double",    "tree",    condsUsual,CapSortable}},
 	{IndexCompositeBTree,   {"composite", "tree",    condsUsual,CapComposite|CapSortable}},
-	{IndexStrBTree,		    {"string",    "tree",    condsUsual,CapSortable}},
+	{IndexStrBTree,		    {"string",    "tree",    condsStr,  CapSortable}},
 	{IndexIntStore,		    {"int",       "-",       condsUsual,CapSortable}},
 	{IndexBool,			    {"bool",      "-",       condsBool, 0}},
 	{IndexInt64Store,	    {"int64",     "-",       condsUsual,CapSortable}},
-	{IndexStrStore,		    {"string",    "-",       condsUsual,CapSortable}},
+	{IndexStrStore,		    {"string",    "-",       condsStr,  CapSortable}},
 	{IndexDoubleStore,	    {"double",    "-",       condsUsual,CapSortable}},
+	{IndexBoolBitmap,	    {"bool",      "bitmap",  condsBool, 0}},
+	{IndexIntBitmap,	    {"int",       "bitmap",  condsUsual,CapSortable}},
+	{IndexInt64Bitmap,	    {"int64",     "bitmap",  condsUsual,CapSortable}},
+	{IndexStrBitmap,	    {"string",    "bitmap",  condsStr,  CapSortable}},
+	{IndexCompositeGeo,     {"composite", "geo",     condsGeo,  CapComposite|CapSortable}},
+	{IndexStrTrigram,       {"string",    "trigram", condsStr,  CapSortable}},
 	{IndexCompositeFastFT,  {"composite", "text",    condsText, CapComposite|CapFullText}},
 	{IndexCompositeFuzzyFT, {"composite", "fuzzytext",condsText, CapComposite|CapFullText}},
 	{IndexFastFT,           {"string",    "text",    condsText, CapFullText}},
@@ -69,7 +77,7 @@ IndexDef::IndexDef(const string &name, const JsonPaths &jsonPaths, const IndexTy
 
 bool IndexDef::IsEqual(const IndexDef &other, bool skipConfig) const {
 	return name_ == other.name_ && jsonPaths_ == other.jsonPaths_ && Type() == other.Type() && fieldType_ == other.fieldType_ &&
-		   opts_.IsEqual(other.opts_, skipConfig);
+		   opts_.IsEqual(other.opts_, skipConfig) && filter_ == other.filter_;
 }
 
 IndexType IndexDef::Type() const {
@@ -94,8 +102,10 @@ void IndexDef::FromType(IndexType type) {
 
 const vector<string> &IndexDef::Conditions() const { return availableIndexes.find(Type())->second.conditions; }
 bool isComposite(IndexType type) {
-	return type == IndexCompositeBTree || type == IndexCompositeFastFT || type == IndexCompositeFuzzyFT || type == IndexCompositeHash;
+	return type == IndexCompositeBTree || type == IndexCompositeFastFT || type == IndexCompositeFuzzyFT || type == IndexCompositeHash ||
+		   type == IndexCompositeGeo;
 }
+bool isGeo(IndexType type) { return type == IndexCompositeGeo; }
 bool isFullText(IndexType type) {
 	return type == IndexFastFT || type == IndexFuzzyFT || type == IndexCompositeFastFT || type == IndexCompositeFuzzyFT;
 }
@@ -120,7 +130,7 @@ Error IndexDef::FromJSON(JsonValue &jvalue) {
 		if (jvalue.getTag() != JSON_OBJECT) throw Error(errParseJson, "Expected json object in 'indexes' key");
 
 		CollateMode collateValue = CollateNone;
-		bool isPk = false, isArray = false, isDense = false, isSparse = false;
+		bool isPk = false, isArray = false, isDense = false, isSparse = false, isBloom = false;
 		string jsonPath;
 		string collateStr;
 		string sortOrderLetters;
@@ -134,9 +144,11 @@ Error IndexDef::FromJSON(JsonValue &jvalue) {
 			parseJsonField("is_array", isArray, elem);
 			parseJsonField("is_dense", isDense, elem);
 			parseJsonField("is_sparse", isSparse, elem);
+			parseJsonField("is_bloom", isBloom, elem);
 			parseJsonField("collate_mode", collateStr, elem);
 			parseJsonField("sort_order_letters", sortOrderLetters, elem);
 			parseJsonField("json_path", jsonPath, elem);
+			parseJsonField("filter", filter_, elem);
 
 			if ("json_paths"_sv == elem->key) {
 				if (elem->value.getTag() != JSON_ARRAY) throw Error(errParseJson, "Expected array in 'json_paths' key");
@@ -156,7 +168,7 @@ Error IndexDef::FromJSON(JsonValue &jvalue) {
 					  "indexDef.json_path is used. It has been deprecated and will be removed in future releases. Use json_paths instead");
 		}
 
-		opts_.PK(isPk).Array(isArray).Dense(isDense).Sparse(isSparse);
+		opts_.PK(isPk).Array(isArray).Dense(isDense).Sparse(isSparse).Bloom(isBloom);
 		opts_.config = config;
 
 		if (!collateStr.empty()) {
@@ -193,6 +205,8 @@ void IndexDef::GetJSON(WrSerializer &ser, int formatFlags) const {
 		.Put("collate_mode", getCollateMode())
 		.Put("sort_order_letters", opts_.collateOpts_.sortOrderTable.GetSortOrderCharacters())
 		.Raw("config", opts_.hasConfig() ? opts_.config.c_str() : "{}");
+	if (opts_.IsBloom()) builder.Put("is_bloom", true);
+	if (!filter_.empty()) builder.Put("filter", filter_);
 
 	if (formatFlags & kIndexJSONWithDescribe) {
 		// extra data for support describe.
@@ -44,10 +44,13 @@ public:
 	string indexType_;
 	string fieldType_;
 	IndexOpts opts_;
+	// Condition of partial index. Empty for usual index
+	string filter_;
 };
 
 bool isComposite(IndexType type);
 bool isFullText(IndexType type);
+bool isGeo(IndexType type);
 bool isSortable(IndexType type);
 
 }  // namespace reindexer
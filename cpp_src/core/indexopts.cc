@@ -17,6 +17,7 @@ bool IndexOpts::IsPK() const { return options & kIndexOptPK; }
 bool IndexOpts::IsArray() const { return options & kIndexOptArray; }
 bool IndexOpts::IsDense() const { return options & kIndexOptDense; }
 bool IndexOpts::IsSparse() const { return options & kIndexOptSparse; }
+bool IndexOpts::IsBloom() const { return options & kIndexOptBloom; }
 bool IndexOpts::hasConfig() const { return !config.empty(); }
 CollateMode IndexOpts::GetCollateMode() const { return static_cast<CollateMode>(collateOpts_.mode); }
 
@@ -40,6 +41,11 @@ IndexOpts& IndexOpts::Sparse(bool value) {
 	return *this;
 }
 
+IndexOpts& IndexOpts::Bloom(bool value) {
+	options = value ? options | kIndexOptBloom : options & ~(kIndexOptBloom);
+	return *this;
+}
+
 IndexOpts& IndexOpts::SetCollateMode(CollateMode mode) {
 	collateOpts_.mode = mode;
 	return *this;
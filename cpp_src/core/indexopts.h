@@ -22,12 +22,14 @@ struct IndexOpts {
 	bool IsArray() const;
 	bool IsDense() const;
 	bool IsSparse() const;
+	bool IsBloom() const;
 	bool hasConfig() const;
 
 	IndexOpts& PK(bool value = true);
 	IndexOpts& Array(bool value = true);
 	IndexOpts& Dense(bool value = true);
 	IndexOpts& Sparse(bool value = true);
+	IndexOpts& Bloom(bool value = true);
 	IndexOpts& SetCollateMode(CollateMode mode);
 	IndexOpts& SetConfig(const std::string& config);
 	CollateMode GetCollateMode() const;
@@ -1,9 +1,11 @@
 
+#include "core/ft/ft_fast/termscache.h"
 #include "core/ft/ftsetcashe.h"
 #include "core/idset.h"
 #include "core/idsetcache.h"
 #include "core/keyvalue/variant.h"
 #include "core/query/querycache.h"
+#include "core/tuplescache.h"
 #include "joincache.h"
 #include "tools/logger.h"
 
@@ -111,5 +113,7 @@ template class LRUCache<IdSetCacheKey, IdSetCacheVal, hash_idset_cache_key, equa
 template class LRUCache<IdSetCacheKey, FtIdSetCacheVal, hash_idset_cache_key, equal_idset_cache_key>;
 template class LRUCache<QueryCacheKey, QueryCacheVal, HashQueryCacheKey, EqQueryCacheKey>;
 template class LRUCache<JoinCacheKey, JoinCacheVal, hash_join_cache_key, equal_join_cache_key>;
+template class LRUCache<TuplesCacheKey, TuplesCacheVal, hash_tuples_cache_key, equal_tuples_cache_key>;
+template class LRUCache<FtTermsCacheKey, FtTermsCacheVal, hash_ft_terms_cache_key, equal_ft_terms_cache_key>;
 
 }  // namespace reindexer
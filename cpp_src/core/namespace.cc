@@ -35,6 +35,7 @@ using std::defer_lock;
 #define kStorageTagsPrefix "tags"
 #define kStorageMetaPrefix "meta"
 #define kStorageCachePrefix "cache"
+#define kStorageDictPrefix "dict"
 #define kTupleName "-tuple"
 
 static const string kPKIndexName = "#pk";
@@ -43,6 +44,12 @@ static const string kLSNIndexName = "#lsn";
 #define kStorageMagic 0x1234FEDC
 #define kStorageVersion 0x8
 
+// Set in LSN of stored item, if item's CJSON is compressed with namespace dictionary
+static const uint64_t kStorageCompressedItemFlag = 1ULL << 63;
+// Min count of items to train dictionary on, and max count of samples
+static const size_t kStorageDictMinSamples = 256;
+static const size_t kStorageDictMaxSamples = 2048;
+
 namespace reindexer {
 
 const int64_t kStorageSerialInitial = 1;
@@ -62,6 +69,15 @@ Namespace::Namespace(const Namespace &src)
 	  storage_(src.storage_),
 	  updates_(src.updates_),
 	  unflushedCount_(0),
+	  storageWriter_(src.storageWriter_),
+	  lastFlushTicket_(src.lastFlushTicket_.load()),
+	  storageFlushStat_(src.storageFlushStat_),
+	  storageCodec_(src.storageCodec_),
+	  storageCompressionStat_(src.storageCompressionStat_),
+	  tuplesCache_(src.tuplesCache_),
+	  residentTuplesSize_(src.residentTuplesSize_.load()),
+	  evictedTuplesCount_(src.evictedTuplesCount_),
+	  evictPos_(src.evictPos_),
 	  sortOrdersBuilt_(false),
 	  meta_(src.meta_),
 	  dbpath_(src.dbpath_),
@@ -78,12 +94,16 @@ Namespace::Namespace(const Namespace &src)
 	logPrintf(LogTrace, "Namespace::Namespace (clone %s)", name_);
 }
 
-Namespace::Namespace(const string &name, UpdatesObservers &observers)
+Namespace::Namespace(const string &name, UpdatesObservers &observers, shared_ptr<datastorage::StorageWriter> storageWriter)
 	: indexes_(*this),
 	  name_(name),
 	  payloadType_(name),
 	  tagsMatcher_(payloadType_),
 	  unflushedCount_(0),
+	  storageWriter_(std::move(storageWriter)),
+	  lastFlushTicket_(0),
+	  storageFlushStat_(make_shared<LatencyHistogram>()),
+	  residentTuplesSize_(0),
 	  sortOrdersBuilt_(false),
 	  queryCache_(make_shared<QueryCache>()),
 	  joinCache_(make_shared<JoinCache>()),
@@ -115,6 +135,10 @@ void Namespace::onConfigUpdated(DBConfigProvider &configProvider) {
 	enablePerfCounters_ = configProvider.GetProfilingConfig().perfStats;
 
 	WLock lk(mtx_);
+	if (configData.documentsMemoryLimit != config_.documentsMemoryLimit) {
+		// Part of memory limit is used by cache of hot tuples
+		tuplesCache_ = configData.documentsMemoryLimit > 0 ? make_shared<TuplesCache>(configData.documentsMemoryLimit / 10) : nullptr;
+	}
 	config_ = configData;
 	storageOpts_.LazyLoad(configData.lazyLoad);
 	storageOpts_.noQueryIdleThresholdSec = configData.noQueryIdleThreshold;
@@ -164,8 +188,13 @@ void Namespace::recreateCompositeIndexes(int startIdx, int endIdx) {
 			indexDef.name_ = index->Name();
 			indexDef.opts_ = index->Opts();
 			indexDef.FromType(index->Type());
+			if (index->Filter()) indexDef.filter_ = index->Filter()->Condition();
 
-			index.reset(Index::New(indexDef, payloadType_, index->Fields()));
+			std::unique_ptr<Index> newIndex(Index::New(indexDef, payloadType_, index->Fields()));
+			// Filter of partial index keeps its bindings. Index is filled by caller, when rows are converted to the new payload type
+			if (index->Filter()) *newIndex->Filter() = *index->Filter();
+			index = std::move(newIndex);
+			if (index->Filter()) continue;
 			for (IdType rowId = 0; rowId < static_cast<int>(items_.size()); ++rowId) {
 				if (!items_[rowId].IsFree()) {
 					indexes_[i]->Upsert(Variant(items_[rowId]), rowId);
@@ -175,6 +204,43 @@ void Namespace::recreateCompositeIndexes(int startIdx, int endIdx) {
 	}
 }
 
+// Partial index contains only rows, which match its filter
+static bool inIndex(const Index &index, const PayloadValue &pv) { return !index.Filter() || index.Filter()->Match(pv); }
+
+void Namespace::checkIndexFilter(const IndexDef &indexDef) {
+	if (indexDef.filter_.empty()) return;
+	IndexType type = indexDef.Type();
+	if (indexDef.opts_.IsPK() || isFullText(type) || isGeo(type) || type == IndexIntStore || type == IndexInt64Store ||
+		type == IndexDoubleStore || type == IndexStrStore || type == IndexBool) {
+		throw Error(errParams, "Index '%s' of type '%s' can't be partial", indexDef.name_, indexDef.indexType_);
+	}
+	IndexFilter filter(indexDef.filter_);
+	for (const QueryEntry &qe : filter.Entries()) {
+		if (qe.index == indexDef.name_ && !isComposite(type)) continue;
+		auto idxNameIt = indexesNames_.find(qe.index);
+		if (idxNameIt == indexesNames_.end() || idxNameIt->second >= indexes_.firstCompositePos() ||
+			isFullText(indexes_[idxNameIt->second]->Type())) {
+			throw Error(errParams, "Filter of partial index '%s' refers to '%s', which is not indexed field", indexDef.name_, qe.index);
+		}
+	}
+}
+
+void Namespace::bindIndexFilter(Index &index) {
+	IndexFilter *filter = index.Filter();
+	for (size_t i = 0; i < filter->Entries().size(); ++i) {
+		const Index &fieldIndex = *indexes_[getIndexByName(filter->Entries()[i].index)];
+		filter->BindField(i, fieldIndex.KeyType(), fieldIndex.Opts().IsArray(), fieldIndex.Opts().collateOpts_,
+						  fieldIndex.Opts().IsSparse() ? fieldIndex.Fields().getTagsPath(0) : TagsPath());
+	}
+	filter->Prepare(payloadType_);
+}
+
+void Namespace::prepareIndexFilters() {
+	for (auto &index : indexes_) {
+		if (index->Filter()) index->Filter()->Prepare(payloadType_);
+	}
+}
+
 void Namespace::updateItems(PayloadType oldPlType, const FieldsSet &changedFields, int deltaFields) {
 	logPrintf(LogTrace, "Namespace::updateItems(%s) delta=%d", name_, deltaFields);
 
@@ -192,6 +258,7 @@ void Namespace::updateItems(PayloadType oldPlType, const FieldsSet &changedField
 	for (auto &idx : indexes_) {
 		idx->UpdatePayloadType(payloadType_);
 	}
+	prepareIndexFilters();
 
 	VariantArray krefs, skrefs;
 	ItemImpl newItem(payloadType_, tagsMatcher_);
@@ -214,15 +281,17 @@ void Namespace::updateItems(PayloadType oldPlType, const FieldsSet &changedField
 		}
 
 		PayloadValue plNew = oldValue.CopyTo(payloadType_, deltaFields >= 0);
+		plNew.SetLSN(plCurr.GetLSN());
 		Payload newValue(payloadType_, plNew);
 
 		for (int fieldIdx = compositeStartIdx; fieldIdx < compositeEndIdx; ++fieldIdx) {
-			indexes_[fieldIdx]->Delete(Variant(plCurr), rowId);
+			if (!indexes_[fieldIdx]->Filter()) indexes_[fieldIdx]->Delete(Variant(plCurr), rowId);
 		}
 
 		for (auto fieldIdx : changedFields) {
 			auto &index = *indexes_[fieldIdx];
-			if ((fieldIdx == 0) || deltaFields <= 0) {
+			// Dropped partial index is not cleaned: it's removed right after
+			if (((fieldIdx == 0) || deltaFields <= 0) && !index.Filter()) {
 				oldValue.Get(fieldIdx, skrefs);
 				for (auto key : skrefs) index.Delete(key, rowId);
 				if (skrefs.empty()) index.Delete(Variant(), rowId);
@@ -231,19 +300,24 @@ void Namespace::updateItems(PayloadType oldPlType, const FieldsSet &changedField
 			if ((fieldIdx == 0) || deltaFields >= 0) {
 				newItem.GetPayload().Get(fieldIdx, skrefs);
 				krefs.resize(0);
-				for (auto key : skrefs) krefs.push_back(index.Upsert(key, rowId));
+				bool indexed = inIndex(index, *newItem.GetPayload().Value());
+				for (auto key : skrefs) krefs.push_back(indexed ? index.Upsert(key, rowId) : index.UpsertUnindexed(key, rowId));
 
 				newValue.Set(fieldIdx, krefs);
-				if (krefs.empty()) index.Upsert(Variant(), rowId);
+				if (krefs.empty() && indexed) index.Upsert(Variant(), rowId);
 			}
 		}
 
 		for (int fieldIdx = compositeStartIdx; fieldIdx < compositeEndIdx; ++fieldIdx) {
-			indexes_[fieldIdx]->Upsert(Variant(plNew), rowId);
+			if (inIndex(*indexes_[fieldIdx], plNew)) indexes_[fieldIdx]->Upsert(Variant(plNew), rowId);
 		}
 
 		plCurr = std::move(plNew);
 	}
+	residentTuplesSize_ = 0;
+	for (auto &item : items_) {
+		if (!item.IsFree()) residentTuplesSize_ += tupleSize(item);
+	}
 	markUpdated();
 	if (errCount != 0) {
 		logPrintf(LogError, "Can't update indexes of %d items in namespace %s: %s", errCount, name_, lastErr.what());
@@ -259,21 +333,29 @@ void Namespace::addToWAL(const IndexDef &indexDef, WALRecType type) {
 }
 
 void Namespace::AddIndex(const IndexDef &indexDef) {
+	std::lock_guard<std::mutex> lck(indexesMtx_);
+	if (buildIndexOnline(indexDef, false)) return;
 	WLock wlock(mtx_);
+	restoreEvictedTuples();
 	addIndex(indexDef);
 	saveIndexesToStorage();
 	addToWAL(indexDef, WalIndexAdd);
 }
 
 void Namespace::UpdateIndex(const IndexDef &indexDef) {
+	std::lock_guard<std::mutex> lck(indexesMtx_);
+	if (buildIndexOnline(indexDef, true)) return;
 	WLock wlock(mtx_);
+	restoreEvictedTuples();
 	updateIndex(indexDef);
 	saveIndexesToStorage();
 	addToWAL(indexDef, WalIndexUpdate);
 }
 
 void Namespace::DropIndex(const IndexDef &indexDef) {
+	std::lock_guard<std::mutex> lck(indexesMtx_);
 	WLock wlock(mtx_);
+	restoreEvictedTuples();
 	dropIndex(indexDef);
 	saveIndexesToStorage();
 	addToWAL(indexDef, WalIndexDrop);
@@ -295,6 +377,14 @@ void Namespace::dropIndex(const IndexDef &index) {
 		if (indexes_[i]->Fields().contains(fieldIdx))
 			throw Error(LogError, "Cannot remove index %s : it's a part of a composite index %s", index.name_, indexes_[i]->Name());
 	}
+	for (int i = 0; i < indexes_.totalSize(); ++i) {
+		if (i == fieldIdx || !indexes_[i]->Filter()) continue;
+		for (const QueryEntry &qe : indexes_[i]->Filter()->Entries()) {
+			if (qe.index == index.name_) {
+				throw Error(errParams, "Cannot remove index %s : it's used in filter of partial index %s", index.name_, indexes_[i]->Name());
+			}
+		}
+	}
 	for (auto &namePair : indexesNames_) {
 		if (namePair.second >= fieldIdx) {
 			namePair.second--;
@@ -366,6 +456,7 @@ void Namespace::addIndex(const IndexDef &indexDef) {
 	if (opts.IsPK() && opts.IsArray()) {
 		throw Error(errParams, "Can't add index '%s' in namespace '%s'. PK field can't be array", indexName, name_);
 	}
+	checkIndexFilter(indexDef);
 
 	if (isComposite(indexDef.Type())) {
 		addCompositeIndex(indexDef);
@@ -386,6 +477,7 @@ void Namespace::addIndex(const IndexDef &indexDef) {
 
 		++sparseIndexesCount_;
 		insertIndex(Index::New(indexDef, payloadType_, fields), idxNo, indexName);
+		if (indexes_[idxNo]->Filter()) bindIndexFilter(*indexes_[idxNo]);
 	} else {
 		PayloadType oldPlType = payloadType_;
 
@@ -396,6 +488,7 @@ void Namespace::addIndex(const IndexDef &indexDef) {
 
 		FieldsSet changedFields{0, idxNo};
 		insertIndex(newIndex.release(), idxNo, indexName);
+		if (indexes_[idxNo]->Filter()) bindIndexFilter(*indexes_[idxNo]);
 		updateItems(oldPlType, changedFields, 1);
 	}
 	int sortedIdxCount = getSortedIdxCount();
@@ -435,11 +528,33 @@ IndexDef Namespace::getIndexDefinition(const string &indexName) {
 
 void Namespace::addCompositeIndex(const IndexDef &indexDef) {
 	string indexName = indexDef.name_;
+	FieldsSet fields = compositeIndexFields(indexDef);
+	assert(indexesNames_.find(indexName) == indexesNames_.end());
+
+	int idxPos = indexes_.size();
+	insertIndex(Index::New(indexDef, payloadType_, fields), idxPos, indexName);
+	if (indexes_[idxPos]->Filter()) bindIndexFilter(*indexes_[idxPos]);
+
+	for (IdType rowId = 0; rowId < int(items_.size()); rowId++) {
+		if (!items_[rowId].IsFree() && inIndex(*indexes_[idxPos], items_[rowId])) {
+			indexes_[idxPos]->Upsert(Variant(items_[rowId]), rowId);
+		}
+	}
+	int sortedIdxCount = getSortedIdxCount();
+	for (auto &idx : indexes_) idx->SetSortedIdxCount(sortedIdxCount);
+}
+
+FieldsSet Namespace::compositeIndexFields(const IndexDef &indexDef) {
+	const string &indexName = indexDef.name_;
 	IndexType type = indexDef.Type();
 	IndexOpts opts = indexDef.opts_;
 
 	FieldsSet fields;
 
+	if (type == IndexCompositeGeo && (indexDef.jsonPaths_.size() != 2 || opts.IsPK())) {
+		throw Error(errParams, "Geo index '%s' must consist of 2 fields (latitude+longitude) and can't be PK", indexName);
+	}
+
 	for (auto &jsonPathOrSubIdx : indexDef.jsonPaths_) {
 		auto idxNameIt = indexesNames_.find(jsonPathOrSubIdx);
 		if (idxNameIt == indexesNames_.end()) {
@@ -454,7 +569,7 @@ void Namespace::addCompositeIndex(const IndexDef &indexDef) {
 			fields.push_back(jsonPathOrSubIdx);
 			fields.push_back(indexes_[idxNameIt->second]->Fields().getTagsPath(0));
 		} else {
-			if (indexes_[idxNameIt->second]->Opts().IsArray() && (type == IndexCompositeBTree || type == IndexCompositeHash)) {
+			if (indexes_[idxNameIt->second]->Opts().IsArray() && (type == IndexCompositeBTree || type == IndexCompositeHash || type == IndexCompositeGeo)) {
 				throw Error(errParams, "Can't add array subindex '%s' to composite index '%s'", jsonPathOrSubIdx, indexName);
 			}
 			fields.push_back(idxNameIt->second);
@@ -462,18 +577,269 @@ void Namespace::addCompositeIndex(const IndexDef &indexDef) {
 	}
 
 	assert(fields.getJsonPathsLength() == fields.getTagsPathsLength());
-	assert(indexesNames_.find(indexName) == indexesNames_.end());
+	return fields;
+}
+
+// Builds index without namespace lock: from snapshot of rows, and then under lock for rows, which are modified during the build.
+// Returns false, if index can't be built online and must be built by blocking path
+bool Namespace::buildIndexOnline(const IndexDef &indexDef, bool update) {
+	unique_ptr<IndexBuild> build;
+	{
+		WLock wlock(mtx_);
+		if (!config_.onlineIndexBuild || isSystem()) return false;
+		build = startIndexBuild(indexDef, update);
+		if (!build) return false;
+		indexBuild_ = build.get();
+	}
+	// Snapshot holds strings of rows, which can be deleted from namespace during the build
+	auto releaseSnapshot = [&build]() {
+		for (auto &pv : build->snapshot) {
+			if (!pv.IsFree()) Payload(build->oldType, pv).ReleaseStrings();
+		}
+	};
 
-	int idxPos = indexes_.size();
-	insertIndex(Index::New(indexDef, payloadType_, fields), idxPos, indexName);
+	auto tmStart = high_resolution_clock::now();
+	try {
+		build->rows.resize(build->snapshot.size());
+		for (IdType id = 0; id < IdType(build->snapshot.size()); ++id) {
+			if (!build->snapshot[id].IsFree()) build->AddRow(id, build->snapshot[id]);
+		}
+	} catch (...) {
+		WLock wlock(mtx_);
+		indexBuild_ = nullptr;
+		releaseSnapshot();
+		throw;
+	}
 
-	for (IdType rowId = 0; rowId < int(items_.size()); rowId++) {
-		if (!items_[rowId].IsFree()) {
-			indexes_[idxPos]->Upsert(Variant(items_[rowId]), rowId);
+	WLock wlock(mtx_);
+	size_t changedCount = build->changed.size();
+	finishIndexBuild(*build);
+	saveIndexesToStorage();
+	addToWAL(indexDef, update ? WalIndexUpdate : WalIndexAdd);
+	wlock.unlock();
+
+	releaseSnapshot();
+	logPrintf(LogInfo, "[%s] Index '%s' is built online in %dms, %d items, %d items are modified during the build", name_,
+			  indexDef.name_, duration_cast<std::chrono::milliseconds>(high_resolution_clock::now() - tmStart).count(),
+			  build->snapshot.size(), changedCount);
+	return true;
+}
+
+// Prepares online build of index and takes snapshot of rows. Returns nullptr for PK and partial indexes, and for updates,
+// which change layout of payload or affect other indexes: they are done by blocking path. NOT THREAD SAFE!
+unique_ptr<Namespace::IndexBuild> Namespace::startIndexBuild(const IndexDef &indexDef, bool update) {
+	const string &indexName = indexDef.name_;
+	IndexType type = indexDef.Type();
+	if (indexDef.opts_.IsPK() || !indexDef.filter_.empty()) return nullptr;
+	auto idxNameIt = indexesNames_.find(indexName);
+	if (update != (idxNameIt != indexesNames_.end())) return nullptr;
+
+	unique_ptr<IndexBuild> build(new IndexBuild);
+	auto kindOf = [](IndexType type, const IndexOpts &opts) {
+		return isComposite(type) ? IndexBuild::BuildComposite : opts.IsSparse() ? IndexBuild::BuildSparse : IndexBuild::BuildDense;
+	};
+	build->kind = kindOf(type, indexDef.opts_);
+	if (update) {
+		int pos = idxNameIt->second;
+		const Index &oldIndex = *indexes_[pos];
+		if (pos == 0 || oldIndex.Opts().IsPK() || kindOf(oldIndex.Type(), oldIndex.Opts()) != build->kind ||
+			indexDef.IsEqual(getIndexDefinition(indexName), true)) {
+			return nullptr;
+		}
+		for (int i = 0; i < indexes_.totalSize(); ++i) {
+			if (i != pos && i >= indexes_.firstCompositePos() && indexes_[i]->Fields().contains(pos)) return nullptr;
+			if (i == pos || !indexes_[i]->Filter()) continue;
+			for (const QueryEntry &qe : indexes_[i]->Filter()->Entries()) {
+				if (qe.index == indexName) return nullptr;
+			}
+		}
+		build->replacedPos = pos;
+	}
+
+	build->oldType = payloadType_;
+	build->newType = payloadType_;
+	switch (build->kind) {
+		case IndexBuild::BuildComposite:
+			build->index.reset(Index::New(indexDef, payloadType_, compositeIndexFields(indexDef)));
+			break;
+		case IndexBuild::BuildSparse: {
+			FieldsSet fields;
+			for (const string &jsonPath : indexDef.jsonPaths_) {
+				bool updated = false;
+				TagsPath tagsPath = tagsMatcher_.path2tag(jsonPath, updated);
+				assert(tagsPath.size() > 0);
+				fields.push_back(jsonPath);
+				fields.push_back(tagsPath);
+			}
+			build->index.reset(Index::New(indexDef, payloadType_, fields));
+			break;
 		}
+		case IndexBuild::BuildDense: {
+			build->index.reset(Index::New(indexDef, PayloadType(), FieldsSet()));
+			PayloadFieldType fieldType(build->index->KeyType(), indexName, indexDef.jsonPaths_, indexDef.opts_.IsArray());
+			if (update) {
+				// Payload of updated index is rebuilt in place, so layout of field must be the same
+				const PayloadFieldType &oldField = payloadType_->Field(build->replacedPos);
+				if (oldField.Type() != fieldType.Type() || oldField.IsArray() != fieldType.IsArray() ||
+					oldField.JsonPaths() != fieldType.JsonPaths()) {
+					return nullptr;
+				}
+				build->field = build->replacedPos;
+			} else {
+				build->field = payloadType_->NumFields();
+				build->newType.Add(fieldType);
+				for (const string &jsonPath : indexDef.jsonPaths_) {
+					bool updated = false;
+					build->tagsPaths.push_back(tagsMatcher_.path2tag(jsonPath, updated));
+				}
+			}
+			build->index->SetFields(FieldsSet{build->field});
+			build->index->UpdatePayloadType(build->newType);
+
+			// Composite indexes refer to rows, so they are rebuilt for the new rows
+			for (int i = indexes_.firstCompositePos(); i < indexes_.totalSize(); ++i) {
+				const Index &index = *indexes_[i];
+				IndexDef compositeDef;
+				compositeDef.name_ = index.Name();
+				compositeDef.opts_ = index.Opts();
+				compositeDef.FromType(index.Type());
+				if (index.Filter()) compositeDef.filter_ = index.Filter()->Condition();
+				unique_ptr<Index> composite(Index::New(compositeDef, build->newType, index.Fields()));
+				if (index.Filter()) {
+					*composite->Filter() = *index.Filter();
+					composite->Filter()->Prepare(build->newType);
+				}
+				build->composites.push_back(std::move(composite));
+			}
+			break;
+		}
+	}
+
+	restoreEvictedTuples();
+	build->snapshot.assign(items_.begin(), items_.end());
+	for (auto &pv : build->snapshot) {
+		if (!pv.IsFree()) Payload(payloadType_, pv).AddRefStrings();
 	}
+	return build;
+}
+
+// Reindexes rows, which are modified during online build, and switches namespace to the built index. NOT THREAD SAFE!
+void Namespace::finishIndexBuild(IndexBuild &build) {
+	indexBuild_ = nullptr;
+	std::sort(build.changed.begin(), build.changed.end());
+	build.changed.erase(std::unique(build.changed.begin(), build.changed.end()), build.changed.end());
+	for (IdType id : build.changed) {
+		build.RemoveRow(id);
+		if (!items_.exists(id)) continue;
+		if (id >= IdType(build.rows.size())) build.rows.resize(id + 1);
+		build.AddRow(id, items_[id]);
+	}
+	build.rows.resize(items_.size());
+
+	string indexName = build.index->Name();
+	if (build.replacedPos >= 0) {
+		indexes_[build.replacedPos] = std::move(build.index);
+	} else if (build.kind == IndexBuild::BuildComposite) {
+		insertIndex(build.index.release(), indexes_.size(), indexName);
+	} else if (build.kind == IndexBuild::BuildSparse) {
+		++sparseIndexesCount_;
+		insertIndex(build.index.release(), payloadType_->NumFields(), indexName);
+	} else {
+		payloadType_ = build.newType;
+		tagsMatcher_.updatePayloadType(payloadType_);
+		insertIndex(build.index.release(), build.field, indexName);
+	}
+	if (build.kind == IndexBuild::BuildDense) {
+		int compositePos = indexes_.firstCompositePos();
+		for (auto &composite : build.composites) indexes_[compositePos++] = std::move(composite);
+		for (auto &idx : indexes_) idx->UpdatePayloadType(payloadType_);
+		prepareIndexFilters();
+		items_.swap(build.rows);
+	}
+
 	int sortedIdxCount = getSortedIdxCount();
 	for (auto &idx : indexes_) idx->SetSortedIdxCount(sortedIdxCount);
+	markUpdated();
+	if (build.errCount != 0) {
+		logPrintf(LogError, "Can't update indexes of %d items in namespace %s: %s", build.errCount, name_, build.lastErr.what());
+	}
+}
+
+void Namespace::IndexBuild::AddRow(IdType id, const PayloadValue &pv) {
+	PayloadValue row(pv);
+	VariantArray keys, krefs;
+	// Values, which can't be converted to type of index, are not indexed, like in blocking build
+	auto getKeys = [&](const TagsPath &tagsPath) {
+		try {
+			ConstPayload(oldType, pv).GetByJsonPath(tagsPath, krefs, index->KeyType());
+			keys.insert(keys.end(), krefs.begin(), krefs.end());
+		} catch (const Error &err) {
+			errCount++;
+			lastErr = err;
+		}
+	};
+
+	switch (kind) {
+		case BuildComposite:
+			index->Upsert(Variant(row), id);
+			break;
+		case BuildSparse:
+			getKeys(index->Fields().getTagsPath(0));
+			for (auto &key : keys) index->Upsert(key, id);
+			if (keys.empty()) index->Upsert(Variant(), id);
+			break;
+		case BuildDense:
+			if (replacedPos >= 0) {
+				ConstPayload(oldType, pv).Get(field, keys);
+				row.Clone();
+			} else {
+				for (const TagsPath &tagsPath : tagsPaths) getKeys(tagsPath);
+				row = Payload(oldType, row).CopyTo(newType, true);
+			}
+			row.SetLSN(pv.GetLSN());
+			if (index->Opts().GetCollateMode() == CollateUTF8) {
+				for (auto &key : keys) key.EnsureUTF8();
+			}
+			krefs.resize(0);
+			for (auto &key : keys) krefs.push_back(index->Upsert(key, id));
+			Payload(newType, row).Set(field, krefs);
+			if (krefs.empty()) index->Upsert(Variant(), id);
+			for (auto &composite : composites) {
+				if (inIndex(*composite, row)) composite->Upsert(Variant(row), id);
+			}
+			break;
+	}
+	rows[id] = std::move(row);
+}
+
+void Namespace::IndexBuild::RemoveRow(IdType id) {
+	if (id >= IdType(rows.size()) || rows[id].IsFree()) return;
+	PayloadValue &row = rows[id];
+	VariantArray keys;
+
+	switch (kind) {
+		case BuildComposite:
+			index->Delete(Variant(row), id);
+			break;
+		case BuildSparse:
+			try {
+				ConstPayload(oldType, row).GetByJsonPath(index->Fields().getTagsPath(0), keys, index->KeyType());
+			} catch (const Error &) {
+				keys.clear();
+			}
+			for (auto &key : keys) index->Delete(key, id);
+			if (keys.empty()) index->Delete(Variant(), id);
+			break;
+		case BuildDense:
+			for (auto &composite : composites) {
+				if (inIndex(*composite, row)) composite->Delete(Variant(row), id);
+			}
+			ConstPayload(newType, row).Get(field, keys, index->Opts().IsArray());
+			for (auto &key : keys) index->Delete(key, id);
+			if (keys.empty()) index->Delete(Variant(), id);
+			break;
+	}
+	row.Free();
 }
 
 void Namespace::insertIndex(Index *newIndex, int idxNo, const string &realName) {
@@ -564,6 +930,9 @@ void Namespace::Delete(Item &item, bool noLock) {
 
 void Namespace::doDelete(IdType id) {
 	assert(items_.exists(id));
+	if (indexBuild_) indexBuild_->changed.push_back(id);
+	restoreTuple(id);
+	residentTuplesSize_ -= tupleSize(items_[id]);
 
 	Payload pl(payloadType_, items_[id]);
 
@@ -586,7 +955,7 @@ void Namespace::doDelete(IdType id) {
 
 	// erase from composite indexes
 	for (field = indexes_.firstCompositePos(); field < indexes_.totalSize(); ++field) {
-		indexes_[field]->Delete(Variant(items_[id]), id);
+		if (inIndex(*indexes_[field], items_[id])) indexes_[field]->Delete(Variant(items_[id]), id);
 	}
 
 	// Holder for tuple. It is required for sparse indexes will be valid
@@ -609,10 +978,14 @@ void Namespace::doDelete(IdType id) {
 		} else {
 			pl.Get(field, skrefs, index.Opts().IsArray());
 		}
-		// Delete value from index
-		for (auto key : skrefs) index.Delete(key, id);
-		// If no krefs delete empty value from index
-		if (!skrefs.size()) index.Delete(Variant(), id);
+		if (inIndex(index, items_[id])) {
+			// Delete value from index
+			for (auto key : skrefs) index.Delete(key, id);
+			// If no krefs delete empty value from index
+			if (!skrefs.size()) index.Delete(Variant(), id);
+		} else {
+			for (auto key : skrefs) index.DeleteUnindexed(key, id);
+		}
 	} while (++field != borderIdx);
 
 	// free PayloadValue
@@ -633,6 +1006,7 @@ void Namespace::Delete(const Query &q, QueryResults &result) {
 	NsSelecter selecter(this);
 	SelectCtx ctx(q);
 	selecter(result, ctx);
+	loadEvictedTuples(result, 0, ctx.nsid);
 	result.lockResults();
 
 	auto tmStart = high_resolution_clock::now();
@@ -686,6 +1060,11 @@ void Namespace::EndTransaction() { mtx_.unlock(); }
 void Namespace::doUpsert(ItemImpl *ritem, IdType id, bool doUpdate) {
 	// Upsert fields to indexes
 	assert(items_.exists(id));
+	if (indexBuild_) indexBuild_->changed.push_back(id);
+	if (doUpdate) {
+		restoreTuple(id);
+		residentTuplesSize_ -= tupleSize(items_[id]);
+	}
 	auto &plData = items_[id];
 
 	// Inplace payload
@@ -699,10 +1078,14 @@ void Namespace::doUpsert(ItemImpl *ritem, IdType id, bool doUpdate) {
 	// keep them in nsamespace, to prevent allocs
 	// VariantArray krefs, skrefs;
 
+	// Payload is modified inplace, so old rows of partial indexes are detected before
+	h_vector<bool, 32> wasInIndex;
+	for (auto &index : indexes_) wasInIndex.push_back(doUpdate && inIndex(*index, plData));
+
 	// Delete from composite indexes first
 	if (doUpdate) {
 		for (int field = indexes_.firstCompositePos(); field < indexes_.totalSize(); ++field) {
-			indexes_[field]->Delete(Variant(plData), id);
+			if (wasInIndex[field]) indexes_[field]->Delete(Variant(plData), id);
 		}
 	}
 
@@ -738,25 +1121,31 @@ void Namespace::doUpsert(ItemImpl *ritem, IdType id, bool doUpdate) {
 			} else {
 				pl.Get(field, krefs, index.Opts().IsArray());
 			}
-			for (auto key : krefs) index.Delete(key, id);
-			if (!krefs.size()) index.Delete(Variant(), id);
+			if (wasInIndex[field]) {
+				for (auto key : krefs) index.Delete(key, id);
+				if (!krefs.size()) index.Delete(Variant(), id);
+			} else {
+				for (auto key : krefs) index.DeleteUnindexed(key, id);
+			}
 		}
 		// Put value to index
+		bool indexed = inIndex(index, *plNew.Value());
 		krefs.resize(0);
 		krefs.reserve(skrefs.size());
-		for (auto key : skrefs) krefs.push_back(index.Upsert(key, id));
+		for (auto key : skrefs) krefs.push_back(indexed ? index.Upsert(key, id) : index.UpsertUnindexed(key, id));
 
 		// Put value to payload
 		if (!isIndexSparse) pl.Set(field, krefs);
 		// If no krefs doUpsert empty value to index
-		if (!skrefs.size()) index.Upsert(Variant(), id);
+		if (!skrefs.size() && indexed) index.Upsert(Variant(), id);
 	} while (++field != borderIdx);
 
 	// Upsert to composite indexes
 	for (int field = indexes_.firstCompositePos(); field < indexes_.totalSize(); ++field) {
-		indexes_[field]->Upsert(Variant(plData), id);
+		if (inIndex(*indexes_[field], plData)) indexes_[field]->Upsert(Variant(plData), id);
 	}
 	repl_.dataHash ^= pl.GetHash();
+	residentTuplesSize_ += tupleSize(plData);
 }
 
 void Namespace::updateTagsMatcherFromItem(ItemImpl *ritem, string &jsonSliceBuf) {
@@ -847,12 +1236,10 @@ void Namespace::modifyItem(Item &item, bool store, int mode, bool noLock) {
 			logPrintf(LogTrace, "Saving tags of namespace %s:\n%s", name_, tagsMatcher_.dump());
 		}
 
-		WrSerializer pk, data;
+		WrSerializer pk, cjson;
 		pk << kStorageItemPrefix;
 		newPl.SerializeFields(pk, pkFields());
-		data.PutUInt64(lsn);
-		itemImpl->GetCJSON(data);
-		writeToStorage(pk.Slice(), data.Slice());
+		writeItemToStorage(pk.Slice(), lsn, itemImpl->GetCJSON(cjson));
 		++unflushedCount_;
 	}
 
@@ -960,6 +1347,7 @@ void Namespace::updateSelectTime() {
 int64_t Namespace::getLastSelectTime() const { return lastSelectTime_; }
 
 void Namespace::Select(QueryResults &result, SelectCtx &params) {
+	size_t resultsFrom = result.Items().size();
 	if (params.query.entries.size() == 1 && params.query.entries[0].index == kLSNIndexName) {
 		WALSelecter selecter(this);
 		selecter(result, params);
@@ -967,6 +1355,7 @@ void Namespace::Select(QueryResults &result, SelectCtx &params) {
 		NsSelecter selecter(this);
 		selecter(result, params);
 	}
+	loadEvictedTuples(result, resultsFrom, params.nsid);
 }
 
 NamespaceDef Namespace::getDefinition() {
@@ -980,6 +1369,7 @@ NamespaceDef Namespace::getDefinition() {
 		indexDef.name_ = index.Name();
 		indexDef.opts_ = index.Opts();
 		indexDef.FromType(index.Type());
+		if (index.Filter()) indexDef.filter_ = index.Filter()->Condition();
 
 		if (index.Opts().IsSparse() || i >= payloadType_.NumFields()) {
 			int fIdx = 0;
@@ -1029,7 +1419,8 @@ NamespaceMemStat Namespace::GetMemStat() {
 
 	for (auto &idx : indexes_) {
 		auto istat = idx->GetMemStat();
-		ret.Total.indexesSize += istat.idsetPlainSize + istat.idsetBTreeSize + istat.sortOrdersSize + istat.fulltextSize + istat.columnSize;
+		ret.Total.indexesSize += istat.idsetPlainSize + istat.idsetBTreeSize + istat.sortOrdersSize + istat.fulltextSize + istat.columnSize +
+								 istat.bloomFilterSize;
 		ret.Total.dataSize += istat.dataSize;
 		ret.Total.cacheSize += istat.idsetCache.totalSize;
 		ret.indexes.push_back(istat);
@@ -1040,6 +1431,16 @@ NamespaceMemStat Namespace::GetMemStat() {
 	ret.storageOK = storage_ != nullptr;
 	ret.storagePath = dbpath_;
 	ret.storageLoaded = storageLoaded_.load();
+	ret.storageCompression = storageCompressionStat_;
+	ret.storageCompression.enabled = storageCodec_ && config_.storageCompression;
+	if (storageCodec_) ret.storageCompression.dictSize = storageCodec_->Dict().size();
+	ret.tieredStorage.memoryLimit = std::max(config_.documentsMemoryLimit, int64_t(0));
+	ret.tieredStorage.residentSize = residentTuplesSize_;
+	ret.tieredStorage.evictedItemsCount = evictedTuplesCount_;
+	if (tuplesCache_) {
+		ret.tieredStorage.cache = tuplesCache_->GetMemStat();
+		ret.Total.cacheSize += ret.tieredStorage.cache.totalSize;
+	}
 	return ret;
 }
 
@@ -1048,6 +1449,7 @@ NamespacePerfStat Namespace::GetPerfStat() {
 	ret.name = name_;
 	ret.selects = selectPerfCounter_.Get<PerfStat>();
 	ret.updates = updatePerfCounter_.Get<PerfStat>();
+	ret.storageFlushes = storageFlushStat_->Get<LatencyHistogramStat>();
 	for (unsigned i = 1; i < indexes_.size(); i++) {
 		ret.indexes.emplace_back(indexes_[i]->GetIndexPerfStat());
 	}
@@ -1121,6 +1523,213 @@ void Namespace::loadReplStateFromStorage() {
 	}
 }
 
+void Namespace::loadStorageDictFromStorage() {
+	string dict;
+	Error status = storage_->Read(StorageOpts().FillCache(), string_view(kStorageDictPrefix), dict);
+	if (!status.ok() && status.code() != errNotFound) {
+		throw Error(errNotValid, "Error load storage dictionary '%s': %s", name_, status.what());
+	}
+	storageCodec_.reset();
+	if (dict.size()) {
+		logPrintf(LogTrace, "Loaded storage dictionary of namespace %s, %d bytes", name_, dict.size());
+		storageCodec_ = make_shared<datastorage::DictCodec>(std::move(dict));
+	}
+}
+
+// Trains dictionary on namespace documents and rewrites all documents compressed. Dictionary is trained once,
+// documents written before are decoded with the same dictionary. NOT THREAD SAFE!
+void Namespace::trainStorageDict() {
+	size_t itemsCount = items_.size() - free_.size();
+	if (itemsCount < kStorageDictMinSamples) return;
+
+	auto tmStart = high_resolution_clock::now();
+	vector<string> samples;
+	size_t step = std::max(itemsCount / kStorageDictMaxSamples, size_t(1));
+	WrSerializer ser;
+	for (size_t id = 0, n = 0; id < items_.size() && samples.size() < kStorageDictMaxSamples; ++id) {
+		if (items_[id].IsFree() || n++ % step) continue;
+		ser.Reset();
+		key_string tupleHolder;
+		ItemImpl item(payloadType_, loadEvictedTuple(id, items_[id], tupleHolder), tagsMatcher_);
+		samples.push_back(item.GetCJSON(ser).ToString());
+	}
+	string dict = datastorage::DictCodec::Train(vector<string_view>(samples.begin(), samples.end()));
+	if (dict.empty()) {
+		logPrintf(LogWarning, "[%s] Documents have no repeated content, storage compression is not used", name_);
+		config_.storageCompression = false;
+		return;
+	}
+
+	writeToStorage(string_view(kStorageDictPrefix), dict);
+	storageCodec_ = make_shared<datastorage::DictCodec>(std::move(dict));
+	storageCompressionStat_ = StorageCompressionStat();
+
+	// Rewrite existing documents with dictionary
+	for (size_t id = 0; id < items_.size(); ++id) {
+		if (items_[id].IsFree()) continue;
+		WrSerializer pk, cjson;
+		pk << kStorageItemPrefix;
+		Payload(payloadType_, items_[id]).SerializeFields(pk, pkFields());
+		key_string tupleHolder;
+		ItemImpl item(payloadType_, loadEvictedTuple(id, items_[id], tupleHolder), tagsMatcher_);
+		writeItemToStorage(pk.Slice(), items_[id].GetLSN(), item.GetCJSON(cjson));
+	}
+	++unflushedCount_;
+
+	logPrintf(LogInfo, "[%s] Trained storage dictionary of %d bytes in %dms. %d documents compressed with ratio %.2f", name_,
+			  storageCodec_->Dict().size(), duration_cast<std::chrono::milliseconds>(high_resolution_clock::now() - tmStart).count(),
+			  itemsCount, double(storageCompressionStat_.rawSize) / std::max(storageCompressionStat_.storedSize, size_t(1)));
+}
+
+void Namespace::writeItemToStorage(const string_view &pk, int64_t lsn, const string_view &cjson) {
+	WrSerializer data;
+	if (storageCodec_ && config_.storageCompression) {
+		data.PutUInt64(uint64_t(lsn) | kStorageCompressedItemFlag);
+		storageCodec_->Compress(cjson, data);
+	} else {
+		data.PutUInt64(lsn);
+		data.Write(cjson);
+	}
+	storageCompressionStat_.rawSize += cjson.size();
+	storageCompressionStat_.storedSize += data.Len() - sizeof(lsn);
+	writeToStorage(pk, data.Slice());
+}
+
+size_t Namespace::tupleSize(const PayloadValue &pv) {
+	VariantArray tuple;
+	ConstPayload(payloadType_, pv).Get(0, tuple);
+	return tuple.empty() ? 0 : p_string(tuple[0]).length();
+}
+
+bool Namespace::needToEvictTuples() const {
+	// Sparse indexes values are stored in tuples, so they can't be evicted. Online index build reads tuples of snapshot
+	return storage_ && config_.documentsMemoryLimit > 0 && residentTuplesSize_ > config_.documentsMemoryLimit * 9 / 10 &&
+		   !sparseIndexesCount_ && !indexBuild_ && !needToLoadData();
+}
+
+// Evicts tuples of items, until size of resident tuples is below memory limit. Tuple of evicted item is replaced with
+// empty string and is loaded from storage on demand. Items are evicted in round-robin order, hot items are served
+// from tuples cache. NOT THREAD SAFE!
+void Namespace::evictTuples() {
+	// Evicted tuples are loaded from storage, so all updates must be written to storage before eviction
+	doFlushStorage();
+	waitFlushStorage();
+
+	auto tmStart = high_resolution_clock::now();
+	int64_t target = config_.documentsMemoryLimit * 8 / 10;
+	size_t evictedCount = 0;
+	VariantArray tuple, empty;
+	for (size_t n = 0; n < items_.size() && residentTuplesSize_ > target; ++n, ++evictPos_) {
+		if (evictPos_ >= IdType(items_.size())) evictPos_ = 0;
+		auto &pv = items_[evictPos_];
+		if (pv.IsFree()) continue;
+		size_t size = tupleSize(pv);
+		if (!size) continue;
+
+		pv.Clone();
+		Payload pl(payloadType_, pv);
+		pl.Get(0, tuple);
+		indexes_[0]->Delete(tuple[0], evictPos_);
+		empty.clear();
+		empty.push_back(indexes_[0]->Upsert(Variant(string()), evictPos_));
+		pl.Set(0, empty);
+		residentTuplesSize_ -= size;
+		evictedTuplesCount_++;
+		evictedCount++;
+	}
+	logPrintf(LogInfo, "[%s] Evicted %d items to storage in %dms, %d items are evicted, resident size=%dM", name_, evictedCount,
+			  duration_cast<std::chrono::milliseconds>(high_resolution_clock::now() - tmStart).count(), evictedTuplesCount_,
+			  residentTuplesSize_ / (1024 * 1024));
+}
+
+// Makes tuple of item resident again. It's required before modification of item. NOT THREAD SAFE!
+void Namespace::restoreTuple(IdType id) {
+	if (!evictedTuplesCount_ || tupleSize(items_[id])) return;
+
+	key_string loaded = fetchTuple(id, items_[id]);
+	auto &pv = items_[id];
+	pv.Clone();
+	Payload pl(payloadType_, pv);
+	VariantArray tuple;
+	pl.Get(0, tuple);
+	indexes_[0]->Delete(tuple[0], id);
+	tuple.clear();
+	tuple.push_back(indexes_[0]->Upsert(Variant(loaded), id));
+	pl.Set(0, tuple);
+	residentTuplesSize_ += loaded->length();
+	evictedTuplesCount_--;
+}
+
+void Namespace::restoreEvictedTuples() {
+	if (!evictedTuplesCount_) return;
+	logPrintf(LogInfo, "[%s] Loading %d evicted items from storage", name_, evictedTuplesCount_);
+	for (IdType id = 0; id < IdType(items_.size()) && evictedTuplesCount_; ++id) {
+		if (!items_[id].IsFree()) restoreTuple(id);
+	}
+}
+
+key_string Namespace::fetchTuple(IdType id, const PayloadValue &pv) {
+	TuplesCacheKey key{id, pv.GetLSN()};
+	auto cache = tuplesCache_;
+	if (cache) {
+		auto it = cache->Get(key);
+		if (it.val.tuple) return it.val.tuple;
+	}
+	if (!storage_) throw Error(errLogic, "Can't load evicted item of '%s': storage is closed", name_);
+
+	WrSerializer pk;
+	pk << kStorageItemPrefix;
+	ConstPayload(payloadType_, pv).SerializeFields(pk, pkFields());
+	string data, cjsonBuf;
+	Error err = storage_->Read(StorageOpts().FillCache(false), pk.Slice(), data);
+	if (!err.ok()) throw Error(err.code(), "Can't load evicted item of '%s' from storage: %s", name_, err.what());
+	if (data.size() < sizeof(uint64_t)) throw Error(errParseBin, "Not enougth data in stored item of '%s'", name_);
+
+	uint64_t lsnField = *reinterpret_cast<const uint64_t *>(data.data());
+	string_view cjson(data.data() + sizeof(lsnField), data.size() - sizeof(lsnField));
+	if (lsnField & kStorageCompressedItemFlag) {
+		if (!storageCodec_) throw Error(errParseBin, "Item is compressed, but there is no dictionary in storage");
+		storageCodec_->Decompress(cjson, cjsonBuf);
+		cjson = cjsonBuf;
+	}
+
+	ItemImpl item(payloadType_, tagsMatcher_);
+	item.Unsafe(true);
+	err = item.FromCJSON(cjson);
+	if (!err.ok()) throw err;
+	VariantArray tuple;
+	item.GetPayload().Get(0, tuple);
+	p_string str(tuple[0]);
+	key_string ret = make_key_string(str.data(), str.length());
+
+	if (cache) cache->Put(key, TuplesCacheVal{ret});
+	return ret;
+}
+
+PayloadValue Namespace::loadEvictedTuple(IdType id, const PayloadValue &pv, key_string &holder) {
+	if (!evictedTuplesCount_ || tupleSize(pv)) return pv;
+
+	holder = fetchTuple(id, pv);
+	PayloadValue ret(pv);
+	ret.Clone();
+	VariantArray tuple;
+	tuple.push_back(Variant(holder));
+	Payload(payloadType_, ret).Set(0, tuple);
+	return ret;
+}
+
+void Namespace::loadEvictedTuples(QueryResults &result, size_t from, int nsid) {
+	if (!evictedTuplesCount_) return;
+	auto &items = result.Items();
+	for (size_t i = from; i < items.size(); ++i) {
+		auto &ref = items[i];
+		if (ref.nsid != nsid || ref.raw || ref.value.IsFree()) continue;
+		key_string holder;
+		ref.value = loadEvictedTuple(ref.id, ref.value, holder);
+		if (holder) result.stringsHolder.push_back(std::move(holder));
+	}
+}
+
 void Namespace::saveIndexesToStorage() {
 	// clear ItemImpl pool on payload change
 	pool_.clear();
@@ -1164,9 +1773,8 @@ void Namespace::saveReplStateToStorage() {
 
 bool Namespace::needToLoadData() const { return (storage_ && (dbpath_.length() > 0)) ? !storageLoaded_.load() : false; }
 
-void Namespace::EnableStorage(const string &path, StorageOpts opts) {
+void Namespace::EnableStorage(const string &path, StorageOpts opts, datastorage::StorageType storageType) {
 	string dbpath = fs::JoinPath(path, name_);
-	datastorage::StorageType storageType = datastorage::StorageType::LevelDB;
 
 	WLock lock(mtx_);
 	if (storage_) {
@@ -1189,6 +1797,7 @@ void Namespace::EnableStorage(const string &path, StorageOpts opts) {
 				throw Error(errLogic, "Can't enable storage for namespace '%s' on path '%s': format error", name_, dbpath);
 			}
 			loadReplStateFromStorage();
+			loadStorageDictFromStorage();
 		}
 		if (!success && opts.IsDropOnFileFormatError()) {
 			logPrintf(LogWarning, "Dropping storage for namespace '%s' on path '%s' due to format error", name_, dbpath);
@@ -1226,6 +1835,7 @@ void Namespace::LoadFromStorage() {
 	unique_ptr<datastorage::Cursor> dbIter(storage_->GetCursor(opts));
 	ItemImpl item(payloadType_, tagsMatcher_);
 	item.Unsafe(true);
+	string cjsonBuf;
 	int errCount = 0;
 	int64_t maxLSN = -1;
 	Error lastErr = errOK;
@@ -1247,10 +1857,26 @@ void Namespace::LoadFromStorage() {
 			}
 
 			// Read LSN
-			int64_t lsn = *reinterpret_cast<const int64_t *>(dataSlice.data());
+			uint64_t lsnField = *reinterpret_cast<const uint64_t *>(dataSlice.data());
+			int64_t lsn = lsnField & ~kStorageCompressedItemFlag;
 			assert(lsn >= 0);
 			maxLSN = std::max(maxLSN, lsn);
 			dataSlice = dataSlice.substr(sizeof(lsn));
+			storageCompressionStat_.storedSize += dataSlice.size();
+
+			if (lsnField & kStorageCompressedItemFlag) {
+				try {
+					if (!storageCodec_) throw Error(errParseBin, "Item is compressed, but there is no dictionary in storage");
+					storageCodec_->Decompress(dataSlice, cjsonBuf);
+				} catch (const Error &err) {
+					logPrintf(LogTrace, "Error load item to '%s' from storage: '%s'", name_, err.what());
+					errCount++;
+					lastErr = err;
+					continue;
+				}
+				dataSlice = cjsonBuf;
+			}
+			storageCompressionStat_.rawSize += dataSlice.size();
 
 			auto err = item.FromCJSON(dataSlice);
 			if (!err.ok()) {
@@ -1295,36 +1921,86 @@ void Namespace::initWAL(int64_t maxLSN) {
 }
 
 void Namespace::BackgroundRoutine() {
+	if (needToTrainStorageDict()) {
+		WLock lck(mtx_);
+		if (needToTrainStorageDict()) trainStorageDict();
+	}
+	if (needToEvictTuples()) {
+		WLock lck(mtx_);
+		if (needToEvictTuples()) evictTuples();
+	}
 	flushStorage();
 	commitIndexes();
 }
 
 void Namespace::flushStorage() {
 	RLock rlock(mtx_);
+	doFlushStorage();
+}
+
+void Namespace::doFlushStorage() {
 	if (storage_) {
+		// Flushes are serialized by storage_mtx_ until batch is submitted, so batches of concurrent flushers
+		// (under shared lock) are written in the same order, as they were taken
+		std::unique_lock<std::mutex> lck(storage_mtx_);
 		if (unflushedCount_) {
 			unflushedCount_ = 0;
-			std::unique_lock<std::mutex> lck(storage_mtx_);
-			Error status = storage_->Write(StorageOpts().FillCache(), *(updates_.get()));
-			if (!status.ok()) throw Error(errLogic, "Error write ns '%s' to storage: %s", name_, status.what());
-			updates_->Clear();
-			saveReplStateToStorage();
+			// Replication state is written in the same batch, so it never gets ahead of data on disk
+			WrSerializer ser;
+			JsonBuilder builder(ser);
+			repl_.GetJSON(builder);
+			builder.End();
+			updates_->Put(string_view(kStorageReplStatePrefix), ser.Slice());
+
+			datastorage::UpdatesCollection::Ptr batch = std::move(updates_);
+			updates_.reset(storage_->GetUpdatesCollection());
+
+			if (storageWriter_) {
+				lastFlushTicket_ = storageWriter_->Submit(storage_, std::move(batch), storageOpts_.IsSync(), storageFlushStat_, name_);
+			} else {
+				auto tmStart = high_resolution_clock::now();
+				Error status = storage_->Write(StorageOpts().FillCache().Sync(storageOpts_.IsSync()), *batch);
+				storageFlushStat_->Hit(duration_cast<microseconds>(high_resolution_clock::now() - tmStart));
+				if (!status.ok()) throw Error(errLogic, "Error write ns '%s' to storage: %s", name_, status.what());
+			}
 		}
 	}
 }
 
+void Namespace::waitFlushStorage() {
+	if (!storageWriter_) return;
+	Error status = storageWriter_->Wait(lastFlushTicket_);
+	if (!status.ok()) throw Error(errLogic, "Error write ns '%s' to storage: %s", name_, status.what());
+}
+
+void Namespace::FlushStorage() {
+	flushStorage();
+	waitFlushStorage();
+}
+
+void Namespace::syncStorageWriter() {
+	if (storageWriter_ && storage_) storageWriter_->Wait(storageWriter_->Sync(storage_));
+}
+
 void Namespace::DeleteStorage() {
 	WLock lck(mtx_);
 	if (storage_) {
+		{
+			std::unique_lock<std::mutex> lck(storage_mtx_);
+			updates_->Clear();
+		}
+		syncStorageWriter();
 		storage_->Destroy(dbpath_);
 		dbpath_.clear();
 		storage_.reset();
+		storageCodec_.reset();
 	}
 }
 
 void Namespace::CloseStorage() {
 	flushStorage();
 	WLock lck(mtx_);
+	syncStorageWriter();
 	dbpath_.clear();
 	storage_.reset();
 }
@@ -1334,6 +2010,9 @@ bool Namespace::tryToReload() {
 	if (noQueryIdleThresholdSec > 0) {
 		int64_t now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 		if ((now - getLastSelectTime()) > noQueryIdleThresholdSec) {
+			// Namespace isn't reloaded during online index build
+			std::unique_lock<std::mutex> indexesLck(indexesMtx_, std::try_to_lock);
+			if (!indexesLck.owns_lock()) return true;
 			unique_lock<shared_timed_mutex> lk(mtx_);
 			items_.clear();
 			for (auto it = indexesNames_.begin(); it != indexesNames_.end();) {
@@ -1369,7 +2048,8 @@ Item Namespace::NewItem() {
 void Namespace::ToPool(ItemImpl *item) {
 	WLock lck(mtx_);
 	item->Clear(tagsMatcher_);
-	if (pool_.size() < 1024)
+	// Item, which was created before change of payload type, can't be reused
+	if (pool_.size() < 1024 && item->Type().get() == payloadType_.get())
 		pool_.push_back(std::unique_ptr<ItemImpl>(item));
 	else
 		delete item;
@@ -1522,6 +2202,7 @@ void Namespace::FillResult(QueryResults &result, IdSet::Ptr ids, const h_vector<
 	for (auto &id : *ids) {
 		result.Add({id, items_[id], 0, 0});
 	}
+	loadEvictedTuples(result, 0, 0);
 }
 
 void Namespace::GetFromJoinCache(JoinCacheRes &ctx) {
@@ -1554,6 +2235,33 @@ void Namespace::GetIndsideFromJoinCache(JoinCacheRes &ctx) {
 	}
 }
 
+bool Namespace::joinKeysAbsent(const QueryEntries &entries) const {
+	for (size_t i = 0; i < entries.size(); ++i) {
+		const QueryEntry &qe = entries[i];
+		if (qe.op != OpAnd || (i + 1 < entries.size() && entries[i + 1].op == OpOr) || qe.idxNo < 0 || qe.values.empty() ||
+			(qe.condition != CondEq && qe.condition != CondSet)) {
+			continue;
+		}
+		const Index &index = *indexes_[qe.idxNo];
+		if (!index.Opts().IsBloom()) continue;
+		bool absent = true;
+		for (const Variant &value : qe.values) {
+			Variant key(value);
+			try {
+				key.convert(index.KeyType());
+			} catch (const Error &) {
+				absent = false;
+			}
+			if (!absent || index.MayContain(key)) {
+				absent = false;
+				break;
+			}
+		}
+		if (absent) return true;
+	}
+	return false;
+}
+
 void Namespace::PutToJoinCache(JoinCacheRes &res, SelectCtx::PreResult::Ptr preResult) {
 	JoinCacheVal joinCacheVal;
 	res.needPut = false;
@@ -17,8 +17,12 @@
 #include "perfstatcounter.h"
 #include "query/querycache.h"
 #include "replicator/waltracker.h"
+#include "storage/dictcodec.h"
 #include "storage/idatastorage.h"
+#include "storage/storagefactory.h"
+#include "storage/storagewriter.h"
 #include "transactionimpl.h"
+#include "tuplescache.h"
 
 namespace reindexer {
 
@@ -87,17 +91,47 @@ protected:
 		bool exists(IdType id) const { return id < IdType(size()) && !at(id).IsFree(); }
 	};
 
+	// State of online index build. Index is built from snapshot of rows without namespace lock, rows, which are modified
+	// during the build, are recorded by writers and reindexed under namespace lock before switch to the new index
+	struct IndexBuild {
+		enum Kind { BuildDense, BuildSparse, BuildComposite };
+
+		// Adds row with id to built indexes. Row is converted to the new payload type
+		void AddRow(IdType id, const PayloadValue &pv);
+		// Removes row with id from built indexes
+		void RemoveRow(IdType id);
+
+		Kind kind;
+		// Position of replaced index or -1 for the new index
+		int replacedPos = -1;
+		// Payload field of dense index
+		int field = 0;
+		PayloadType oldType, newType;
+		vector<TagsPath> tagsPaths;
+		unique_ptr<Index> index;
+		// Composite indexes, which are rebuilt for rows of dense index
+		vector<unique_ptr<Index>> composites;
+		// Snapshot of rows. Strings of snapshot are held until the end of build
+		vector<PayloadValue> snapshot;
+		// Rows, which are indexed by built indexes, in layout of the new payload type
+		vector<PayloadValue> rows;
+		// Ids of rows, which are modified during the build
+		vector<IdType> changed;
+		int errCount = 0;
+		Error lastErr;
+	};
+
 public:
 	typedef shared_ptr<Namespace> Ptr;
 
-	Namespace(const string &_name, UpdatesObservers &observers);
+	Namespace(const string &_name, UpdatesObservers &observers, shared_ptr<datastorage::StorageWriter> storageWriter = nullptr);
 	Namespace &operator=(const Namespace &) = delete;
 	~Namespace();
 
 	const string &GetName() { return name_; }
 	bool isSystem() const { return !name_.empty() && name_[0] == '#'; }
 
-	void EnableStorage(const string &path, StorageOpts opts);
+	void EnableStorage(const string &path, StorageOpts opts, datastorage::StorageType storageType = datastorage::StorageType::LevelDB);
 	void LoadFromStorage();
 	void DeleteStorage();
 
@@ -118,6 +152,8 @@ public:
 	void Delete(const Query &query, QueryResults &result);
 	void BackgroundRoutine();
 	void CloseStorage();
+	// Flush updates to storage and wait until they are written by storage writer
+	void FlushStorage();
 
 	void ApplyTransactionStep(TransactionStep &step);
 
@@ -150,6 +186,8 @@ protected:
 	bool loadIndexesFromStorage();
 	void saveReplStateToStorage();
 	void loadReplStateFromStorage();
+	void loadStorageDictFromStorage();
+	void trainStorageDict();
 
 	void initWAL(int64_t maxLSN);
 
@@ -163,17 +201,29 @@ protected:
 	void insertIndex(Index *newIndex, int idxNo, const string &realName);
 	void addIndex(const IndexDef &indexDef);
 	void addCompositeIndex(const IndexDef &indexDef);
+	FieldsSet compositeIndexFields(const IndexDef &indexDef);
+	bool buildIndexOnline(const IndexDef &indexDef, bool update);
+	unique_ptr<IndexBuild> startIndexBuild(const IndexDef &indexDef, bool update);
+	void finishIndexBuild(IndexBuild &build);
 	void updateIndex(const IndexDef &indexDef);
 	void dropIndex(const IndexDef &index);
 	void addToWAL(const IndexDef &indexDef, WALRecType type);
 
 	void recreateCompositeIndexes(int startIdx, int endIdx);
+	void checkIndexFilter(const IndexDef &indexDef);
+	void bindIndexFilter(Index &index);
+	void prepareIndexFilters();
 	void onConfigUpdated(DBConfigProvider &configProvider);
 	NamespaceDef getDefinition();
 	IndexDef getIndexDefinition(const string &indexName);
 
 	string getMeta(const string &key);
 	void flushStorage();
+	// Same as flushStorage, but namespace lock must be held by caller
+	void doFlushStorage();
+	// Waits, until the last flushed batch is written by storage writer. Throws error of write
+	void waitFlushStorage();
+	void syncStorageWriter();
 	void putMeta(const string &key, const string_view &data);
 
 	pair<IdType, bool> findByPK(ItemImpl *ritem);
@@ -185,14 +235,31 @@ protected:
 	void PutToJoinCache(JoinCacheRes &res, JoinCacheVal &val);
 	void GetFromJoinCache(JoinCacheRes &ctx);
 	void GetIndsideFromJoinCache(JoinCacheRes &ctx);
+	// Checks by bloom filters of indexes, that rows, matching AND-ed conditions of join, are absent
+	bool joinKeysAbsent(const QueryEntries &entries) const;
 
 	const FieldsSet &pkFields();
 	void writeToStorage(const string_view &key, const string_view &data) {
 		std::unique_lock<std::mutex> lck(storage_mtx_);
 		updates_->Put(key, data);
 	}
+	void writeItemToStorage(const string_view &pk, int64_t lsn, const string_view &cjson);
 
 	bool needToLoadData() const;
+	bool needToTrainStorageDict() const {
+		return storage_ && config_.storageCompression && !storageCodec_ && !needToLoadData();
+	}
+
+	size_t tupleSize(const PayloadValue &pv);
+	bool needToEvictTuples() const;
+	void evictTuples();
+	void restoreTuple(IdType id);
+	void restoreEvictedTuples();
+	key_string fetchTuple(IdType id, const PayloadValue &pv);
+	// Returns pv, if it's tuple is resident, or copy of pv with tuple, loaded from cache or storage. Loaded tuple is kept by holder
+	PayloadValue loadEvictedTuple(IdType id, const PayloadValue &pv, key_string &holder);
+	// Loads evicted tuples of items of this namespace in result, starting from position
+	void loadEvictedTuples(QueryResults &result, size_t from, int nsid);
 	StorageOpts getStorageOpts();
 	void SetStorageOpts(StorageOpts opts);
 
@@ -214,7 +281,18 @@ protected:
 
 	shared_ptr<datastorage::IDataStorage> storage_;
 	datastorage::UpdatesCollection::Ptr updates_;
-	int unflushedCount_;
+	std::atomic<int> unflushedCount_;
+	shared_ptr<datastorage::StorageWriter> storageWriter_;
+	std::atomic<datastorage::StorageWriter::Ticket> lastFlushTicket_;
+	shared_ptr<LatencyHistogram> storageFlushStat_;
+	// Codec of stored documents. Is set, when dictionary is trained or loaded from storage
+	shared_ptr<const datastorage::DictCodec> storageCodec_;
+	StorageCompressionStat storageCompressionStat_;
+	// Tuples of items, evicted to storage due to documentsMemoryLimit, are replaced with empty strings
+	TuplesCache::Ptr tuplesCache_;
+	std::atomic<int64_t> residentTuplesSize_;
+	size_t evictedTuplesCount_ = 0;
+	IdType evictPos_ = 0;
 
 	shared_timed_mutex mtx_;
 	std::mutex storage_mtx_;
@@ -231,6 +309,11 @@ protected:
 	int sparseIndexesCount_ = 0;
 	VariantArray krefs, skrefs;
 
+	// Serializes changes of indexes, online build is done under this mutex without namespace lock
+	std::mutex indexesMtx_;
+	// Online index build in progress
+	IndexBuild *indexBuild_ = nullptr;
+
 private:
 	Namespace(const Namespace &src);
 
@@ -36,6 +36,14 @@ void NamespaceMemStat::GetJSON(WrSerializer &ser) {
 		auto obj = builder.Object("query_cache");
 		queryCache.GetJSON(obj);
 	}
+	{
+		auto obj = builder.Object("storage_compression");
+		storageCompression.GetJSON(obj);
+	}
+	{
+		auto obj = builder.Object("tiered_storage");
+		tieredStorage.GetJSON(obj);
+	}
 
 	auto arr = builder.Array("indexes");
 	for (auto &index : indexes) {
@@ -44,6 +52,22 @@ void NamespaceMemStat::GetJSON(WrSerializer &ser) {
 	}
 };
 
+void StorageCompressionStat::GetJSON(JsonBuilder &builder) {
+	builder.Put("enabled", enabled);
+	builder.Put("dict_size", dictSize);
+	builder.Put("raw_size", rawSize);
+	builder.Put("stored_size", storedSize);
+	builder.Put("ratio", storedSize ? double(rawSize) / storedSize : 1.0);
+}
+
+void TieredStorageStat::GetJSON(JsonBuilder &builder) {
+	builder.Put("memory_limit", memoryLimit);
+	builder.Put("resident_size", residentSize);
+	builder.Put("evicted_items_count", evictedItemsCount);
+	auto obj = builder.Object("cache");
+	cache.GetJSON(obj);
+}
+
 void LRUCacheMemStat::GetJSON(JsonBuilder &builder) {
 	builder.Put("total_size", totalSize);
 	builder.Put("items_count", itemsCount);
@@ -59,6 +83,7 @@ void IndexMemStat::GetJSON(JsonBuilder &builder) {
 	if (sortOrdersSize) builder.Put("sort_orders_size", sortOrdersSize);
 	if (fulltextSize) builder.Put("fulltext_size", fulltextSize);
 	if (columnSize) builder.Put("column_size", columnSize);
+	if (bloomFilterSize) builder.Put("bloom_filter_size", bloomFilterSize);
 
 	if (idsetCache.totalSize || idsetCache.itemsCount || idsetCache.emptyCount || idsetCache.hitCountLimit) {
 		auto obj = builder.Object("idset_cache");
@@ -92,6 +117,10 @@ void NamespacePerfStat::GetJSON(WrSerializer &ser) {
 		auto obj = builder.Object("selects");
 		selects.GetJSON(obj);
 	}
+	if (storageFlushes.totalCount) {
+		auto obj = builder.Object("storage_flushes");
+		storageFlushes.GetJSON(obj);
+	}
 
 	auto arr = builder.Array("indexes");
 
@@ -101,6 +130,21 @@ void NamespacePerfStat::GetJSON(WrSerializer &ser) {
 	}
 }
 
+void LatencyHistogramStat::GetJSON(JsonBuilder &builder) {
+	builder.Put("total_count", totalCount);
+	builder.Put("avg_latency_us", avgTimeUs);
+	builder.Put("max_latency_us", maxTimeUs);
+
+	// Report only non-empty buckets as pairs of upper bound and hits count
+	auto arr = builder.Array("histogram");
+	for (unsigned i = 0; i < buckets.size(); i++) {
+		if (!buckets[i]) continue;
+		auto obj = arr.Object();
+		obj.Put("le_us", int64_t(1) << i);
+		obj.Put("count", buckets[i]);
+	}
+}
+
 void IndexPerfStat::GetJSON(JsonBuilder &builder) {
 	builder.Put("name", name);
 	{
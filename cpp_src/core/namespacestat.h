@@ -31,6 +31,7 @@ struct IndexMemStat {
 	size_t sortOrdersSize = 0;
 	size_t fulltextSize = 0;
 	size_t columnSize = 0;
+	size_t bloomFilterSize = 0;
 	LRUCacheMemStat idsetCache;
 };
 
@@ -56,6 +57,26 @@ struct ReplicationStat : public ReplicationState {
 	size_t walSize = 0;
 };
 
+struct StorageCompressionStat {
+	void GetJSON(JsonBuilder &builder);
+
+	bool enabled = false;
+	size_t dictSize = 0;
+	// Sizes of documents, loaded from and written to storage since namespace was opened
+	size_t rawSize = 0;
+	size_t storedSize = 0;
+};
+
+struct TieredStorageStat {
+	void GetJSON(JsonBuilder &builder);
+
+	size_t memoryLimit = 0;
+	// Size of non-indexed contents of documents, resident in memory
+	size_t residentSize = 0;
+	size_t evictedItemsCount = 0;
+	LRUCacheMemStat cache;
+};
+
 struct NamespaceMemStat {
 	void GetJSON(WrSerializer &ser);
 
@@ -75,6 +96,8 @@ struct NamespaceMemStat {
 	ReplicationStat replication;
 	LRUCacheMemStat joinCache;
 	LRUCacheMemStat queryCache;
+	StorageCompressionStat storageCompression;
+	TieredStorageStat tieredStorage;
 	std::vector<IndexMemStat> indexes;
 };
 
@@ -91,6 +114,15 @@ struct PerfStat {
 	size_t maxTimeUs;
 };
 
+struct LatencyHistogramStat {
+	void GetJSON(JsonBuilder &builder);
+	size_t totalCount = 0;
+	size_t avgTimeUs = 0;
+	size_t maxTimeUs = 0;
+	// Upper bound of i-th bucket is 2^i microseconds
+	std::vector<size_t> buckets;
+};
+
 struct IndexPerfStat {
 	IndexPerfStat() = default;
 	IndexPerfStat(const std::string &n, const PerfStat &s, const PerfStat &c) : name(n), selects(s), commits(c) {}
@@ -107,6 +139,7 @@ struct NamespacePerfStat {
 	std::string name;
 	PerfStat updates;
 	PerfStat selects;
+	LatencyHistogramStat storageFlushes;
 	std::vector<IndexPerfStat> indexes;
 };
 
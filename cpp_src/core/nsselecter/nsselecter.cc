@@ -1,5 +1,8 @@
+#include <cmath>
+#include <limits>
 #include <sstream>
 
+#include "core/geo.h"
 #include "core/index/index.h"
 #include "core/namespace.h"
 #include "explaincalc.h"
@@ -15,6 +18,9 @@ using std::stringstream;
 
 namespace reindexer {
 
+// Scan of column is used instead of comparator, if select loop checks at least 1/kColumnScanMinRatio of namespace rows
+const int kColumnScanMinRatio = 8;
+
 void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 	ctx.enableSortOrders = ns_->sortOrdersBuilt_;
 	if (ns_->config_.logLevel > ctx.query.debugLevel) {
@@ -56,6 +62,7 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 	bool disableOptimizeSortOrder = !ctx.query.sortingEntries_.empty() || ctx.preResult;
 	SortingEntries sortBy = (isFt || disableOptimizeSortOrder) ? ctx.query.sortingEntries_ : detectOptimalSortOrder(*whereEntries);
 	prepareSortingIndexes(sortBy);
+	if (!ctx.skipIndexesLookup && !isFt && ctx.query.forcedSortOrder.empty()) substituteCompositeSort(*whereEntries, sortBy);
 
 	if (ctx.preResult) {
 		// For building join preresult always use ASC sort orders
@@ -95,8 +102,20 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 	}
 	explain.SetPrepareTime();
 
-	prepareIteratorsForSelectLoop(*whereEntries, qres, ctx.sortingCtx.sortId(), isFt);
+	// Full text index ranks only the best documents, if they are the only condition and results are returned in order of rank
+	size_t ftTopK = 0;
+	if (isFt && whereEntries->size() == 1 && (*whereEntries)[0].op == OpAnd && sortBy.empty() && !ctx.preResult && !ctx.isForceAll &&
+		ctx.query.calcTotal == ModeNoTotal && ctx.query.count != UINT_MAX && ctx.query.aggregations_.empty() &&
+		ctx.query.joinQueries_.empty()) {
+		ftTopK = size_t(ctx.query.start) + ctx.query.count;
+	}
+	prepareIteratorsForSelectLoop(*whereEntries, qres, ctx.sortingCtx.sortId(), isFt, ftTopK);
 	prepareEqualPositionComparator(ctx.query, *whereEntries, qres);
+	// Scan of whole column is useless, if select loop is going to be stopped by limit
+	bool fullLoop = needCalcTotal || ctx.isForceAll || ctx.query.count == UINT_MAX || !ctx.query.aggregations_.empty() ||
+					(!ctx.sortingCtx.entries.empty() && !ctx.sortingCtx.sortIndex());
+	if (fullLoop) applyColumnScans(qres, ctx.sortingCtx.sortId());
+	mergeBitmapIterators(qres);
 
 	explain.SetSelectTime();
 
@@ -189,6 +208,7 @@ void NsSelecter::operator()(QueryResults &result, SelectCtx &ctx) {
 	LoopCtx lctx(ctx);
 	lctx.qres = &qres;
 	lctx.calcTotal = needCalcTotal;
+	lctx.needTuples = ns_->evictedTuplesCount_ && queryNeedsTuples(*whereEntries, ctx);
 	if (isFt) result.haveProcent = true;
 	if (reverse && hasComparators && hasScan) selectLoop<true, true, true>(lctx, result);
 	if (!reverse && hasComparators && hasScan) selectLoop<false, true, true>(lctx, result);
@@ -305,6 +325,12 @@ void NsSelecter::applyGeneralSort(ConstItemIterator itFirst, ConstItemIterator i
 
 	if (ctx.sortingCtx.entries.empty()) return;
 
+	const int firstSortIdx = ctx.sortingCtx.entries[0].data->index;
+	if (ctx.sortingCtx.entries.size() == 1 && firstSortIdx >= 0 && isGeo(ns_->indexes_[firstSortIdx]->Type())) {
+		applyDistanceSort(itFirst, itLast, itEnd, ctx);
+		return;
+	}
+
 	FieldsSet fields;
 	auto &payloadType = ns_->payloadType_;
 	bool multiSort = ctx.sortingCtx.entries.size() > 1;
@@ -364,6 +390,43 @@ void NsSelecter::applyGeneralSort(ConstItemIterator itFirst, ConstItemIterator i
 	});
 }
 
+// Sorting by geo index orders items by distance from center of DWITHIN or INBOX condition on the same index
+void NsSelecter::applyDistanceSort(ConstItemIterator itFirst, ConstItemIterator itLast, ConstItemIterator itEnd, const SelectCtx &ctx) {
+	const SortingEntry &sortEntry = *ctx.sortingCtx.entries[0].data;
+	const QueryEntry *geoEntry = nullptr;
+	for (const QueryEntry &qe : ctx.query.entries) {
+		int idxNo = IndexValueType::SetByJsonPath;
+		if (isGeoCondition(qe.condition) && ns_->getIndexByName(qe.index, idxNo) && idxNo == sortEntry.index) {
+			geoEntry = &qe;
+			break;
+		}
+	}
+	if (!geoEntry) throw Error(errQueryExec, "Sorting by geo index '%s' requires DWITHIN or INBOX condition on it", sortEntry.column);
+
+	// Distance is calculated once per item, not on each comparison
+	GeoPoint center = GeoArea(geoEntry->condition, geoEntry->values).Center();
+	const FieldsSet &fields = ns_->indexes_[sortEntry.index]->Fields();
+	vector<std::pair<double, ItemRef *>> distances;
+	distances.reserve(itEnd - itFirst);
+	for (ItemIterator it = itFirst; it != itEnd; ++it) {
+		GeoPoint p = GetGeoPoint(ConstPayload(ns_->payloadType_, it->value), fields);
+		distances.push_back({p.valid ? GeoDistance(center, p) : std::numeric_limits<double>::max(), &*it});
+	}
+
+	bool desc = sortEntry.desc;
+	std::partial_sort(distances.begin(), distances.begin() + (itLast - itFirst), distances.end(),
+					  [desc](const std::pair<double, ItemRef *> &lhs, const std::pair<double, ItemRef *> &rhs) {
+						  // If distances are equal, then sort by row ID, to give consistent results
+						  if (lhs.first == rhs.first) return desc ? lhs.second->id > rhs.second->id : lhs.second->id < rhs.second->id;
+						  return desc ? lhs.first > rhs.first : lhs.first < rhs.first;
+					  });
+
+	vector<ItemRef> sorted;
+	sorted.reserve(distances.size());
+	for (auto &d : distances) sorted.push_back(std::move(*d.second));
+	std::move(sorted.begin(), sorted.end(), ItemIterator(itFirst));
+}
+
 void NsSelecter::setLimitAndOffset(ItemRefVector &queryResult, size_t offset, size_t limit) {
 	const unsigned totalRows = queryResult.size();
 	if (offset > 0) {
@@ -430,7 +493,8 @@ void NsSelecter::convertWhereValues(QueryEntry &ce) {
 	}
 }
 
-void NsSelecter::prepareIteratorsForSelectLoop(const QueryEntries &entries, RawQueryResult &result, unsigned sortId, bool is_ft) {
+void NsSelecter::prepareIteratorsForSelectLoop(const QueryEntries &entries, RawQueryResult &result, unsigned sortId, bool is_ft,
+												size_t ftTopK) {
 	bool fullText = false;
 	for (size_t i = 0; i < entries.size(); ++i) {
 		const QueryEntry &qe(entries[i]);
@@ -438,6 +502,13 @@ void NsSelecter::prepareIteratorsForSelectLoop(const QueryEntries &entries, RawQ
 		SelectKeyResults selectResults;
 		bool sparseIndex = false;
 		bool byJsonPath = (qe.idxNo == IndexValueType::SetByJsonPath);
+		if (isGeoCondition(qe.condition) && (byJsonPath || !isGeo(ns_->indexes_[qe.idxNo]->Type()))) {
+			throw Error(errQueryExec, "Geo condition on '%s' requires geo index", qe.index);
+		}
+		if (qe.condition == CondLike && !byJsonPath &&
+			(ns_->indexes_[qe.idxNo]->KeyType() != KeyValueString || isFullText(ns_->indexes_[qe.idxNo]->Type()))) {
+			throw Error(errQueryExec, "Condition LIKE on '%s' requires string index", qe.index);
+		}
 		if (byJsonPath) {
 			FieldsSet fields;
 			tagsPath = ns_->tagsMatcher_.path2tag(qe.index);
@@ -460,13 +531,25 @@ void NsSelecter::prepareIteratorsForSelectLoop(const QueryEntries &entries, RawQ
 				type = Index::ForceIdset;
 
 			auto ctx = fnc_ ? fnc_->CreateCtx(qe.idxNo) : BaseFunctionCtx::Ptr{};
-			if (ctx && ctx->type == BaseFunctionCtx::kFtCtx) ft_ctx_ = reindexer::reinterpret_pointer_cast<FtCtx>(ctx);
+			if (ctx && ctx->type == BaseFunctionCtx::kFtCtx) {
+				ft_ctx_ = reindexer::reinterpret_pointer_cast<FtCtx>(ctx);
+				ft_ctx_->SetTopK(ftTopK);
+			}
 
 			if (index->Opts().GetCollateMode() == CollateUTF8 || fullText) {
 				for (auto &key : qe.values) key.EnsureUTF8();
 			}
 			PerfStatCalculatorST calc(index->GetSelectPerfCounter(), ns_->enablePerfCounters_);
-			selectResults = index->SelectKey(qe.values, qe.condition, sortId, type, ctx);
+			if (index->Filter() && !index->Filter()->ImpliedBy(entries)) {
+				// Partial index doesn't contain rows, which may match the query: values are compared in payload
+				SelectKeyResult comparisonResult;
+				comparisonResult.comparators_.push_back(Comparator(qe.condition, index->KeyType(), qe.values, index->Opts().IsArray(),
+																   qe.distinct, ns_->payloadType_, index->Fields(), nullptr,
+																   index->Opts().collateOpts_));
+				selectResults.push_back(comparisonResult);
+			} else {
+				selectResults = index->SelectKey(qe.values, qe.condition, sortId, type, ctx);
+			}
 		}
 		for (SelectKeyResult &res : selectResults) {
 			switch (qe.op) {
@@ -497,6 +580,64 @@ void NsSelecter::prepareIteratorsForSelectLoop(const QueryEntries &entries, RawQ
 	}
 }
 
+// Comparators on columns of '-' indexes are replaced by bitmaps, which are calculated by scan of whole column.
+// It's profitable only if select loop is going to check large part of namespace anyway
+void NsSelecter::applyColumnScans(RawQueryResult &result, SortType sortId) {
+	// Column is indexed by row id, so it can't be used, if rows are iterated in order of sort index
+	if (sortId) return;
+
+	const int itemsCount = ns_->items_.size();
+	int iters = itemsCount;
+	for (const SelectIterator &it : result) {
+		if (!it.comparators_.size() && it.op != OpNot && it.size()) iters = std::min(iters, it.GetMaxIterations());
+	}
+	if (iters < itemsCount / kColumnScanMinRatio) return;
+
+	for (SelectIterator &it : result) {
+		if ((it.op != OpAnd && it.op != OpNot) || it.distinct || it.size() || it.comparators_.size() != 1) continue;
+		IdBitmap::Ptr ids = it.comparators_[0].ScanColumn();
+		if (!ids) continue;
+		// Column keeps values of deleted items
+		for (IdType id : ns_->free_) ids->Reset(id);
+
+		SelectKeyResult res;
+		res.push_back(SingleSelectKeyResult(ids));
+		it = SelectIterator(res, it.op, false, it.name);
+	}
+}
+
+// Conditions on bitmap indexes are merged into single bitmap by bitwise AND/OR/NOT of whole words.
+// Select loop iterates only over resulting ids, and count of them is known without iteration
+void NsSelecter::mergeBitmapIterators(RawQueryResult &result) {
+	h_vector<size_t, 4> ands, nots;
+	for (size_t i = 0; i < result.size(); ++i) {
+		if (!result[i].OnlyBitmaps()) continue;
+		if (result[i].op == OpAnd) ands.push_back(i);
+		if (result[i].op == OpNot) nots.push_back(i);
+	}
+	if (ands.empty() || (ands.size() == 1 && nots.empty() && result[ands[0]].size() == 1)) return;
+
+	IdBitmap::Ptr merged = result[ands[0]].UniteBitmaps();
+	string name = result[ands[0]].name;
+	for (size_t i = 1; i < ands.size(); ++i) {
+		merged->And(*result[ands[i]].UniteBitmaps());
+		name += " AND " + result[ands[i]].name;
+	}
+	for (size_t i : nots) {
+		merged->AndNot(*result[i].UniteBitmaps());
+		name += " AND NOT " + result[i].name;
+	}
+
+	SelectKeyResult res;
+	res.push_back(SingleSelectKeyResult(merged));
+	result[ands[0]] = SelectIterator(res, OpAnd, false, name);
+
+	h_vector<size_t, 4> erased(ands.begin() + 1, ands.end());
+	erased.insert(erased.end(), nots.begin(), nots.end());
+	std::sort(erased.begin(), erased.end());
+	for (size_t i = erased.size(); i > 0; --i) result.erase(result.begin() + erased[i - 1]);
+}
+
 void NsSelecter::prepareEqualPositionComparator(const Query &query, const QueryEntries &entries, RawQueryResult &result) {
 	if (query.equalPositions_.empty()) return;
 	for (const EqualPosition &ep : query.equalPositions_) {
@@ -519,9 +660,9 @@ void NsSelecter::prepareEqualPositionComparator(const Query &query, const QueryE
 	}
 }
 
-bool NsSelecter::proccessJoin(SelectCtx &sctx, IdType properRowId, bool found, bool match, bool hasInnerJoin) {
+bool NsSelecter::proccessJoin(SelectCtx &sctx, IdType properRowId, const PayloadValue &pv, bool found, bool match, bool hasInnerJoin) {
 	// inner join process
-	ConstPayload pl(ns_->payloadType_, ns_->items_[properRowId]);
+	ConstPayload pl(ns_->payloadType_, pv);
 
 	if (hasInnerJoin) {
 		for (size_t i = 0; i < sctx.joinedSelectors->size(); i++) {
@@ -620,7 +761,10 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 
 		bool found = true;
 		assert(static_cast<size_t>(properRowId) < ns_->items_.size());
-		PayloadValue &pv = ns_->items_[properRowId];
+		key_string tupleHolder;
+		PayloadValue residentPv;
+		if (ctx.needTuples) residentPv = ns_->loadEvictedTuple(properRowId, ns_->items_[properRowId], tupleHolder);
+		PayloadValue &pv = ctx.needTuples ? residentPv : ns_->items_[properRowId];
 		assert(pv.Ptr());
 		for (auto cur = ctx.qres->begin() + 1; cur != ctx.qres->end(); cur++) {
 			if (!hasComparators || !cur->TryCompare(pv, properRowId)) {
@@ -649,7 +793,7 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 		}
 
 		if (found && sctx.joinedSelectors) {
-			found = proccessJoin(sctx, properRowId, found, !start && count, hasInnerJoin);
+			found = proccessJoin(sctx, properRowId, pv, found, !start && count, hasInnerJoin);
 		}
 
 		if (found) {
@@ -680,7 +824,7 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 					}
 				}
 				if (!multisortFinished) {
-					addSelectResult(proc, rowId, properRowId, sctx, aggregators, result);
+					addSelectResult(proc, rowId, properRowId, pv, tupleHolder, sctx, aggregators, result);
 				}
 				if (lastResSize < result.Count()) {
 					if (start) {
@@ -693,7 +837,7 @@ void NsSelecter::selectLoop(LoopCtx &ctx, QueryResults &result) {
 			if (start) {
 				--start;
 			} else if (count) {
-				addSelectResult(proc, rowId, properRowId, sctx, aggregators, result);
+				addSelectResult(proc, rowId, properRowId, pv, tupleHolder, sctx, aggregators, result);
 				--count;
 				if (!count && multiSort && !multisortFinished) getSortIndexValue(sortCtx, properRowId, prevValues);
 			}
@@ -743,15 +887,36 @@ void NsSelecter::getSortIndexValue(const SelectCtx::SortingCtx::Entry *sortCtx,
 	}
 }
 
-void NsSelecter::addSelectResult(uint8_t proc, IdType rowId, IdType properRowId, const SelectCtx &sctx,
-								 h_vector<Aggregator, 4> &aggregators, QueryResults &result) {
+void NsSelecter::addSelectResult(uint8_t proc, IdType rowId, IdType properRowId, const PayloadValue &pv, const key_string &tupleHolder,
+								 const SelectCtx &sctx, h_vector<Aggregator, 4> &aggregators, QueryResults &result) {
 	if (aggregators.size()) {
-		for (auto &aggregator : aggregators) aggregator.Aggregate(ns_->items_[properRowId]);
+		for (auto &aggregator : aggregators) aggregator.Aggregate(pv);
 	} else if (sctx.preResult && sctx.preResult->mode == SelectCtx::PreResult::ModeBuild) {
 		sctx.preResult->ids.Add(rowId, IdSet::Unordered, 0);
 	} else {
-		result.Add({properRowId, ns_->items_[properRowId], proc, sctx.nsid});
+		result.Add({properRowId, pv, proc, sctx.nsid});
+		if (tupleHolder) result.stringsHolder.push_back(tupleHolder);
+	}
+}
+
+bool NsSelecter::queryNeedsTuples(const QueryEntries &entries, const SelectCtx &ctx) {
+	for (auto &qe : entries) {
+		if (qe.idxNo == IndexValueType::SetByJsonPath) return true;
+	}
+	for (auto &se : ctx.sortingCtx.entries) {
+		if (se.data->index == IndexValueType::SetByJsonPath) return true;
+	}
+	for (auto &jq : ctx.query.joinQueries_) {
+		for (auto &je : jq.joinEntries_) {
+			if (je.idxNo == IndexValueType::SetByJsonPath) return true;
+		}
 	}
+	// Aggregators of not indexed and sparse fields read values from tuple
+	for (auto &ag : ctx.query.aggregations_) {
+		int idx = -1;
+		if (!ns_->getIndexByName(ag.index_, idx) || ns_->indexes_[idx]->Opts().IsSparse()) return true;
+	}
+	return false;
 }
 
 h_vector<Aggregator, 4> NsSelecter::getAggregators(const Query &q) {
@@ -804,6 +969,203 @@ void NsSelecter::substituteCompositeIndexes(QueryEntries &entries) {
 			fields.clear();
 		}
 	}
+	substituteCompositePrefixes(entries);
+}
+
+// Entry is a member of top level AND chain: it's not combined by OR with the next entry
+static bool isAndChainEntry(const QueryEntries &entries, size_t i) {
+	return entries[i].op == OpAnd && (i + 1 == entries.size() || entries[i + 1].op != OpOr);
+}
+
+static Variant minFieldValue(KeyValueType type) {
+	switch (type) {
+		case KeyValueBool:
+			return Variant(false);
+		case KeyValueInt:
+			return Variant(std::numeric_limits<int>::min());
+		case KeyValueInt64:
+			return Variant(std::numeric_limits<int64_t>::min());
+		case KeyValueDouble:
+			return Variant(-std::numeric_limits<double>::infinity());
+		default:
+			return Variant(string());
+	}
+}
+
+static Variant maxFieldValue(KeyValueType type) {
+	switch (type) {
+		case KeyValueBool:
+			return Variant(true);
+		case KeyValueInt:
+			return Variant(std::numeric_limits<int>::max());
+		case KeyValueInt64:
+			return Variant(std::numeric_limits<int64_t>::max());
+		case KeyValueDouble:
+			return Variant(std::numeric_limits<double>::infinity());
+		default:
+			// Byte 0xFF never occurs in UTF-8, so this string is greater than any stored string in binary order
+			return Variant(string("\xFF"));
+	}
+}
+
+// Replaces value of strict bound by the nearest value, which is greater (or less) than it in binary order of composite index
+// @return false, if there is no such value
+static bool toNonStrictBound(Variant &v, bool greater) {
+	switch (v.Type()) {
+		case KeyValueInt: {
+			int val = v.As<int>();
+			if (val == (greater ? std::numeric_limits<int>::max() : std::numeric_limits<int>::min())) return false;
+			v = Variant(greater ? val + 1 : val - 1);
+			return true;
+		}
+		case KeyValueInt64: {
+			int64_t val = v.As<int64_t>();
+			if (val == (greater ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min())) return false;
+			v = Variant(greater ? val + 1 : val - 1);
+			return true;
+		}
+		case KeyValueDouble: {
+			double val = v.As<double>();
+			if (!std::isfinite(val)) return false;
+			v = Variant(std::nextafter(val, greater ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity()));
+			return true;
+		}
+		case KeyValueString:
+			// The nearest greater string is the string with appended zero byte. There is no nearest less string
+			if (!greater) return false;
+			v = Variant(v.As<string>() + '\0');
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Ordered composite index selects continuous range of keys, when query has equal conditions on leading fields of the index,
+// optionally followed by range condition on the next field. Such conditions are replaced by RANGE condition on composite index.
+// Bounds of range are filled by minimal and maximal values of trailing fields
+void NsSelecter::substituteCompositePrefixes(QueryEntries &entries) {
+	for (;;) {
+		int bestIdx = -1;
+		h_vector<size_t, 4> bestEntries;
+		for (int i = ns_->indexes_.firstCompositePos(); i < ns_->indexes_.totalSize(); ++i) {
+			const auto &index = ns_->indexes_[i];
+			const FieldsSet &fields = index->Fields();
+			if (index->Type() != IndexCompositeBTree || fields.getTagsPathsLength() > 0 || index->Filter()) continue;
+
+			// Fields of index are compared in binary order, so conditions on fields with collate mode can't be substituted
+			auto suitable = [&](const QueryEntry &qe, size_t fieldPos) {
+				if (qe.idxNo != fields[fieldPos] || qe.distinct) return false;
+				const auto &fieldIndex = ns_->indexes_[qe.idxNo];
+				return !fieldIndex->Opts().IsArray() && !fieldIndex->Opts().IsSparse() && fieldIndex->Opts().GetCollateMode() == CollateNone;
+			};
+			h_vector<size_t, 4> used;
+			for (size_t fieldPos = 0; fieldPos < fields.size() && used.size() == fieldPos; ++fieldPos) {
+				for (size_t e = 0; e < entries.size(); ++e) {
+					const QueryEntry &qe = entries[e];
+					if (isAndChainEntry(entries, e) && qe.condition == CondEq && qe.values.size() == 1 &&
+						qe.values[0].Type() != KeyValueNull && suitable(qe, fieldPos)) {
+						used.push_back(e);
+						break;
+					}
+				}
+			}
+			// Equal conditions on all fields are substituted by composite EQ
+			if (used.empty() || used.size() == fields.size()) continue;
+			for (size_t e = 0; e < entries.size(); ++e) {
+				const QueryEntry &qe = entries[e];
+				bool isRange = qe.condition == CondLt || qe.condition == CondLe || qe.condition == CondGt || qe.condition == CondGe ||
+							   (qe.condition == CondRange && qe.values.size() == 2);
+				if (isAndChainEntry(entries, e) && isRange && qe.values.size() && suitable(qe, used.size())) {
+					used.push_back(e);
+					break;
+				}
+			}
+			if (used.size() > bestEntries.size()) {
+				bestIdx = i;
+				bestEntries = used;
+			}
+		}
+		if (bestIdx < 0) return;
+
+		const FieldsSet &fields = ns_->indexes_[bestIdx]->Fields();
+		VariantArray lo, hi;
+		auto fillBounds = [&]() {
+			lo.clear();
+			hi.clear();
+			for (size_t fieldPos = 0; fieldPos < fields.size(); ++fieldPos) {
+				KeyValueType fieldType = ns_->payloadType_.Field(fields[fieldPos]).Type();
+				Variant loVal = minFieldValue(fieldType), hiVal = maxFieldValue(fieldType);
+				if (fieldPos < bestEntries.size()) {
+					const QueryEntry &qe = entries[bestEntries[fieldPos]];
+					VariantArray values = qe.values;
+					for (auto &v : values) v.convert(fieldType);
+					switch (qe.condition) {
+						case CondEq:
+							loVal = hiVal = values[0];
+							break;
+						case CondGt:
+							if (!toNonStrictBound(values[0], true)) return false;
+							loVal = values[0];
+							break;
+						case CondGe:
+							loVal = values[0];
+							break;
+						case CondLt:
+							if (!toNonStrictBound(values[0], false)) return false;
+							hiVal = values[0];
+							break;
+						case CondLe:
+							hiVal = values[0];
+							break;
+						default:
+							loVal = values[0];
+							hiVal = values[1];
+							break;
+					}
+				}
+				lo.push_back(loVal);
+				hi.push_back(hiVal);
+			}
+			return true;
+		};
+		if (!fillBounds()) {
+			// Range condition can't be expressed by bounds: only equal conditions are substituted, range condition is kept as is
+			bestEntries.pop_back();
+			fillBounds();
+		}
+
+		QueryEntry ce(OpAnd, CondRange, ns_->indexes_[bestIdx]->Name(), bestIdx);
+		ce.values.push_back(Variant(lo));
+		ce.values.push_back(Variant(hi));
+		std::sort(bestEntries.begin(), bestEntries.end());
+		entries[bestEntries[0]] = std::move(ce);
+		for (size_t i = bestEntries.size() - 1; i > 0; --i) entries.erase(entries.begin() + bestEntries[i]);
+	}
+}
+
+// Rows of range of ordered composite index are ordered by the field, if values of all preceding fields are the same in both bounds of range
+void NsSelecter::substituteCompositeSort(const QueryEntries &entries, SortingEntries &sortBy) {
+	if (sortBy.size() != 1 || sortBy[0].index < 0 || sortBy[0].index >= ns_->indexes_.firstCompositePos()) return;
+	const auto &sortIndex = ns_->indexes_[sortBy[0].index];
+	if (sortIndex->Opts().IsArray() || sortIndex->Opts().IsSparse() || sortIndex->Opts().GetCollateMode() != CollateNone) return;
+
+	for (size_t i = 0; i < entries.size(); ++i) {
+		const QueryEntry &qe = entries[i];
+		if (!isAndChainEntry(entries, i) || qe.condition != CondRange || qe.idxNo < ns_->indexes_.firstCompositePos()) continue;
+		const auto &index = ns_->indexes_[qe.idxNo];
+		const FieldsSet &fields = index->Fields();
+		if (index->Type() != IndexCompositeBTree || fields.getTagsPathsLength() > 0) continue;
+		FieldsSet prefix;
+		size_t fieldPos = 0;
+		while (fieldPos < fields.size() && fields[fieldPos] != sortBy[0].index) prefix.push_back(fields[fieldPos++]);
+		if (fieldPos == 0 || fieldPos == fields.size()) continue;
+		const PayloadValue &lo(qe.values[0]);
+		if (ConstPayload(ns_->payloadType_, lo).Compare(static_cast<const PayloadValue &>(qe.values[1]), prefix) != 0) continue;
+
+		sortBy[0].column = index->Name();
+		sortBy[0].index = qe.idxNo;
+		return;
+	}
 }
 
 SortingEntries NsSelecter::detectOptimalSortOrder(const QueryEntries &entries) {
@@ -828,6 +1190,8 @@ SortingEntries NsSelecter::detectOptimalSortOrder(const QueryEntries &entries) {
 int NsSelecter::getCompositeIndex(const FieldsSet &fields) {
 	if (fields.getTagsPathsLength() == 0) {
 		for (int i = ns_->indexes_.firstCompositePos(); i < ns_->indexes_.totalSize(); i++) {
+			// Geo index can't select exact values of its fields. Partial index doesn't contain all rows
+			if (isGeo(ns_->indexes_[i]->Type()) || ns_->indexes_[i]->Filter()) continue;
 			if (ns_->indexes_[i]->Fields().contains(fields)) return i;
 		}
 	}
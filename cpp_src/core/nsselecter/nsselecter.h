@@ -75,6 +75,8 @@ private:
 		LoopCtx(SelectCtx &ctx) : sctx(ctx) {}
 		RawQueryResult *qres = nullptr;
 		bool calcTotal = false;
+		// Evicted tuples of items must be loaded to evaluate query
+		bool needTuples = false;
 		SelectCtx &sctx;
 	};
 
@@ -85,16 +87,21 @@ private:
 	using ItemIterator = ItemRefVector::iterator;
 	using ConstItemIterator = const ItemIterator &;
 	void applyGeneralSort(ConstItemIterator itFirst, ConstItemIterator itLast, ConstItemIterator itEnd, const SelectCtx &ctx);
+	void applyDistanceSort(ConstItemIterator itFirst, ConstItemIterator itLast, ConstItemIterator itEnd, const SelectCtx &ctx);
 
 	bool containsFullTextIndexes(const QueryEntries &entries);
-	void prepareIteratorsForSelectLoop(const QueryEntries &entries, RawQueryResult &result, SortType sortId, bool is_ft);
+	void prepareIteratorsForSelectLoop(const QueryEntries &entries, RawQueryResult &result, SortType sortId, bool is_ft, size_t ftTopK);
 	void prepareEqualPositionComparator(const Query &query, const QueryEntries &entries, RawQueryResult &result);
-	void addSelectResult(uint8_t proc, IdType rowId, IdType properRowId, const SelectCtx &sctx, h_vector<Aggregator, 4> &aggregators,
-						 QueryResults &result);
+	void applyColumnScans(RawQueryResult &result, SortType sortId);
+	void mergeBitmapIterators(RawQueryResult &result);
+	void addSelectResult(uint8_t proc, IdType rowId, IdType properRowId, const PayloadValue &pv, const key_string &tupleHolder,
+						 const SelectCtx &sctx, h_vector<Aggregator, 4> &aggregators, QueryResults &result);
 	QueryEntries lookupQueryIndexes(const QueryEntries &entries);
 	void convertWhereValues(QueryEntry &ce);
 
 	void substituteCompositeIndexes(QueryEntries &entries);
+	void substituteCompositePrefixes(QueryEntries &entries);
+	void substituteCompositeSort(const QueryEntries &entries, SortingEntries &sortBy);
 	SortingEntries detectOptimalSortOrder(const QueryEntries &entries);
 	h_vector<Aggregator, 4> getAggregators(const Query &q);
 	int getCompositeIndex(const FieldsSet &fieldsmask);
@@ -104,7 +111,8 @@ private:
 	void prepareSortingContext(const SortingEntries &sortBy, SelectCtx &ctx, bool isFt);
 	void prepareSortingIndexes(SortingEntries &sortBy);
 	void getSortIndexValue(const SelectCtx::SortingCtx::Entry *sortCtx, IdType rowId, VariantArray &value);
-	bool proccessJoin(SelectCtx &sctx, IdType properRowId, bool found, bool match, bool hasInnerJoin);
+	bool proccessJoin(SelectCtx &sctx, IdType properRowId, const PayloadValue &pv, bool found, bool match, bool hasInnerJoin);
+	bool queryNeedsTuples(const QueryEntries &entries, const SelectCtx &ctx);
 
 	Namespace *ns_;
 	SelectFunction::Ptr fnc_;
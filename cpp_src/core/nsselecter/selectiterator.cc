@@ -21,7 +21,17 @@ void SelectIterator::Start(bool reverse) {
 	lastIt_ = begin();
 
 	for (auto it = begin(); it != end(); it++) {
-		if (it->isRange_) {
+		if (it->useBitmap_) {
+			if (isReverse_) {
+				it->rrBegin_ = it->bitmap_->Capacity() - 1;
+				it->rrEnd_ = -1;
+				it->rrIt_ = it->rrBegin_;
+			} else {
+				it->rBegin_ = 0;
+				it->rEnd_ = it->bitmap_->Capacity();
+				it->rIt_ = it->rBegin_;
+			}
+		} else if (it->isRange_) {
 			if (isReverse_) {
 				auto rrBegin = it->rEnd_ - 1;
 				it->rrEnd_ = it->rBegin_ - 1;
@@ -61,9 +71,9 @@ void SelectIterator::Start(bool reverse) {
 	if (isUnsorted) {
 		type_ = Unsorted;
 
-	} else if (size() == 1 && !isReverse_) {
+	} else if (size() == 1 && !begin()->useBitmap_ && !isReverse_) {
 		type_ = begin()->isRange_ ? SingleRange : SingleIdset;
-	} else if (size() == 1) {
+	} else if (size() == 1 && !begin()->useBitmap_) {
 		type_ = begin()->isRange_ ? RevSingleRange : RevSingleIdset;
 	}
 	if (size() == 0) {
@@ -77,7 +87,15 @@ bool SelectIterator::nextFwd(IdType minHint) {
 	if (minHint > lastVal_) lastVal_ = minHint - 1;
 	int minVal = INT_MAX;
 	for (auto it = begin(); it != end(); it++) {
-		if (it->useBtree_) {
+		if (it->useBitmap_) {
+			if (it->rIt_ != it->rEnd_) {
+				it->rIt_ = it->bitmap_->Next(max(it->rIt_, lastVal_ + 1));
+				if (it->rIt_ != it->rEnd_ && it->rIt_ < minVal) {
+					minVal = it->rIt_;
+					lastIt_ = it;
+				}
+			}
+		} else if (it->useBtree_) {
 			if (it->itset_ != it->setend_) {
 				it->itset_ = it->set_->upper_bound(lastVal_);
 				if (it->itset_ != it->setend_ && *it->itset_ < minVal) {
@@ -113,6 +131,16 @@ bool SelectIterator::nextRev(IdType maxHint) {
 
 	int maxVal = INT_MIN;
 	for (auto it = begin(); it != end(); it++) {
+		if (it->useBitmap_) {
+			if (it->rrIt_ != it->rrEnd_) {
+				it->rrIt_ = it->bitmap_->Prev(min(it->rrIt_, lastVal_ - 1));
+				if (it->rrIt_ != it->rrEnd_ && it->rrIt_ > maxVal) {
+					maxVal = it->rrIt_;
+					lastIt_ = it;
+				}
+			}
+			continue;
+		}
 		if (it->useBtree_ && it->ritset_ != it->setrend_) {
 			for (; it->ritset_ != it->setrend_ && *it->ritset_ >= lastVal_; ++it->ritset_) {
 			}
@@ -230,7 +258,13 @@ bool SelectIterator::nextUnsorted() {
 void SelectIterator::ExcludeLastSet() {
 	if (!End() && lastIt_ != end()) {
 		assert(!lastIt_->isRange_);
-		if (lastIt_->useBtree_) {
+		if (lastIt_->useBitmap_) {
+			if (isReverse_) {
+				lastIt_->rrIt_ = lastIt_->rrEnd_;
+			} else {
+				lastIt_->rIt_ = lastIt_->rEnd_;
+			}
+		} else if (lastIt_->useBtree_) {
 			lastIt_->itset_ = lastIt_->setend_;
 			lastIt_->ritset_ = lastIt_->setrend_;
 		} else {
@@ -280,6 +314,8 @@ int SelectIterator::GetMaxIterations() const {
 	for (const SingleSelectKeyResult &r : *this) {
 		if (r.isRange_) {
 			cnt += std::abs(r.rEnd_ - r.rBegin_);
+		} else if (r.useBitmap_) {
+			cnt += r.bitmap_->Count();
 		} else if (r.useBtree_) {
 			cnt += r.set_->size();
 		} else {
@@ -289,6 +325,21 @@ int SelectIterator::GetMaxIterations() const {
 	return cnt;
 }
 
+bool SelectIterator::OnlyBitmaps() const {
+	if (distinct || comparators_.size() || !size()) return false;
+	for (const SingleSelectKeyResult &r : *this) {
+		if (!r.useBitmap_) return false;
+	}
+	return true;
+}
+
+IdBitmap::Ptr SelectIterator::UniteBitmaps() const {
+	assert(OnlyBitmaps());
+	auto united = std::make_shared<IdBitmap>(*begin()->bitmap_);
+	for (auto it = begin() + 1; it != end(); ++it) united->Or(*it->bitmap_);
+	return united;
+}
+
 const char *SelectIterator::TypeName() const {
 	switch (type_) {
 		case Forward:
@@ -317,6 +368,7 @@ string SelectIterator::Dump() const {
 
 	for (auto &it : *this) {
 		if (it.useBtree_) ret += "btree;";
+		if (it.useBitmap_) ret += "bitmap;";
 		if (it.isRange_) ret += "range;";
 		if (it.bsearch_) ret += "bsearch;";
 		ret += ",";
@@ -120,6 +120,15 @@ public:
 	/// each object in sequence.
 	void SetExpectMaxIterations(int expectedIterations_);
 
+	/// Checks if all the results are bitmaps without
+	/// comparators, so they can be merged with bitmaps
+	/// of other conditions by bitwise operations.
+	/// @return true if iterator contains only bitmaps.
+	bool OnlyBitmaps() const;
+	/// Unites all the bitmaps of result by bitwise OR.
+	/// @return new bitmap, which can be modified.
+	IdBitmap::Ptr UniteBitmaps() const;
+
 	int Type() { return type_; }
 
 	const char *TypeName() const;
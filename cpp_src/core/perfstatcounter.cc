@@ -73,6 +73,22 @@ void PerfStatCounter<Mutex>::lap() {
 	lastValuesUs.reserve(kMaxValuesCountForStddev);
 }
 
+LatencyHistogram::LatencyHistogram() : totalCount_(0), totalTimeUs_(0), maxTimeUs_(0) {
+	for (auto &b : buckets_) b = 0;
+}
+
+void LatencyHistogram::Hit(std::chrono::microseconds time) {
+	size_t us = time.count();
+	int bucket = 0;
+	while (bucket < kBucketsCount - 1 && (size_t(1) << bucket) < us) bucket++;
+	buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+	totalCount_.fetch_add(1, std::memory_order_relaxed);
+	totalTimeUs_.fetch_add(us, std::memory_order_relaxed);
+	size_t prevMax = maxTimeUs_.load(std::memory_order_relaxed);
+	while (prevMax < us && !maxTimeUs_.compare_exchange_weak(prevMax, us, std::memory_order_relaxed)) {
+	}
+}
+
 template class PerfStatCounter<std::mutex>;
 template class PerfStatCounter<dummy_mutex>;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdlib.h>
+#include <atomic>
 #include <chrono>
 #include <mutex>
 #include <vector>
@@ -74,4 +75,29 @@ public:
 };
 using PerfStatCalculatorMT = PerfStatCalculator<std::mutex>;
 using PerfStatCalculatorST = PerfStatCalculator<dummy_mutex>;
+
+// Lock free latency histogram. Upper bound of i-th bucket is 2^i microseconds, last bucket collects everything above
+class LatencyHistogram {
+public:
+	static const int kBucketsCount = 24;
+
+	LatencyHistogram();
+	void Hit(std::chrono::microseconds time);
+	template <class T>
+	T Get() const {
+		T ret;
+		ret.totalCount = totalCount_.load(std::memory_order_relaxed);
+		ret.avgTimeUs = ret.totalCount ? totalTimeUs_.load(std::memory_order_relaxed) / ret.totalCount : 0;
+		ret.maxTimeUs = maxTimeUs_.load(std::memory_order_relaxed);
+		ret.buckets.resize(kBucketsCount);
+		for (int i = 0; i < kBucketsCount; i++) ret.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+		return ret;
+	}
+
+protected:
+	std::atomic<size_t> buckets_[kBucketsCount];
+	std::atomic<size_t> totalCount_;
+	std::atomic<size_t> totalTimeUs_;
+	std::atomic<size_t> maxTimeUs_;
+};
 }  // namespace reindexer
@@ -27,6 +27,7 @@ const unordered_map<Filter, string, EnumClassHash> filter_map = {
 const unordered_map<CondType, string, EnumClassHash> cond_map = {
 	{CondAny, "any"},	 {CondEq, "eq"},   {CondLt, "lt"},			{CondLe, "le"},		  {CondGt, "gt"},	{CondGe, "ge"},
 	{CondRange, "range"}, {CondSet, "set"}, {CondAllSet, "allset"}, {CondEmpty, "empty"}, {CondEq, "match"},
+	{CondDWithin, "dwithin"}, {CondInBox, "inbox"}, {CondLike, "like"},
 };
 
 const unordered_map<OpType, string, EnumClassHash> op_map = {{OpOr, "or"}, {OpAnd, "and"}, {OpNot, "not"}};
@@ -52,6 +52,7 @@ static const fast_hash_map<string, Filter> filter_map = {
 static const fast_hash_map<string, CondType> cond_map = {
 	{"any", CondAny},	 {"eq", CondEq},   {"lt", CondLt},			{"le", CondLe},		  {"gt", CondGt},	{"ge", CondGe},
 	{"range", CondRange}, {"set", CondSet}, {"allset", CondAllSet}, {"empty", CondEmpty}, {"match", CondEq},
+	{"dwithin", CondDWithin}, {"inbox", CondInBox}, {"like", CondLike},
 };
 
 static const fast_hash_map<string, OpType> op_map = {{"or", OpOr}, {"and", OpAnd}, {"not", OpNot}};
@@ -179,6 +180,7 @@ void parseFilter(JsonValue& filter, Query& q) {
 		case CondEq:
 		case CondLt:
 		case CondLe:
+		case CondLike:
 			if (qe.values.size() != 1) {
 				throw Error(errLogic, "Condition %d must have exact 1 value, but %d values was provided", qe.condition, qe.values.size());
 			}
@@ -193,6 +195,16 @@ void parseFilter(JsonValue& filter, Query& q) {
 				throw Error(errLogic, "Condition SET must have at least 1 value, but %d values was provided", qe.values.size());
 			}
 			break;
+		case CondDWithin:
+			if (qe.values.size() != 3) {
+				throw Error(errLogic, "Condition DWITHIN must have exact 3 values, but %d values was provided", qe.values.size());
+			}
+			break;
+		case CondInBox:
+			if (qe.values.size() != 4) {
+				throw Error(errLogic, "Condition INBOX must have exact 4 values, but %d values was provided", qe.values.size());
+			}
+			break;
 		case CondAny:
 		case CondAllSet:
 			if (qe.values.size() != 0) {
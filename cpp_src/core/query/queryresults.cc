@@ -34,6 +34,7 @@ QueryResults &QueryResults::operator=(QueryResults &&obj) noexcept {
 		nonCacheableData = std::move(obj.nonCacheableData);
 		lockedResults_ = std::move(obj.lockedResults_);
 		explainResults = std::move(obj.explainResults);
+		stringsHolder = std::move(obj.stringsHolder);
 		aggregationResults = std::move(obj.aggregationResults);
 		obj.lockedResults_ = false;
 	}
@@ -104,6 +104,8 @@ public:
 	int totalCount = 0;
 	bool haveProcent = false;
 	bool nonCacheableData = false;
+	// Strings, which are referenced by items, but are not owned by namespace. E.g. tuples of items, loaded from storage
+	vector<key_string> stringsHolder;
 
 	struct Context;
 	// precalc context size
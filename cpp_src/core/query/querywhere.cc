@@ -68,6 +68,12 @@ CondType QueryWhere::getCondType(string_view cond) {
 		return CondSet;
 	} else if (iequals(cond, "range"_sv)) {
 		return CondRange;
+	} else if (iequals(cond, "dwithin"_sv)) {
+		return CondDWithin;
+	} else if (iequals(cond, "inbox"_sv)) {
+		return CondInBox;
+	} else if (iequals(cond, "like"_sv)) {
+		return CondLike;
 	}
 	throw Error(errParseSQL, "Expected condition operator, but found '%s' in query", cond);
 }
@@ -191,7 +197,7 @@ int QueryWhere::ParseWhere(tokenizer &parser) {
 	return 0;
 }
 
-const char *condNames[] = {"IS NOT NULL", "=", "<", "<=", ">", "=>", "RANGE", "IN", "ALLSET", "IS NULL"};
+const char *condNames[] = {"IS NOT NULL", "=", "<", "<=", ">", "=>", "RANGE", "IN", "ALLSET", "IS NULL", "DWITHIN", "INBOX", "LIKE"};
 const char *opNames[] = {"-", "OR", "AND", "AND NOT"};
 
 void QueryWhere::dumpWhere(WrSerializer &ser, bool stripArgs) const {
@@ -6,6 +6,8 @@ namespace reindexer {
 Reindexer::Reindexer() { impl_ = new ReindexerImpl(); }
 Reindexer::~Reindexer() { delete impl_; }
 Error Reindexer::Connect(const string& dsn) { return impl_->Connect(dsn); }
+Error Reindexer::Backup(const string& dir) { return impl_->Backup(dir); }
+Error Reindexer::Restore(const string& dir) { return impl_->Restore(dir); }
 Error Reindexer::EnableStorage(const string& storagePath, bool skipPlaceholderCheck) {
 	return impl_->EnableStorage(storagePath, skipPlaceholderCheck);
 }
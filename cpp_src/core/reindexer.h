@@ -31,7 +31,8 @@ public:
 	Reindexer(const Reindexer &) = delete;
 
 	/// Connect - connect to reindexer database in embeded mode
-	/// @param dsn - uri of database, like: `builtin:///var/lib/reindexer/dbname` or just `/var/lib/reindexer/dbname`
+	/// @param dsn - uri of database, like: `builtin:///var/lib/reindexer/dbname` or just `/var/lib/reindexer/dbname`.
+	/// Storage engine of new database may be set with `engine` parameter: `builtin:///var/lib/reindexer/dbname?engine=logstorage`
 	Error Connect(const string &dsn);
 
 	/// Enable storage. Must be called before InitSystemNamespaces
@@ -39,6 +40,15 @@ public:
 	/// @param skipPlaceholderCheck - If set, then reindexer will not check folder for placeholder
 	Error EnableStorage(const string &storagePath, bool skipPlaceholderCheck = false);
 
+	/// Make online backup of all namespaces. Backup is consistent across namespaces:
+	/// storage snapshots of all namespaces are taken at the same moment. Then snapshots are copied in parallel.
+	/// @param dir - file system path to directory for backup files. Must not contain another backup
+	Error Backup(const string &dir);
+	/// Restore namespaces from backup, made by Backup. Existing namespaces with the same names are dropped.
+	/// Storage records are restored as is, without documents re-encoding
+	/// @param dir - file system path to directory with backup files
+	Error Restore(const string &dir);
+
 	/// Open or create namespace
 	/// @param nsName - Name of namespace
 	/// @param opts - Storage options. Can be one of <br>
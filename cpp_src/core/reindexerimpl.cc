@@ -8,11 +8,14 @@
 #include "core/itemimpl.h"
 #include "core/namespacedef.h"
 #include "core/selectfunc/selectfunc.h"
+#include "core/storage/backupfile.h"
 #include "kx/kxsort.h"
 #include "replicator/replicator.h"
 #include "tools/errors.h"
 #include "tools/fsops.h"
 #include "tools/logger.h"
+#include "tools/jsontools.h"
+#include "tools/stringstools.h"
 
 using std::lock_guard;
 using std::string;
@@ -26,18 +29,22 @@ const char* kNamespacesNamespace = "#namespaces";
 const char* kConfigNamespace = "#config";
 const char* kStoragePlaceholderFilename = ".reindexer.storage";
 const char* kReplicationConfFilename = "replication.conf";
+const char* kBackupManifestFilename = "backup.json";
+const char* kBackupFileExt = ".rxbak";
 
 namespace reindexer {
 
-ReindexerImpl::ReindexerImpl() : replicator_(new Replicator(this)) {
+ReindexerImpl::ReindexerImpl() : storageWriter_(std::make_shared<datastorage::StorageWriter>()), replicator_(new Replicator(this)) {
 	stopBackgroundThread_ = false;
 	configProvider_.setHandler(ProfilingConf, std::bind(&ReindexerImpl::onProfiligConfigLoad, this));
+	configProvider_.setHandler(StorageConf, std::bind(&ReindexerImpl::onStorageConfigLoad, this));
 	backgroundThread_ = std::thread([this]() { this->backgroundRoutine(); });
 }
 
 ReindexerImpl::~ReindexerImpl() {
 	stopBackgroundThread_ = true;
 	backgroundThread_.join();
+	storageWriter_->Stop();
 }
 
 Error ReindexerImpl::EnableStorage(const string& storagePath, bool skipPlaceholderCheck) {
@@ -67,7 +74,15 @@ Error ReindexerImpl::EnableStorage(const string& storagePath, bool skipPlacehold
 	if (!isEmpty && !skipPlaceholderCheck) {
 		FILE* f = fopen(fs::JoinPath(storagePath, kStoragePlaceholderFilename).c_str(), "r");
 		if (f) {
+			// Placeholder contains name of storage engine, which was used to create database
+			char engine[32] = {0};
+			size_t len = fread(engine, 1, sizeof(engine) - 1, f);
 			fclose(f);
+			try {
+				storageType_ = datastorage::StorageFactory::TypeFromName(string(engine, len));
+			} catch (const Error& err) {
+				return err;
+			}
 		} else {
 			return Error(errParams, "Cowadly refusing to use directory '%s' - it's not empty, and doesn't contains reindexer placeholder",
 						 storagePath);
@@ -75,7 +90,8 @@ Error ReindexerImpl::EnableStorage(const string& storagePath, bool skipPlacehold
 	} else {
 		FILE* f = fopen(fs::JoinPath(storagePath, kStoragePlaceholderFilename).c_str(), "w");
 		if (f) {
-			fwrite("leveldb", 7, 1, f);
+			const char* engine = datastorage::StorageFactory::TypeName(storageType_);
+			fwrite(engine, strlen(engine), 1, f);
 			fclose(f);
 		} else {
 			return Error(errParams, "Can't create placeholder in directory '%s' for reindexer storage - reason %s", storagePath,
@@ -94,6 +110,21 @@ Error ReindexerImpl::Connect(const string& dsn) {
 	if (dsn.compare(0, 10, "builtin://") == 0) {
 		path = dsn.substr(10);
 	}
+	// Storage engine for new database may be set with dsn parameter, like `builtin:///var/lib/reindexer/dbname?engine=logstorage`
+	auto pos = path.find('?');
+	if (pos != string::npos) {
+		vector<string> params;
+		split(path.substr(pos + 1), "&", true, params);
+		path.resize(pos);
+		for (auto& param : params) {
+			if (param.compare(0, 7, "engine=") != 0) continue;
+			try {
+				storageType_ = datastorage::StorageFactory::TypeFromName(param.substr(7));
+			} catch (const Error& err) {
+				return err;
+			}
+		}
+	}
 
 	auto err = EnableStorage(path);
 	if (!err.ok()) return err;
@@ -141,9 +172,9 @@ Error ReindexerImpl::AddNamespace(const NamespaceDef& nsDef) {
 			return Error(errParams, "Namespace name contains invalid character. Only alphas, digits,'_','-, are allowed");
 		}
 		bool readyToLoadStorage = (nsDef.storage.IsEnabled() && !storagePath_.empty());
-		ns = std::make_shared<Namespace>(nsDef.name, observers_);
+		ns = std::make_shared<Namespace>(nsDef.name, observers_, storageWriter_);
 		if (readyToLoadStorage) {
-			ns->EnableStorage(storagePath_, nsDef.storage);
+			ns->EnableStorage(storagePath_, nsDef.storage, storageType_);
 		}
 		ns->onConfigUpdated(configProvider_);
 		if (readyToLoadStorage) {
@@ -178,10 +209,13 @@ Error ReindexerImpl::OpenNamespace(string_view name, const StorageOpts& storageO
 			return Error(errParams, "Namespace name contains invalid character. Only alphas, digits,'_','-, are allowed");
 		}
 		auto nameStr = name.ToString();
-		ns = std::make_shared<Namespace>(nameStr, observers_);
-		if (storageOpts.IsEnabled() && !storagePath_.empty()) {
-			ns->EnableStorage(storagePath_, storageOpts);
-			ns->onConfigUpdated(configProvider_);
+		ns = std::make_shared<Namespace>(nameStr, observers_, storageWriter_);
+		bool readyToLoadStorage = (storageOpts.IsEnabled() && !storagePath_.empty());
+		if (readyToLoadStorage) {
+			ns->EnableStorage(storagePath_, storageOpts, storageType_);
+		}
+		ns->onConfigUpdated(configProvider_);
+		if (readyToLoadStorage) {
 			if (!ns->getStorageOpts().IsLazyLoad()) ns->LoadFromStorage();
 		}
 		{
@@ -313,6 +347,14 @@ Error ReindexerImpl::CommitTransaction(Transaction& tr) {
 	}
 	if (ns) ns->EndTransaction();
 
+	if (err.ok() && storageWriter_->GetPolicy() == datastorage::StorageFlushPolicy::PerCommit) {
+		try {
+			ns->FlushStorage();
+		} catch (const Error& e) {
+			err = e;
+		}
+	}
+
 	if (trAccessor->GetCmpl()) trAccessor->GetCmpl()(err);
 	return err;
 }
@@ -560,6 +602,8 @@ JoinedSelectors ReindexerImpl::prepareJoinedSelectors(const Query& q, QueryResul
 			if (joinRes.needPut) {
 				jns->PutToJoinCache(joinRes, preResult);
 			}
+			// Outer row is pruned without select, if joined namespace doesn't contain its keys
+			if (jns->joinKeysAbsent(pjItemQ->entries)) return false;
 			if (joinResLong.haveData) {
 				found = joinResLong.it.val.ids_->size();
 				matchedAtLeastOnce = joinResLong.it.val.matchedAtLeastOnce;
@@ -677,10 +721,9 @@ void ReindexerImpl::doSelect(const Query& q, QueryResults& result, NsLocker& loc
 	result.lockResults();
 }
 
-Error ReindexerImpl::Commit(string_view /*_namespace*/) {
+Error ReindexerImpl::Commit(string_view nsName) {
 	try {
-		// getNamespace(_namespace)->FlushStorage();
-
+		getNamespace(nsName)->FlushStorage();
 	} catch (const Error& err) {
 		return err;
 	}
@@ -775,7 +818,7 @@ Error ReindexerImpl::EnumNamespaces(vector<NamespaceDef>& defs, bool bEnumAll) {
 				}
 				unique_ptr<Namespace> tmpNs(new Namespace(d.name, observers_));
 				try {
-					tmpNs->EnableStorage(storagePath_, StorageOpts());
+					tmpNs->EnableStorage(storagePath_, StorageOpts(), storageType_);
 					defs.push_back(tmpNs->GetDefinition());
 				} catch (reindexer::Error) {
 				}
@@ -865,7 +908,10 @@ std::vector<string> defDBConfig = {
 				"log_level":"none",
 				"lazyload":false,
 				"unload_idle_threshold":0,
-				"join_cache_mode":"on"
+				"join_cache_mode":"on",
+				"storage_compression":false,
+				"documents_memory_limit":0,
+				"online_index_build":false
 			}
     	]
 	})json",
@@ -879,6 +925,13 @@ std::vector<string> defDBConfig = {
 			"force_sync_on_wrong_data_hash": false,
 			"namespaces":[]
 		}
+    })json",
+	R"json({
+        "type":"storage",
+        "storage":{
+			"flush_mode":"async",
+			"sync_interval_ms":1000
+		}
     })json"};
 
 Error ReindexerImpl::InitSystemNamespaces() {
@@ -1022,6 +1075,22 @@ void ReindexerImpl::onProfiligConfigLoad() {
 	Delete(Query(kPerfStatsNamespace), qr1);
 }
 
+void ReindexerImpl::onStorageConfigLoad() {
+	StorageConfigData storageCfg = configProvider_.GetStorageConfig();
+	datastorage::StorageFlushPolicy policy = datastorage::StorageFlushPolicy::Async;
+	switch (storageCfg.flushMode) {
+		case StorageFlushPeriodic:
+			policy = datastorage::StorageFlushPolicy::Periodic;
+			break;
+		case StorageFlushPerCommit:
+			policy = datastorage::StorageFlushPolicy::PerCommit;
+			break;
+		default:
+			break;
+	}
+	storageWriter_->SetPolicy(policy, std::chrono::milliseconds(storageCfg.syncIntervalMs));
+}
+
 Error ReindexerImpl::SubscribeUpdates(IUpdatesObserver* observer, bool subscribe) {
 	if (subscribe) {
 		return observers_.Add(observer);
@@ -1030,4 +1099,206 @@ Error ReindexerImpl::SubscribeUpdates(IUpdatesObserver* observer, bool subscribe
 	}
 }
 
+// Runs fn(i) for i in [0,count) on pool of threads
+static void parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+	size_t threadsCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), 8);
+	threadsCount = std::min(threadsCount, count);
+	std::atomic<size_t> next(0);
+	vector<std::thread> threads;
+	for (size_t t = 0; t < threadsCount; ++t) {
+		threads.emplace_back([&]() {
+			for (size_t i = next++; i < count; i = next++) fn(i);
+		});
+	}
+	for (auto& th : threads) th.join();
+}
+
+Error ReindexerImpl::Backup(const string& dir) {
+	struct NsBackup {
+		Namespace::Ptr ns;
+		datastorage::Snapshot::Ptr snapshot;
+		int64_t lsn = -1;
+		size_t records = 0, bytes = 0;
+		Error err;
+	};
+
+	if (storagePath_.empty()) return Error(errParams, "Can't backup database without storage");
+	if (fs::MkDirAll(dir) < 0) return Error(errParams, "Can't create backup directory '%s': %s", dir, strerror(errno));
+	if (fs::Stat(fs::JoinPath(dir, kBackupManifestFilename)) != fs::StatError) {
+		return Error(errConflict, "Directory '%s' already contains backup", dir);
+	}
+
+	auto tmStart = std::chrono::high_resolution_clock::now();
+	vector<NsBackup> backups;
+	try {
+		for (auto& ns : getNamespaces()) {
+			if (ns->isSystem()) continue;
+			ensureDataLoaded(ns);
+			backups.emplace_back();
+			backups.back().ns = ns;
+		}
+		std::sort(backups.begin(), backups.end(), [](const NsBackup& l, const NsBackup& r) { return l.ns->GetName() < r.ns->GetName(); });
+
+		// Read locks of all namespaces are held while snapshots are taken, so all snapshots correspond to the same moment.
+		// Selects are not blocked, modifications are blocked only for the time of flush
+		vector<shared_lock<shared_timed_mutex>> locks;
+		locks.reserve(backups.size());
+		for (auto& b : backups) {
+			locks.emplace_back(b.ns->mtx_);
+			b.ns->doFlushStorage();
+		}
+		for (auto& b : backups) {
+			auto& ns = *b.ns;
+			if (!ns.storage_) {
+				logPrintf(LogWarning, "Namespace '%s' has no storage. Skipping it in backup", ns.name_);
+				continue;
+			}
+			ns.waitFlushStorage();
+			b.snapshot = ns.storage_->MakeSnapshot();
+			b.lsn = ns.repl_.slaveMode ? ns.repl_.lastLsn : ns.wal_.LSNCounter() - 1;
+		}
+	} catch (const Error& err) {
+		for (auto& b : backups) {
+			if (b.snapshot) b.ns->storage_->ReleaseSnapshot(b.snapshot);
+		}
+		return err;
+	}
+
+	backups.erase(std::remove_if(backups.begin(), backups.end(), [](const NsBackup& b) { return !b.snapshot; }), backups.end());
+	parallelFor(backups.size(), [&](size_t i) {
+		auto& b = backups[i];
+		// Snapshot is released on every path: cursors of storage throw on read errors
+		struct SnapshotReleaser {
+			~SnapshotReleaser() {
+				b.ns->storage_->ReleaseSnapshot(b.snapshot);
+				b.snapshot.reset();
+			}
+			NsBackup& b;
+		} releaser{b};
+		try {
+			b.err = datastorage::BackupStorage(*b.ns->storage_, b.snapshot, fs::JoinPath(dir, b.ns->GetName() + kBackupFileExt),
+											   b.records, b.bytes);
+		} catch (const Error& err) {
+			b.err = err;
+		} catch (const std::exception& err) {
+			b.err = Error(errLogic, "%s", err.what());
+		} catch (...) {
+			b.err = Error(errLogic, "Unknown exception");
+		}
+	});
+
+	WrSerializer ser;
+	{
+		JsonBuilder builder(ser);
+		builder.Put("version", 1);
+		builder.Put("engine", datastorage::StorageFactory::TypeName(storageType_));
+		builder.Put("created_unix_nano",
+					std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		auto arr = builder.Array("namespaces");
+		size_t bytes = 0;
+		for (auto& b : backups) {
+			if (!b.err.ok()) return Error(b.err.code(), "Backup of namespace '%s' failed: %s", b.ns->GetName(), b.err.what());
+			auto obj = arr.Object();
+			obj.Put("name", b.ns->GetName());
+			obj.Put("lsn", b.lsn);
+			obj.Put("records", b.records);
+			obj.Put("size", b.bytes);
+			bytes += b.bytes;
+		}
+	}
+
+	// Manifest is written last, so presence of manifest means, that backup is complete
+	string manifestPath = fs::JoinPath(dir, kBackupManifestFilename), tmpPath = manifestPath + ".tmp";
+	FILE* f = fopen(tmpPath.c_str(), "w");
+	if (!f) return Error(errParams, "Can't create '%s': %s", tmpPath, strerror(errno));
+	bool ok = fwrite(ser.Buf(), ser.Len(), 1, f) == 1;
+	ok = (fclose(f) == 0) && ok;
+	if (!ok || rename(tmpPath.c_str(), manifestPath.c_str()) < 0) {
+		return Error(errLogic, "Can't write '%s': %s", manifestPath, strerror(errno));
+	}
+
+	logPrintf(LogInfo, "Backup of %d namespaces to '%s' done in %d ms", int(backups.size()), dir,
+			  int(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - tmStart).count()));
+	return errOK;
+}
+
+Error ReindexerImpl::Restore(const string& dir) {
+	struct NsRestore {
+		string name;
+		size_t records = 0;
+		Error err;
+	};
+
+	if (storagePath_.empty()) return Error(errParams, "Can't restore database without storage");
+
+	string manifest;
+	if (fs::ReadFile(fs::JoinPath(dir, kBackupManifestFilename), manifest) < 0) {
+		return Error(errNotFound, "Can't read backup manifest in '%s': %s", dir, strerror(errno));
+	}
+
+	vector<NsRestore> restores;
+	try {
+		JsonAllocator jalloc;
+		JsonValue jvalue;
+		char* endp;
+		if (jsonParse(&manifest[0], &endp, &jvalue, jalloc) != JSON_OK || jvalue.getTag() != JSON_OBJECT) {
+			return Error(errParseJson, "Malformed backup manifest in '%s'", dir);
+		}
+		int version = 0;
+		string engine;
+		for (auto elem : jvalue) {
+			parseJsonField("version", version, elem);
+			parseJsonField("engine", engine, elem);
+			if (!strcmp(elem->key, "namespaces") && elem->value.getTag() == JSON_ARRAY) {
+				for (auto nselem : elem->value) {
+					NsRestore r;
+					for (auto field : nselem->value) parseJsonField("name", r.name, field);
+					if (!validateObjectName(r.name)) {
+						return Error(errParseJson, "Wrong namespace name '%s' in backup manifest", r.name);
+					}
+					restores.push_back(std::move(r));
+				}
+			}
+		}
+		if (version != 1) return Error(errParams, "Unsupported backup version %d", version);
+		if (datastorage::StorageFactory::TypeFromName(engine) != storageType_) {
+			return Error(errParams, "Backup is made with storage engine '%s', but database uses '%s'", engine,
+						 datastorage::StorageFactory::TypeName(storageType_));
+		}
+	} catch (const Error& err) {
+		return err;
+	}
+
+	auto tmStart = std::chrono::high_resolution_clock::now();
+	parallelFor(restores.size(), [&](size_t i) {
+		auto& r = restores[i];
+		bool exists;
+		{
+			shared_lock<shared_timed_mutex> lock(mtx_);
+			exists = namespaces_.find(r.name) != namespaces_.end();
+		}
+		if (exists) {
+			r.err = closeNamespace(r.name, true);
+			if (!r.err.ok()) return;
+		}
+		string nsPath = fs::JoinPath(storagePath_, r.name);
+		fs::RmDirAll(nsPath);
+		{
+			std::unique_ptr<datastorage::IDataStorage> storage(datastorage::StorageFactory::create(storageType_));
+			r.err = storage->Open(nsPath, StorageOpts().Enabled().CreateIfMissing());
+			if (!r.err.ok()) return;
+			r.err = datastorage::RestoreStorage(*storage, fs::JoinPath(dir, r.name + kBackupFileExt), r.records);
+			if (!r.err.ok()) return;
+		}
+		r.err = OpenNamespace(r.name, StorageOpts().Enabled());
+	});
+
+	for (auto& r : restores) {
+		if (!r.err.ok()) return Error(r.err.code(), "Restore of namespace '%s' failed: %s", r.name, r.err.what());
+	}
+	logPrintf(LogInfo, "Restore of %d namespaces from '%s' done in %d ms", int(restores.size()), dir,
+			  int(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - tmStart).count()));
+	return errOK;
+}
+
 }  // namespace reindexer
@@ -58,6 +58,8 @@ public:
 	Error EnumMeta(string_view nsName, vector<string> &keys);
 	Error InitSystemNamespaces();
 	Error SubscribeUpdates(IUpdatesObserver *observer, bool subscribe);
+	Error Backup(const string &dir);
+	Error Restore(const string &dir);
 
 protected:
 	class NsLocker : public h_vector<pair<Namespace::Ptr, smart_lock<shared_timed_mutex>>, 4> {
@@ -103,6 +105,7 @@ protected:
 	Error updateDbFromConfig(string_view configNsName, Item &configItem);
 	void updateConfigProvider(Item &configItem);
 	void onProfiligConfigLoad();
+	void onStorageConfigLoad();
 	void tryLoadReplicatorConfFromFile();
 
 	void backgroundRoutine();
@@ -115,7 +118,9 @@ protected:
 
 	shared_timed_mutex mtx_;
 	string storagePath_;
+	datastorage::StorageType storageType_ = datastorage::StorageType::LevelDB;
 
+	shared_ptr<datastorage::StorageWriter> storageWriter_;
 	std::thread backgroundThread_;
 	std::atomic<bool> stopBackgroundThread_;
 
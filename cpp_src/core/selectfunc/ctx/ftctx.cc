@@ -31,6 +31,8 @@ bool FtCtx::PrepareAreas(fast_hash_map<string, int> &fields, const string &name)
 }
 void FtCtx::SetData(Data::Ptr data) { data_ = data; }
 FtCtx::Data::Ptr FtCtx::GetData() { return data_; }
+void FtCtx::SetTopK(size_t topK) { topK_ = topK; }
+size_t FtCtx::TopK() { return topK_; }
 
 AreaHolder::Ptr FtCtx::Area(IdType id) {
 	auto it = data_->holders_.find(id);
@@ -37,8 +37,13 @@ public:
 	void SetData(Data::Ptr data);
 	Data::Ptr GetData();
 
+	// Count of the best documents, which are requested by query. 0 - all the found documents are requested
+	void SetTopK(size_t topK);
+	size_t TopK();
+
 private:
 	Data::Ptr data_;
+	size_t topK_ = 0;
 
 };  // namespace reindexer
 }  // namespace reindexer
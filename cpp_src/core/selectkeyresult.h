@@ -1,9 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <climits>
 #include <memory>
 
 #include "core/comparator.h"
+#include "core/idbitmap.h"
 #include "core/idset.h"
 #include "index/keyentry.h"
 
@@ -34,14 +36,19 @@ public:
 	explicit SingleSelectKeyResult(IdSet::Ptr ids) : tempIds_(ids), ids_(*ids) {}
 	explicit SingleSelectKeyResult(const IdSetRef &ids) : ids_(ids) {}
 	explicit SingleSelectKeyResult(IdType rBegin, IdType rEnd) : rBegin_(rBegin), rEnd_(rEnd), isRange_(true) {}
+	explicit SingleSelectKeyResult(const IdBitmap &bitmap) : bitmap_(&bitmap), useBitmap_(true) {}
+	explicit SingleSelectKeyResult(IdBitmap::Ptr bitmap) : tempBitmap_(bitmap), bitmap_(bitmap.get()), useBitmap_(true) {}
 	SingleSelectKeyResult(const SingleSelectKeyResult &other)
 		: tempIds_(other.tempIds_),
 		  ids_(other.ids_),
 		  set_(other.set_),
+		  tempBitmap_(other.tempBitmap_),
+		  bitmap_(other.bitmap_),
 		  bsearch_(other.bsearch_),
 		  isRange_(other.isRange_),
-		  useBtree_(other.useBtree_) {
-		if (isRange_) {
+		  useBtree_(other.useBtree_),
+		  useBitmap_(other.useBitmap_) {
+		if (isRange_ || useBitmap_) {
 			rBegin_ = other.rBegin_;
 			rEnd_ = other.rEnd_;
 			rIt_ = other.rIt_;
@@ -65,10 +72,13 @@ public:
 			tempIds_ = other.tempIds_;
 			ids_ = other.ids_;
 			set_ = other.set_;
+			tempBitmap_ = other.tempBitmap_;
+			bitmap_ = other.bitmap_;
 			bsearch_ = other.bsearch_;
 			isRange_ = other.isRange_;
 			useBtree_ = other.useBtree_;
-			if (isRange_) {
+			useBitmap_ = other.useBitmap_;
+			if (isRange_ || useBitmap_) {
 				rBegin_ = other.rBegin_;
 				rEnd_ = other.rEnd_;
 				rIt_ = other.rIt_;
@@ -94,6 +104,8 @@ protected:
 	IdSet::Ptr tempIds_;
 	IdSetRef ids_;
 	base_idsetset *set_ = nullptr;
+	IdBitmap::Ptr tempBitmap_;
+	const IdBitmap *bitmap_ = nullptr;
 
 	union {
 		IdSetRef::const_iterator begin_;
@@ -126,6 +138,8 @@ protected:
 	bool bsearch_ = false;
 	bool isRange_ = false;
 	bool useBtree_ = false;
+	// if useBitmap is true, then ids are taken from bitmap_ and rBegin_/rEnd_/rIt_ are positions in bitmap
+	bool useBitmap_ = false;
 };
 
 /// Stores results of selecting data for 1 certain key,
@@ -144,6 +158,8 @@ public:
 	/// @return Pointer to a sorted IdSet object made
 	/// from all the SingleSelectKeyResult inner objects.
 	IdSet::Ptr mergeIdsets() {
+		// Already merged
+		if (size() == 1 && begin()->tempIds_ && !begin()->useBtree_) return begin()->tempIds_;
 		auto mergedIds = std::make_shared<IdSet>();
 
 		size_t expectSize = 0;
@@ -158,8 +174,24 @@ public:
 		}
 		mergedIds->reserve(expectSize);
 
+		if (size() > kMaxLinearMergeIdsets) {
+			mergeByHeap(*mergedIds);
+		} else {
+			mergeLinear(*mergedIds);
+		}
+		mergedIds->shrink_to_fit();
+		clear();
+		push_back(SingleSelectKeyResult(mergedIds));
+		return mergedIds;
+	}
+
+protected:
+	// Count of idsets, which are merged by linear search of minimal id. More idsets are merged with heap
+	static constexpr size_t kMaxLinearMergeIdsets = 8;
+
+	void mergeLinear(IdSet &mergedIds) {
 		for (;;) {
-			const int min = mergedIds->size() ? mergedIds->back() : INT_MIN;
+			const int min = mergedIds.size() ? mergedIds.back() : INT_MIN;
 			int curMin = INT_MAX;
 			for (auto it = begin(); it != end(); it++) {
 				if (it->useBtree_) {
@@ -173,12 +205,37 @@ public:
 				}
 			}
 			if (curMin == INT_MAX) break;
-			mergedIds->Add(curMin, IdSet::Unordered, 0);
+			mergedIds.Add(curMin, IdSet::Unordered, 0);
 		};
-		mergedIds->shrink_to_fit();
-		clear();
-		push_back(SingleSelectKeyResult(mergedIds));
-		return mergedIds;
+	}
+
+	// k-way merge: O(log k) per id instead of O(k)
+	void mergeByHeap(IdSet &mergedIds) {
+		auto value = [](const SingleSelectKeyResult &r) { return r.useBtree_ ? *r.itset_ : *r.it_; };
+		auto atEnd = [](const SingleSelectKeyResult &r) { return r.useBtree_ ? r.itset_ == r.set_->end() : r.it_ == r.ids_.end(); };
+		auto greater = [this, &value](size_t lhs, size_t rhs) { return value((*this)[lhs]) > value((*this)[rhs]); };
+		h_vector<size_t, 16> heap;
+		heap.reserve(size());
+		for (size_t i = 0; i < size(); ++i) {
+			if (!atEnd((*this)[i])) heap.push_back(i);
+		}
+		std::make_heap(heap.begin(), heap.end(), greater);
+		while (!heap.empty()) {
+			std::pop_heap(heap.begin(), heap.end(), greater);
+			SingleSelectKeyResult &r = (*this)[heap.back()];
+			const IdType id = value(r);
+			if (mergedIds.empty() || mergedIds.back() != id) mergedIds.Add(id, IdSet::Unordered, 0);
+			if (r.useBtree_) {
+				++r.itset_;
+			} else {
+				++r.it_;
+			}
+			if (atEnd(r)) {
+				heap.pop_back();
+			} else {
+				std::push_heap(heap.begin(), heap.end(), greater);
+			}
+		}
 	}
 };  // namespace reindexer
 
@@ -0,0 +1,162 @@
+#include "backupfile.h"
+#include <errno.h>
+#include <string.h>
+#include <memory>
+#include "core/type_consts.h"
+#include "tools/oscompat.h"
+
+namespace reindexer {
+namespace datastorage {
+
+static const uint32_t kBackupMagic = 0x4B425852;  // "RXBK"
+static const uint32_t kBackupVersion = 1;
+// Key length of footer record. Storage keys are never empty, but let's be explicit
+static const uint32_t kFooterMark = 0xFFFFFFFF;
+static const size_t kBackupBufferSize = 1 << 20;
+// Max size of records batch, written to storage on restore
+static const size_t kRestoreBatchSize = 16 << 20;
+
+BackupFileWriter::~BackupFileWriter() {
+	if (f_) fclose(f_);
+}
+
+Error BackupFileWriter::Open(const string &path) {
+	path_ = path;
+	f_ = fopen(path.c_str(), "wb");
+	if (!f_) return Error(errLogic, "Can't create backup file '%s': %s", path, strerror(errno));
+	setvbuf(f_, nullptr, _IOFBF, kBackupBufferSize);
+	uint32_t hdr[2] = {kBackupMagic, kBackupVersion};
+	return write(hdr, sizeof(hdr));
+}
+
+Error BackupFileWriter::Write(const string_view &key, const string_view &value) {
+	uint32_t lens[2] = {uint32_t(key.size()), uint32_t(value.size())};
+	Error err = write(lens, sizeof(lens));
+	if (err.ok()) err = write(key.data(), key.size());
+	if (err.ok()) err = write(value.data(), value.size());
+	if (err.ok()) records_++;
+	return err;
+}
+
+Error BackupFileWriter::Close() {
+	uint32_t mark = kFooterMark;
+	uint64_t records = records_;
+	Error err = write(&mark, sizeof(mark));
+	if (err.ok()) err = write(&records, sizeof(records));
+#ifdef _WIN32
+	bool synced = fflush(f_) == 0 && _commit(_fileno(f_)) == 0;
+#else
+	bool synced = fflush(f_) == 0 && fsync(fileno(f_)) == 0;
+#endif
+	if (err.ok() && !synced) {
+		err = Error(errLogic, "Can't sync backup file '%s': %s", path_, strerror(errno));
+	}
+	fclose(f_);
+	f_ = nullptr;
+	return err;
+}
+
+Error BackupFileWriter::write(const void *data, size_t size) {
+	if (size && fwrite(data, size, 1, f_) != 1) {
+		return Error(errLogic, "Can't write backup file '%s': %s", path_, strerror(errno));
+	}
+	bytes_ += size;
+	return Error();
+}
+
+BackupFileReader::~BackupFileReader() {
+	if (f_) fclose(f_);
+}
+
+Error BackupFileReader::Open(const string &path) {
+	path_ = path;
+	f_ = fopen(path.c_str(), "rb");
+	if (!f_) return Error(errNotFound, "Can't open backup file '%s': %s", path, strerror(errno));
+	setvbuf(f_, nullptr, _IOFBF, kBackupBufferSize);
+	uint32_t hdr[2];
+	Error err = read(hdr, sizeof(hdr));
+	if (!err.ok()) return err;
+	if (hdr[0] != kBackupMagic) return Error(errParseBin, "'%s' is not a backup file", path);
+	if (hdr[1] != kBackupVersion) return Error(errParseBin, "Unsupported version %d of backup file '%s'", hdr[1], path);
+	return Error();
+}
+
+Error BackupFileReader::Read(string &key, string &value, bool &eof) {
+	eof = false;
+	uint32_t keyLen;
+	Error err = read(&keyLen, sizeof(keyLen));
+	if (!err.ok()) return err;
+	if (keyLen == kFooterMark) {
+		uint64_t records;
+		err = read(&records, sizeof(records));
+		if (!err.ok()) return err;
+		if (records != records_) {
+			return Error(errParseBin, "Backup file '%s' is broken: %d records expected, but %d found", path_, records, records_);
+		}
+		eof = true;
+		return Error();
+	}
+	uint32_t valueLen;
+	err = read(&valueLen, sizeof(valueLen));
+	key.resize(keyLen);
+	if (err.ok()) err = read(&key[0], keyLen);
+	value.resize(valueLen);
+	if (err.ok()) err = read(&value[0], valueLen);
+	if (err.ok()) records_++;
+	return err;
+}
+
+Error BackupFileReader::read(void *data, size_t size) {
+	if (size && fread(data, size, 1, f_) != 1) {
+		return Error(errParseBin, "Unexpected end of backup file '%s'", path_);
+	}
+	return Error();
+}
+
+Error BackupStorage(IDataStorage &storage, const Snapshot::Ptr &snapshot, const string &path, size_t &records, size_t &bytes) {
+	BackupFileWriter writer;
+	Error err = writer.Open(path);
+	if (!err.ok()) return err;
+
+	std::unique_ptr<Cursor> cursor(storage.GetSnapshotCursor(snapshot));
+	for (cursor->SeekToFirst(); cursor->Valid(); cursor->Next()) {
+		err = writer.Write(cursor->Key(), cursor->Value());
+		if (!err.ok()) return err;
+	}
+	err = writer.Close();
+	records = writer.Records();
+	bytes = writer.Bytes();
+	return err;
+}
+
+Error RestoreStorage(IDataStorage &storage, const string &path, size_t &records) {
+	BackupFileReader reader;
+	Error err = reader.Open(path);
+	if (!err.ok()) return err;
+
+	std::unique_ptr<UpdatesCollection> batch(storage.GetUpdatesCollection());
+	string key, value;
+	size_t batchSize = 0;
+	records = 0;
+	for (bool eof = false;;) {
+		err = reader.Read(key, value, eof);
+		if (!err.ok()) return err;
+		if (!eof) {
+			batch->Put(key, value);
+			batchSize += key.size() + value.size();
+			records++;
+		}
+		if (batchSize >= kRestoreBatchSize || eof) {
+			// The last batch is synced, so restored storage is durable on return
+			err = storage.Write(StorageOpts().Sync(eof), *batch);
+			if (!err.ok()) return err;
+			batch->Clear();
+			batchSize = 0;
+		}
+		if (eof) break;
+	}
+	return Error();
+}
+
+}  // namespace datastorage
+}  // namespace reindexer
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdio.h>
+#include <string>
+#include "estl/string_view.h"
+#include "idatastorage.h"
+#include "tools/errors.h"
+
+namespace reindexer {
+namespace datastorage {
+
+using std::string;
+
+/// Writer of namespace backup file. Backup file is a raw copy of namespace storage:
+/// header, sequence of key/value records, footer with count of records.
+class BackupFileWriter {
+public:
+	BackupFileWriter() = default;
+	~BackupFileWriter();
+	BackupFileWriter(const BackupFileWriter &) = delete;
+	BackupFileWriter &operator=(const BackupFileWriter &) = delete;
+
+	Error Open(const string &path);
+	Error Write(const string_view &key, const string_view &value);
+	/// Writes footer and syncs file to disk.
+	Error Close();
+
+	size_t Records() const { return records_; }
+	size_t Bytes() const { return bytes_; }
+
+protected:
+	Error write(const void *data, size_t size);
+
+	FILE *f_ = nullptr;
+	string path_;
+	size_t records_ = 0;
+	size_t bytes_ = 0;
+};
+
+/// Reader of namespace backup file.
+class BackupFileReader {
+public:
+	BackupFileReader() = default;
+	~BackupFileReader();
+	BackupFileReader(const BackupFileReader &) = delete;
+	BackupFileReader &operator=(const BackupFileReader &) = delete;
+
+	Error Open(const string &path);
+	/// Reads next record.
+	/// @param eof - set to true, when all records are read and footer is verified.
+	Error Read(string &key, string &value, bool &eof);
+
+protected:
+	Error read(void *data, size_t size);
+
+	FILE *f_ = nullptr;
+	string path_;
+	size_t records_ = 0;
+};
+
+/// Copies all records of storage snapshot to backup file.
+Error BackupStorage(IDataStorage &storage, const Snapshot::Ptr &snapshot, const string &path, size_t &records, size_t &bytes);
+/// Writes all records of backup file to storage with batches.
+Error RestoreStorage(IDataStorage &storage, const string &path, size_t &records);
+
+}  // namespace datastorage
+}  // namespace reindexer
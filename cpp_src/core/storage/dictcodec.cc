@@ -0,0 +1,180 @@
+#include "dictcodec.h"
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include "tools/errors.h"
+
+namespace reindexer {
+namespace datastorage {
+
+const size_t DictCodec::kDefaultDictSize;
+const size_t DictCodec::kMinMatch;
+
+static const int kDictHashBits = 15;
+// Max count of dictionary candidates, checked for each position
+static const int kMaxChain = 16;
+// Size of window, which is used to find repeated substrings while training
+static const size_t kTrainWindow = 8;
+static const size_t kMaxSegment = 256;
+
+static inline uint32_t hash4(const char *p, int bits) {
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return (v * 2654435761u) >> (32 - bits);
+}
+
+static inline uint32_t hash8(const char *p) {
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return (v * 0x9E3779B97F4A7C15ull) >> 32;
+}
+
+DictCodec::DictCodec(string dict) : dict_(std::move(dict)), dictHead_(1 << kDictHashBits, -1), dictChain_(dict_.size(), -1) {
+	for (size_t i = 0; i + kMinMatch <= dict_.size(); ++i) {
+		uint32_t h = hash4(&dict_[i], kDictHashBits);
+		dictChain_[i] = dictHead_[h];
+		dictHead_[h] = i;
+	}
+}
+
+void DictCodec::Compress(string_view src, WrSerializer &dst) const {
+	const size_t n = src.size(), dsz = dict_.size();
+	const char *s = src.data();
+	dst.PutVarUint(n);
+
+	int bits = 8;
+	while ((size_t(1) << bits) < n * 2 && bits < 16) bits++;
+	vector<int32_t> head(1 << bits, -1);
+
+	size_t pos = 0, litStart = 0;
+	while (pos + kMinMatch <= n) {
+		size_t bestLen = 0, bestDist = 0;
+
+		uint32_t h = hash4(s + pos, bits);
+		int32_t c = head[h];
+		head[h] = pos;
+		if (c >= 0) {
+			size_t len = 0;
+			while (pos + len < n && s[c + len] == s[pos + len]) len++;
+			bestLen = len;
+			bestDist = pos - c;
+		}
+
+		if (dsz) {
+			int steps = 0;
+			for (int32_t d = dictHead_[hash4(s + pos, kDictHashBits)]; d >= 0 && steps < kMaxChain; d = dictChain_[d], ++steps) {
+				// Match may continue after end of dictionary into the beginning of src
+				size_t len = 0;
+				for (; pos + len < n; ++len) {
+					size_t v = d + len;
+					if ((v < dsz ? dict_[v] : s[v - dsz]) != s[pos + len]) break;
+				}
+				if (len > bestLen) {
+					bestLen = len;
+					bestDist = dsz - d + pos;
+				}
+			}
+		}
+
+		if (bestLen < kMinMatch) {
+			pos++;
+			continue;
+		}
+		dst.PutVarUint(pos - litStart);
+		dst.Write(string_view(s + litStart, pos - litStart));
+		dst.PutVarUint(bestLen - kMinMatch);
+		dst.PutVarUint(bestDist);
+		for (size_t i = pos + 1; i < pos + bestLen && i + kMinMatch <= n; ++i) head[hash4(s + i, bits)] = i;
+		pos += bestLen;
+		litStart = pos;
+	}
+	dst.PutVarUint(n - litStart);
+	dst.Write(string_view(s + litStart, n - litStart));
+}
+
+void DictCodec::Decompress(string_view src, string &dst) const {
+	const size_t dsz = dict_.size();
+	Serializer rd(src);
+	size_t n = rd.GetVarUint();
+	dst.clear();
+	dst.reserve(n);
+
+	for (;;) {
+		size_t lit = rd.GetVarUint();
+		if (lit > n - dst.size() || lit > src.size() - rd.Pos()) {
+			throw Error(errParseBin, "Compressed data is broken: literals overflow at pos=%d", int(rd.Pos()));
+		}
+		dst.append(src.data() + rd.Pos(), lit);
+		rd.SetPos(rd.Pos() + lit);
+		if (dst.size() == n) break;
+
+		size_t len = rd.GetVarUint() + kMinMatch;
+		size_t dist = rd.GetVarUint();
+		size_t cur = dst.size();
+		if (!dist || dist > cur + dsz || len > n - cur) {
+			throw Error(errParseBin, "Compressed data is broken: wrong match at pos=%d", int(rd.Pos()));
+		}
+		if (dist <= cur && dist >= len) {
+			// dst has enough capacity, so append from itself does not reallocate
+			dst.append(dst, cur - dist, len);
+		} else if (dist > cur && dist - cur >= len) {
+			dst.append(dict_, dsz - (dist - cur), len);
+		} else {
+			for (size_t i = 0; i < len; ++i, ++cur) {
+				dst.push_back(dist > cur ? dict_[dsz - (dist - cur)] : dst[cur - dist]);
+			}
+		}
+	}
+}
+
+string DictCodec::Train(const vector<string_view> &samples, size_t maxSize) {
+	std::unordered_map<uint32_t, uint32_t> freq;
+	for (auto &s : samples) {
+		for (size_t i = 0; i + kTrainWindow <= s.size(); ++i) freq[hash8(s.data() + i)]++;
+	}
+
+	// Segments are runs of repeated windows. Score of segment is count of bytes it saves in all samples
+	struct Segment {
+		uint64_t score = 0;
+		uint32_t count = 0;
+	};
+	std::unordered_map<string, Segment> segments;
+	for (auto &s : samples) {
+		for (size_t i = 0; i + kTrainWindow <= s.size();) {
+			if (freq[hash8(s.data() + i)] < 2) {
+				i++;
+				continue;
+			}
+			size_t start = i;
+			while (i + kTrainWindow <= s.size() && i - start < kMaxSegment && freq[hash8(s.data() + i)] >= 2) i++;
+			auto &seg = segments[string(s.data() + start, i - start + kTrainWindow - 1)];
+			seg.score += i - start + kTrainWindow - 1;
+			seg.count++;
+		}
+	}
+
+	vector<std::pair<uint64_t, const string *>> ranked;
+	for (auto &seg : segments) {
+		if (seg.second.count > 1) ranked.emplace_back(seg.second.score, &seg.first);
+	}
+	std::sort(ranked.begin(), ranked.end(), [](const std::pair<uint64_t, const string *> &l, const std::pair<uint64_t, const string *> &r) {
+		return l.first > r.first;
+	});
+
+	vector<const string *> chosen;
+	string dict;
+	for (auto &r : ranked) {
+		if (dict.size() + r.second->size() > maxSize) continue;
+		if (dict.find(*r.second) != string::npos) continue;
+		dict += *r.second;
+		chosen.push_back(r.second);
+	}
+
+	// The most valuable segments are placed to the end of dictionary, so references to them are shorter
+	dict.clear();
+	for (auto it = chosen.rbegin(); it != chosen.rend(); ++it) dict += **it;
+	return dict;
+}
+
+}  // namespace datastorage
+}  // namespace reindexer
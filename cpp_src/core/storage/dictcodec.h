@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "estl/string_view.h"
+#include "tools/serializer.h"
+
+namespace reindexer {
+namespace datastorage {
+
+using std::string;
+using std::vector;
+
+/// LZ77 codec with a shared dictionary, trained on sample documents.
+/// Matches may reference both previously decoded bytes of the document and
+/// the dictionary, so values repeated across documents (categories, vendor
+/// names, URLs) are replaced with short references even in small documents.
+/// Encoded format: varuint raw size, then sequence of tokens:
+/// varuint literals count, literals, varuint (match length - kMinMatch), varuint match distance.
+/// The last token has no match part.
+class DictCodec {
+public:
+	/// Builds codec with trained dictionary.
+	/// @param dict - dictionary, built by Train.
+	DictCodec(string dict);
+	DictCodec(const DictCodec &) = delete;
+	DictCodec &operator=(const DictCodec &) = delete;
+
+	/// Trains dictionary from the most frequent substrings of samples.
+	/// @param samples - sample documents.
+	/// @param maxSize - max size of dictionary.
+	/// @return dictionary, suitable for DictCodec constructor.
+	static string Train(const vector<string_view> &samples, size_t maxSize = kDefaultDictSize);
+
+	/// Compresses src and appends result to dst.
+	void Compress(string_view src, WrSerializer &dst) const;
+	/// Decompresses src to dst. Throws Error on broken data.
+	void Decompress(string_view src, string &dst) const;
+
+	const string &Dict() const { return dict_; }
+
+	static const size_t kDefaultDictSize = 32 * 1024;
+	static const size_t kMinMatch = 4;
+
+protected:
+	string dict_;
+	// Hash chains of 4-byte sequences of dictionary
+	vector<int32_t> dictHead_;
+	vector<int32_t> dictChain_;
+};
+
+}  // namespace datastorage
+}  // namespace reindexer
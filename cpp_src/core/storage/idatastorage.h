@@ -89,6 +89,13 @@ public:
 	/// @return newly created Cursor object.
 	virtual Cursor* GetCursor(StorageOpts& opts) = 0;
 
+	/// Allocates and returns Cursor object, which
+	/// iterates over state of Storage at the moment of snapshot.
+	/// The client itself is responsible for it's deallocation.
+	/// @param snapshot - snapshot, acquired by MakeSnapshot.
+	/// @return newly created Cursor object.
+	virtual Cursor* GetSnapshotCursor(const Snapshot::Ptr& snapshot) = 0;
+
 	/// Allocates and returns UpdatesCollection object to a Storage.
 	/// The client itself is responsible for it's deallocation.
 	/// @return newly created UpdatesCollection object.
@@ -129,6 +129,15 @@ Cursor* LevelDbStorage::GetCursor(StorageOpts& opts) {
 	return new LevelDbIterator(db_->NewIterator(options));
 }
 
+Cursor* LevelDbStorage::GetSnapshotCursor(const Snapshot::Ptr& snapshot) {
+	if (!db_) throw Error(errParams, storageNotInitialized);
+	if (!snapshot) throw Error(errParams, "Storage pointer is null");
+	leveldb::ReadOptions options;
+	options.fill_cache = false;
+	options.snapshot = static_cast<const LevelDbSnapshot*>(snapshot.get())->snapshot_;
+	return new LevelDbIterator(db_->NewIterator(options));
+}
+
 UpdatesCollection* LevelDbStorage::GetUpdatesCollection() { return new LevelDbBatchBuffer(); }
 
 LevelDbBatchBuffer::LevelDbBatchBuffer() {}
@@ -31,6 +31,7 @@ public:
 	void Flush() final;
 	void Destroy(const string& path) final;
 	Cursor* GetCursor(StorageOpts& opts) final;
+	Cursor* GetSnapshotCursor(const Snapshot::Ptr& snapshot) final;
 	UpdatesCollection* GetUpdatesCollection() final;
 
 private:
@@ -0,0 +1,521 @@
+#include "logstorage.h"
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
+#include "tools/fsops.h"
+#include "tools/logger.h"
+#include "vendor/murmurhash/MurmurHash3.h"
+
+namespace reindexer {
+namespace datastorage {
+
+static const char *kLogStorageNotInitialized = "Storage is not initialized";
+static const char *kSegmentSuffix = ".log";
+// Segment is sealed, when it grows over this size
+static const uint64_t kSegmentSize = 64 * 1024 * 1024;
+// Compaction is started, when total size of segments is bigger, than this threshold...
+static const uint64_t kMinCompactionBytes = 16 * 1024 * 1024;
+// ... and garbage takes more than a half of total size
+static const double kMaxGarbageRatio = 0.5;
+// Max size of records batch, copied by compaction under storage lock
+static const size_t kCompactionBatchSize = 4 * 1024 * 1024;
+
+static const uint32_t kTombstone = 0xFFFFFFFF;
+
+// Record layout: checksum(4) keyLen(4) valueLen(4) key value
+// Checksum is calculated over all record bytes after checksum field
+struct LogRecordHeader {
+	uint32_t checksum;
+	uint32_t keyLen;
+	uint32_t valueLen;
+};
+static const size_t kHeaderSize = sizeof(LogRecordHeader);
+
+static uint64_t recordSize(size_t keyLen, uint32_t valueLen) { return kHeaderSize + keyLen + (valueLen == kTombstone ? 0 : valueLen); }
+
+static uint32_t recordChecksum(const char *rec, size_t size) {
+	uint32_t hash;
+	MurmurHash3_x86_32(rec + sizeof(uint32_t), size - sizeof(uint32_t), 0, &hash);
+	return hash;
+}
+
+static void putRecord(string &buf, const string_view &key, const string_view &value, bool tombstone) {
+	LogRecordHeader hdr;
+	hdr.keyLen = key.size();
+	hdr.valueLen = tombstone ? kTombstone : value.size();
+	size_t pos = buf.size();
+	buf.append(reinterpret_cast<const char *>(&hdr), kHeaderSize);
+	buf.append(key.data(), key.size());
+	if (!tombstone) buf.append(value.data(), value.size());
+	hdr.checksum = recordChecksum(&buf[pos], buf.size() - pos);
+	memcpy(&buf[pos], &hdr.checksum, sizeof(hdr.checksum));
+}
+
+// Parses record at pos. Returns false, if record is truncated or corrupted
+static bool parseRecord(const string_view &data, size_t pos, LogRecordHeader &hdr) {
+	if (data.size() - pos < kHeaderSize) return false;
+	memcpy(&hdr, data.data() + pos, kHeaderSize);
+	if (hdr.keyLen > data.size() - pos - kHeaderSize) return false;
+	uint64_t size = recordSize(hdr.keyLen, hdr.valueLen);
+	if (size > data.size() - pos) return false;
+	return recordChecksum(data.data() + pos, size) == hdr.checksum;
+}
+
+static string segmentName(uint32_t id) {
+	char name[32];
+	snprintf(name, sizeof(name), "%08u%s", id, kSegmentSuffix);
+	return name;
+}
+
+static int syncFd(int fd) {
+#ifdef __APPLE__
+	return ::fsync(fd);
+#else
+	return ::fdatasync(fd);
+#endif
+}
+
+LogSegment::LogSegment(const string &p, uint32_t i, int f, uint64_t sz) : path(p), id(i), fd(f), size(sz), obsolete(false) {}
+
+LogSegment::~LogSegment() {
+	Unmap();
+	::close(fd);
+	if (obsolete) ::unlink(path.c_str());
+}
+
+void LogSegment::Map() {
+	std::unique_lock<std::mutex> lck(mapMtx_);
+	size_t sz = size;
+	if (mapped_.load(std::memory_order_relaxed) || !sz) return;
+	void *p = mmap(nullptr, sz, PROT_READ, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED) {
+		logPrintf(LogWarning, "Can't mmap log storage segment '%s': %s", path, strerror(errno));
+		return;
+	}
+	madvise(p, sz, MADV_SEQUENTIAL);
+	mappedSize_.store(sz, std::memory_order_relaxed);
+	mapped_.store(static_cast<const char *>(p), std::memory_order_release);
+}
+
+void LogSegment::Unmap() {
+	std::unique_lock<std::mutex> lck(mapMtx_);
+	const char *mapped = mapped_.exchange(nullptr, std::memory_order_relaxed);
+	if (mapped) munmap(const_cast<char *>(mapped), mappedSize_);
+	mappedSize_.store(0, std::memory_order_relaxed);
+}
+
+string_view LogSegment::Read(uint64_t offset, uint32_t len, string &buf) const {
+	const char *mapped = mapped_.load(std::memory_order_acquire);
+	if (mapped && offset + len <= mappedSize_.load(std::memory_order_relaxed)) return string_view(mapped + offset, len);
+
+	buf.resize(len);
+	size_t done = 0;
+	while (done < len) {
+		ssize_t n = ::pread(fd, &buf[done], len - done, offset + done);
+		if (n <= 0) {
+			if (n < 0 && errno == EINTR) continue;
+			throw Error(errLogic, "Can't read log storage segment '%s': %s", path, n < 0 ? strerror(errno) : "unexpected end of file");
+		}
+		done += n;
+	}
+	return string_view(buf);
+}
+
+LogStorage::LogStorage() : compacting_(false), stopCompaction_(false) {}
+
+LogStorage::~LogStorage() { close(); }
+
+void LogStorage::close() {
+	stopCompaction_ = true;
+	if (compactionThread_.joinable()) compactionThread_.join();
+	stopCompaction_ = false;
+
+	std::unique_lock<std::mutex> lck(mtx_);
+	if (active_) syncFd(active_->fd);
+	active_.reset();
+	segments_.clear();
+	index_.reset();
+	totalBytes_ = liveBytes_ = 0;
+}
+
+Error LogStorage::Open(const string &path, const StorageOpts &opts) {
+	if (path.empty()) {
+		throw Error(errParams, "Cannot enable storage: the path is empty '%s'", path);
+	}
+	close();
+
+	if (!fs::DirectoryExists(path)) {
+		if (!opts.IsCreateIfMissing()) return Error(errNotFound, "Storage directory '%s' does not exist", path);
+		if (fs::MkDirAll(path) < 0) return Error(errLogic, "Can't create storage directory '%s': %s", path, strerror(errno));
+	}
+
+	std::vector<fs::DirEntry> entries;
+	if (fs::ReadDir(path, entries) < 0) return Error(errLogic, "Can't read storage directory '%s': %s", path, strerror(errno));
+
+	std::vector<uint32_t> ids;
+	for (auto &e : entries) {
+		unsigned id;
+		char suffix[8] = {0};
+		if (!e.isDir && sscanf(e.name.c_str(), "%8u%4s", &id, suffix) == 2 && !strcmp(suffix, kSegmentSuffix)) ids.push_back(id);
+	}
+	std::sort(ids.begin(), ids.end());
+
+	std::unique_lock<std::mutex> lck(mtx_);
+	path_ = path;
+	opts_ = opts;
+	index_ = std::make_shared<LogIndex>();
+
+	for (auto id : ids) {
+		Error err = openSegment(id, true);
+		if (!err.ok()) return err;
+	}
+	if (ids.empty()) {
+		Error err = openSegment(0, false);
+		if (!err.ok()) return err;
+	}
+	active_ = segments_.rbegin()->second;
+	return Error();
+}
+
+Error LogStorage::openSegment(uint32_t id, bool replay) {
+	string path = fs::JoinPath(path_, segmentName(id));
+	int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fd < 0) return Error(errLogic, "Can't open log storage segment '%s': %s", path, strerror(errno));
+
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		::close(fd);
+		return Error(errLogic, "Can't stat log storage segment '%s': %s", path, strerror(errno));
+	}
+
+	auto seg = std::make_shared<LogSegment>(path, id, fd, st.st_size);
+	if (replay) {
+		uint64_t validSize = 0;
+		Error err = replaySegment(*seg, validSize);
+		if (!err.ok()) return err;
+		if (validSize != seg->size) {
+			logPrintf(LogWarning, "Log storage segment '%s' is corrupted at offset %d. Truncating %d bytes", path, validSize,
+					  seg->size - validSize);
+			seg->Unmap();
+			if (ftruncate(fd, validSize) < 0) return Error(errLogic, "Can't truncate '%s': %s", path, strerror(errno));
+			seg->size = validSize;
+			seg->Map();
+		}
+	}
+	totalBytes_ += seg->size;
+	segments_.emplace(id, std::move(seg));
+	return Error();
+}
+
+Error LogStorage::replaySegment(LogSegment &seg, uint64_t &validSize) {
+	seg.Map();
+	string buf;
+	string_view data = seg.Read(0, seg.size, buf);
+	size_t pos = 0;
+	LogRecordHeader hdr;
+	while (pos < data.size() && parseRecord(data, pos, hdr)) pos += recordSize(hdr.keyLen, hdr.valueLen);
+	validSize = pos;
+	applyRecords(data.substr(0, pos), seg, 0);
+	return Error();
+}
+
+void LogStorage::applyRecords(const string_view &records, LogSegment &seg, uint64_t baseOffset) {
+	LogIndex &index = mutableIndex();
+	LogRecordHeader hdr;
+	string key;
+
+	for (size_t pos = 0; pos < records.size();) {
+		memcpy(&hdr, records.data() + pos, kHeaderSize);
+		key.assign(records.data() + pos + kHeaderSize, hdr.keyLen);
+		uint64_t recSize = recordSize(hdr.keyLen, hdr.valueLen);
+
+		auto it = index.find(key);
+		if (it != index.end()) {
+			uint64_t oldSize = recordSize(hdr.keyLen, it->second.size);
+			auto oldSeg = segments_.find(it->second.segment);
+			if (oldSeg != segments_.end()) oldSeg->second->liveBytes -= oldSize;
+			liveBytes_ -= oldSize;
+		}
+		if (hdr.valueLen == kTombstone) {
+			if (it != index.end()) index.erase(it);
+		} else {
+			LogLocation loc{seg.id, hdr.valueLen, baseOffset + pos + kHeaderSize + hdr.keyLen};
+			if (it != index.end()) {
+				it->second = loc;
+			} else {
+				index.insert({key, loc});
+			}
+			seg.liveBytes += recSize;
+			liveBytes_ += recSize;
+		}
+		pos += recSize;
+	}
+}
+
+LogIndex &LogStorage::mutableIndex() {
+	// Index is shared with snapshots and cursors. Copy it on write
+	if (index_.use_count() > 1) index_ = std::make_shared<LogIndex>(*index_);
+	return *index_;
+}
+
+Error LogStorage::rollSegment() {
+	if (syncFd(active_->fd) < 0) return Error(errLogic, "Can't sync '%s': %s", active_->path, strerror(errno));
+	active_->Map();
+	Error err = openSegment(active_->id + 1, false);
+	if (!err.ok()) return err;
+	active_ = segments_.rbegin()->second;
+	return Error();
+}
+
+Error LogStorage::append(const string &records, const StorageOpts &opts) {
+	if (!active_) throw Error(errParams, kLogStorageNotInitialized);
+	if (records.empty() && !opts.IsSync()) return Error();
+
+	if (active_->size && active_->size + records.size() > kSegmentSize) {
+		Error err = rollSegment();
+		if (!err.ok()) return err;
+	}
+
+	uint64_t offset = active_->size;
+	size_t done = 0;
+	while (done < records.size()) {
+		ssize_t n = ::pwrite(active_->fd, records.data() + done, records.size() - done, offset + done);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			// Cut partially written records
+			if (ftruncate(active_->fd, offset) < 0) {
+				logPrintf(LogError, "Can't truncate '%s': %s", active_->path, strerror(errno));
+			}
+			return Error(errLogic, "Can't write to log storage segment '%s': %s", active_->path, strerror(errno));
+		}
+		done += n;
+	}
+	if (opts.IsSync() && syncFd(active_->fd) < 0) {
+		return Error(errLogic, "Can't sync '%s': %s", active_->path, strerror(errno));
+	}
+
+	active_->size += records.size();
+	totalBytes_ += records.size();
+	applyRecords(records, *active_, offset);
+	return Error();
+}
+
+Error LogStorage::Read(const StorageOpts & /*opts*/, const string_view &key, string &value) {
+	LogLocation loc;
+	shared_ptr<LogSegment> seg;
+	{
+		std::unique_lock<std::mutex> lck(mtx_);
+		if (!index_) throw Error(errParams, kLogStorageNotInitialized);
+		auto it = index_->find(string(key.data(), key.size()));
+		if (it == index_->end()) return Error(errNotFound, "Not found");
+		loc = it->second;
+		seg = segments_[loc.segment];
+	}
+	string_view data = seg->Read(loc.offset, loc.size, value);
+	if (data.data() != value.data()) value.assign(data.data(), data.size());
+	return Error();
+}
+
+Error LogStorage::Write(const StorageOpts &opts, const string_view &key, const string_view &value) {
+	string rec;
+	putRecord(rec, key, value, false);
+	Error err;
+	{
+		std::unique_lock<std::mutex> lck(mtx_);
+		err = append(rec, opts);
+	}
+	maybeStartCompaction();
+	return err;
+}
+
+Error LogStorage::Write(const StorageOpts &opts, UpdatesCollection &buffer) {
+	LogBatch *batch = static_cast<LogBatch *>(&buffer);
+	Error err;
+	{
+		std::unique_lock<std::mutex> lck(mtx_);
+		err = append(batch->records_, opts);
+	}
+	maybeStartCompaction();
+	return err;
+}
+
+Error LogStorage::Delete(const StorageOpts &opts, const string_view &key) {
+	string rec;
+	putRecord(rec, key, string_view(), true);
+	Error err;
+	{
+		std::unique_lock<std::mutex> lck(mtx_);
+		err = append(rec, opts);
+	}
+	maybeStartCompaction();
+	return err;
+}
+
+LogStorage::State LogStorage::getState() {
+	std::unique_lock<std::mutex> lck(mtx_);
+	if (!index_) throw Error(errParams, kLogStorageNotInitialized);
+	return State{index_, segments_};
+}
+
+Snapshot::Ptr LogStorage::MakeSnapshot() {
+	State state = getState();
+	return std::make_shared<LogSnapshot>(std::move(state.index), std::move(state.segments));
+}
+
+void LogStorage::ReleaseSnapshot(Snapshot::Ptr snapshot) {
+	if (!snapshot) throw Error(errParams, "Storage pointer is null");
+	snapshot.reset();
+}
+
+void LogStorage::Flush() {
+	std::unique_lock<std::mutex> lck(mtx_);
+	if (active_) syncFd(active_->fd);
+}
+
+void LogStorage::Destroy(const string &path) {
+	close();
+	if (fs::RmDirAll(path) < 0) {
+		logPrintf(LogWarning, "Cannot destroy DB: %s, %s", path, strerror(errno));
+	}
+}
+
+Cursor *LogStorage::GetCursor(StorageOpts & /*opts*/) {
+	State state = getState();
+	return new LogCursor(std::move(state.index), std::move(state.segments));
+}
+
+Cursor *LogStorage::GetSnapshotCursor(const Snapshot::Ptr &snapshot) {
+	if (!snapshot) throw Error(errParams, "Storage pointer is null");
+	auto logSnapshot = static_cast<const LogSnapshot *>(snapshot.get());
+	return new LogCursor(logSnapshot->index_, logSnapshot->segments_);
+}
+
+UpdatesCollection *LogStorage::GetUpdatesCollection() { return new LogBatch(); }
+
+uint64_t LogStorage::DiskUsage() {
+	std::unique_lock<std::mutex> lck(mtx_);
+	return totalBytes_;
+}
+
+void LogStorage::maybeStartCompaction() {
+	std::unique_lock<std::mutex> lck(mtx_);
+	if (compacting_ || segments_.size() < 2 || totalBytes_ < kMinCompactionBytes) return;
+	if (double(totalBytes_ - liveBytes_) < double(totalBytes_) * kMaxGarbageRatio) return;
+
+	// Previous compaction thread is already finished, since compacting_ is false
+	if (compactionThread_.joinable()) compactionThread_.join();
+	compacting_ = true;
+	compactionThread_ = std::thread([this]() {
+		try {
+			compact();
+		} catch (const Error &err) {
+			logPrintf(LogError, "Log storage '%s' compaction failed: %s", path_, err.what());
+		}
+		compacting_ = false;
+	});
+}
+
+void LogStorage::compact() {
+	// Segments are compacted only in order of creation: tombstones of the oldest segment
+	// can be dropped safely, since there are no older records, which they can hide
+	shared_ptr<LogSegment> seg;
+	{
+		std::unique_lock<std::mutex> lck(mtx_);
+		if (segments_.size() < 2) return;
+		seg = segments_.begin()->second;
+	}
+	logPrintf(LogInfo, "Log storage '%s': compacting segment %d, %d of %d bytes are live", path_, seg->id, seg->liveBytes, seg->size);
+
+	seg->Map();
+	string buf, records;
+	string_view data = seg->Read(0, seg->size, buf);
+	LogRecordHeader hdr;
+
+	for (size_t pos = 0; pos < data.size() && !stopCompaction_;) {
+		std::unique_lock<std::mutex> lck(mtx_);
+		records.clear();
+		while (pos < data.size() && records.size() < kCompactionBatchSize) {
+			memcpy(&hdr, data.data() + pos, kHeaderSize);
+			if (hdr.valueLen != kTombstone) {
+				string key(data.data() + pos + kHeaderSize, hdr.keyLen);
+				auto it = index_->find(key);
+				uint64_t valueOffset = pos + kHeaderSize + hdr.keyLen;
+				// Copy only records, which are still referenced by index
+				if (it != index_->end() && it->second.segment == seg->id && it->second.offset == valueOffset) {
+					records.append(data.data() + pos, recordSize(hdr.keyLen, hdr.valueLen));
+				}
+			}
+			pos += recordSize(hdr.keyLen, hdr.valueLen);
+		}
+		Error err = append(records, StorageOpts());
+		if (!err.ok()) throw err;
+	}
+	if (stopCompaction_) return;
+
+	std::unique_lock<std::mutex> lck(mtx_);
+	// Copied records must reach disk before segment is removed
+	if (syncFd(active_->fd) < 0) throw Error(errLogic, "Can't sync '%s': %s", active_->path, strerror(errno));
+	totalBytes_ -= seg->size;
+	segments_.erase(seg->id);
+	seg->obsolete = true;
+}
+
+void LogBatch::Put(const string_view &key, const string_view &value) { putRecord(records_, key, value, false); }
+
+void LogBatch::Remove(const string_view &key) { putRecord(records_, key, string_view(), true); }
+
+void LogBatch::Clear() { records_.clear(); }
+
+int LogComparator::Compare(const string_view &a, const string_view &b) const {
+	int res = memcmp(a.data(), b.data(), std::min(a.size(), b.size()));
+	if (res) return res;
+	return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+
+LogCursor::LogCursor(shared_ptr<const LogIndex> index, LogSegments segments)
+	: index_(std::move(index)), segments_(std::move(segments)), it_(index_->end()) {}
+
+bool LogCursor::Valid() const { return it_ != index_->end(); }
+
+void LogCursor::SeekToFirst() { it_ = index_->begin(); }
+
+void LogCursor::SeekToLast() {
+	it_ = index_->end();
+	if (!index_->empty()) --it_;
+}
+
+void LogCursor::Seek(const string_view &target) { it_ = index_->lower_bound(string(target.data(), target.size())); }
+
+void LogCursor::Next() { ++it_; }
+
+void LogCursor::Prev() {
+	if (it_ == index_->begin()) {
+		it_ = index_->end();
+	} else {
+		--it_;
+	}
+}
+
+string_view LogCursor::Key() const { return string_view(it_->first); }
+
+string_view LogCursor::Value() const {
+	const LogLocation &loc = it_->second;
+	auto seg = segments_.find(loc.segment);
+	assert(seg != segments_.end());
+	return seg->second->Read(loc.offset, loc.size, valueBuf_);
+}
+
+Comparator &LogCursor::GetComparator() { return comparator_; }
+
+}  // namespace datastorage
+}  // namespace reindexer
+
+#endif  // _WIN32
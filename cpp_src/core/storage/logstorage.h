@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "core/type_consts.h"
+#include "cpp-btree/btree_map.h"
+#include "idatastorage.h"
+
+namespace reindexer {
+namespace datastorage {
+
+/// Segment file of log storage. Records are only appended to the segment,
+/// sealed segments are immutable and are mapped to memory for reading.
+class LogSegment {
+public:
+	LogSegment(const string &path, uint32_t id, int fd, uint64_t size);
+	~LogSegment();
+	LogSegment(const LogSegment &) = delete;
+	LogSegment &operator=(const LogSegment &) = delete;
+
+	/// Reads len bytes at offset. Returns view to mapped memory or to buf.
+	string_view Read(uint64_t offset, uint32_t len, string &buf) const;
+	/// Maps current content of segment to memory. Segment is mapped once, readers see either no mapping or the whole one.
+	void Map();
+	/// Unmaps segment. Must not be called concurrently with reads.
+	void Unmap();
+
+	const string path;
+	const uint32_t id;
+	const int fd;
+	// Count of bytes written to segment
+	std::atomic<uint64_t> size;
+	// Count of bytes of records, which are still referenced by index. Guarded by storage mutex
+	uint64_t liveBytes = 0;
+	// Segment is not needed anymore. File will be removed, when last reference is released
+	std::atomic<bool> obsolete;
+
+protected:
+	// Reads are lock free: mappedSize_ is written before mapped_ is published with release order
+	std::atomic<const char *> mapped_{nullptr};
+	std::atomic<size_t> mappedSize_{0};
+	// Serializes Map and Unmap
+	std::mutex mapMtx_;
+};
+
+/// Location of record value in segments.
+struct LogLocation {
+	uint32_t segment;
+	uint32_t size;
+	uint64_t offset;
+};
+
+using LogIndex = btree::btree_map<string, LogLocation>;
+using LogSegments = std::map<uint32_t, shared_ptr<LogSegment>>;
+
+/// Append-only log structured storage.
+/// Each Put/Remove appends record to the active segment file, in-memory
+/// ordered index holds location of the latest record of each key. When
+/// too much garbage is accumulated, the oldest sealed segment is rewritten
+/// in background: still live records are copied to the active segment and
+/// segment file is removed.
+/// Suits workloads with full document rewrites and sequential full scans on load:
+/// there is no multi-level compaction, and load reads segments sequentially from memory mapped files.
+class LogStorage : public IDataStorage {
+public:
+	LogStorage();
+	~LogStorage();
+
+	Error Open(const string &path, const StorageOpts &opts) final;
+	Error Read(const StorageOpts &opts, const string_view &key, string &value) final;
+	Error Write(const StorageOpts &opts, const string_view &key, const string_view &value) final;
+	Error Write(const StorageOpts &opts, UpdatesCollection &buffer) final;
+	Error Delete(const StorageOpts &opts, const string_view &key) final;
+
+	Snapshot::Ptr MakeSnapshot() final;
+	void ReleaseSnapshot(Snapshot::Ptr) final;
+
+	void Flush() final;
+	void Destroy(const string &path) final;
+	Cursor *GetCursor(StorageOpts &opts) final;
+	Cursor *GetSnapshotCursor(const Snapshot::Ptr &snapshot) final;
+	UpdatesCollection *GetUpdatesCollection() final;
+
+	/// Returns total size of segment files on disk.
+	uint64_t DiskUsage();
+
+protected:
+	friend class LogCursor;
+	struct State {
+		shared_ptr<const LogIndex> index;
+		LogSegments segments;
+	};
+
+	void close();
+	Error openSegment(uint32_t id, bool replay);
+	Error replaySegment(LogSegment &seg, uint64_t &validSize);
+	Error append(const string &records, const StorageOpts &opts);
+	void applyRecords(const string_view &records, LogSegment &segment, uint64_t baseOffset);
+	LogIndex &mutableIndex();
+	Error rollSegment();
+	State getState();
+
+	void maybeStartCompaction();
+	void compact();
+
+	string path_;
+	StorageOpts opts_;
+	std::mutex mtx_;
+	shared_ptr<LogIndex> index_;
+	LogSegments segments_;
+	shared_ptr<LogSegment> active_;
+	uint64_t totalBytes_ = 0, liveBytes_ = 0;
+
+	std::thread compactionThread_;
+	std::atomic<bool> compacting_;
+	std::atomic<bool> stopCompaction_;
+};
+
+/// Batch of log records. Records are serialized into a buffer which is appended to segment with a single write.
+class LogBatch : public UpdatesCollection {
+public:
+	void Put(const string_view &key, const string_view &value) final;
+	void Remove(const string_view &key) final;
+	void Clear() final;
+
+protected:
+	string records_;
+	friend class LogStorage;
+};
+
+class LogComparator : public Comparator {
+public:
+	int Compare(const string_view &a, const string_view &b) const final;
+};
+
+class LogCursor : public Cursor {
+public:
+	LogCursor(shared_ptr<const LogIndex> index, LogSegments segments);
+
+	bool Valid() const final;
+	void SeekToFirst() final;
+	void SeekToLast() final;
+	void Seek(const string_view &target) final;
+	void Next() final;
+	void Prev() final;
+
+	string_view Key() const final;
+	string_view Value() const final;
+
+	Comparator &GetComparator() final;
+
+private:
+	const shared_ptr<const LogIndex> index_;
+	const LogSegments segments_;
+	LogIndex::const_iterator it_;
+	mutable string valueBuf_;
+	LogComparator comparator_;
+};
+
+class LogSnapshot : public Snapshot {
+public:
+	LogSnapshot(shared_ptr<const LogIndex> index, LogSegments segments) : index_(std::move(index)), segments_(std::move(segments)) {}
+
+private:
+	shared_ptr<const LogIndex> index_;
+	LogSegments segments_;
+	friend class LogStorage;
+};
+
+}  // namespace datastorage
+}  // namespace reindexer
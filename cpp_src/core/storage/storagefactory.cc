@@ -1,5 +1,6 @@
 #include "storagefactory.h"
 #include "leveldbstorage.h"
+#include "logstorage.h"
 
 namespace reindexer {
 namespace datastorage {
@@ -8,9 +9,33 @@ IDataStorage* StorageFactory::create(StorageType type) {
 	switch (type) {
 		case StorageType::LevelDB:
 			return new LevelDbStorage();
+		case StorageType::LogStorage:
+#ifndef _WIN32
+			return new LogStorage();
+#else
+			throw Error(errParams, "Log storage is not supported on this platform");
+#endif
 		default:
 			throw std::runtime_error("No such storage type!");
 	}
 }
+
+const char* StorageFactory::TypeName(StorageType type) {
+	switch (type) {
+		case StorageType::LevelDB:
+			return "leveldb";
+		case StorageType::LogStorage:
+			return "logstorage";
+		default:
+			throw std::runtime_error("No such storage type!");
+	}
+}
+
+StorageType StorageFactory::TypeFromName(const string& name) {
+	if (name == "leveldb" || name.empty()) return StorageType::LevelDB;
+	if (name == "logstorage") return StorageType::LogStorage;
+	throw Error(errParams, "Unknown storage engine '%s'", name);
+}
+
 }  // namespace datastorage
 }  // namespace reindexer
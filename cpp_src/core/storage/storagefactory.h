@@ -5,11 +5,14 @@
 namespace reindexer {
 namespace datastorage {
 
-enum class StorageType { LevelDB = 0 };
+enum class StorageType { LevelDB = 0, LogStorage = 1 };
 
 class StorageFactory {
 public:
 	static IDataStorage* create(StorageType);
+	// Storage engine name, as it is written in DSN, server config and storage placeholder file
+	static const char* TypeName(StorageType);
+	static StorageType TypeFromName(const string& name);
 };
 }  // namespace datastorage
 }  // namespace reindexer
@@ -0,0 +1,194 @@
+#include "storagewriter.h"
+#include <algorithm>
+#include "core/type_consts.h"
+#include "tools/logger.h"
+
+namespace reindexer {
+namespace datastorage {
+
+const size_t kMaxErrors = 1024;
+
+StorageWriter::StorageWriter() : lastSync_(std::chrono::steady_clock::now()) {
+	thread_ = std::thread([this]() { this->run(); });
+}
+
+StorageWriter::~StorageWriter() { Stop(); }
+
+void StorageWriter::SetPolicy(StorageFlushPolicy policy, std::chrono::milliseconds syncInterval) {
+	std::unique_lock<std::mutex> lck(mtx_);
+	policy_ = policy;
+	syncInterval_ = syncInterval.count() > 0 ? syncInterval : std::chrono::milliseconds(1);
+	cv_.notify_one();
+}
+
+StorageFlushPolicy StorageWriter::GetPolicy() {
+	std::unique_lock<std::mutex> lck(mtx_);
+	return policy_;
+}
+
+StorageWriter::Ticket StorageWriter::Submit(shared_ptr<IDataStorage> storage, UpdatesCollection::Ptr batch, bool forceSync,
+											shared_ptr<LatencyHistogram> stat, const std::string &nsName) {
+	std::unique_lock<std::mutex> lck(mtx_);
+	Ticket ticket = ++submitted_;
+	if (!running_) {
+		// Writer is already stopped. Write batch synchronously
+		Batch b{std::move(storage), std::move(batch), forceSync, std::move(stat), nsName, ticket};
+		lck.unlock();
+		Error err = writeBatch(b, true);
+		lck.lock();
+		if (!err.ok()) setError(ticket, err);
+		written_ = std::max(written_, ticket);
+		return ticket;
+	}
+	queue_.push_back({std::move(storage), std::move(batch), forceSync, std::move(stat), nsName, ticket});
+	cv_.notify_one();
+	return ticket;
+}
+
+StorageWriter::Ticket StorageWriter::Sync(shared_ptr<IDataStorage> storage) { return Submit(std::move(storage), nullptr, true, nullptr, ""); }
+
+Error StorageWriter::Wait(Ticket ticket) {
+	std::unique_lock<std::mutex> lck(mtx_);
+	doneCv_.wait(lck, [&]() { return written_ >= ticket; });
+	auto it = errors_.find(ticket);
+	if (it != errors_.end()) return it->second;
+	return ticket <= failedUpTo_ ? failedError_ : Error();
+}
+
+void StorageWriter::setError(Ticket ticket, const Error &err) {
+	errors_.emplace(ticket, err);
+	if (errors_.size() > kMaxErrors) {
+		auto oldest = errors_.begin();
+		if (failedError_.ok()) failedError_ = oldest->second;
+		failedUpTo_ = std::max(failedUpTo_, oldest->first);
+		errors_.erase(oldest);
+	}
+}
+
+void StorageWriter::Stop() {
+	{
+		std::unique_lock<std::mutex> lck(mtx_);
+		stop_ = true;
+		cv_.notify_one();
+	}
+	if (thread_.joinable()) thread_.join();
+}
+
+void StorageWriter::run() {
+	std::vector<Batch> group;
+	std::unique_lock<std::mutex> lck(mtx_);
+	for (;;) {
+		if (queue_.empty() && !stop_) {
+			if (policy_ == StorageFlushPolicy::Periodic && !dirty_.empty()) {
+				cv_.wait_until(lck, lastSync_ + syncInterval_);
+			} else {
+				cv_.wait(lck);
+			}
+		}
+
+		bool syncAll = (policy_ == StorageFlushPolicy::PerCommit) ||
+					   (policy_ == StorageFlushPolicy::Periodic && std::chrono::steady_clock::now() - lastSync_ >= syncInterval_);
+		Ticket ticket = submitted_;
+		group.swap(queue_);
+		bool stop = stop_;
+		lck.unlock();
+
+		if (!group.empty()) writeGroup(group, syncAll);
+		if (syncAll || stop) syncDirty();
+		group.clear();
+
+		lck.lock();
+		written_ = ticket;
+		if (stop && queue_.empty()) {
+			running_ = false;
+			doneCv_.notify_all();
+			break;
+		}
+		doneCv_.notify_all();
+	}
+}
+
+void StorageWriter::writeGroup(std::vector<Batch> &group, bool syncAll) {
+	auto tmStart = std::chrono::high_resolution_clock::now();
+	std::vector<std::pair<Ticket, Error>> errors;
+
+	for (size_t i = 0; i < group.size(); i++) {
+		Batch &batch = group[i];
+
+		// Storages write their log sequentially, so it's enough to sync only the last batch of each storage in group
+		bool lastOfStorage = std::none_of(group.begin() + i + 1, group.end(), [&](const Batch &b) { return b.storage == batch.storage; });
+		bool needSync = lastOfStorage && (syncAll || std::any_of(group.begin(), group.begin() + i + 1, [&](const Batch &b) {
+										  return b.storage == batch.storage && b.forceSync;
+									  }));
+
+		Error err = writeBatch(batch, needSync);
+		if (!err.ok()) {
+			errors.emplace_back(batch.ticket, err);
+			// Previous batches of storage in group are synced by this one, so their waiters get the error too
+			for (size_t j = 0; needSync && j < i; j++) {
+				if (group[j].storage == batch.storage) errors.emplace_back(group[j].ticket, err);
+			}
+		}
+
+		if (needSync) {
+			removeDirty(batch.storage);
+		} else if (lastOfStorage) {
+			addDirty(batch.storage);
+		}
+	}
+
+	groupCommitStat_.Hit(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tmStart));
+
+	if (!errors.empty()) {
+		std::unique_lock<std::mutex> lck(mtx_);
+		for (auto &e : errors) setError(e.first, e.second);
+	}
+}
+
+Error StorageWriter::writeBatch(Batch &batch, bool sync) {
+	auto tmStart = std::chrono::high_resolution_clock::now();
+	Error status;
+	try {
+		if (batch.updates) {
+			status = batch.storage->Write(StorageOpts().FillCache().Sync(sync), *batch.updates);
+		} else if (sync) {
+			UpdatesCollection::Ptr empty(batch.storage->GetUpdatesCollection());
+			status = batch.storage->Write(StorageOpts().Sync(), *empty);
+		}
+	} catch (const Error &err) {
+		status = err;
+	}
+	if (!status.ok()) {
+		logPrintf(LogError, "Error write ns '%s' to storage: %s", batch.nsName, status.what());
+	}
+	if (batch.stat) {
+		batch.stat->Hit(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tmStart));
+	}
+	return status;
+}
+
+void StorageWriter::syncDirty() {
+	for (auto &storage : dirty_) {
+		try {
+			UpdatesCollection::Ptr empty(storage->GetUpdatesCollection());
+			Error status = storage->Write(StorageOpts().Sync(), *empty);
+			if (!status.ok()) logPrintf(LogError, "Error sync storage: %s", status.what());
+		} catch (const Error &err) {
+			logPrintf(LogError, "Error sync storage: %s", err.what());
+		}
+	}
+	dirty_.clear();
+	lastSync_ = std::chrono::steady_clock::now();
+}
+
+void StorageWriter::addDirty(const shared_ptr<IDataStorage> &storage) {
+	if (std::find(dirty_.begin(), dirty_.end(), storage) == dirty_.end()) dirty_.push_back(storage);
+}
+
+void StorageWriter::removeDirty(const shared_ptr<IDataStorage> &storage) {
+	auto it = std::find(dirty_.begin(), dirty_.end(), storage);
+	if (it != dirty_.end()) dirty_.erase(it);
+}
+
+}  // namespace datastorage
+}  // namespace reindexer
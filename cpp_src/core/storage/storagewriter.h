@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/namespacestat.h"
+#include "core/perfstatcounter.h"
+#include "idatastorage.h"
+
+namespace reindexer {
+namespace datastorage {
+
+/// Durability policy of the storage writer.
+enum class StorageFlushPolicy {
+	/// Batches are written without fsync. Durability is up to OS page cache.
+	Async = 0,
+	/// Batches are written without fsync, but each dirty storage is synced at least once per sync interval.
+	Periodic = 1,
+	/// Each group commit is synced before writers are notified.
+	PerCommit = 2,
+};
+
+/// Dedicated storage writer thread. Accumulates updates batches from all
+/// namespaces of database and writes them to storages in group commits,
+/// so namespaces do not hold their locks while waiting for disk IO.
+class StorageWriter {
+public:
+	using Ticket = uint64_t;
+
+	StorageWriter();
+	~StorageWriter();
+	StorageWriter(const StorageWriter &) = delete;
+	StorageWriter &operator=(const StorageWriter &) = delete;
+
+	/// Sets durability policy.
+	/// @param policy - durability policy.
+	/// @param syncInterval - max interval between fsyncs of dirty storage for Periodic policy.
+	void SetPolicy(StorageFlushPolicy policy, std::chrono::milliseconds syncInterval);
+	StorageFlushPolicy GetPolicy();
+
+	/// Enqueues updates batch to be written by writer thread.
+	/// Caller must not touch batch after the call.
+	/// @param storage - target storage.
+	/// @param batch - updates to be written.
+	/// @param forceSync - sync this batch regardless of policy.
+	/// @param stat - optional histogram to report write latency of batch.
+	/// @param nsName - name of namespace for logging.
+	/// @return ticket, which can be passed to Wait.
+	Ticket Submit(shared_ptr<IDataStorage> storage, UpdatesCollection::Ptr batch, bool forceSync, shared_ptr<LatencyHistogram> stat,
+				  const std::string &nsName);
+
+	/// Enqueues sync of all previously submitted batches of the storage.
+	/// @return ticket, which can be passed to Wait.
+	Ticket Sync(shared_ptr<IDataStorage> storage);
+
+	/// Waits until all batches up to ticket are written (and synced, if policy or batch requires it).
+	/// @return error of write or sync of batch with ticket, if it was failed.
+	Error Wait(Ticket ticket);
+
+	/// Returns latency histogram of group commits.
+	LatencyHistogramStat GetGroupCommitStat() const { return groupCommitStat_.Get<LatencyHistogramStat>(); }
+
+	/// Stops writer thread. All pending batches are written before return.
+	void Stop();
+
+protected:
+	struct Batch {
+		shared_ptr<IDataStorage> storage;
+		UpdatesCollection::Ptr updates;
+		bool forceSync;
+		shared_ptr<LatencyHistogram> stat;
+		std::string nsName;
+		Ticket ticket;
+	};
+
+	void run();
+	void writeGroup(std::vector<Batch> &group, bool syncAll);
+	static Error writeBatch(Batch &batch, bool sync);
+	void setError(Ticket ticket, const Error &err);
+	void syncDirty();
+	void addDirty(const shared_ptr<IDataStorage> &storage);
+	void removeDirty(const shared_ptr<IDataStorage> &storage);
+
+	std::mutex mtx_;
+	std::condition_variable cv_, doneCv_;
+	std::vector<Batch> queue_;
+	Ticket submitted_ = 0, written_ = 0;
+	// Errors of failed batches by tickets. When there are more than kMaxErrors errors, the oldest ones are dropped, and all tickets
+	// up to failedUpTo_ are reported as failed with the first dropped error: status of each of them is unknown
+	std::map<Ticket, Error> errors_;
+	Ticket failedUpTo_ = 0;
+	Error failedError_;
+	bool stop_ = false;
+	bool running_ = true;
+
+	StorageFlushPolicy policy_ = StorageFlushPolicy::Async;
+	std::chrono::milliseconds syncInterval_{1000};
+
+	// Accessed only from writer thread
+	std::vector<shared_ptr<IDataStorage>> dirty_;
+	std::chrono::steady_clock::time_point lastSync_;
+
+	LatencyHistogram groupCommitStat_;
+	std::thread thread_;
+};
+
+}  // namespace datastorage
+}  // namespace reindexer
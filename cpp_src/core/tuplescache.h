@@ -0,0 +1,39 @@
+#pragma once
+
+#include "core/keyvalue/key_string.h"
+#include "core/lrucache.h"
+#include "core/type_consts.h"
+
+namespace reindexer {
+
+// Item's tuple is identified by item id and lsn: lsn is changed on each modification of item, so cached tuple of
+// deleted or modified item is never returned for new item with the same id
+struct TuplesCacheKey {
+	size_t Size() const { return sizeof(TuplesCacheKey); }
+
+	IdType id;
+	int64_t lsn;
+};
+
+struct TuplesCacheVal {
+	size_t Size() const { return tuple ? sizeof(*tuple) + tuple->heap_size() : 0; }
+
+	key_string tuple;
+};
+
+struct equal_tuples_cache_key {
+	bool operator()(const TuplesCacheKey &lhs, const TuplesCacheKey &rhs) const { return lhs.id == rhs.id && lhs.lsn == rhs.lsn; }
+};
+struct hash_tuples_cache_key {
+	size_t operator()(const TuplesCacheKey &k) const { return std::hash<int64_t>()(k.lsn) ^ (size_t(k.id) << 16); }
+};
+
+// Cache of hot tuples of items, evicted from memory to storage
+class TuplesCache : public LRUCache<TuplesCacheKey, TuplesCacheVal, hash_tuples_cache_key, equal_tuples_cache_key> {
+public:
+	TuplesCache(size_t sizeLimit) : LRUCache(sizeLimit, 1) {}
+
+	typedef shared_ptr<TuplesCache> Ptr;
+};
+
+}  // namespace reindexer
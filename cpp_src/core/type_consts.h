@@ -35,6 +35,12 @@ typedef enum IndexType {
 	IndexStrStore = 15,
 	IndexDoubleStore = 16,
 	IndexCompositeFuzzyFT = 17,
+	IndexBoolBitmap = 18,
+	IndexIntBitmap = 19,
+	IndexInt64Bitmap = 20,
+	IndexStrBitmap = 21,
+	IndexCompositeGeo = 22,
+	IndexStrTrigram = 23,
 } IndexType;
 
 typedef enum QueryItemType {
@@ -72,6 +78,9 @@ typedef enum CondType {
 	CondSet = 7,
 	CondAllSet = 8,
 	CondEmpty = 9,
+	CondDWithin = 10,
+	CondInBox = 11,
+	CondLike = 12,
 } CondType;
 
 enum ErrorCode {
@@ -136,7 +145,13 @@ enum {
 	kResultsWithRaw = 0x200
 };
 
-typedef enum IndexOpt { kIndexOptPK = 1 << 7, kIndexOptArray = 1 << 6, kIndexOptDense = 1 << 5, kIndexOptSparse = 1 << 3 } IndexOpt;
+typedef enum IndexOpt {
+	kIndexOptPK = 1 << 7,
+	kIndexOptArray = 1 << 6,
+	kIndexOptDense = 1 << 5,
+	kIndexOptSparse = 1 << 3,
+	kIndexOptBloom = 1 << 2
+} IndexOpt;
 
 typedef enum StotageOpt {
 	kStorageOptEnabled = 1 << 0,
@@ -144,9 +144,15 @@ public:
 	int16_t word_len_at(int idx) const { return words_len_[idx].first; }
 	int16_t virtual_word_len(int idx) const { return words_len_[idx].second; }
 
-	void build() {
+	// Without suffix array only words are stored, and lookup finds nothing
+	void build(bool with_suffix_array = true) {
 		if (built_) return;
 		text_.shrink_to_fit();
+		if (!with_suffix_array) {
+			vector<V>().swap(mapped_);
+			built_ = true;
+			return;
+		}
 		sa_.resize(text_.length());
 		::divsufsort(reinterpret_cast<const char_type *>(text_.c_str()), &sa_[0], text_.length());
 		build_lcp();
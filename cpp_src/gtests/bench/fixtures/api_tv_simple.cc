@@ -45,6 +45,8 @@ void ApiTvSimple::RegisterAllCases() {
 	Register("Query4CondRange", &ApiTvSimple::Query4CondRange, this);
 	Register("Query4CondRangeTotal", &ApiTvSimple::Query4CondRangeTotal, this);
 	Register("Query4CondRangeCachedTotal", &ApiTvSimple::Query4CondRangeCachedTotal, this);
+	Register("QueryStoreRange", &ApiTvSimple::QueryStoreRange, this);
+	Register("QueryStoreRangeTotal", &ApiTvSimple::QueryStoreRangeTotal, this);
 }
 
 Error ApiTvSimple::Initialize() {
@@ -92,6 +94,7 @@ reindexer::Item ApiTvSimple::MakeItem() {
 	item["location"] = locations_.at(random<size_t>(0, locations_.size() - 1));
 	item["start_time"] = random<int>(0, 50000);
 	item["end_time"] = startTime + random<int>(1, 5) * 1000;
+	item["rate"] = random<int>(0, 1000) / 100.0;
 
 	return item;
 }
@@ -587,3 +590,27 @@ void ApiTvSimple::Query4CondRangeCachedTotal(benchmark::State& state) {
 		if (!err.ok()) state.SkipWithError(err.what().c_str());
 	}
 }
+
+void ApiTvSimple::QueryStoreRange(benchmark::State& state) {
+	AllocsTracker allocsTracker(state);
+	for (auto _ : state) {
+		Query q(nsdef_.name);
+		q.Where("rate", CondRange, {5.0, 5.5}).Where("age", CondLt, 3).Limit(20);
+
+		QueryResults qres;
+		auto err = db_->Select(q, qres);
+		if (!err.ok()) state.SkipWithError(err.what().c_str());
+	}
+}
+
+void ApiTvSimple::QueryStoreRangeTotal(benchmark::State& state) {
+	AllocsTracker allocsTracker(state);
+	for (auto _ : state) {
+		Query q(nsdef_.name);
+		q.Where("rate", CondRange, {5.0, 5.5}).Where("age", CondLt, 3).Limit(20).ReqTotal();
+
+		QueryResults qres;
+		auto err = db_->Select(q, qres);
+		if (!err.ok()) state.SkipWithError(err.what().c_str());
+	}
+}
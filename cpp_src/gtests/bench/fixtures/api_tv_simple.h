@@ -21,7 +21,8 @@ public:
 			.AddIndex("price_id", "hash", "int", IndexOpts().Array())
 			.AddIndex("location", "hash", "string", IndexOpts())
 			.AddIndex("end_time", "hash", "int", IndexOpts())
-			.AddIndex("start_time", "tree", "int", IndexOpts());
+			.AddIndex("start_time", "tree", "int", IndexOpts())
+			.AddIndex("rate", "-", "double", IndexOpts());
 	}
 
 	virtual void RegisterAllCases();
@@ -63,6 +64,8 @@ protected:
 	void Query4CondRange(State& state);
 	void Query4CondRangeTotal(State& state);
 	void Query4CondRangeCachedTotal(State& state);
+	void QueryStoreRange(State& state);
+	void QueryStoreRangeTotal(State& state);
 
 private:
 	vector<string> countries_;
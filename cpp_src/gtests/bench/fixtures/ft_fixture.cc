@@ -4,6 +4,7 @@
 #include <iterator>
 #include <thread>
 
+#include "gason/gason.h"
 #include "tools/stringstools.h"
 
 using benchmark::State;
@@ -28,7 +29,10 @@ FullText::FullText(Reindexer* db, const string& name, size_t maxItems) : BaseFix
 		.AddIndex("year", "tree", "int", IndexOpts())
 		.AddIndex("countries", "tree", "string", IndexOpts().Array())
 		.AddIndex("searchfast", {"countries", "description"}, "text", "composite", IndexOpts().Dense())
-		.AddIndex("searchfuzzy", {"countries", "description"}, "fuzzytext", "composite", IndexOpts());
+		.AddIndex("searchfastcompact", {"countries", "description"}, "text", "composite",
+				  IndexOpts().Dense().SetConfig("{\"compact_typos\":true}"))
+		.AddIndex("searchfuzzy", {"countries", "description"}, "fuzzytext", "composite", IndexOpts())
+		.AddIndex("searchfuzzydense", {"countries", "description"}, "fuzzytext", "composite", IndexOpts().Dense());
 }
 
 reindexer::Error FullText::Initialize() {
@@ -80,6 +84,10 @@ void FullText::RegisterAllCases() {
 	Register("BuildCommonIndexes", &FullText::BuildCommonIndexes, this)->Iterations(1)->Unit(benchmark::kMicrosecond);
 	Register("BuildFastTextIndex", &FullText::BuildFastTextIndex, this)->Iterations(1)->Unit(benchmark::kMicrosecond);
 	Register("BuildFuzzyTextIndex", &FullText::BuildFuzzyTextIndex, this)->Iterations(1)->Unit(benchmark::kMicrosecond);
+	Register("BuildFuzzyTextIndexDense", &FullText::BuildFuzzyTextIndexDense, this)->Iterations(1)->Unit(benchmark::kMicrosecond);
+	Register("BuildFastTextIndexCompactTypos", &FullText::BuildFastTextIndexCompactTypos, this)
+		->Iterations(1)
+		->Unit(benchmark::kMicrosecond);
 
 	Register("Fast1WordMatch", &FullText::Fast1WordMatch, this)->Unit(benchmark::kMicrosecond);
 	Register("Fast2WordsMatch", &FullText::Fast2WordsMatch, this)->Unit(benchmark::kMicrosecond);
@@ -89,6 +97,8 @@ void FullText::RegisterAllCases() {
 	Register("Fast2SuffixMatch", &FullText::Fast2SuffixMatch, this)->Unit(benchmark::kMicrosecond);
 	Register("Fast1TypoWordMatch", &FullText::Fast1TypoWordMatch, this)->Unit(benchmark::kMicrosecond);
 	Register("Fast2TypoWordMatch", &FullText::Fast2TypoWordMatch, this)->Unit(benchmark::kMicrosecond);
+	Register("Fast1TypoWordMatchCompactTypos", &FullText::Fast1TypoWordMatchCompactTypos, this)->Unit(benchmark::kMicrosecond);
+	Register("Fast2TypoWordMatchCompactTypos", &FullText::Fast2TypoWordMatchCompactTypos, this)->Unit(benchmark::kMicrosecond);
 
 	Register("Fuzzy1WordMatch", &FullText::Fuzzy1WordMatch, this)->Unit(benchmark::kMicrosecond);
 	Register("Fuzzy2WordsMatch", &FullText::Fuzzy2WordsMatch, this)->Unit(benchmark::kMicrosecond);
@@ -228,12 +238,12 @@ void FullText::BuildFastTextIndex(benchmark::State& state) {
 	state.SetLabel("Commit ratio: " + std::to_string(ratio));
 }
 
-void FullText::BuildFuzzyTextIndex(benchmark::State& state) {
+void FullText::BuildFastTextIndexCompactTypos(benchmark::State& state) {
 	AllocsTracker allocsTracker(state, printFlags);
 	size_t mem = 0;
 	for (auto _ : state) {
 		Query q(nsdef_.name);
-		q.Where("searchfuzzy", CondEq, words_.at(random<size_t>(0, words_.size() - 1))).Limit(20);
+		q.Where("searchfastcompact", CondEq, words_.at(random<size_t>(0, words_.size() - 1))).Limit(20);
 
 		QueryResults qres;
 
@@ -247,6 +257,58 @@ void FullText::BuildFuzzyTextIndex(benchmark::State& state) {
 	state.SetLabel("Commit ratio: " + std::to_string(ratio));
 }
 
+void FullText::BuildFuzzyTextIndex(benchmark::State& state) { buildFuzzyTextIndex(state, "searchfuzzy"); }
+
+// Dense fuzzy index is built by one thread
+void FullText::BuildFuzzyTextIndexDense(benchmark::State& state) { buildFuzzyTextIndex(state, "searchfuzzydense"); }
+
+void FullText::buildFuzzyTextIndex(benchmark::State& state, const string& index) {
+	AllocsTracker allocsTracker(state, printFlags);
+	size_t mem = 0;
+	for (auto _ : state) {
+		Query q(nsdef_.name);
+		q.Where(index, CondEq, words_.at(random<size_t>(0, words_.size() - 1))).Limit(20);
+
+		QueryResults qres;
+
+		mem = get_alloc_size();
+		auto err = db_->Select(q, qres);
+		mem = get_alloc_size() - mem;
+
+		if (!err.ok()) state.SkipWithError(err.what().c_str());
+	}
+	double ratio = mem / double(raw_data_sz_);
+	state.SetLabel("Commit ratio: " + std::to_string(ratio));
+	state.counters["FulltextMB"] = double(fulltextSize(index)) / (1024 * 1024);
+}
+
+// Size of fulltext data of index from memory statistics of namespace
+size_t FullText::fulltextSize(const string& index) {
+	QueryResults qr;
+	auto err = db_->Select(Query("#memstats").Where("name", CondEq, nsdef_.name), qr);
+	if (!err.ok() || qr.Count() != 1) return 0;
+
+	string json = qr[0].GetItem().GetJSON().ToString();
+	JsonAllocator jalloc;
+	JsonValue jvalue;
+	char* endp;
+	if (jsonParse(&json[0], &endp, &jvalue, jalloc) != JSON_OK || jvalue.getTag() != JSON_OBJECT) return 0;
+	for (auto elem : jvalue) {
+		if (string(elem->key) != "indexes" || elem->value.getTag() != JSON_ARRAY) continue;
+		for (auto idx : elem->value) {
+			size_t size = 0;
+			bool found = false;
+			for (auto field : idx->value) {
+				string key = field->key;
+				if (key == "name" && field->value.getTag() == JSON_STRING) found = index == field->value.toString();
+				if (key == "fulltext_size" && field->value.getTag() == JSON_NUMBER) size = field->value.toNumber();
+			}
+			if (found) return size;
+		}
+	}
+	return 0;
+}
+
 void FullText::Fast1WordMatch(benchmark::State& state) {
 	AllocsTracker allocsTracker(state, printFlags);
 	size_t cnt = 0;
@@ -483,6 +545,40 @@ void FullText::Fast2TypoWordMatch(benchmark::State& state) {
 	state.SetLabel(FormatString("RPR: %.1f", cnt / double(state.iterations())));
 }
 
+void FullText::Fast1TypoWordMatchCompactTypos(benchmark::State& state) {
+	AllocsTracker allocsTracker(state, printFlags);
+	size_t cnt = 0;
+	for (auto _ : state) {
+		Query q(nsdef_.name);
+
+		string word = MakeTypoWord();
+		q.Where("searchfastcompact", CondEq, word);
+
+		QueryResults qres;
+		auto err = db_->Select(q, qres);
+		if (!err.ok()) state.SkipWithError(err.what().c_str());
+		cnt += qres.Count();
+	}
+	state.SetLabel(FormatString("RPR: %.1f", cnt / double(state.iterations())));
+}
+
+void FullText::Fast2TypoWordMatchCompactTypos(benchmark::State& state) {
+	AllocsTracker allocsTracker(state, printFlags);
+	size_t cnt = 0;
+	for (auto _ : state) {
+		Query q(nsdef_.name);
+
+		string words = MakeTypoWord() + " " + MakeTypoWord();
+		q.Where("searchfastcompact", CondEq, words);
+
+		QueryResults qres;
+		auto err = db_->Select(q, qres);
+		if (!err.ok()) state.SkipWithError(err.what().c_str());
+		cnt += qres.Count();
+	}
+	state.SetLabel(FormatString("RPR: %.1f", cnt / double(state.iterations())));
+}
+
 void FullText::Fuzzy1TypoWordMatch(benchmark::State& state) {
 	AllocsTracker allocsTracker(state, printFlags);
 	size_t cnt = 0;
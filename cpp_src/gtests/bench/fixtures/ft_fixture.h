@@ -28,6 +28,8 @@ protected:
 	void BuildCommonIndexes(State& state);
 	void BuildFastTextIndex(State& state);
 	void BuildFuzzyTextIndex(State& state);
+	void BuildFuzzyTextIndexDense(State& state);
+	void BuildFastTextIndexCompactTypos(State& state);
 
 	void Fast1WordMatch(State& state);
 	void Fast2WordsMatch(State& state);
@@ -46,12 +48,17 @@ protected:
 
 	void Fast1TypoWordMatch(State& state);
 	void Fast2TypoWordMatch(State& state);
+	void Fast1TypoWordMatchCompactTypos(State& state);
+	void Fast2TypoWordMatchCompactTypos(State& state);
 	void Fuzzy1TypoWordMatch(State& state);
 	void Fuzzy2TypoWordMatch(State& state);
 
 	void BuildStepFastIndex(State& state);
 
 protected:
+	void buildFuzzyTextIndex(State& state, const string& index);
+	size_t fulltextSize(const string& index);
+
 	string CreatePhrase();
 
 	string MakePrefixWord();
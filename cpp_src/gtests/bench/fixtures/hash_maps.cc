@@ -0,0 +1,103 @@
+#include "hash_maps.h"
+
+#include <random>
+#include <unordered_map>
+#include "core/payload/payloadiface.h"
+
+using reindexer::IdSet;
+using reindexer::Payload;
+using reindexer::PayloadFieldType;
+using reindexer::PayloadValue;
+using reindexer::Variant;
+using reindexer::VariantArray;
+using reindexer::equal_composite;
+using reindexer::equal_sptr;
+using reindexer::hash_composite;
+using reindexer::hash_sptr;
+using reindexer::key_string;
+using reindexer::make_key_string;
+
+typedef reindexer::Index::KeyEntryPlain KeyEntry;
+
+HashMaps::HashMaps(size_t maxKeys) : maxKeys_(maxKeys), payloadType_("hash_maps"), compositeFields_({0, 1}) {
+	payloadType_.Add(PayloadFieldType(KeyValueInt, "id", {"id"}, false));
+	payloadType_.Add(PayloadFieldType(KeyValueString, "name", {"name"}, false));
+
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+	for (size_t i = 0; i < maxKeys_; ++i) {
+		int v = dist(gen);
+		intKeys_.push_back(v);
+		string s = "key-" + std::to_string(v) + "-" + std::to_string(i);
+		strKeys_.push_back(make_key_string(s.data(), s.size()));
+
+		PayloadValue pv(payloadType_.TotalSize());
+		Payload pl(payloadType_, pv);
+		VariantArray field;
+		field.push_back(Variant(int(i % 1000)));
+		pl.Set(0, field);
+		field.clear();
+		field.push_back(Variant(strKeys_.back()));
+		pl.Set(1, field);
+		compositeKeys_.push_back(pv);
+	}
+}
+
+void HashMaps::RegisterAllCases() {
+	registerCases("Int", std::unordered_map<int, KeyEntry>(), reindexer::fast_number_map<int, KeyEntry>(), intKeys_);
+
+	hash_sptr strHash(CollateASCII);
+	equal_sptr strEqual{CollateOpts(CollateASCII)};
+	registerCases("CollatedString", reindexer::unordered_str_map<KeyEntry>(1000, strHash, strEqual),
+				  reindexer::fast_str_map<KeyEntry>(1000, strHash, strEqual), strKeys_);
+
+	hash_composite compositeHash(payloadType_, compositeFields_);
+	equal_composite compositeEqual(payloadType_, compositeFields_);
+	registerCases("Composite", reindexer::unordered_payload_map<KeyEntry>(1000, compositeHash, compositeEqual),
+				  reindexer::fast_payload_map<KeyEntry>(1000, compositeHash, compositeEqual), compositeKeys_);
+}
+
+template <typename StdMap, typename FastMap, typename Key>
+void HashMaps::registerCases(const string& name, const StdMap& stdMap, const FastMap& fastMap, const vector<Key>& keys) {
+	string prefix = "HashMaps/" + name;
+	benchmark::RegisterBenchmark((prefix + "/Lookup/UnorderedMap").c_str(),
+								 [this, stdMap, &keys](State& state) { Lookup(state, stdMap, keys); });
+	benchmark::RegisterBenchmark((prefix + "/Lookup/OpenAddressing").c_str(),
+								 [this, fastMap, &keys](State& state) { Lookup(state, fastMap, keys); });
+	benchmark::RegisterBenchmark((prefix + "/Upsert/UnorderedMap").c_str(),
+								 [this, stdMap, &keys](State& state) { Upsert(state, stdMap, keys); })
+		->Iterations(10);
+	benchmark::RegisterBenchmark((prefix + "/Upsert/OpenAddressing").c_str(),
+								 [this, fastMap, &keys](State& state) { Upsert(state, fastMap, keys); })
+		->Iterations(10);
+}
+
+template <typename Map, typename Key>
+void HashMaps::Lookup(State& state, Map map, const vector<Key>& keys) {
+	for (size_t i = 0; i < keys.size(); ++i) {
+		map[keys[i]].Unsorted().Add(i, IdSet::Auto, 0);
+	}
+
+	size_t i = 0, found = 0;
+	for (auto _ : state) {
+		auto it = map.find(keys[i]);
+		if (it != map.end()) found++;
+		if (++i == keys.size()) i = 0;
+	}
+	if (found != size_t(state.iterations())) state.SkipWithError("Key not found");
+	state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Map, typename Key>
+void HashMaps::Upsert(State& state, const Map& emptyMap, const vector<Key>& keys) {
+	for (auto _ : state) {
+		Map map(emptyMap);
+		for (size_t i = 0; i < keys.size(); ++i) {
+			auto it = map.find(keys[i]);
+			if (it == map.end()) it = map.insert({keys[i], KeyEntry()}).first;
+			it->second.Unsorted().Add(i, IdSet::Auto, 0);
+		}
+		benchmark::DoNotOptimize(map.size());
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
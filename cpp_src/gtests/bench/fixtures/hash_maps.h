@@ -0,0 +1,39 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "core/index/index.h"
+#include "core/index/number_map.h"
+#include "core/index/payload_map.h"
+#include "core/index/string_map.h"
+
+using std::string;
+using std::vector;
+
+using benchmark::State;
+
+// Compares maps of hash indexes on raw map level: node based std::unordered_map, which was used before,
+// and open addressing maps. Measures point lookup and upsert throughput for int, collated string and composite keys
+class HashMaps {
+public:
+	HashMaps(size_t maxKeys);
+
+	void RegisterAllCases();
+
+protected:
+	template <typename Map, typename Key>
+	void Lookup(State& state, Map map, const vector<Key>& keys);
+	template <typename Map, typename Key>
+	void Upsert(State& state, const Map& emptyMap, const vector<Key>& keys);
+
+	template <typename StdMap, typename FastMap, typename Key>
+	void registerCases(const string& name, const StdMap& stdMap, const FastMap& fastMap, const vector<Key>& keys);
+
+	size_t maxKeys_;
+	vector<int> intKeys_;
+	vector<reindexer::key_string> strKeys_;
+	vector<reindexer::PayloadValue> compositeKeys_;
+	reindexer::PayloadType payloadType_;
+	reindexer::FieldsSet compositeFields_;
+};
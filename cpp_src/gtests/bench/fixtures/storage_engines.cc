@@ -0,0 +1,87 @@
+#include "storage_engines.h"
+
+#include <sys/stat.h>
+#include <vector>
+#include "tools/fsops.h"
+
+using reindexer::Error;
+using reindexer::datastorage::Cursor;
+using reindexer::datastorage::StorageFactory;
+using reindexer::datastorage::UpdatesCollection;
+namespace fs = reindexer::fs;
+
+static const size_t kBatchSize = 100;
+
+void StorageEngines::RegisterAllCases() {
+	for (auto type : {StorageType::LevelDB, StorageType::LogStorage}) {
+		string name = string("StorageEngines/") + StorageFactory::TypeName(type);
+		fs::RmDirAll(enginePath(type));
+		// Each iteration writes kBatchSize documents. Keys are reused, so the engines have to deal with garbage
+		benchmark::RegisterBenchmark((name + "/WriteBatch").c_str(), [this, type](State& state) { WriteBatch(state, type); })
+			->Iterations(maxDocs_ * 4 / kBatchSize);
+		benchmark::RegisterBenchmark((name + "/Load").c_str(), [this, type](State& state) { Load(state, type); })->Iterations(5);
+	}
+}
+
+void StorageEngines::WriteBatch(State& state, StorageType type) {
+	auto storage = open(state, type, true);
+	if (!storage) return;
+
+	string doc(docSize_, 'a');
+	unique_ptr<UpdatesCollection> batch(storage->GetUpdatesCollection());
+	size_t key = 0;
+	for (auto _ : state) {
+		batch->Clear();
+		for (size_t i = 0; i < kBatchSize; ++i, ++key) {
+			string k = "I" + std::to_string(key % maxDocs_);
+			doc[key % docSize_]++;
+			batch->Put(k, doc);
+		}
+		Error err = storage->Write(StorageOpts(), *batch);
+		if (!err.ok()) state.SkipWithError(err.what().c_str());
+	}
+	storage->Flush();
+	state.SetBytesProcessed(state.iterations() * kBatchSize * docSize_);
+	state.counters["DiskMB"] = double(diskUsage(enginePath(type))) / (1024 * 1024);
+}
+
+void StorageEngines::Load(State& state, StorageType type) {
+	size_t docs = 0;
+	for (auto _ : state) {
+		auto storage = open(state, type, false);
+		if (!storage) return;
+		StorageOpts opts;
+		unique_ptr<Cursor> cursor(storage->GetCursor(opts.FillCache(false)));
+		docs = 0;
+		for (cursor->SeekToFirst(); cursor->Valid(); cursor->Next()) {
+			benchmark::DoNotOptimize(cursor->Value());
+			docs++;
+		}
+	}
+	state.counters["Docs"] = docs;
+	state.counters["DiskMB"] = double(diskUsage(enginePath(type))) / (1024 * 1024);
+}
+
+unique_ptr<IDataStorage> StorageEngines::open(State& state, StorageType type, bool create) {
+	unique_ptr<IDataStorage> storage(StorageFactory::create(type));
+	StorageOpts opts;
+	Error err = storage->Open(enginePath(type), opts.CreateIfMissing(create));
+	if (!err.ok()) {
+		state.SkipWithError(err.what().c_str());
+		return nullptr;
+	}
+	return storage;
+}
+
+string StorageEngines::enginePath(StorageType type) const { return fs::JoinPath(path_, StorageFactory::TypeName(type)); }
+
+size_t StorageEngines::diskUsage(const string& path) const {
+	std::vector<fs::DirEntry> entries;
+	size_t total = 0;
+	if (fs::ReadDir(path, entries) < 0) return 0;
+	for (auto& e : entries) {
+		struct stat st;
+		if (!e.isDir && stat(fs::JoinPath(path, e.name).c_str(), &st) == 0) total += st.st_size;
+	}
+	return total;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include "core/storage/storagefactory.h"
+
+using std::string;
+using std::unique_ptr;
+
+using benchmark::State;
+
+using reindexer::datastorage::IDataStorage;
+using reindexer::datastorage::StorageType;
+
+// Compares storage engines on raw storage level: write throughput of batched
+// document rewrites, full load time and disk usage
+class StorageEngines {
+public:
+	StorageEngines(const string& path, size_t maxDocs, size_t docSize) : path_(path), maxDocs_(maxDocs), docSize_(docSize) {}
+
+	void RegisterAllCases();
+
+protected:
+	void WriteBatch(State& state, StorageType type);
+	void Load(State& state, StorageType type);
+
+	unique_ptr<IDataStorage> open(State& state, StorageType type, bool create);
+	string enginePath(StorageType type) const;
+	size_t diskUsage(const string& path) const;
+
+	string path_;
+	size_t maxDocs_;
+	size_t docSize_;
+};
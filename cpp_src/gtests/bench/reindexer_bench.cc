@@ -4,7 +4,9 @@
 
 #include "api_tv_composite.h"
 #include "api_tv_simple.h"
+#include "hash_maps.h"
 #include "join_items.h"
+#include "storage_engines.h"
 
 #include "tools/fsops.h"
 
@@ -36,6 +38,8 @@ int main(int argc, char** argv) {
 	JoinItems joinItems(DB.get(), 500);
 	ApiTvSimple apiTvSimple(DB.get(), "ApiTvSimple", kItemsInBenchDataset);
 	ApiTvComposite apiTvComposite(DB.get(), "ApiTvComposite", kItemsInBenchDataset);
+	StorageEngines storageEngines(kStoragePath "/engines", kItemsInBenchDataset / 5, 1024);
+	HashMaps hashMaps(kItemsInBenchDataset);
 
 	auto err = apiTvSimple.Initialize();
 	if (!err.ok()) return err.code();
@@ -52,6 +56,8 @@ int main(int argc, char** argv) {
 	joinItems.RegisterAllCases();
 	apiTvSimple.RegisterAllCases();
 	apiTvComposite.RegisterAllCases();
+	storageEngines.RegisterAllCases();
+	hashMaps.RegisterAllCases();
 
 	::benchmark::RunSpecifiedBenchmarks();
 }
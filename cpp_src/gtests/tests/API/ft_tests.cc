@@ -1,4 +1,5 @@
 #include <iostream>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include "debug/allocdebug.h"
@@ -56,6 +57,44 @@ TEST_F(FTApi, NumberToWordsSelect) {
 	}
 }
 
+TEST_F(FTApi, PhraseAndNear) {
+	Add("new york city", "");
+	Add("york new", "");
+	Add("new jersey and york", "");
+	Add("new big york", "");
+	Add("visit new", "york later");
+	Add("bank of america", "");
+	Add("alpha beta gamma", "");
+	Add("alpha beta delta beta gamma", "");
+
+	auto select = [&](const string& dsl) {
+		QueryResults res;
+		auto err = reindexer->Select(Query("nm2").Where("ft3", CondEq, dsl), res);
+		EXPECT_TRUE(err.ok()) << err.what();
+		std::set<string> found;
+		for (auto it : res) found.insert(it.GetItem()["ft1"].As<string>());
+		return found;
+	};
+
+	// Words of exact phrase follow each other in the same field
+	EXPECT_EQ(select("\"new york\""), (std::set<string>{"new york city"}));
+	EXPECT_EQ(select("\"new york\"~2"), (std::set<string>{"new york city", "york new", "new big york"}));
+	EXPECT_EQ(select("\"new york\"~3"), (std::set<string>{"new york city", "york new", "new big york", "new jersey and york"}));
+	// Stop words are skipped, but they take positions in document
+	EXPECT_EQ(select("\"bank of america\""), (std::set<string>{"bank of america"}));
+	// Each word of phrase follows the found positions of the previous word
+	EXPECT_EQ(select("\"alpha beta gamma\""), (std::set<string>{"alpha beta gamma"}));
+	EXPECT_EQ(select("\"beta gamma\""), (std::set<string>{"alpha beta gamma", "alpha beta delta beta gamma"}));
+
+	EXPECT_EQ(select("new NEAR/1 york"), (std::set<string>{"new york city", "york new"}));
+	EXPECT_EQ(select("new NEAR/2 york"), (std::set<string>{"new york city", "york new", "new big york"}));
+	EXPECT_EQ(select("alpha NEAR/2 gamma"), (std::set<string>{"alpha beta gamma"}));
+
+	QueryResults res;
+	auto err = reindexer->Select(Query("nm2").Where("ft3", CondEq, "NEAR/2 york"), res);
+	EXPECT_EQ(err.code(), errParseDSL);
+}
+
 TEST_F(FTApi, DeleteTest) {
 	unordered_map<string, int> data;
 
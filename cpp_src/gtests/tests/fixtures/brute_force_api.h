@@ -0,0 +1,72 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <map>
+#include "reindexer_api.h"
+
+// Namespace with pk 'id', which is modelled by rows of type Row. Query results are checked by brute force filter of the model
+template <typename Row>
+class BruteForceApi : public ReindexerApi {
+public:
+	using Filter = std::function<bool(int, const Row &)>;
+	using Less = std::function<bool(int, int)>;
+
+	// Checks, that query returns exactly ids of rows, matched by filter. Result of sorted query is compared with matched ids, which
+	// are ordered by less and cut by offset and limit of query. Ids, which are equal for less, can be returned in any order
+	void Check(Query q, Filter filter, Less less = nullptr) {
+		vector<int> expected, selected;
+		for (auto &it : rows_) {
+			if (filter(it.first, it.second)) expected.push_back(it.first);
+		}
+
+		QueryResults qr;
+		Error err = reindexer->Select(q.ReqTotal(), qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		EXPECT_EQ(qr.totalCount, expected.size()) << q.GetJSON();
+		for (auto it : qr) {
+			Item item = it.GetItem();
+			int id = item["id"].As<int>();
+			auto row = rows_.find(id);
+			ASSERT_TRUE(row != rows_.end()) << id;
+			EXPECT_TRUE(filter(id, row->second)) << q.GetJSON() << " id " << id;
+			CheckItem(item, row->second);
+			selected.push_back(id);
+		}
+
+		if (!less) {
+			std::sort(selected.begin(), selected.end());
+			EXPECT_EQ(selected, expected) << q.GetJSON();
+			return;
+		}
+		std::stable_sort(expected.begin(), expected.end(), less);
+		expected.erase(expected.begin(), expected.begin() + std::min<size_t>(q.start, expected.size()));
+		if (expected.size() > q.count) expected.resize(q.count);
+		ASSERT_EQ(selected.size(), expected.size()) << q.GetJSON();
+		for (size_t i = 0; i < selected.size(); ++i) {
+			EXPECT_FALSE(less(selected[i], expected[i]) || less(expected[i], selected[i])) << q.GetJSON() << " position " << i;
+		}
+	}
+
+	void UpsertJSON(const string &ns, const string &json) {
+		Item item = NewItem(ns);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		Error err = item.FromJSON(json);
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(ns, item);
+	}
+
+	void DeleteById(const string &ns, int id) {
+		Item item = NewItem(ns);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		Error err = item.FromJSON("{\"id\":" + std::to_string(id) + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		err = reindexer->Delete(ns, item);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+protected:
+	// Checks values of selected item, which are not checked by filter
+	virtual void CheckItem(Item &, const Row &) {}
+
+	std::map<int, Row> rows_;
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include "gason/gason.h"
+#include "reindexer_api.h"
+#include "tools/fsops.h"
+
+// Namespaces with pk 'id' and fulltext index 'text'. Composite fulltext index 'text' is built by fields 'text1' and 'text2'
+class FtIndexApi : public ReindexerApi {
+public:
+	void TearDown() override {
+		reindexer.reset();
+		reindexer::fs::RmDirAll(kStoragePath);
+	}
+
+	// Memory statistics are available only in database with storage
+	void Connect() {
+		reindexer::fs::RmDirAll(kStoragePath);
+		reindexer.reset(new Reindexer);
+		Error err = reindexer->Connect(string("builtin://") + kStoragePath);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void DefineNs(const string &ns, const string &config, bool composite = false) {
+		Error err = reindexer->OpenNamespace(ns);
+		ASSERT_TRUE(err.ok()) << err.what();
+		if (composite) {
+			DefineNamespaceDataset(ns, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+										IndexDeclaration{"text1", "-", "string", IndexOpts()},
+										IndexDeclaration{"text2", "-", "string", IndexOpts()},
+										IndexDeclaration{"text1+text2=text", "text", "composite", IndexOpts().SetConfig(config)}});
+		} else {
+			DefineNamespaceDataset(ns, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+										IndexDeclaration{"text", "text", "string", IndexOpts().SetConfig(config)}});
+		}
+	}
+
+	void UpsertItem(const string &ns, int id, const string &text) { upsertJSON(ns, id, ",\"text\":\"" + text + "\""); }
+	void UpsertItem(const string &ns, int id, const string &text1, const string &text2) {
+		upsertJSON(ns, id, ",\"text1\":\"" + text1 + "\",\"text2\":\"" + text2 + "\"");
+	}
+
+	void DeleteItem(const string &ns, int id) {
+		Item item = NewItem(ns);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		Error err = item.FromJSON("{\"id\":" + std::to_string(id) + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		err = reindexer->Delete(ns, item);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	// Ids and ranks of found items in order of results
+	vector<std::pair<int, int>> Select(const string &ns, const string &dsl, unsigned offset = 0, unsigned limit = UINT_MAX) {
+		QueryResults qr;
+		Error err = reindexer->Select(Query(ns, offset, limit).Where("text", CondEq, dsl), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		vector<std::pair<int, int>> res;
+		for (auto it : qr) res.emplace_back(it.GetItem()["id"].As<int>(), it.GetItemRef().proc);
+		return res;
+	}
+
+	// Items with equal ranks can be in different order
+	static vector<std::pair<int, int>> Sorted(vector<std::pair<int, int>> res) {
+		std::sort(res.begin(), res.end());
+		return res;
+	}
+	static vector<int> Ids(const vector<std::pair<int, int>> &res) {
+		vector<int> ids;
+		for (auto &r : res) ids.push_back(r.first);
+		return ids;
+	}
+	static vector<int> Ranks(const vector<std::pair<int, int>> &res) {
+		vector<int> ranks;
+		for (auto &r : res) ranks.push_back(r.second);
+		return ranks;
+	}
+
+	static string Word(int word) { return "word" + std::to_string(word); }
+
+	// Size of fulltext data of index from memory statistics of namespace
+	size_t FulltextSize(const string &ns, const string &index) {
+		QueryResults qr;
+		Error err = reindexer->Select(Query("#memstats").Where("name", CondEq, ns), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		EXPECT_EQ(qr.Count(), 1u);
+		if (qr.Count() != 1) return 0;
+		string json = qr[0].GetItem().GetJSON().ToString();
+		JsonAllocator jalloc;
+		JsonValue jvalue;
+		char *endp;
+		EXPECT_EQ(jsonParse(&json[0], &endp, &jvalue, jalloc), JSON_OK);
+		for (auto elem : jvalue) {
+			if (string(elem->key) != "indexes") continue;
+			for (auto idx : elem->value) {
+				size_t size = 0;
+				bool found = false;
+				for (auto field : idx->value) {
+					if (string(field->key) == "name") found = index == field->value.toString();
+					if (string(field->key) == "fulltext_size") size = field->value.toNumber();
+				}
+				if (found) return size;
+			}
+		}
+		return 0;
+	}
+
+	const char *kStoragePath = "/tmp/reindex/ft_index_api";
+
+private:
+	void upsertJSON(const string &ns, int id, const string &fields) {
+		Item item = NewItem(ns);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		Error err = item.FromJSON("{\"id\":" + std::to_string(id) + fields + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(ns, item);
+	}
+};
@@ -0,0 +1,142 @@
+#include <thread>
+#include "reindexer_api.h"
+#include "tools/fsops.h"
+
+class BackupApi : public ReindexerApi {
+public:
+	void SetUp() override {
+		reindexer::fs::RmDirAll(kStoragePath);
+		reindexer::fs::RmDirAll(kBackupPath);
+		reindexer.reset(new Reindexer);
+		Error err = reindexer->Connect(string("builtin://") + kStoragePath);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+	void TearDown() override {
+		reindexer.reset();
+		reindexer::fs::RmDirAll(kStoragePath);
+		reindexer::fs::RmDirAll(kBackupPath);
+	}
+
+	void DefineNs(const string &ns) {
+		Error err = reindexer->OpenNamespace(ns);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(ns, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"value", "tree", "string", IndexOpts()}});
+	}
+
+	void FillNs(const string &ns, int from, int count) {
+		for (int i = from; i < from + count; ++i) {
+			Item item = NewItem(ns);
+			ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+			item["id"] = i;
+			item["value"] = RandString();
+			Upsert(ns, item);
+		}
+		Error err = Commit(ns);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	size_t Count(const string &ns) {
+		QueryResults qr;
+		Error err = reindexer->Select(Query(ns), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		return qr.Count();
+	}
+
+	const char *kStoragePath = "/tmp/reindex/backup_test";
+	const char *kBackupPath = "/tmp/reindex/backup_test_dump";
+};
+
+TEST_F(BackupApi, BackupAndRestore) {
+	const string ns2 = "backup_ns2";
+	DefineNs(default_namespace);
+	DefineNs(ns2);
+	FillNs(default_namespace, 0, 1000);
+	FillNs(ns2, 0, 300);
+
+	Error err = reindexer->Backup(kBackupPath);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	// Second backup to the same directory must fail
+	err = reindexer->Backup(kBackupPath);
+	EXPECT_FALSE(err.ok());
+
+	// Modifications after backup must not be visible after restore
+	FillNs(default_namespace, 1000, 500);
+	err = reindexer->DropNamespace(ns2);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	err = reindexer->Restore(kBackupPath);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(Count(default_namespace), 1000u);
+	EXPECT_EQ(Count(ns2), 300u);
+
+	// Restored namespaces must be loadable from storage
+	err = reindexer->CloseNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	err = reindexer->OpenNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(Count(default_namespace), 1000u);
+	QueryResults qr;
+	err = reindexer->Select(Query(default_namespace).Where("id", CondEq, 999), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 1u);
+}
+
+TEST_F(BackupApi, RestoreWithoutBackup) {
+	Error err = reindexer->Restore(kBackupPath);
+	EXPECT_FALSE(err.ok());
+}
+
+TEST_F(BackupApi, BackupWithConcurrentWrites) {
+	DefineNs(default_namespace);
+	const int kWriters = 3, kBase = 1000000;
+	std::atomic<int> written[kWriters];
+	std::atomic<bool> stop{false};
+	vector<std::thread> writers;
+	for (int t = 0; t < kWriters; ++t) {
+		written[t] = 0;
+		writers.emplace_back([&, t]() {
+			// Each writer upserts its ids sequentially and flushes storage with commit
+			for (int i = 0; !stop; ++i) {
+				Item item = NewItem(default_namespace);
+				EXPECT_TRUE(item.Status().ok()) << item.Status().what();
+				item["id"] = t * kBase + i;
+				item["value"] = "value" + std::to_string(t * kBase + i);
+				Error err = reindexer->Upsert(default_namespace, item);
+				EXPECT_TRUE(err.ok()) << err.what();
+				if (i % 10 == 0) {
+					err = Commit(default_namespace);
+					EXPECT_TRUE(err.ok()) << err.what();
+				}
+				written[t] = i + 1;
+			}
+		});
+	}
+	while (written[0] < 500) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	int writtenBefore[kWriters];
+	for (int t = 0; t < kWriters; ++t) writtenBefore[t] = written[t];
+	Error err = reindexer->Backup(kBackupPath);
+	stop = true;
+	for (auto &th : writers) th.join();
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	err = reindexer->Restore(kBackupPath);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	// Backup is a snapshot of one moment: it contains all the items upserted before backup, and items of each writer are its prefix
+	for (int t = 0; t < kWriters; ++t) {
+		QueryResults qr;
+		err = reindexer->Select(Query(default_namespace).Where("id", CondRange, {t * kBase, (t + 1) * kBase - 1}).Sort("id", false), qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		EXPECT_GE(int(qr.Count()), writtenBefore[t]);
+		int expected = t * kBase;
+		for (auto it : qr) {
+			Item item = it.GetItem();
+			int id = item["id"].As<int>();
+			ASSERT_EQ(id, expected);
+			EXPECT_EQ(item["value"].As<string>(), "value" + std::to_string(id));
+			expected++;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#include "brute_force_api.h"
+
+// Rows hold values of 'active'. Other fields are functions of id
+class BitmapIndexApi : public BruteForceApi<bool> {
+public:
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"active", "bitmap", "bool", IndexOpts()},
+												   IndexDeclaration{"color", "bitmap", "string", IndexOpts().SetCollateMode(CollateASCII)},
+												   IndexDeclaration{"level", "bitmap", "int", IndexOpts()},
+												   IndexDeclaration{"rating", "tree", "int", IndexOpts()}});
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i, i % 3 == 0);
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void UpsertItem(int id, bool active) {
+		string json = "{\"id\":" + std::to_string(id) + ",\"active\":" + (active ? "true" : "false") +
+					  ",\"level\":" + std::to_string(Level(id)) + ",\"rating\":" + std::to_string(kItemsCount - id);
+		if (HasColor(id)) json += ",\"color\":\"" + Color(id) + "\"";
+		UpsertJSON(default_namespace, json + "}");
+		rows_[id] = active;
+	}
+
+	// Sorting by rating is reverse order of ids
+	static bool ByRating(int l, int r) { return l > r; }
+
+	static int Level(int id) { return id % 7; }
+	static bool HasColor(int id) { return id % 50 != 49; }
+	static string Color(int id) {
+		static const char *colors[] = {"red", "Green", "blue", "Black"};
+		return colors[id % 4];
+	}
+
+	static constexpr int kItemsCount = 1000;
+};
+
+TEST_F(BitmapIndexApi, Conditions) {
+	Check(Query(default_namespace).Where("active", CondEq, true), [](int, bool active) { return active; });
+	Check(Query(default_namespace).Where("color", CondEq, "RED"), [](int id, bool) { return HasColor(id) && Color(id) == "red"; });
+	Check(Query(default_namespace).Where("color", CondSet, {"red", "black"}),
+		  [](int id, bool) { return HasColor(id) && (Color(id) == "red" || Color(id) == "Black"); });
+	// Missing string field is indexed as empty string
+	Check(Query(default_namespace).Where("color", CondEq, ""), [](int id, bool) { return !HasColor(id); });
+	Check(Query(default_namespace).Where("level", CondGe, 5), [](int id, bool) { return Level(id) >= 5; });
+	Check(Query(default_namespace).Where("level", CondRange, {2, 4}), [](int id, bool) { return Level(id) >= 2 && Level(id) <= 4; });
+}
+
+TEST_F(BitmapIndexApi, MergedConditions) {
+	Check(Query(default_namespace).Where("active", CondEq, true).Where("color", CondEq, "red"),
+		  [](int id, bool active) { return active && HasColor(id) && Color(id) == "red"; });
+	Check(Query(default_namespace).Where("active", CondEq, true).Not().Where("level", CondLt, 3),
+		  [](int id, bool active) { return active && Level(id) >= 3; });
+	Check(Query(default_namespace).Where("level", CondEq, 1).Or().Where("color", CondEq, "blue").Where("active", CondEq, false),
+		  [](int id, bool active) { return (Level(id) == 1 || (HasColor(id) && Color(id) == "blue")) && !active; });
+	Check(Query(default_namespace).Where("active", CondEq, true).Where("id", CondLt, 500).Where("level", CondSet, {0, 6}),
+		  [](int id, bool active) { return active && id < 500 && (Level(id) == 0 || Level(id) == 6); });
+
+	// Limited query still returns total count of merged bitmap
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("active", CondEq, true).Where("level", CondEq, 2).Limit(3).ReqTotal(), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 3u);
+	EXPECT_EQ(qr.totalCount, 48u);
+}
+
+TEST_F(BitmapIndexApi, SortedSelect) {
+	// Sort by ordered index makes bitmap index fallback to comparators
+	Check(Query(default_namespace).Where("active", CondEq, true).Where("color", CondEq, "green").Sort("rating", false),
+		  [](int id, bool active) { return active && HasColor(id) && Color(id) == "Green"; }, ByRating);
+
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("active", CondEq, true).Sort("id", true).Limit(2), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.Count(), 2u);
+	EXPECT_EQ(qr[0].GetItem()["id"].As<int>(), 999);
+	EXPECT_EQ(qr[1].GetItem()["id"].As<int>(), 996);
+
+	qr.Clear();
+	err = reindexer->Select(Query(default_namespace).Distinct("color").Where("active", CondEq, true), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 5u);
+}
+
+TEST_F(BitmapIndexApi, Modifications) {
+	for (int id = 0; id < kItemsCount; id += 5) UpsertItem(id, !rows_[id]);
+	QueryResults delQr;
+	Error err = reindexer->Delete(Query(default_namespace).Where("level", CondEq, 3).Where("active", CondEq, true), delQr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (auto it : delQr) rows_.erase(it.GetItem()["id"].As<int>());
+	EXPECT_GT(delQr.Count(), 0u);
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	Check(Query(default_namespace).Where("active", CondEq, true), [](int, bool active) { return active; });
+	Check(Query(default_namespace).Where("active", CondEq, false).Where("level", CondEq, 3),
+		  [](int id, bool active) { return !active && Level(id) == 3; });
+	Check(Query(default_namespace).Where("level", CondEq, 3), [](int id, bool) { return Level(id) == 3; });
+}
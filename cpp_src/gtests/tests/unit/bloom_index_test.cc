@@ -0,0 +1,114 @@
+#include "brute_force_api.h"
+
+struct BloomIndexRow {
+	string name;
+	int64_t value;
+};
+
+class BloomIndexApi : public BruteForceApi<BloomIndexRow> {
+public:
+	using Row = BloomIndexRow;
+
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK().Bloom()},
+												   IndexDeclaration{"name", "hash", "string", IndexOpts(0, CollateUTF8).Bloom()},
+												   IndexDeclaration{"value", "tree", "int64", IndexOpts().Bloom()}});
+		err = reindexer->OpenNamespace(joinedNs_);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(joinedNs_, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+										   IndexDeclaration{"owner_id", "hash", "int", IndexOpts().Bloom()}});
+		// Inserts and deletes of keys rebuild bloom filters several times
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i);
+		for (int i = 0; i < kItemsCount; i += 2) DeleteItem(i);
+		for (int i = 0; i < kItemsCount; i += 4) UpsertItem(i);
+		for (int i = 0; i < kItemsCount / 10; ++i) {
+			UpsertJSON(joinedNs_, "{\"id\":" + std::to_string(i) + ",\"owner_id\":" + std::to_string(i * 7) + "}");
+		}
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		err = Commit(joinedNs_);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void UpsertItem(int id) {
+		Row row{"Name" + std::to_string(rand() % 5000), rand() % 100000};
+		UpsertJSON(default_namespace,
+				   "{\"id\":" + std::to_string(id) + ",\"name\":\"" + row.name + "\",\"value\":" + std::to_string(row.value) + "}");
+		rows_[id] = row;
+	}
+
+	void DeleteItem(int id) {
+		DeleteById(default_namespace, id);
+		rows_.erase(id);
+	}
+
+	static constexpr int kItemsCount = 10000;
+	const string joinedNs_ = "bloom_joined_ns";
+};
+
+TEST_F(BloomIndexApi, Selects) {
+	for (int i = 0; i < 200; ++i) {
+		int id = rand() % (kItemsCount * 2);
+		Check(Query(default_namespace).Where("id", CondEq, id), [id](int rid, const Row &) { return rid == id; });
+		int64_t value = rand() % 110000;
+		Check(Query(default_namespace).Where("value", CondEq, value), [value](int, const Row &r) { return r.value == value; });
+	}
+	Check(Query(default_namespace).Where("id", CondSet, {1, 2, 3, kItemsCount + 1, kItemsCount + 2}),
+		  [](int id, const Row &) { return id == 1 || id == 2 || id == 3; });
+	// Keys are compared by collate rules
+	Check(Query(default_namespace).Where("name", CondSet, {"name10", "NAME11", "Name5001"}), [](int, const Row &r) {
+		return r.name == "Name10" || r.name == "Name11";
+	});
+	Check(Query(default_namespace).Where("name", CondEq, "absent"), [](int, const Row &) { return false; });
+}
+
+TEST_F(BloomIndexApi, JoinProbes) {
+	auto check = [this](JoinType joinType) {
+		Query q(default_namespace);
+		Query jq(joinedNs_);
+		if (joinType == InnerJoin) {
+			q.InnerJoin("id", "owner_id", CondEq, jq);
+		} else {
+			q.LeftJoin("id", "owner_id", CondEq, jq);
+		}
+		QueryResults qr;
+		Error err = reindexer->Select(q, qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		size_t joined = 0, expected = 0;
+		for (auto &it : rows_) {
+			if (it.first % 7 == 0 && it.first / 7 < kItemsCount / 10) ++expected;
+		}
+		for (auto it : qr) {
+			const auto &joinedResults = it.GetJoined();
+			if (joinedResults.empty() || joinedResults[0].Count() == 0) continue;
+			ASSERT_EQ(joinedResults[0].Count(), 1u);
+			EXPECT_EQ(joinedResults[0][0].GetItem()["owner_id"].As<int>(), it.GetItem()["id"].As<int>());
+			++joined;
+		}
+		EXPECT_EQ(joined, expected);
+		EXPECT_EQ(qr.Count(), joinType == InnerJoin ? expected : rows_.size());
+	};
+	check(InnerJoin);
+	check(LeftJoin);
+}
+
+TEST_F(BloomIndexApi, Errors) {
+	auto addIndex = [this](const string &name, const string &indexType, const string &fieldType, IndexOpts opts) {
+		return reindexer->AddIndex(default_namespace, {name, {name}, indexType, fieldType, opts.Bloom()});
+	};
+	EXPECT_FALSE(addIndex("f1", "-", "int", IndexOpts()).ok());
+	EXPECT_FALSE(addIndex("f1", "text", "string", IndexOpts()).ok());
+	EXPECT_FALSE(addIndex("f1", "hash", "string", IndexOpts(0, CollateNumeric)).ok());
+	EXPECT_FALSE(reindexer->AddIndex(default_namespace, {"id+value", {"id", "value"}, "hash", "composite", IndexOpts().Bloom()}).ok());
+	EXPECT_TRUE(addIndex("f1", "tree", "double", IndexOpts()).ok());
+
+	vector<reindexer::NamespaceDef> defs;
+	Error err = reindexer->EnumNamespaces(defs, false);
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (auto &def : defs) {
+		if (def.name != default_namespace) continue;
+		for (auto &idef : def.indexes) EXPECT_EQ(idef.opts_.IsBloom(), idef.name_ != "-tuple") << idef.name_;
+	}
+}
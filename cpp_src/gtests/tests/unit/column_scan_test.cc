@@ -0,0 +1,80 @@
+#include "brute_force_api.h"
+
+// Values of fields are functions of id
+struct ColumnScanRow {};
+
+class ColumnScanApi : public BruteForceApi<ColumnScanRow> {
+public:
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"price", "-", "int", IndexOpts()},
+												   IndexDeclaration{"stamp", "-", "int64", IndexOpts()},
+												   IndexDeclaration{"weight", "-", "double", IndexOpts()},
+												   IndexDeclaration{"stock", "-", "int", IndexOpts().Dense()},
+												   IndexDeclaration{"group", "hash", "int", IndexOpts()},
+												   IndexDeclaration{"rating", "tree", "int", IndexOpts()}});
+		for (int i = 0; i < kItemsCount; ++i) {
+			UpsertJSON(default_namespace, "{\"id\":" + std::to_string(i) + ",\"price\":" + std::to_string(Price(i)) +
+											  ",\"stamp\":" + std::to_string(Stamp(i)) + ",\"weight\":" + std::to_string(Weight(i)) +
+											  ",\"stock\":" + std::to_string(i % 10) + ",\"group\":" + std::to_string(i % 2) +
+											  ",\"rating\":" + std::to_string(kItemsCount - i) + "}");
+			rows_[i] = ColumnScanRow();
+		}
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	static int Price(int id) { return (id * 37) % 1000; }
+	static int64_t Stamp(int id) { return 1500000000000LL + id; }
+	static double Weight(int id) { return double(id % 100) / 4; }
+
+	static constexpr int kItemsCount = 1000;
+};
+
+TEST_F(ColumnScanApi, Conditions) {
+	Check(Query(default_namespace).Where("price", CondEq, 37), [](int id, const ColumnScanRow &) { return Price(id) == 37; });
+	Check(Query(default_namespace).Where("price", CondLt, 100), [](int id, const ColumnScanRow &) { return Price(id) < 100; });
+	Check(Query(default_namespace).Where("price", CondRange, {200, 300}),
+		  [](int id, const ColumnScanRow &) { return Price(id) >= 200 && Price(id) <= 300; });
+	Check(Query(default_namespace).Where("stamp", CondGe, Stamp(900)), [](int id, const ColumnScanRow &) { return id >= 900; });
+	Check(Query(default_namespace).Where("weight", CondGt, 20.0), [](int id, const ColumnScanRow &) { return Weight(id) > 20.0; });
+	Check(Query(default_namespace).Where("weight", CondLe, 1.5), [](int id, const ColumnScanRow &) { return Weight(id) <= 1.5; });
+	Check(Query(default_namespace).Where("price", CondSet, {1, 2, 3}),
+		  [](int id, const ColumnScanRow &) { return Price(id) >= 1 && Price(id) <= 3; });
+	// Dense index has no column
+	Check(Query(default_namespace).Where("stock", CondEq, 3), [](int id, const ColumnScanRow &) { return id % 10 == 3; });
+}
+
+TEST_F(ColumnScanApi, CombinedConditions) {
+	Check(Query(default_namespace).Where("price", CondLt, 500).Where("weight", CondGe, 10.0).Not().Where("stamp", CondLt, Stamp(100)),
+		  [](int id, const ColumnScanRow &) { return Price(id) < 500 && Weight(id) >= 10.0 && id >= 100; });
+	Check(Query(default_namespace).Where("group", CondEq, 1).Where("price", CondGt, 900),
+		  [](int id, const ColumnScanRow &) { return id % 2 == 1 && Price(id) > 900; });
+	Check(Query(default_namespace).Where("id", CondSet, {1, 2, 3, 4}).Where("price", CondGt, 100),
+		  [](int id, const ColumnScanRow &) { return id >= 1 && id <= 4 && Price(id) > 100; });
+	Check(Query(default_namespace).Where("price", CondLt, 100).Or().Where("weight", CondEq, 0.0),
+		  [](int id, const ColumnScanRow &) { return Price(id) < 100 || Weight(id) == 0.0; });
+
+	// Sort by ordered index makes comparators to check rows in order of sort index
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("price", CondLt, 100).Sort("rating", false).Limit(1), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.Count(), 1u);
+	EXPECT_LT(Price(qr[0].GetItem()["id"].As<int>()), 100);
+	EXPECT_GT(qr[0].GetItem()["id"].As<int>(), 900);
+}
+
+TEST_F(ColumnScanApi, DeletedItems) {
+	QueryResults delQr;
+	Error err = reindexer->Delete(Query(default_namespace).Where("id", CondLt, 300), delQr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(delQr.Count(), 300u);
+	for (int id = 0; id < 300; ++id) rows_.erase(id);
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	Check(Query(default_namespace).Where("price", CondLt, 500), [](int id, const ColumnScanRow &) { return Price(id) < 500; });
+	Check(Query(default_namespace).Where("stamp", CondGe, Stamp(0)), [](int, const ColumnScanRow &) { return true; });
+}
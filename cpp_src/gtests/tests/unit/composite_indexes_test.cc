@@ -1,4 +1,6 @@
 #include "composite_indexes_api.h"
+#include "core/index/index.h"
+#include "core/index/updatetracker.h"
 
 TEST_F(CompositeIndexesApi, CompositeIndexesAddTest) {
 	addCompositeIndex({kFieldNameBookid, kFieldNameBookid2}, CompositeIndexHash, IndexOpts().PK());
@@ -198,3 +200,50 @@ TEST_F(CompositeIndexesApi, CompositeIndexesSelectTest) {
 	err = reindexer->Select(Query(default_namespace), qr13);
 	EXPECT_TRUE(err.ok()) << err.what();
 }
+
+// Updated keys of composite open addressing map are tracked for partial commit, while inserts rehash the map
+TEST(CompositeUpdateTracker, PartialUpdates) {
+	using reindexer::PayloadValue;
+	using Map = reindexer::fast_payload_map<reindexer::Index::KeyEntryPlain>;
+	reindexer::PayloadType payloadType("composite_tracker");
+	payloadType.Add(reindexer::PayloadFieldType(KeyValueInt, "a", {"a"}, false));
+	payloadType.Add(reindexer::PayloadFieldType(KeyValueInt, "b", {"b"}, false));
+	reindexer::FieldsSet fields({0, 1});
+	auto makeKey = [&](int a, int b) {
+		PayloadValue pv(payloadType.TotalSize());
+		reindexer::Payload pl(payloadType, pv);
+		pl.Set(0, VariantArray{Variant(a)});
+		pl.Set(1, VariantArray{Variant(b)});
+		return pv;
+	};
+	auto upsert = [&](Map &map, int key, IdType id) {
+		auto it = map.find(makeKey(key, key + 1));
+		if (it == map.end()) it = map.insert({makeKey(key, key + 1), reindexer::Index::KeyEntryPlain()}).first;
+		it->second.Unsorted().Add(id, reindexer::IdSet::Auto, 0);
+		return it;
+	};
+
+	Map map(16, reindexer::hash_composite(payloadType, fields), reindexer::equal_composite(payloadType, fields));
+	reindexer::UpdateTracker<Map> tracker;
+	for (int i = 0; i < 1000; ++i) upsert(map, i, i);
+	tracker.markCompleteUpdated();
+	tracker.clear();
+
+	// Existing and new keys are updated. New keys make the map grow and move its entries
+	for (int i = 0; i < 100; ++i) {
+		auto it = upsert(map, i % 2 ? i : 1000 + i, 2000 + i);
+		tracker.markUpdated(map, &*it);
+	}
+	auto it = map.find(makeKey(1002, 1003));
+	ASSERT_TRUE(it != map.end());
+	tracker.markDeleted(&*it);
+	map.erase(it);
+
+	EXPECT_TRUE(tracker.isUpdated());
+	EXPECT_FALSE(tracker.isCompleteUpdated());
+	EXPECT_EQ(tracker.updated().size(), 99u);
+	EXPECT_EQ(tracker.updated().count(map.find(makeKey(1, 2))->first), 1u);
+	EXPECT_EQ(tracker.updated().count(map.find(makeKey(2, 3))->first), 0u);
+	tracker.commitUpdated(map);
+	EXPECT_EQ(map.find(makeKey(1, 2))->second.Unsorted().size(), 2u);
+}
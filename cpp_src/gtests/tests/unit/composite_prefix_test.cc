@@ -0,0 +1,157 @@
+#include <limits>
+#include <thread>
+#include "brute_force_api.h"
+
+struct CompositePrefixRow {
+	string tenant;
+	int64_t created;
+	double score;
+};
+
+class CompositePrefixApi : public BruteForceApi<CompositePrefixRow> {
+public:
+	using Row = CompositePrefixRow;
+
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"tenant", "hash", "string", IndexOpts()},
+												   IndexDeclaration{"created", "tree", "int64", IndexOpts()},
+												   IndexDeclaration{"score", "-", "double", IndexOpts()}});
+		err = reindexer->AddIndex(default_namespace, {kCompositeName, {"tenant", "created", "score"}, "tree", "composite", IndexOpts()});
+		ASSERT_TRUE(err.ok()) << err.what();
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i);
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void UpsertItem(int id) {
+		Row row{"tenant" + std::to_string(rand() % 7), int64_t(rand() % 200) - 50, double(rand() % 20) / 4};
+		UpsertJSON(default_namespace, "{\"id\":" + std::to_string(id) + ",\"tenant\":\"" + row.tenant + "\",\"created\":" +
+										  std::to_string(row.created) + ",\"score\":" + std::to_string(row.score) + "}");
+		rows_[id] = row;
+	}
+
+	// Sorted result is compared by values of 'created'
+	Less ByCreated(bool desc) {
+		return [this, desc](int l, int r) { return desc ? rows_[l].created > rows_[r].created : rows_[l].created < rows_[r].created; };
+	}
+
+	void CheckAll() {
+		for (int t = 0; t < 8; ++t) {
+			string tenant = "tenant" + std::to_string(t);
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant), [&](int, const Row &r) { return r.tenant == tenant; });
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant).Where("created", CondEq, 10),
+				  [&](int, const Row &r) { return r.tenant == tenant && r.created == 10; });
+			Check(Query(default_namespace).Where("created", CondGt, 20).Where("tenant", CondEq, tenant),
+				  [&](int, const Row &r) { return r.tenant == tenant && r.created > 20; });
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant).Where("created", CondGe, 20),
+				  [&](int, const Row &r) { return r.tenant == tenant && r.created >= 20; });
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant).Where("created", CondLt, -10),
+				  [&](int, const Row &r) { return r.tenant == tenant && r.created < -10; });
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant).Where("created", CondLe, -10),
+				  [&](int, const Row &r) { return r.tenant == tenant && r.created <= -10; });
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant).Where("created", CondEq, 5).Where("score", CondGt, 2.5),
+				  [&](int, const Row &r) { return r.tenant == tenant && r.created == 5 && r.score > 2.5; });
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant).Where("created", CondEq, 5).Where("score", CondLt, 2.5),
+				  [&](int, const Row &r) { return r.tenant == tenant && r.created == 5 && r.score < 2.5; });
+			// OR binds condition on prefix field with another condition, so it can't be substituted
+			Check(Query(default_namespace).Where("tenant", CondEq, tenant).Or().Where("created", CondEq, 7),
+				  [&](int, const Row &r) { return r.tenant == tenant || r.created == 7; });
+
+			for (bool desc : {false, true}) {
+				Query q = Query(default_namespace).Where("tenant", CondEq, tenant).Where("created", CondRange, {0, 100});
+				Check(q.Sort("created", desc).Limit(15),
+					  [&](int, const Row &r) { return r.tenant == tenant && r.created >= 0 && r.created <= 100; }, ByCreated(desc));
+			}
+		}
+	}
+
+	// Sort orders are built by background routine of namespace. Returns explain of sorted query after that
+	string WaitSortOrders() {
+		Query q = Query(default_namespace).Where("tenant", CondEq, "tenant1").Where("created", CondGe, 10).Sort("created", false).Limit(5);
+		q.Explain();
+		string explain;
+		for (int i = 0; i < 100; ++i) {
+			QueryResults qr;
+			Error err = reindexer->Select(q, qr);
+			EXPECT_TRUE(err.ok()) << err.what();
+			explain = qr.GetExplainResults();
+			if (explain.find("\"sort_index\":\"-\"") == string::npos) break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+		return explain;
+	}
+
+	const string kCompositeName = "tenant+created+score";
+	static constexpr int kItemsCount = 5000;
+};
+
+TEST_F(CompositePrefixApi, Selects) {
+	CheckAll();
+	// Ranges of composite index are selected from sort orders of the index
+	WaitSortOrders();
+	CheckAll();
+}
+
+TEST_F(CompositePrefixApi, Modifications) {
+	for (int id = 0; id < kItemsCount; id += 4) UpsertItem(id);
+	QueryResults qr;
+	Error err = reindexer->Delete(Query(default_namespace).Where("tenant", CondEq, "tenant3").Where("created", CondLt, 0), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_GT(qr.Count(), 0u);
+	for (auto it : qr) rows_.erase(it.GetItem()["id"].As<int>());
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	CheckAll();
+}
+
+TEST_F(CompositePrefixApi, Explain) {
+	string explain = WaitSortOrders();
+	EXPECT_NE(explain.find("\"sort_index\":\"" + kCompositeName + "\""), string::npos) << explain;
+	EXPECT_EQ(explain.find("\"field\":\"tenant\""), string::npos) << explain;
+}
+
+// Strict range conditions, which can't be converted to bounds, are kept as is, and equal conditions before them are substituted
+TEST_F(CompositePrefixApi, UnboundedStrictRanges) {
+	const double inf = std::numeric_limits<double>::infinity();
+	for (int t = 0; t < 7; ++t) {
+		string tenant = "tenant" + std::to_string(t);
+		Query q = Query(default_namespace).Where("tenant", CondEq, tenant);
+		Check(Query(q).Where("created", CondGt, std::numeric_limits<int64_t>::max()), [](int, const Row &) { return false; });
+		Check(Query(q).Where("created", CondLt, std::numeric_limits<int64_t>::min()), [](int, const Row &) { return false; });
+		Check(Query(q).Where("created", CondEq, 5).Where("score", CondLt, inf),
+			  [&](int, const Row &r) { return r.tenant == tenant && r.created == 5; });
+		Check(Query(q).Where("created", CondEq, 5).Where("score", CondGt, -inf),
+			  [&](int, const Row &r) { return r.tenant == tenant && r.created == 5; });
+	}
+
+	// There is no nearest less string
+	const string ns = "composite_prefix_strings";
+	Error err = reindexer->OpenNamespace(ns);
+	ASSERT_TRUE(err.ok()) << err.what();
+	DefineNamespaceDataset(ns, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+								IndexDeclaration{"tenant", "hash", "int", IndexOpts()},
+								IndexDeclaration{"name", "tree", "string", IndexOpts()}});
+	err = reindexer->AddIndex(ns, {"tenant+name", {"tenant", "name"}, "tree", "composite", IndexOpts()});
+	ASSERT_TRUE(err.ok()) << err.what();
+	std::map<int, std::pair<int, string>> rows;
+	for (int i = 0; i < 500; ++i) {
+		rows[i] = {rand() % 5, string(1, 'a' + rand() % 26) + std::to_string(i)};
+		Item item = NewItem(ns);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		err = item.FromJSON("{\"id\":" + std::to_string(i) + ",\"tenant\":" + std::to_string(rows[i].first) + ",\"name\":\"" +
+							rows[i].second + "\"}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(ns, item);
+	}
+	err = Commit(ns);
+	ASSERT_TRUE(err.ok()) << err.what();
+	QueryResults qr;
+	err = reindexer->Select(Query(ns).Where("tenant", CondEq, 2).Where("name", CondLt, "m"), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	size_t expected = 0;
+	for (auto &it : rows) expected += it.second.first == 2 && it.second.second < "m";
+	EXPECT_EQ(qr.Count(), expected);
+}
@@ -0,0 +1,138 @@
+#include <atomic>
+#include <thread>
+#include "ft_index_api.h"
+
+class FtBackgroundCommitApi : public FtIndexApi {
+public:
+	void Init(bool readYourWrites, bool composite = false) {
+		composite_ = composite;
+		string config = string(R"json({"max_typos_in_word":0,"enable_background_commit":true,"read_your_writes":)json") +
+						(readYourWrites ? "true" : "false") + "}";
+		DefineNs(default_namespace, config, composite);
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i, i);
+		Error err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	// Words of composite index are in both fields
+	void UpsertItem(int id, int word) {
+		if (composite_) {
+			FtIndexApi::UpsertItem(default_namespace, id, "common", Word(word));
+		} else {
+			FtIndexApi::UpsertItem(default_namespace, id, "common " + Word(word));
+		}
+		std::lock_guard<std::mutex> lck(wordsMtx_);
+		words_[id] = word;
+	}
+
+	void DeleteItem(int id) {
+		FtIndexApi::DeleteItem(default_namespace, id);
+		std::lock_guard<std::mutex> lck(wordsMtx_);
+		words_.erase(id);
+	}
+
+	// Selects items by word. Checks, that all the found items contain the word
+	vector<int> Search(int word) {
+		QueryResults qr;
+		Error err = reindexer->Select(Query(default_namespace).Where("text", CondEq, Word(word)), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		vector<int> ids;
+		for (auto it : qr) {
+			Item item = it.GetItem();
+			if (composite_) {
+				EXPECT_EQ(item["text2"].As<string>(), Word(word));
+			} else {
+				EXPECT_EQ(item["text"].As<string>(), "common " + Word(word));
+			}
+			ids.push_back(item["id"].As<int>());
+		}
+		return ids;
+	}
+
+	// Updates and deletes items in one thread, while fulltext data are built in background by selects of another one
+	void ConcurrentUpdates() {
+		std::atomic<bool> done(false);
+		std::thread writer([&]() {
+			for (int i = 0; i < 3000; ++i) {
+				int id = rand() % (kItemsCount * 2);
+				if (rand() % 4) {
+					UpsertItem(id, rand() % (kItemsCount * 2));
+				} else {
+					DeleteItem(id);
+				}
+			}
+			done = true;
+		});
+		while (!done) {
+			// Search checks, that stale data don't return items, which don't contain the word
+			Search(rand() % (kItemsCount * 2));
+		}
+		writer.join();
+
+		// After all the updates data are eventually consistent
+		bool consistent = false;
+		for (int i = 0; i < 1000 && !consistent; ++i) {
+			consistent = true;
+			for (int word = 0; word < kItemsCount * 2 && consistent; word += 97) {
+				vector<int> expected;
+				for (auto &it : words_) {
+					if (it.second == word) expected.push_back(it.first);
+				}
+				vector<int> found = Search(word);
+				std::sort(found.begin(), found.end());
+				consistent = found == expected;
+			}
+			if (!consistent) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		EXPECT_TRUE(consistent);
+	}
+
+	static constexpr int kItemsCount = 5000;
+	bool composite_ = false;
+	std::mutex wordsMtx_;
+	std::map<int, int> words_;
+};
+
+TEST_F(FtBackgroundCommitApi, EventualPublish) {
+	Init(false);
+	// First select waits for build of fulltext data
+	EXPECT_EQ(Search(10), vector<int>{10});
+
+	UpsertItem(kItemsCount, kItemsCount);
+	DeleteItem(20);
+	// Deleted item is not returned even by the previous data
+	EXPECT_TRUE(Search(20).empty());
+	bool found = false;
+	for (int i = 0; i < 1000 && !found; ++i) {
+		found = Search(kItemsCount) == vector<int>{kItemsCount};
+		if (!found) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	EXPECT_TRUE(found);
+	EXPECT_TRUE(Search(20).empty());
+	EXPECT_EQ(Search(30), vector<int>{30});
+}
+
+TEST_F(FtBackgroundCommitApi, ReadYourWrites) {
+	Init(true);
+	for (int i = 0; i < 20; ++i) {
+		int id = kItemsCount + i;
+		UpsertItem(id, id);
+		EXPECT_EQ(Search(id), vector<int>{id});
+		UpsertItem(id, id + 1000);
+		EXPECT_TRUE(Search(id).empty());
+		EXPECT_EQ(Search(id + 1000), vector<int>{id});
+		DeleteItem(i);
+		EXPECT_TRUE(Search(i).empty());
+	}
+}
+
+TEST_F(FtBackgroundCommitApi, ConcurrentUpdates) {
+	Init(false);
+	ConcurrentUpdates();
+}
+
+// Strings of composite keys are read by background build, while their items are updated and deleted
+TEST_F(FtBackgroundCommitApi, CompositeConcurrentUpdates) {
+	Init(false, true);
+	ConcurrentUpdates();
+}
@@ -0,0 +1,42 @@
+#include "ft_index_api.h"
+
+class FtCompactTyposApi : public FtIndexApi {
+public:
+	void SetUp() override {
+		ReindexerApi::SetUp();
+		for (const string &ns : {kMapNs, kCompactNs}) {
+			DefineNs(ns, string(R"json({"max_typos_in_word":2,"max_step_size":10,"compact_typos":)json") +
+							 (ns == kCompactNs ? "true" : "false") + "}");
+		}
+	}
+
+	// The same documents are upserted to both namespaces. Commit after each part of documents makes several steps
+	void Fill(int from, int to) {
+		for (const string &ns : {kMapNs, kCompactNs}) {
+			for (int i = from; i < to; ++i) UpsertItem(ns, i, words_[i % words_.size()] + " " + words_[(i * 7) % words_.size()]);
+			Error err = Commit(ns);
+			ASSERT_TRUE(err.ok()) << err.what();
+		}
+	}
+
+	// Typos of words find the same documents with the same ranks in both dictionaries
+	void Check() {
+		for (const char *dsl : {"algorithm~", "algoritm~", "algorihtm~", "agorithm~", "sturcture~", "structure~", "dta~", "gaph~",
+								"grph~ tree~", "traversal", "nosuchword~"}) {
+			EXPECT_EQ(Sorted(Select(kCompactNs, dsl)), Sorted(Select(kMapNs, dsl))) << dsl;
+		}
+		EXPECT_FALSE(Select(kCompactNs, "algoritm~").empty());
+	}
+
+	const vector<string> words_ = {"algorithm", "structure", "data", "graph", "tree", "traversal", "sorting", "search"};
+	const string kMapNs = "ft_map_typos";
+	const string kCompactNs = "ft_compact_typos";
+};
+
+TEST_F(FtCompactTyposApi, SameResults) {
+	Fill(0, 100);
+	Check();
+	Fill(100, 105);
+	Fill(105, 110);
+	Check();
+}
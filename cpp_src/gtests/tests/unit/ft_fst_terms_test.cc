@@ -0,0 +1,93 @@
+#include <set>
+#include "core/ft/ft_fast/termsfst.h"
+#include "ft_index_api.h"
+
+using reindexer::FstTermsDict;
+using reindexer::WordIdType;
+using reindexer::suffix_map;
+
+// Transducers find the same words, as brute force search
+TEST(FstTermsDictTest, Lookup) {
+	vector<string> words;
+	std::set<string> unique;
+	while (unique.size() < 5000) {
+		string word;
+		int len = 1 + rand() % 10;
+		// Small alphabet makes a lot of common prefixes and suffixes
+		for (int i = 0; i < len; ++i) word += "abcd\xd1\x8f"[rand() % 6];
+		if (unique.insert(word).second) words.push_back(word);
+	}
+	suffix_map<string, WordIdType> suffixes;
+	for (const string &word : words) suffixes.insert(word, WordIdType());
+	suffixes.build(false);
+	FstTermsDict dict;
+	dict.build(suffixes);
+
+	for (int i = 0; i < 300; ++i) {
+		string pattern = words[rand() % words.size()].substr(0, 1 + rand() % 4);
+		if (i % 2) pattern = words[rand() % words.size()];
+		std::set<uint32_t> expectedPrefix, expectedSuffix;
+		int expectedId = -1;
+		for (uint32_t id = 0; id < words.size(); ++id) {
+			const string &w = words[id];
+			if (w == pattern) expectedId = id;
+			if (w.compare(0, pattern.size(), pattern) == 0) expectedPrefix.insert(id);
+			if (w.size() >= pattern.size() && w.compare(w.size() - pattern.size(), pattern.size(), pattern) == 0) expectedSuffix.insert(id);
+		}
+		EXPECT_EQ(dict.find(pattern), expectedId) << pattern;
+		auto prefix = dict.with_prefix(pattern);
+		EXPECT_EQ(std::set<uint32_t>(prefix.first, prefix.second), expectedPrefix) << pattern;
+		EXPECT_EQ(size_t(prefix.second - prefix.first), expectedPrefix.size()) << pattern;
+		auto suffix = dict.with_suffix(pattern);
+		EXPECT_EQ(std::set<uint32_t>(suffix.first, suffix.second), expectedSuffix) << pattern;
+	}
+	EXPECT_EQ(dict.find("nosuchword"), -1);
+	auto none = dict.with_prefix("x");
+	EXPECT_TRUE(none.first == none.second);
+}
+
+class FtFstTermsApi : public FtIndexApi {
+public:
+	void SetUp() override {
+		ReindexerApi::SetUp();
+		for (const string &ns : {kSuffixArrayNs, kFstNs}) {
+			DefineNs(ns, string(R"json({"max_step_size":10,"enable_translit":false,"enable_kb_layout":false,"fst_terms":)json") +
+							 (ns == kFstNs ? "true" : "false") + "}");
+		}
+	}
+
+	// The same documents are upserted to both namespaces. Commit after each part of documents makes several steps
+	void Fill(int from, int to) {
+		for (const string &ns : {kSuffixArrayNs, kFstNs}) {
+			for (int i = from; i < to; ++i) UpsertItem(ns, i, words_[i % words_.size()] + " " + words_[(i * 7) % words_.size()]);
+			Error err = Commit(ns);
+			ASSERT_TRUE(err.ok()) << err.what();
+		}
+	}
+
+	vector<std::pair<int, int>> Select(const string &ns, const string &dsl) { return Sorted(FtIndexApi::Select(ns, dsl)); }
+
+	void Check() {
+		// Words and prefixes are found the same way, as in suffix array. The same holds for suffixes, which aren't in the middle of words
+		for (const char *dsl : {"search", "graph tree", "algo*", "sea*", "research*", "*ure", "*ing", "*ph", "alg~", "nosuchword", "=data",
+								"+search -tree", "\"data structure\""}) {
+			EXPECT_EQ(Select(kFstNs, dsl), Select(kSuffixArrayNs, dsl)) << dsl;
+		}
+		// Suffix doesn't match the middle of word
+		EXPECT_EQ(Ids(Select(kFstNs, "*search")), Ids(Select(kSuffixArrayNs, "search research")));
+		EXPECT_FALSE(Select(kFstNs, "*search").empty());
+	}
+
+	const vector<string> words_ = {"algorithm", "structure", "data", "graph", "tree", "traversal", "sorting", "search", "searching",
+								   "research", "researcher"};
+	const string kSuffixArrayNs = "ft_suffix_array_terms";
+	const string kFstNs = "ft_fst_terms";
+};
+
+TEST_F(FtFstTermsApi, SameResults) {
+	Fill(0, 100);
+	Check();
+	Fill(100, 105);
+	Fill(105, 110);
+	Check();
+}
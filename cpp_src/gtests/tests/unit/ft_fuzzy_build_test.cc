@@ -0,0 +1,66 @@
+#include "core/ft/ft_fuzzy/searchengine.h"
+#include "reindexer_api.h"
+
+using search_engine::SearchEngine;
+using reindexer::FtDSLQuery;
+using reindexer::fast_hash_map;
+using reindexer::fast_hash_set;
+
+class FuzzyBuildTest : public ::testing::Test {
+public:
+	void SetUp() override {
+		// Small alphabet makes a lot of common grams
+		for (int i = 0; i < kDocsCount; ++i) {
+			for (int field = 0; field < 2; ++field) {
+				string text;
+				int words = 1 + rand() % 10;
+				for (int j = 0; j < words; ++j) {
+					int len = 2 + rand() % 8;
+					for (int k = 0; k < len; ++k) text += "abcdefgh"[rand() % 8];
+					text += ' ';
+				}
+				texts_.push_back(text);
+			}
+		}
+	}
+
+	void Build(SearchEngine &engine, size_t threads) {
+		for (size_t i = 0; i < texts_.size(); ++i) engine.AddData(texts_[i], i / 2, i % 2, extraWordSymbols_);
+		engine.Commit(threads);
+	}
+
+	vector<std::pair<size_t, double>> Search(SearchEngine &engine, const string &text) {
+		FtDSLQuery dsl(fields_, stopWords_, extraWordSymbols_);
+		dsl.parse(text);
+		auto found = engine.Search(dsl);
+		vector<std::pair<size_t, double>> res;
+		for (auto &r : *found.data_) res.emplace_back(r.id_, r.proc_);
+		return res;
+	}
+
+	static constexpr int kDocsCount = 5000;
+	vector<string> texts_;
+	fast_hash_map<string, int> fields_{{"f0", 0}, {"f1", 1}};
+	fast_hash_set<string> stopWords_;
+	string extraWordSymbols_ = "-/+";
+};
+
+// Documents, which are built by ranges in parallel, are found the same, as documents, which are built by one thread
+TEST_F(FuzzyBuildTest, ParallelBuild) {
+	SearchEngine sequential, parallel, rebuilt;
+	Build(sequential, 1);
+	Build(parallel, 4);
+	// Data of the previous build are replaced
+	Build(rebuilt, 4);
+	Build(rebuilt, 4);
+
+	for (int i = 0; i < 100; ++i) {
+		string text = texts_[rand() % texts_.size()];
+		text = text.substr(0, text.find(' ', rand() % text.size()));
+		if (i % 2) text[rand() % text.size()] = 'a';
+		auto expected = Search(sequential, text);
+		EXPECT_EQ(Search(parallel, text), expected) << text;
+		EXPECT_EQ(Search(rebuilt, text), expected) << text;
+		EXPECT_FALSE(expected.empty()) << text;
+	}
+}
@@ -0,0 +1,46 @@
+#include "ft_index_api.h"
+
+class FtParallelSelectApi : public FtIndexApi {
+public:
+	void SetUp() override {
+		ReindexerApi::SetUp();
+		for (const string &ns : {kSequentialNs, kParallelNs}) {
+			DefineNs(ns, string(R"json({"max_step_size":100,"select_threads":)json") + (ns == kParallelNs ? "4" : "1") + "}");
+		}
+		// Frequent words are found in most of documents, so results are large enough to be merged in parallel
+		vector<string> texts;
+		for (int i = 0; i < kItemsCount; ++i) {
+			string text;
+			int words = 1 + rand() % 30;
+			for (int j = 0; j < words; ++j) text += Word(rand() % (1 + rand() % kWordsCount)) + " ";
+			texts.push_back(text);
+		}
+		for (const string &ns : {kSequentialNs, kParallelNs}) {
+			for (int i = 0; i < kItemsCount; ++i) {
+				UpsertItem(ns, i, texts[i]);
+				// Documents are in several steps
+				if (i % (kItemsCount / 4) == 0) {
+					Error err = Commit(ns);
+					ASSERT_TRUE(err.ok()) << err.what();
+					Select(ns, "word1");
+				}
+			}
+			Error err = Commit(ns);
+			ASSERT_TRUE(err.ok()) << err.what();
+		}
+	}
+
+	static constexpr int kItemsCount = 20000;
+	static constexpr int kWordsCount = 100;
+	const string kSequentialNs = "ft_sequential_select";
+	const string kParallelNs = "ft_parallel_select";
+};
+
+TEST_F(FtParallelSelectApi, SameResults) {
+	for (const char *dsl : {"word1", "word1 word2 word3 word4", "word1 word2 word5~ word3*", "word1 +word2", "word1 -word2 word3",
+							"\"word1 word2\" word3", "word1 NEAR/3 word2 word4", "nosuchword word1"}) {
+		EXPECT_EQ(Sorted(Select(kParallelNs, dsl)), Sorted(Select(kSequentialNs, dsl))) << dsl;
+		EXPECT_EQ(Ranks(Select(kParallelNs, dsl, 0, 20)), Ranks(Select(kSequentialNs, dsl, 0, 20))) << dsl;
+	}
+	EXPECT_GT(Select(kParallelNs, "word1 word2 word3 word4").size(), 1000u);
+}
@@ -0,0 +1,88 @@
+#include "ft_index_api.h"
+
+class FtSegmentsApi : public FtIndexApi {
+public:
+	void Init(bool backgroundCommit) {
+		// Small max_step_size: steps are merged by their documents count only
+		string config = string(R"json({"max_typos_in_word":0,"max_step_size":5,"max_rebuild_steps":100,"enable_background_commit":)json") +
+						(backgroundCommit ? "true" : "false") + R"json(,"read_your_writes":true})json";
+		DefineNs(default_namespace, config);
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i, rand() % kWordsCount);
+		Error err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		Check();
+	}
+
+	void UpsertItem(int id, int word) {
+		FtIndexApi::UpsertItem(default_namespace, id, "common " + Word(word) + " item" + std::to_string(id));
+		words_[id] = word;
+	}
+
+	void DeleteItem(int id) {
+		FtIndexApi::DeleteItem(default_namespace, id);
+		words_.erase(id);
+	}
+
+	// Checks found items of several words with the model. Each select commits fulltext data, so each round adds new step
+	void Check() {
+		for (int i = 0; i < 20; ++i) {
+			int word = rand() % kWordsCount;
+			vector<int> expected;
+			for (auto &it : words_) {
+				if (it.second == word) expected.push_back(it.first);
+			}
+			EXPECT_EQ(Ids(Sorted(Select(default_namespace, Word(word)))), expected) << Word(word);
+		}
+	}
+
+	void UpdateRounds() {
+		for (int round = 0; round < 60; ++round) {
+			// Rounds of different size make steps of different size
+			int updates = 1 + rand() % (round % 10 ? 20 : 500);
+			for (int i = 0; i < updates; ++i) UpsertItem(rand() % (kItemsCount * 2), rand() % kWordsCount);
+			for (int i = 0; i < updates / 2; ++i) DeleteItem(rand() % (kItemsCount * 2));
+			Check();
+		}
+		// Word, which is in many steps, is found in all of them
+		for (int i = 0; i < 10; ++i) {
+			UpsertItem(kItemsCount * 2 + i, kWordsCount);
+			Check();
+		}
+		EXPECT_EQ(Select(default_namespace, Word(kWordsCount)).size(), 10u);
+	}
+
+	void MassDeletes() {
+		size_t sizeBefore = FulltextSize(default_namespace, "text");
+		ASSERT_GT(sizeBefore, 0u);
+		// Most of documents are deleted: data are rebuilt by the next select without deleted documents
+		for (int id = 0; id < kItemsCount * 8 / 10; ++id) DeleteItem(id);
+		Check();
+		EXPECT_LT(FulltextSize(default_namespace, "text"), sizeBefore / 2);
+	}
+
+	static constexpr int kItemsCount = 3000;
+	static constexpr int kWordsCount = 500;
+	std::map<int, int> words_;
+};
+
+TEST_F(FtSegmentsApi, Updates) {
+	Init(false);
+	UpdateRounds();
+}
+
+TEST_F(FtSegmentsApi, BackgroundUpdates) {
+	Init(true);
+	UpdateRounds();
+}
+
+TEST_F(FtSegmentsApi, MassDeletes) {
+	Connect();
+	Init(false);
+	MassDeletes();
+}
+
+TEST_F(FtSegmentsApi, BackgroundMassDeletes) {
+	Connect();
+	Init(true);
+	MassDeletes();
+}
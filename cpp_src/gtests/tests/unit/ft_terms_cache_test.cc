@@ -0,0 +1,65 @@
+#include "ft_index_api.h"
+
+class FtTermsCacheApi : public FtIndexApi {
+public:
+	void SetUp() override {
+		ReindexerApi::SetUp();
+		DefineNs(kNs, R"json({"max_step_size":10})json");
+	}
+
+	void Add(int id, const string &text) {
+		UpsertItem(kNs, id, text);
+		Error err = Commit(kNs);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	vector<std::pair<int, int>> Select(const string &dsl) { return Sorted(FtIndexApi::Select(kNs, dsl)); }
+
+	const string kNs = "ft_terms_cache";
+};
+
+TEST_F(FtTermsCacheApi, SameResults) {
+	for (int i = 0; i < 30; ++i) Add(i, "word" + std::to_string(i % 5) + " text" + std::to_string(i) + " other words");
+	// Terms are cached after several selects: results from cache are the same as found ones
+	for (const char *dsl : {"word1", "word1 text*", "word1~ +text3*", "word2 -other", "word*^2 text1", "\"other words\" word3"}) {
+		auto first = Select(dsl);
+		for (int i = 0; i < 3; ++i) EXPECT_EQ(Select(dsl), first) << dsl;
+	}
+	// Same pattern with different options
+	EXPECT_EQ(Ids(Select("text1")), vector<int>({1}));
+	EXPECT_EQ(Ids(Select("text1*")), vector<int>({1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}));
+	EXPECT_EQ(Ids(Select("text1")), vector<int>({1}));
+}
+
+TEST_F(FtTermsCacheApi, Invalidation) {
+	for (int i = 0; i < 20; ++i) Add(i, "word" + std::to_string(i % 2) + " text");
+	for (int i = 0; i < 3; ++i) EXPECT_EQ(Ids(Select("word1")), vector<int>({1, 3, 5, 7, 9, 11, 13, 15, 17, 19}));
+	for (int i = 0; i < 3; ++i) EXPECT_TRUE(Select("newword").empty());
+
+	// New documents are found after commit
+	Add(20, "word1 newword");
+	Add(21, "newword");
+	EXPECT_EQ(Ids(Select("word1")), vector<int>({1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 20}));
+	EXPECT_EQ(Ids(Select("newword")), vector<int>({20, 21}));
+
+	// Deleted documents are not found
+	DeleteItem(kNs, 20);
+	for (int i = 0; i < 3; ++i) EXPECT_EQ(Ids(Select("newword")), vector<int>({21}));
+
+	// Updated document
+	Add(1, "newword");
+	for (int i = 0; i < 3; ++i) EXPECT_EQ(Ids(Select("word1")), vector<int>({3, 5, 7, 9, 11, 13, 15, 17, 19}));
+	EXPECT_EQ(Ids(Select("newword")), vector<int>({1, 21}));
+}
+
+TEST_F(FtTermsCacheApi, ConfigUpdate) {
+	Add(0, "users");
+	Add(1, "user");
+	// Words of the term with stemmers include words with the same stem
+	for (int i = 0; i < 3; ++i) EXPECT_EQ(Ids(Select("users")), vector<int>({0, 1}));
+
+	// Cached words, which were found with the previous config, are not used
+	Error err = reindexer->UpdateIndex(kNs, {"text", {"text"}, "text", "string", IndexOpts().SetConfig(R"json({"stemmers":[]})json")});
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (int i = 0; i < 3; ++i) EXPECT_EQ(Ids(Select("users")), vector<int>({0}));
+}
@@ -0,0 +1,47 @@
+#include "ft_index_api.h"
+
+class FtTopKApi : public FtIndexApi {
+public:
+	void SetUp() override {
+		ReindexerApi::SetUp();
+		DefineNs(default_namespace, "");
+		for (int i = 0; i < kItemsCount; ++i) {
+			// Frequent words are found in most of documents, and documents have different lengths and counts of words
+			string text;
+			int words = 1 + rand() % 30;
+			for (int j = 0; j < words; ++j) text += Word(rand() % (1 + rand() % kWordsCount)) + " ";
+			UpsertItem(default_namespace, i, text);
+		}
+		Error err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	// Documents with limit have the same ranks, as the first documents of select without limit
+	void Check(const string &dsl) {
+		vector<int> all = Ranks(Select(default_namespace, dsl));
+		for (unsigned offset : {0, 7}) {
+			for (unsigned limit : {1, 20, 50}) {
+				vector<int> top = Ranks(Select(default_namespace, dsl, offset, limit));
+				vector<int> expected(all.begin() + std::min<size_t>(offset, all.size()),
+									 all.begin() + std::min<size_t>(offset + limit, all.size()));
+				EXPECT_EQ(top, expected) << dsl << " offset " << offset << " limit " << limit;
+			}
+		}
+	}
+
+	static constexpr int kItemsCount = 5000;
+	static constexpr int kWordsCount = 100;
+};
+
+TEST_F(FtTopKApi, SameRanks) {
+	Check(Word(1));
+	Check(Word(50));
+	Check("word1*");
+	Check("word5~");
+	Check(Word(1) + " " + Word(2));
+	Check(Word(3) + " " + Word(70) + " word9*");
+	Check(Word(1) + " +" + Word(2));
+	Check(Word(1) + " -" + Word(2));
+	Check("\"" + Word(1) + " " + Word(2) + "\"");
+	Check("nosuchword");
+}
@@ -0,0 +1,184 @@
+#include "brute_force_api.h"
+#include "core/geo.h"
+
+using reindexer::GeoDistance;
+using reindexer::GeoPoint;
+
+class GeoIndexApi : public BruteForceApi<GeoPoint> {
+public:
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"lat", "-", "double", IndexOpts()},
+												   IndexDeclaration{"lon", "-", "double", IndexOpts()},
+												   IndexDeclaration{"rating", "tree", "int", IndexOpts()},
+												   IndexDeclaration{"lat+lon=location", "geo", "composite", IndexOpts()}});
+		// Grid of stores near Moscow
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i, 55.0 + (i % 40) * 0.025, 37.0 + (i / 40) * 0.04);
+		// Stores near the 180th meridian
+		for (int i = 0; i < 10; ++i) UpsertItem(kItemsCount + i, -17.0 + i * 0.01, i % 2 ? 179.99 - i * 0.001 : -179.99 + i * 0.001);
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void UpsertItem(int id, double lat, double lon) {
+		Item item = NewItem(default_namespace);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		Error err = item.FromJSON("{\"id\":" + std::to_string(id) + ",\"lat\":" + std::to_string(lat) + ",\"lon\":" +
+								  std::to_string(lon) + ",\"rating\":" + std::to_string(kItemsCount * 2 - id) + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(default_namespace, item);
+		// Use the same values, which are stored after JSON conversion
+		rows_[id] = Point(item["lat"].As<double>(), item["lon"].As<double>());
+	}
+
+	// Sorting by rating is reverse order of ids
+	static bool ByRating(int l, int r) { return l > r; }
+
+	static GeoPoint Point(double lat, double lon) {
+		GeoPoint p;
+		p.lat = lat;
+		p.lon = lon;
+		p.valid = true;
+		return p;
+	}
+
+	static constexpr int kItemsCount = 1000;
+};
+
+TEST_F(GeoIndexApi, DWithin) {
+	const GeoPoint center = Point(55.3, 37.5);
+	for (double radius : {0.0, 500.0, 3000.0, 15000.0, 80000.0}) {
+		Check(Query(default_namespace).Where("location", CondDWithin, {center.lat, center.lon, radius}),
+			  [&](int, const GeoPoint &p) { return GeoDistance(center, p) <= radius; });
+	}
+	// Center in exact point of item
+	Check(Query(default_namespace).Where("location", CondDWithin, {rows_[123].lat, rows_[123].lon, 1.0}),
+		  [&](int, const GeoPoint &p) { return GeoDistance(rows_[123], p) <= 1.0; });
+	// Circle crosses the 180th meridian
+	const GeoPoint east = Point(-16.96, 180.0);
+	Check(Query(default_namespace).Where("location", CondDWithin, {east.lat, east.lon, 20000.0}),
+		  [&](int, const GeoPoint &p) { return GeoDistance(east, p) <= 20000.0; });
+}
+
+TEST_F(GeoIndexApi, InBox) {
+	Check(Query(default_namespace).Where("location", CondInBox, {55.2, 37.3, 55.5, 37.65}),
+		  [](int, const GeoPoint &p) { return p.lat >= 55.2 && p.lat <= 55.5 && p.lon >= 37.3 && p.lon <= 37.65; });
+	Check(Query(default_namespace).Where("location", CondInBox, {-90, -180, 90, 180}), [](int, const GeoPoint &) { return true; });
+	// Box crosses the 180th meridian
+	Check(Query(default_namespace).Where("location", CondInBox, {-17.0, 179.995, -16.9, -179.985}),
+		  [](int, const GeoPoint &p) { return p.lat >= -17.0 && p.lat <= -16.9 && (p.lon >= 179.995 || p.lon <= -179.985); });
+}
+
+TEST_F(GeoIndexApi, CombinedConditions) {
+	const GeoPoint center = Point(55.5, 37.5);
+	Check(Query(default_namespace).Where("location", CondDWithin, {center.lat, center.lon, 10000.0}).Where("lon", CondLt, 37.5),
+		  [&](int, const GeoPoint &p) { return GeoDistance(center, p) <= 10000.0 && p.lon < 37.5; });
+	Check(Query(default_namespace)
+			  .Where("location", CondDWithin, {center.lat, center.lon, 5000.0})
+			  .Or()
+			  .Where("location", CondInBox, {-18.0, 179.0, -16.0, 180.0}),
+		  [&](int, const GeoPoint &p) { return GeoDistance(center, p) <= 5000.0 || p.lon >= 179.0; });
+	Check(Query(default_namespace)
+			  .Where("location", CondInBox, {55.0, 37.0, 55.5, 37.5})
+			  .Not()
+			  .Where("location", CondDWithin, {55.25, 37.25, 10000.0}),
+		  [](int, const GeoPoint &p) {
+			  return p.lat >= 55.0 && p.lat <= 55.5 && p.lon >= 37.0 && p.lon <= 37.5 && GeoDistance(Point(55.25, 37.25), p) > 10000.0;
+		  });
+	// Sort by ordered index makes geo index to check rows by comparator
+	Check(Query(default_namespace).Where("location", CondDWithin, {center.lat, center.lon, 8000.0}).Sort("rating", false),
+		  [&](int, const GeoPoint &p) { return GeoDistance(center, p) <= 8000.0; }, ByRating);
+}
+
+TEST_F(GeoIndexApi, SortByDistance) {
+	const GeoPoint center = Point(55.41, 37.52);
+	for (bool desc : {false, true}) {
+		QueryResults qr;
+		Query q = Query(default_namespace).Where("location", CondDWithin, {center.lat, center.lon, 20000.0}).Sort("location", desc);
+		Error err = reindexer->Select(q.Limit(15), qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(qr.Count(), 15u);
+
+		vector<std::pair<double, int>> expected;
+		for (auto &p : rows_) {
+			double dist = GeoDistance(center, p.second);
+			if (dist <= 20000.0) expected.push_back({desc ? -dist : dist, desc ? -p.first : p.first});
+		}
+		std::sort(expected.begin(), expected.end());
+		for (size_t i = 0; i < qr.Count(); ++i) {
+			EXPECT_EQ(qr[i].GetItem()["id"].As<int>(), desc ? -expected[i].second : expected[i].second) << i;
+		}
+	}
+
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("id", CondLt, 10).Sort("location", false), qr);
+	EXPECT_FALSE(err.ok());
+}
+
+TEST_F(GeoIndexApi, Modifications) {
+	for (int id = 0; id < kItemsCount; id += 3) UpsertItem(id, 10.0 + id * 0.001, 20.0);
+	QueryResults delQr;
+	Error err = reindexer->Delete(Query(default_namespace).Where("location", CondInBox, {55.0, 37.0, 55.2, 37.2}), delQr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_GT(delQr.Count(), 0u);
+	for (auto it : delQr) rows_.erase(it.GetItem()["id"].As<int>());
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	Check(Query(default_namespace).Where("location", CondInBox, {0.0, 0.0, 60.0, 40.0}),
+		  [](int, const GeoPoint &p) { return p.lat >= 0.0 && p.lon >= 0.0 && p.lon <= 40.0; });
+	Check(Query(default_namespace).Where("location", CondDWithin, {10.5, 20.0, 60000.0}),
+		  [](int, const GeoPoint &p) { return GeoDistance(Point(10.5, 20.0), p) <= 60000.0; });
+}
+
+TEST_F(GeoIndexApi, Errors) {
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("lat", CondDWithin, {55.0, 37.0, 1000.0}), qr);
+	EXPECT_FALSE(err.ok());
+	err = reindexer->Select(Query(default_namespace).Where("location", CondDWithin, {55.0, 37.0}), qr);
+	EXPECT_FALSE(err.ok());
+	err = reindexer->Select(Query(default_namespace).Where("location", CondInBox, {56.0, 37.0, 55.0, 38.0}), qr);
+	EXPECT_FALSE(err.ok());
+	err = reindexer->Select(Query(default_namespace).Where("location", CondEq, 55.0), qr);
+	EXPECT_FALSE(err.ok());
+
+	// Equal conditions on both fields are not substituted by geo index
+	err = reindexer->Select(Query(default_namespace).Where("lat", CondEq, rows_[5].lat).Where("lon", CondEq, rows_[5].lon), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.Count(), 1u);
+	EXPECT_EQ(qr[0].GetItem()["id"].As<int>(), 5);
+
+	err = reindexer->AddIndex(default_namespace, {"lat_geo", {"lat"}, "geo", "composite", IndexOpts()});
+	EXPECT_FALSE(err.ok());
+}
+
+TEST_F(GeoIndexApi, SqlAndNotIndexedFields) {
+	// Geo index over not indexed fields. Items without coordinates are not matched
+	Error err = reindexer->AddIndex(default_namespace, {"home", {"home_lat", "home_lon"}, "geo", "composite", IndexOpts()});
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (int id = 0; id < 10; ++id) {
+		Item item = NewItem(default_namespace);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		string json = "{\"id\":" + std::to_string(id) + ",\"lat\":0,\"lon\":0,\"rating\":0";
+		if (id % 2) json += ",\"home_lat\":" + std::to_string(40.0 + id * 0.001) + ",\"home_lon\":-3.7";
+		err = item.FromJSON(json + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(default_namespace, item);
+	}
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	QueryResults qr;
+	err = reindexer->Select("SELECT * FROM " + default_namespace + " WHERE home DWITHIN (40.0,-3.7,100000) ORDER BY home DESC", qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.Count(), 5u);
+	EXPECT_EQ(qr[0].GetItem()["id"].As<int>(), 9);
+	EXPECT_EQ(qr[4].GetItem()["id"].As<int>(), 1);
+
+	qr.Clear();
+	err = reindexer->Select("SELECT * FROM " + default_namespace + " WHERE location INBOX (-0.5,-0.5,0.5,0.5)", qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 10u);
+}
@@ -0,0 +1,94 @@
+#include "brute_force_api.h"
+
+struct LargeSetRow {
+	string name;
+	int value;
+	int price;
+	string code;
+};
+
+class LargeSetApi : public BruteForceApi<LargeSetRow> {
+public:
+	using Row = LargeSetRow;
+
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"name", "hash", "string", IndexOpts(0, CollateUTF8)},
+												   IndexDeclaration{"value", "tree", "int", IndexOpts()},
+												   IndexDeclaration{"price", "-", "int", IndexOpts()}});
+		for (int i = 0; i < kItemsCount; ++i) {
+			Row row{"Name" + std::to_string(i), rand() % 100, rand() % 50000, "code" + std::to_string(rand() % 50000)};
+			UpsertJSON(default_namespace, "{\"id\":" + std::to_string(i) + ",\"name\":\"" + row.name + "\",\"value\":" +
+											  std::to_string(row.value) + ",\"price\":" + std::to_string(row.price) + ",\"code\":\"" +
+											  row.code + "\"}");
+			rows_[i] = row;
+		}
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	static constexpr int kItemsCount = 30000;
+};
+
+TEST_F(LargeSetApi, IndexedFields) {
+	// Half of keys are absent. Idsets of keys are merged to single idset
+	VariantArray ids;
+	std::set<int> idsSet;
+	for (int i = 0; i < 20000; ++i) {
+		int id = rand() % (kItemsCount * 2);
+		ids.push_back(Variant(id));
+		idsSet.insert(id);
+	}
+	for (int i = 0; i < 2; ++i) {
+		Check(Query(default_namespace).Where("id", CondSet, ids), [&idsSet](int id, const Row &) { return idsSet.count(id) != 0; });
+	}
+	Check(Query(default_namespace).Where("id", CondSet, ids).Where("value", CondLt, 10),
+		  [&idsSet](int id, const Row &r) { return idsSet.count(id) && r.value < 10; });
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("id", CondSet, ids).Sort("value", false).Limit(100), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.Count(), 100u);
+	int prevValue = 0;
+	for (auto it : qr) {
+		Item item = it.GetItem();
+		EXPECT_TRUE(idsSet.count(item["id"].As<int>()));
+		EXPECT_GE(item["value"].As<int>(), prevValue);
+		prevValue = item["value"].As<int>();
+	}
+
+	// Strings are compared by collate
+	VariantArray names;
+	for (int i = 0; i < 5000; ++i) names.push_back(Variant(string(i % 2 ? "NAME" : "name") + std::to_string(i * 3)));
+	Check(Query(default_namespace).Where("name", CondSet, names), [](int id, const Row &) { return id % 3 == 0 && id < 15000; });
+
+	// Large idsets of low selective index are checked by comparator
+	VariantArray values;
+	for (int i = 0; i < 2000; ++i) values.push_back(Variant(i % 200));
+	Check(Query(default_namespace).Where("value", CondSet, values).Where("id", CondLt, 1000),
+		  [](int id, const Row &r) { return r.value < 200 && id < 1000; });
+	values.resize(50);
+	Check(Query(default_namespace).Where("value", CondSet, values), [](int, const Row &r) { return r.value < 50; });
+}
+
+TEST_F(LargeSetApi, ComparedFields) {
+	std::set<int> prices;
+	VariantArray priceValues;
+	std::set<string> codes;
+	VariantArray codeValues;
+	for (int i = 0; i < 10000; ++i) {
+		int price = rand() % 60000;
+		prices.insert(price);
+		priceValues.push_back(Variant(price));
+		string code = "code" + std::to_string(price);
+		codes.insert(code);
+		codeValues.push_back(Variant(code));
+	}
+	// Column of '-' index and field without index
+	Check(Query(default_namespace).Where("price", CondSet, priceValues),
+		  [&prices](int, const Row &r) { return prices.count(r.price) != 0; });
+	Check(Query(default_namespace).Where("code", CondSet, codeValues), [&codes](int, const Row &r) { return codes.count(r.code) != 0; });
+	Check(Query(default_namespace).Where("code", CondSet, codeValues).Where("value", CondEq, 5),
+		  [&codes](int, const Row &r) { return codes.count(r.code) && r.value == 5; });
+}
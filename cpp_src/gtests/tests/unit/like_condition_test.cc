@@ -0,0 +1,164 @@
+#include <regex>
+#include "reindexer_api.h"
+
+class LikeConditionApi : public ReindexerApi {
+public:
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"tree_name", "tree", "string", IndexOpts(0, CollateASCII)},
+												   IndexDeclaration{"hash_name", "hash", "string", IndexOpts()},
+												   IndexDeclaration{"store_name", "-", "string", IndexOpts()},
+												   IndexDeclaration{"bitmap_name", "bitmap", "string", IndexOpts()},
+												   IndexDeclaration{"trigram_name", "trigram", "string", IndexOpts(0, CollateASCII)},
+												   IndexDeclaration{"age", "tree", "int", IndexOpts()}});
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i, makeName(i));
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	// Names from small alphabet, so patterns match many of them
+	static string makeName(int i) {
+		static const char *syllables[] = {"ab", "Bc", "ca", "abc", "da", "x", "bca", "Ad"};
+		string name;
+		for (int n = i * 7 + 3; n; n /= 8) name += syllables[n % 8];
+		return name;
+	}
+
+	void UpsertItem(int id, const string &name) {
+		Item item = NewItem(default_namespace);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		string json = "{\"id\":" + std::to_string(id) + ",\"age\":" + std::to_string(id % 50);
+		for (const char *field : {"tree_name", "hash_name", "store_name", "bitmap_name", "trigram_name", "json_name"}) {
+			json += string(",\"") + field + "\":\"" + name + "\"";
+		}
+		Error err = item.FromJSON(json + "}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(default_namespace, item);
+		names_[id] = name;
+	}
+
+	// Reference implementation of LIKE by regular expression
+	static bool like(const string &str, const string &pattern, bool icase) {
+		string re;
+		for (char c : pattern) {
+			if (c == '%') {
+				re += ".*";
+			} else if (c == '_') {
+				re += '.';
+			} else {
+				re += c;
+			}
+		}
+		return std::regex_match(str, std::regex(re, icase ? std::regex::icase : std::regex::ECMAScript));
+	}
+
+	void Check(const string &field, const string &pattern, bool icase) {
+		vector<int> expected;
+		for (auto &it : names_) {
+			if (like(it.second, pattern, icase)) expected.push_back(it.first);
+		}
+
+		QueryResults qr;
+		Error err = reindexer->Select(Query(default_namespace).Where(field, CondLike, pattern), qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		vector<int> selected;
+		for (auto it : qr) selected.push_back(it.GetItem()["id"].As<int>());
+		std::sort(selected.begin(), selected.end());
+		EXPECT_EQ(selected, expected) << field << " LIKE '" << pattern << "'";
+	}
+
+	void CheckAll() {
+		for (const string pattern : {"ab%", "abcab%", "Bc%", "%bca%", "%ca", "a_c%", "%b_a%", "_", "%", "abc", "%x%x%", "Ad%ca%x", "zz%"}) {
+			Check("tree_name", pattern, true);
+			Check("hash_name", pattern, false);
+			Check("store_name", pattern, false);
+			Check("bitmap_name", pattern, false);
+			Check("trigram_name", pattern, true);
+			Check("json_name", pattern, false);
+		}
+	}
+
+	static constexpr int kItemsCount = 3000;
+	std::map<int, string> names_;
+};
+
+TEST_F(LikeConditionApi, Patterns) { CheckAll(); }
+
+TEST_F(LikeConditionApi, Modifications) {
+	for (int id = 0; id < kItemsCount; id += 3) UpsertItem(id, makeName(id + 1) + "xab");
+	QueryResults qr;
+	Error err = reindexer->Delete(Query(default_namespace).Where("trigram_name", CondLike, "%bca%"), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_GT(qr.Count(), 0u);
+	for (auto it : qr) names_.erase(it.GetItem()["id"].As<int>());
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	CheckAll();
+}
+
+TEST_F(LikeConditionApi, SortedAndCombined) {
+	QueryResults qr;
+	Query q = Query(default_namespace).Where("tree_name", CondLike, "ab%").Where("trigram_name", CondLike, "%ca%");
+	Error err = reindexer->Select(q.Sort("age", true).Limit(20), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_GT(qr.Count(), 0u);
+	int lastAge = std::numeric_limits<int>::max();
+	for (auto it : qr) {
+		Item item = it.GetItem();
+		string name = item["tree_name"].As<string>();
+		EXPECT_TRUE(like(name, "ab%", true) && like(name, "%ca%", true)) << name;
+		EXPECT_LE(item["age"].As<int>(), lastAge);
+		lastAge = item["age"].As<int>();
+	}
+
+	// Sort by the same index, which is used for LIKE
+	qr.Clear();
+	err = reindexer->Select(Query(default_namespace).Where("tree_name", CondLike, "bc%").Sort("tree_name", false), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_GT(qr.Count(), 0u);
+	string last;
+	for (auto it : qr) {
+		string name = it.GetItem()["tree_name"].As<string>();
+		EXPECT_TRUE(like(name, "bc%", true)) << name;
+		EXPECT_LE(reindexer::collateCompare(last, name, CollateOpts(CollateASCII)), 0);
+		last = name;
+	}
+}
+
+TEST_F(LikeConditionApi, Utf8AndSql) {
+	Error err = reindexer->AddIndex(default_namespace, {"utf8_name", {"utf8_name"}, "tree", "string", IndexOpts(0, CollateUTF8)});
+	ASSERT_TRUE(err.ok()) << err.what();
+	err = reindexer->AddIndex(default_namespace, {"utf8_trigram", {"utf8_trigram"}, "trigram", "string", IndexOpts(0, CollateUTF8)});
+	ASSERT_TRUE(err.ok()) << err.what();
+	const char *names[] = {"Привет мир", "привет", "Привед", "ПРИВЕТСТВИЕ", "при"};
+	for (int i = 0; i < 5; ++i) {
+		Item item = NewItem(default_namespace);
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		err = item.FromJSON("{\"id\":" + std::to_string(kItemsCount + i) + ",\"utf8_name\":\"" + names[i] + "\",\"utf8_trigram\":\"" +
+							names[i] + "\"}");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert(default_namespace, item);
+	}
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	for (const char *field : {"utf8_name", "utf8_trigram"}) {
+		vector<std::pair<string, size_t>> cases = {{"приве_%", 4}, {"%ВЕТ%", 3}, {"при", 1}, {"%и_ет", 1}, {"п%", 5}};
+		for (auto &c : cases) {
+			QueryResults qr;
+			err = reindexer->Select("SELECT * FROM " + default_namespace + " WHERE " + field + " LIKE '" + c.first + "'", qr);
+			ASSERT_TRUE(err.ok()) << err.what();
+			EXPECT_EQ(qr.Count(), c.second) << field << " LIKE '" << c.first << "'";
+		}
+	}
+}
+
+TEST_F(LikeConditionApi, Errors) {
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("age", CondLike, "1%"), qr);
+	EXPECT_FALSE(err.ok());
+	err = reindexer->Select(Query(default_namespace).Where("tree_name", CondLike, VariantArray{Variant("a%"), Variant("b%")}), qr);
+	EXPECT_FALSE(err.ok());
+}
@@ -0,0 +1,100 @@
+#include <atomic>
+#include <thread>
+#include "core/storage/logstorage.h"
+#include "reindexer_api.h"
+#include "tools/fsops.h"
+
+class LogStorageApi : public ReindexerApi {
+public:
+	void SetUp() override {
+		reindexer::fs::RmDirAll(kStoragePath);
+		Connect("?engine=logstorage");
+	}
+	void TearDown() override {
+		reindexer.reset();
+		reindexer::fs::RmDirAll(kStoragePath);
+	}
+
+	void Connect(const string &params = string()) {
+		reindexer.reset(new Reindexer);
+		Error err = reindexer->Connect(string("builtin://") + kStoragePath + params);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	size_t Count() {
+		QueryResults qr;
+		Error err = reindexer->Select(Query(default_namespace), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		return qr.Count();
+	}
+
+	const char *kStoragePath = "/tmp/reindex/log_storage_test";
+};
+
+TEST_F(LogStorageApi, ReopenDatabase) {
+	Error err = reindexer->OpenNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	DefineNamespaceDataset(default_namespace,
+						   {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"value", "tree", "string", IndexOpts()}});
+
+	// Rewrite each document several times and delete some of them
+	for (int round = 0; round < 3; ++round) {
+		for (int i = 0; i < 1000; ++i) {
+			Item item = NewItem(default_namespace);
+			ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+			item["id"] = i;
+			item["value"] = RandString();
+			Upsert(default_namespace, item);
+		}
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+	QueryResults qr;
+	err = reindexer->Delete(Query(default_namespace).Where("id", CondLt, 100), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	// Engine of existing database is taken from the placeholder file, not from dsn
+	Connect();
+	EXPECT_EQ(Count(), 900u);
+
+	string placeholder;
+	reindexer::fs::ReadFile(reindexer::fs::JoinPath(kStoragePath, ".reindexer.storage"), placeholder);
+	EXPECT_EQ(placeholder, "logstorage");
+}
+
+// Records are read without lock, while writes roll and map segments
+TEST_F(LogStorageApi, ReadWhileRollSegments) {
+	reindexer.reset();
+	const string path = reindexer::fs::JoinPath(kStoragePath, "segments");
+	reindexer::fs::MkDirAll(path);
+	reindexer::datastorage::LogStorage storage;
+	StorageOpts opts;
+	Error err = storage.Open(path, opts.CreateIfMissing());
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	// Values of 1Kb fill several segments of 64Mb
+	const int kRecordsCount = 200000;
+	auto value = [](int i) { return string(1024, 'a' + i % 26); };
+	std::atomic<int> written(0);
+	std::thread writer([&]() {
+		for (int i = 0; i < kRecordsCount; ++i) {
+			Error err = storage.Write(opts, "key" + std::to_string(i), value(i));
+			ASSERT_TRUE(err.ok()) << err.what();
+			written = i + 1;
+		}
+	});
+	string buf;
+	bool ok = true;
+	while (written < kRecordsCount && ok) {
+		int count = written;
+		if (!count) continue;
+		int i = rand() % count;
+		err = storage.Read(opts, "key" + std::to_string(i), buf);
+		ok = err.ok() && buf == value(i);
+	}
+	EXPECT_TRUE(ok) << err.what();
+	writer.join();
+	EXPECT_GT(storage.DiskUsage(), 2 * 64 * 1024 * 1024u);
+}
@@ -0,0 +1,162 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "brute_force_api.h"
+
+struct OnlineIndexRow {
+	string name;
+	int value;
+	string group;
+};
+
+class OnlineIndexApi : public BruteForceApi<OnlineIndexRow> {
+public:
+	using Row = OnlineIndexRow;
+
+	void SetUp() override {
+		Error err = reindexer->InitSystemNamespaces();
+		ASSERT_TRUE(err.ok()) << err.what();
+		Item item = NewItem("#config");
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		err = item.FromJSON(R"json({"type":"namespaces","namespaces":[{"namespace":"*","online_index_build":true}]})json");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert("#config", item);
+
+		err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"name", "hash", "string", IndexOpts()}});
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i);
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void UpsertItem(int id) {
+		Row row{"name" + std::to_string(rand() % 100), rand() % 1000, "group" + std::to_string(rand() % 10)};
+		UpsertJSON(default_namespace, "{\"id\":" + std::to_string(id) + ",\"name\":\"" + row.name + "\",\"value\":" +
+										  std::to_string(row.value) + ",\"group\":\"" + row.group + "\"}");
+		std::lock_guard<std::mutex> lck(rowsMtx_);
+		rows_[id] = row;
+	}
+
+	void DeleteItem(int id) {
+		DeleteById(default_namespace, id);
+		std::lock_guard<std::mutex> lck(rowsMtx_);
+		rows_.erase(id);
+	}
+
+	// Runs change of index, while rows are modified and selected concurrently
+	void ChangeIndex(std::function<Error()> change) {
+		std::atomic<bool> done(false);
+		Error changeErr;
+		std::thread changer([&]() {
+			changeErr = change();
+			done = true;
+		});
+		int modified = 0;
+		bool selected = true;
+		// Changer thread is joined before any assertion returns from the test
+		while ((!done || modified < 100) && selected) {
+			int id = rand() % (kItemsCount + 1000);
+			if (rand() % 4) {
+				UpsertItem(id);
+			} else {
+				DeleteItem(id);
+			}
+			if (modified++ % 10 == 0) {
+				QueryResults qr;
+				Error err = reindexer->Select(Query(default_namespace).Where("name", CondEq, "name1"), qr);
+				selected = err.ok();
+				EXPECT_TRUE(selected) << err.what();
+			}
+		}
+		changer.join();
+		ASSERT_TRUE(selected);
+		ASSERT_TRUE(changeErr.ok()) << changeErr.what();
+		Error err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void CheckItem(Item &item, const Row &row) override { EXPECT_EQ(item["name"].As<string>(), row.name); }
+
+	static constexpr int kItemsCount = 20000;
+	std::mutex rowsMtx_;
+};
+
+TEST_F(OnlineIndexApi, AddIndexes) {
+	ChangeIndex([this]() { return reindexer->AddIndex(default_namespace, {"value", "tree", "int", IndexOpts()}); });
+	Check(Query(default_namespace).Where("value", CondEq, 500), [](int, const Row &r) { return r.value == 500; });
+	Check(Query(default_namespace).Where("value", CondLt, 20), [](int, const Row &r) { return r.value < 20; });
+
+	ChangeIndex([this]() { return reindexer->AddIndex(default_namespace, {"group", "hash", "string", IndexOpts().Sparse()}); });
+	Check(Query(default_namespace).Where("group", CondEq, "group3"), [](int, const Row &r) { return r.group == "group3"; });
+
+	ChangeIndex(
+		[this]() { return reindexer->AddIndex(default_namespace, {"name+value", {"name", "value"}, "tree", "composite", IndexOpts()}); });
+	Check(Query(default_namespace).WhereComposite("name+value", CondEq, {{Variant(string("name5")), Variant(100)}}),
+		  [](int, const Row &r) { return r.name == "name5" && r.value == 100; });
+	Check(Query(default_namespace).Where("value", CondEq, 500).Where("group", CondEq, "group1"),
+		  [](int, const Row &r) { return r.value == 500 && r.group == "group1"; });
+}
+
+TEST_F(OnlineIndexApi, UpdateIndexes) {
+	Error err = reindexer->AddIndex(default_namespace, {"value", "tree", "int", IndexOpts()});
+	ASSERT_TRUE(err.ok()) << err.what();
+	err = reindexer->AddIndex(default_namespace, {"value+id", {"value", "id"}, "hash", "composite", IndexOpts()});
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	// Strings of index are rebuilt, composite index is rebuilt for the new rows
+	ChangeIndex([this]() { return reindexer->UpdateIndex(default_namespace, {"name", "tree", "string", IndexOpts()}); });
+	Check(Query(default_namespace).Where("name", CondEq, "name7"), [](int, const Row &r) { return r.name == "name7"; });
+	Check(Query(default_namespace).Where("name", CondLt, "name2"), [](int, const Row &r) { return r.name < "name2"; });
+	for (auto it = rows_.begin(); it != rows_.end(); std::advance(it, std::min<size_t>(1000, std::distance(it, rows_.end())))) {
+		QueryResults qr;
+		err = reindexer->Select(Query(default_namespace).WhereComposite("value+id", CondEq, {{Variant(it->second.value), Variant(it->first)}}), qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(qr.Count(), 1u);
+		EXPECT_EQ(qr[0].GetItem()["name"].As<string>(), it->second.name);
+	}
+
+	ChangeIndex(
+		[this]() { return reindexer->UpdateIndex(default_namespace, {"value+id", {"value", "id"}, "tree", "composite", IndexOpts()}); });
+	Check(Query(default_namespace).Where("value", CondGe, 990), [](int, const Row &r) { return r.value >= 990; });
+
+	vector<reindexer::NamespaceDef> defs;
+	err = reindexer->EnumNamespaces(defs, false);
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (auto &def : defs) {
+		if (def.name != default_namespace) continue;
+		for (auto &idef : def.indexes) {
+			if (idef.name_ == "name" || idef.name_ == "value+id") {
+				EXPECT_EQ(idef.indexType_, "tree") << idef.name_;
+			}
+		}
+	}
+}
+
+// Items, which are alive while payload type is changed, are not reused by the next items of namespace
+TEST_F(OnlineIndexApi, OutdatedPooledItems) {
+	vector<Item> outdated;
+	for (int i = 0; i < 10; ++i) {
+		outdated.push_back(NewItem(default_namespace));
+		ASSERT_TRUE(outdated.back().Status().ok()) << outdated.back().Status().what();
+	}
+	ChangeIndex([this]() { return reindexer->AddIndex(default_namespace, {"value", "tree", "int", IndexOpts()}); });
+	ChangeIndex([this]() { return reindexer->AddIndex(default_namespace, {"group", "hash", "string", IndexOpts()}); });
+	outdated.clear();
+
+	for (int id = 0; id < 100; ++id) UpsertItem(id);
+	Error err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (int id = 0; id < 100; ++id) {
+		auto it = rows_.find(id);
+		QueryResults qr;
+		err = reindexer->Select(Query(default_namespace).Where("id", CondEq, id), qr);
+		ASSERT_TRUE(err.ok()) << err.what();
+		ASSERT_EQ(qr.Count(), 1u);
+		Item item = qr[0].GetItem();
+		EXPECT_EQ(item["name"].As<string>(), it->second.name);
+		EXPECT_EQ(item["value"].As<int>(), it->second.value);
+		EXPECT_EQ(item["group"].As<string>(), it->second.group);
+	}
+}
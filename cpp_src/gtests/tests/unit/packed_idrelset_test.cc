@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/ft/packedidrelset.h"
+
+using std::vector;
+using reindexer::IdRelType;
+using reindexer::PackedIdRelSet;
+using reindexer::VDocIdType;
+
+static vector<IdRelType> makeEntries(VDocIdType firstId, int count) {
+	vector<IdRelType> entries;
+	VDocIdType id = firstId;
+	for (int i = 0; i < count; ++i) {
+		IdRelType e;
+		// Deltas of ids and counts of positions have different bit widths in different blocks
+		id += 1 + rand() % (i % 300 < 150 ? 3 : 100000);
+		e.id = id;
+		int fields = 1 + rand() % 3;
+		for (int f = 0; f < fields; ++f) {
+			int positions = 1 + rand() % (i % 7 ? 2 : 40);
+			for (int p = 0; p < positions; ++p) e.pos.push_back(IdRelType::PosType(p * 3 + rand() % 3, f));
+		}
+		entries.push_back(std::move(e));
+	}
+	return entries;
+}
+
+static void checkEntries(const PackedIdRelSet &set, const vector<IdRelType> &expected) {
+	ASSERT_EQ(set.size(), expected.size());
+	size_t i = 0;
+	for (auto it = set.begin(); it != set.end(); ++it, ++i) {
+		ASSERT_LT(i, expected.size());
+		const IdRelType &e = expected[i];
+		ASSERT_EQ(it.Id(), e.id);
+		ASSERT_EQ(it.Field(), e.pos[0].field());
+		ASSERT_EQ(it.WordsInField(), e.wordsInField(e.pos[0].field()));
+		// Positions are read only for some entries
+		if (i % 3) continue;
+		ASSERT_EQ(it->pos.size(), e.pos.size());
+		for (size_t j = 0; j < e.pos.size(); ++j) ASSERT_EQ(it->pos[j].fpos, e.pos[j].fpos);
+	}
+	ASSERT_EQ(i, expected.size());
+}
+
+TEST(PackedIdRelSetTest, PackAndSkip) {
+	vector<IdRelType> expected;
+	PackedIdRelSet set;
+	checkEntries(set, expected);
+
+	// Entries are appended by parts: incomplete block is packed again with the new entries
+	for (int count : {1, 50, 127, 1, 1000, 300, 128}) {
+		auto entries = makeEntries(expected.empty() ? 0 : expected.back().id, count);
+		set.insert(set.end(), entries.begin(), entries.end());
+		for (auto &e : entries) expected.push_back(std::move(e));
+		checkEntries(set, expected);
+	}
+
+	for (int i = 0; i < 300; ++i) {
+		VDocIdType target = rand() % (expected.back().id + 10);
+		auto it = set.begin();
+		// Iterator moves forward only
+		VDocIdType prev = rand() % (target + 1);
+		ASSERT_EQ(it.SkipTo(prev), prev <= expected.back().id);
+		bool found = it.SkipTo(target);
+		auto expIt = std::lower_bound(expected.begin(), expected.end(), target,
+									  [](const IdRelType &e, VDocIdType id) { return e.id < id; });
+		ASSERT_EQ(found, expIt != expected.end());
+		if (!found) continue;
+		ASSERT_EQ(it.Id(), expIt->id);
+		ASSERT_EQ(it->pos.size(), expIt->pos.size());
+	}
+}
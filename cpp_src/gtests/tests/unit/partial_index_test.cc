@@ -0,0 +1,127 @@
+#include "brute_force_api.h"
+
+struct PartialIndexRow {
+	string status;
+	int64_t created;
+	string tag;
+};
+
+class PartialIndexApi : public BruteForceApi<PartialIndexRow> {
+public:
+	using Row = PartialIndexRow;
+
+	void SetUp() override {
+		Error err = reindexer->OpenNamespace(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		DefineNamespaceDataset(default_namespace, {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()},
+												   IndexDeclaration{"status", "hash", "string", IndexOpts()}});
+		AddPartialIndex("created", {"created"}, "tree", "int64", "status = 'active'");
+		AddPartialIndex("tag", {"tag"}, "hash", "string", "status IN ('active', 'pending')");
+		AddPartialIndex("tag+created", {"tag", "created"}, "tree", "composite", "status = 'active'");
+		for (int i = 0; i < kItemsCount; ++i) UpsertItem(i);
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void AddPartialIndex(const string &name, const reindexer::JsonPaths &jsonPaths, const string &indexType, const string &fieldType,
+						 const string &filter) {
+		reindexer::IndexDef indexDef(name, jsonPaths, indexType, fieldType, IndexOpts());
+		indexDef.filter_ = filter;
+		Error err = reindexer->AddIndex(default_namespace, indexDef);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	void UpsertItem(int id) {
+		static const char *statuses[] = {"active", "archived", "archived", "pending", "archived"};
+		Row row{statuses[rand() % 5], rand() % 1000, "tag" + std::to_string(rand() % 20)};
+		UpsertJSON(default_namespace, "{\"id\":" + std::to_string(id) + ",\"status\":\"" + row.status + "\",\"created\":" +
+										  std::to_string(row.created) + ",\"tag\":\"" + row.tag + "\"}");
+		rows_[id] = row;
+	}
+
+	void CheckAll() {
+		// Sorted result is compared by values of 'created'
+		auto byCreated = [this](int l, int r) { return rows_[l].created < rows_[r].created; };
+		Check(Query(default_namespace).Where("status", CondEq, "active").Where("created", CondGt, 500),
+			  [](int, const Row &r) { return r.status == "active" && r.created > 500; });
+		// Filter isn't implied by query: rows, which are not in partial index, are compared in payload
+		Check(Query(default_namespace).Where("created", CondGt, 500), [](int, const Row &r) { return r.created > 500; });
+		Check(Query(default_namespace).Where("created", CondEmpty, 0), [](int, const Row &) { return false; });
+		Check(Query(default_namespace).Where("status", CondEq, "pending").Where("tag", CondSet, {"tag1", "tag2"}),
+			  [](int, const Row &r) { return r.status == "pending" && (r.tag == "tag1" || r.tag == "tag2"); });
+		Check(Query(default_namespace).Where("tag", CondEq, "tag3"), [](int, const Row &r) { return r.tag == "tag3"; });
+		Check(Query(default_namespace).Where("status", CondEq, "active").Where("tag", CondEq, "tag5").Where("created", CondEq, 100),
+			  [](int, const Row &r) { return r.status == "active" && r.tag == "tag5" && r.created == 100; });
+		Check(Query(default_namespace).Where("tag", CondEq, "tag5").Where("created", CondLt, 100),
+			  [](int, const Row &r) { return r.tag == "tag5" && r.created < 100; });
+		Check(Query(default_namespace).Where("status", CondEq, "active").Sort("created", false).Limit(20),
+			  [](int, const Row &r) { return r.status == "active"; }, byCreated);
+		Check(Query(default_namespace).Sort("created", false).Limit(30), [](int, const Row &) { return true; }, byCreated);
+	}
+
+	static constexpr int kItemsCount = 3000;
+};
+
+TEST_F(PartialIndexApi, Selects) { CheckAll(); }
+
+TEST_F(PartialIndexApi, Modifications) {
+	// Rows move in and out of partial indexes
+	for (int id = 0; id < kItemsCount; id += 3) UpsertItem(id);
+	QueryResults qr;
+	Error err = reindexer->Delete(Query(default_namespace).Where("status", CondEq, "pending").Where("tag", CondEq, "tag7"), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (auto it : qr) rows_.erase(it.GetItem()["id"].As<int>());
+	err = Commit(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	CheckAll();
+
+	// Partial index, which is added to namespace with data, and drop of partial index
+	AddPartialIndex("tag_created", {"tag_created"}, "tree", "int", "tag = 'tag1'");
+	err = reindexer->DropIndex(default_namespace, reindexer::IndexDef("tag+created"));
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (int id = 0; id < kItemsCount; id += 5) UpsertItem(id);
+	CheckAll();
+}
+
+TEST_F(PartialIndexApi, UsedWhenImplied) {
+	QueryResults qr;
+	Error err = reindexer->Select(Query(default_namespace).Where("status", CondEq, "active").Where("created", CondEq, 500).Explain(), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	string explain = qr.GetExplainResults();
+	EXPECT_NE(explain.find("\"field\":\"created\""), string::npos) << explain;
+	EXPECT_EQ(explain.find("\"field\":\"created\",\"keys\":0,\"comparators\":1"), string::npos) << explain;
+
+	qr.Clear();
+	err = reindexer->Select(Query(default_namespace).Where("created", CondEq, 500).Explain(), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	explain = qr.GetExplainResults();
+	EXPECT_NE(explain.find("\"field\":\"created\",\"keys\":0,\"comparators\":1"), string::npos) << explain;
+
+	vector<reindexer::NamespaceDef> defs;
+	err = reindexer->EnumNamespaces(defs, false);
+	ASSERT_TRUE(err.ok()) << err.what();
+	for (auto &def : defs) {
+		if (def.name != default_namespace) continue;
+		auto it = std::find_if(def.indexes.begin(), def.indexes.end(), [](const reindexer::IndexDef &idef) { return idef.name_ == "tag"; });
+		ASSERT_TRUE(it != def.indexes.end());
+		EXPECT_EQ(it->filter_, "status IN ('active', 'pending')");
+	}
+}
+
+TEST_F(PartialIndexApi, Errors) {
+	auto addIndex = [this](const string &name, const string &indexType, const string &fieldType, IndexOpts opts, const string &filter) {
+		reindexer::IndexDef indexDef(name, {name}, indexType, fieldType, opts);
+		indexDef.filter_ = filter;
+		return reindexer->AddIndex(default_namespace, indexDef);
+	};
+	EXPECT_FALSE(addIndex("f1", "tree", "int", IndexOpts(), "unknown = 1").ok());
+	EXPECT_FALSE(addIndex("f1", "tree", "int", IndexOpts(), "status = 'active' OR f1 > 5").ok());
+	EXPECT_FALSE(addIndex("f1", "tree", "int", IndexOpts(), "status = ").ok());
+	EXPECT_FALSE(addIndex("f1", "-", "int", IndexOpts(), "status = 'active'").ok());
+	EXPECT_FALSE(addIndex("f1", "text", "string", IndexOpts(), "status = 'active'").ok());
+	EXPECT_TRUE(addIndex("f1", "tree", "int", IndexOpts(), "f1 > 5 AND status = 'active'").ok());
+
+	// Index, which is used in filter, can't be dropped
+	Error err = reindexer->DropIndex(default_namespace, reindexer::IndexDef("status"));
+	EXPECT_FALSE(err.ok());
+}
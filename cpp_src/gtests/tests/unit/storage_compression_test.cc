@@ -0,0 +1,84 @@
+#include <thread>
+#include "reindexer_api.h"
+#include "tools/fsops.h"
+
+class StorageCompressionApi : public ReindexerApi {
+public:
+	void SetUp() override {
+		reindexer::fs::RmDirAll(kStoragePath);
+		reindexer.reset(new Reindexer);
+		Error err = reindexer->Connect(string("builtin://") + kStoragePath);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+	void TearDown() override {
+		reindexer.reset();
+		reindexer::fs::RmDirAll(kStoragePath);
+	}
+
+	void EnableCompression() {
+		Item item = NewItem("#config");
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		Error err = item.FromJSON(R"json({"type":"namespaces","namespaces":[{"namespace":"*","storage_compression":true}]})json");
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert("#config", item);
+	}
+
+	string GetMemStat() {
+		QueryResults qr;
+		Error err = reindexer->Select(Query("#memstats").Where("name", CondEq, default_namespace), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		EXPECT_EQ(qr.Count(), 1u);
+		return qr.Count() ? qr[0].GetItem().GetJSON().ToString() : string();
+	}
+
+	const char *kStoragePath = "/tmp/reindex/storage_compression_test";
+};
+
+TEST_F(StorageCompressionApi, CompressAndReload) {
+	Error err = reindexer->OpenNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	DefineNamespaceDataset(default_namespace,
+						   {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"vendor", "hash", "string", IndexOpts()}});
+
+	const char *vendors[] = {"Samsung Electronics Co., Ltd.", "Apple Inc.", "Xiaomi Corporation", "Huawei Technologies Co., Ltd."};
+	auto fill = [&](int from, int count) {
+		for (int i = from; i < from + count; ++i) {
+			Item item = NewItem(default_namespace);
+			ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+			string json = "{\"id\":" + std::to_string(i) + ",\"vendor\":\"" + vendors[i % 4] +
+						  "\",\"url\":\"https://shop.example.com/products/smartphones/item-" + std::to_string(i) + "\"}";
+			err = item.FromJSON(json);
+			ASSERT_TRUE(err.ok()) << err.what();
+			Upsert(default_namespace, item);
+		}
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	};
+	fill(0, 1000);
+
+	// Dictionary is trained by background routine
+	EnableCompression();
+	string memstat;
+	for (int i = 0; i < 100; ++i) {
+		memstat = GetMemStat();
+		if (memstat.find("\"storage_compression\":{\"enabled\":true") != string::npos) break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+	ASSERT_NE(memstat.find("\"storage_compression\":{\"enabled\":true"), string::npos) << memstat;
+	fill(1000, 1000);
+
+	err = reindexer->CloseNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	err = reindexer->OpenNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	QueryResults qr;
+	err = reindexer->Select(Query(default_namespace).Where("vendor", CondEq, vendors[1]), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 500u);
+	for (auto it : qr) {
+		Item item = it.GetItem();
+		string url = "https://shop.example.com/products/smartphones/item-" + std::to_string(item["id"].As<int>());
+		EXPECT_NE(item.GetJSON().ToString().find(url), string::npos);
+	}
+}
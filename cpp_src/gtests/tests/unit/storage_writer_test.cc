@@ -0,0 +1,142 @@
+#include "reindexer_api.h"
+#include "core/storage/storagefactory.h"
+#include "core/storage/storagewriter.h"
+#include "tools/fsops.h"
+
+class StorageWriterApi : public ReindexerApi {
+public:
+	void SetUp() override {
+		reindexer::fs::RmDirAll(kStoragePath);
+		reindexer.reset(new Reindexer);
+		Error err = reindexer->Connect(string("builtin://") + kStoragePath);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+	void TearDown() override {
+		reindexer.reset();
+		reindexer::fs::RmDirAll(kStoragePath);
+	}
+
+	void SetFlushMode(const char *mode) {
+		Item item = NewItem("#config");
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		char json[256];
+		snprintf(json, sizeof(json), R"json({"type":"storage","storage":{"flush_mode":"%s","sync_interval_ms":10}})json", mode);
+		Error err = item.FromJSON(json);
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert("#config", item);
+	}
+
+	void FillNs(int from, int count) {
+		for (int i = from; i < from + count; ++i) {
+			Item item = NewItem(default_namespace);
+			ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+			item["id"] = i;
+			item["value"] = RandString();
+			Upsert(default_namespace, item);
+		}
+	}
+
+	size_t ReopenAndCount() {
+		Error err = reindexer->CloseNamespace(default_namespace);
+		EXPECT_TRUE(err.ok()) << err.what();
+		err = reindexer->OpenNamespace(default_namespace);
+		EXPECT_TRUE(err.ok()) << err.what();
+		QueryResults qr;
+		err = reindexer->Select(Query(default_namespace), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		return qr.Count();
+	}
+
+	const char *kStoragePath = "/tmp/reindex/storage_writer_test";
+};
+
+TEST_F(StorageWriterApi, FlushModes) {
+	Error err = reindexer->OpenNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	DefineNamespaceDataset(default_namespace,
+						   {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"value", "tree", "string", IndexOpts()}});
+
+	int total = 0;
+	for (const char *mode : {"async", "periodic", "per_commit"}) {
+		SetFlushMode(mode);
+		FillNs(total, 500);
+		total += 500;
+		err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+		EXPECT_EQ(ReopenAndCount(), size_t(total)) << "flush mode " << mode;
+	}
+}
+
+using reindexer::string_view;
+using reindexer::datastorage::UpdatesCollection;
+using reindexer::datastorage::Snapshot;
+using reindexer::datastorage::Cursor;
+
+// Storage, which fails writes of batches, when failWrites is set
+class FailingStorage : public reindexer::datastorage::IDataStorage {
+public:
+	FailingStorage(IDataStorage *storage) : storage_(storage) {}
+	Error Open(const string &path, const StorageOpts &opts) override { return storage_->Open(path, opts); }
+	Error Read(const StorageOpts &opts, const string_view &key, string &value) override { return storage_->Read(opts, key, value); }
+	Error Write(const StorageOpts &opts, const string_view &key, const string_view &value) override {
+		return storage_->Write(opts, key, value);
+	}
+	Error Write(const StorageOpts &opts, UpdatesCollection &buffer) override {
+		if (failWrites) return Error(errLogic, "Write failed");
+		return storage_->Write(opts, buffer);
+	}
+	Error Delete(const StorageOpts &opts, const string_view &key) override { return storage_->Delete(opts, key); }
+	Snapshot::Ptr MakeSnapshot() override { return storage_->MakeSnapshot(); }
+	void ReleaseSnapshot(Snapshot::Ptr snapshot) override { storage_->ReleaseSnapshot(snapshot); }
+	void Flush() override { storage_->Flush(); }
+	Cursor *GetCursor(StorageOpts &opts) override { return storage_->GetCursor(opts); }
+	Cursor *GetSnapshotCursor(const Snapshot::Ptr &snapshot) override { return storage_->GetSnapshotCursor(snapshot); }
+	UpdatesCollection *GetUpdatesCollection() override { return storage_->GetUpdatesCollection(); }
+	void Destroy(const string &path) override { storage_->Destroy(path); }
+
+	std::atomic<bool> failWrites{false};
+
+private:
+	std::unique_ptr<IDataStorage> storage_;
+};
+
+TEST_F(StorageWriterApi, WriteErrors) {
+	using namespace reindexer::datastorage;
+	auto storage = std::make_shared<FailingStorage>(StorageFactory::create(StorageType::LevelDB));
+	Error err = storage->Open(string(kStoragePath) + "/failing", StorageOpts().Enabled().CreateIfMissing());
+	ASSERT_TRUE(err.ok()) << err.what();
+
+	auto batch = [&](const char *key) {
+		UpdatesCollection::Ptr updates(storage->GetUpdatesCollection());
+		updates->Put(key, "value");
+		return updates;
+	};
+
+	for (auto policy : {StorageFlushPolicy::Async, StorageFlushPolicy::PerCommit}) {
+		StorageWriter writer;
+		writer.SetPolicy(policy, std::chrono::milliseconds(10));
+		storage->failWrites = false;
+		auto ok = writer.Submit(storage, batch("ok"), false, nullptr, "test");
+		EXPECT_TRUE(writer.Wait(ok).ok());
+
+		// Error of failed batch is returned to all its waiters
+		storage->failWrites = true;
+		auto failed = writer.Submit(storage, batch("failed"), false, nullptr, "test");
+		err = writer.Wait(failed);
+		EXPECT_FALSE(err.ok());
+		EXPECT_EQ(err.code(), errLogic);
+		EXPECT_FALSE(writer.Wait(failed).ok());
+		EXPECT_TRUE(writer.Wait(ok).ok());
+
+		// Errors of old tickets are not lost, when there are too many failed batches
+		vector<StorageWriter::Ticket> tickets;
+		for (int i = 0; i < 2000; ++i) tickets.push_back(writer.Submit(storage, batch("failed"), false, nullptr, "test"));
+		for (auto ticket : tickets) EXPECT_FALSE(writer.Wait(ticket).ok()) << ticket;
+
+		// Stopped writer writes batches synchronously
+		writer.Stop();
+		EXPECT_FALSE(writer.Wait(writer.Submit(storage, batch("stopped"), false, nullptr, "test")).ok());
+		storage->failWrites = false;
+		EXPECT_TRUE(writer.Wait(writer.Submit(storage, batch("stopped"), false, nullptr, "test")).ok());
+	}
+}
@@ -0,0 +1,159 @@
+#include <stdlib.h>
+#include <thread>
+#include "reindexer_api.h"
+#include "tools/fsops.h"
+
+class TieredStorageApi : public ReindexerApi {
+public:
+	void SetUp() override {
+		reindexer::fs::RmDirAll(kStoragePath);
+		reindexer.reset(new Reindexer);
+		Error err = reindexer->Connect(string("builtin://") + kStoragePath);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+	void TearDown() override {
+		reindexer.reset();
+		reindexer::fs::RmDirAll(kStoragePath);
+	}
+
+	void SetMemoryLimit(int64_t limit) {
+		Item item = NewItem("#config");
+		ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+		string json = R"json({"type":"namespaces","namespaces":[{"namespace":"*","documents_memory_limit":)json" + std::to_string(limit) + "}]}";
+		Error err = item.FromJSON(json);
+		ASSERT_TRUE(err.ok()) << err.what();
+		Upsert("#config", item);
+	}
+
+	int64_t GetEvictedCount() {
+		QueryResults qr;
+		Error err = reindexer->Select(Query("#memstats").Where("name", CondEq, default_namespace), qr);
+		EXPECT_TRUE(err.ok()) << err.what();
+		EXPECT_EQ(qr.Count(), 1u);
+		if (!qr.Count()) return 0;
+		string memstat = qr[0].GetItem().GetJSON().ToString();
+		const char *field = "\"evicted_items_count\":";
+		auto pos = memstat.find(field);
+		EXPECT_NE(pos, string::npos) << memstat;
+		return pos == string::npos ? 0 : atoll(memstat.c_str() + pos + strlen(field));
+	}
+
+	// Tuples are evicted by background routine
+	void EvictTuples() {
+		SetMemoryLimit(20000);
+		int64_t evicted = 0;
+		for (int i = 0; i < 100 && !evicted; ++i) {
+			evicted = GetEvictedCount();
+			if (!evicted) std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+		ASSERT_GT(evicted, 0);
+	}
+
+	void Fill(int from, int count) {
+		for (int i = from; i < from + count; ++i) {
+			Item item = NewItem(default_namespace);
+			ASSERT_TRUE(item.Status().ok()) << item.Status().what();
+			Error err = item.FromJSON("{\"id\":" + std::to_string(i) + ",\"group\":" + std::to_string(i % 10) + ",\"price\":" + std::to_string(Price(i)) +
+									  ",\"url\":\"" + Url(i) + "\"}");
+			ASSERT_TRUE(err.ok()) << err.what();
+			Upsert(default_namespace, item);
+		}
+		Error err = Commit(default_namespace);
+		ASSERT_TRUE(err.ok()) << err.what();
+	}
+
+	static int Price(int i) { return i % 100; }
+	static string Url(int i) { return "https://shop.example.com/products/smartphones/item-" + std::to_string(i); }
+
+	const char *kStoragePath = "/tmp/reindex/tiered_storage_test";
+};
+
+TEST_F(TieredStorageApi, EvictAndFetch) {
+	Error err = reindexer->OpenNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	DefineNamespaceDataset(default_namespace,
+						   {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"group", "tree", "int", IndexOpts()}});
+	Fill(0, 2000);
+	EvictTuples();
+
+	// Non-indexed fields of evicted items are read from storage
+	QueryResults qr;
+	err = reindexer->Select(Query(default_namespace).Where("group", CondEq, 3), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 200u);
+	for (auto it : qr) {
+		Item item = it.GetItem();
+		EXPECT_NE(item.GetJSON().ToString().find(Url(item["id"].As<int>())), string::npos);
+	}
+
+	// Conditions and sorting by non-indexed fields
+	qr.Clear();
+	err = reindexer->Select(Query(default_namespace).Where("url", CondEq, Url(1234)), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.Count(), 1u);
+	EXPECT_EQ(qr[0].GetItem()["id"].As<int>(), 1234);
+
+	qr.Clear();
+	err = reindexer->Select(Query(default_namespace).Where("group", CondEq, 5).Sort("url", true).Limit(1), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	ASSERT_EQ(qr.Count(), 1u);
+	EXPECT_EQ(qr[0].GetItem()["id"].As<int>(), 995);
+
+	// Modifications of evicted items
+	Fill(0, 100);
+	QueryResults delQr;
+	err = reindexer->Delete(Query(default_namespace).Where("id", CondLt, 50), delQr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(delQr.Count(), 50u);
+
+	qr.Clear();
+	err = reindexer->Select(Query(default_namespace), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 1950u);
+	for (auto it : qr) {
+		Item item = it.GetItem();
+		EXPECT_NE(item.GetJSON().ToString().find(Url(item["id"].As<int>())), string::npos);
+	}
+
+	// Changing of indexes makes all items resident
+	err = reindexer->AddIndex(default_namespace, {"url", "hash", "string", IndexOpts()});
+	ASSERT_TRUE(err.ok()) << err.what();
+	qr.Clear();
+	err = reindexer->Select(Query(default_namespace).Where("url", CondEq, Url(1500)), qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	EXPECT_EQ(qr.Count(), 1u);
+}
+
+TEST_F(TieredStorageApi, AggregateNotIndexedFields) {
+	Error err = reindexer->OpenNamespace(default_namespace);
+	ASSERT_TRUE(err.ok()) << err.what();
+	DefineNamespaceDataset(default_namespace,
+						   {IndexDeclaration{"id", "hash", "int", IndexOpts().PK()}, IndexDeclaration{"group", "tree", "int", IndexOpts()}});
+	Fill(0, 2000);
+	EvictTuples();
+
+	// Aggregated values of not indexed field are read from tuples of evicted items
+	QueryResults qr;
+	err = reindexer->Select(Query(default_namespace)
+								.Where("group", CondEq, 3)
+								.Aggregate("price", AggSum)
+								.Aggregate("price", AggAvg)
+								.Aggregate("price", AggMin)
+								.Aggregate("price", AggMax)
+								.Aggregate("price", AggFacet),
+							qr);
+	ASSERT_TRUE(err.ok()) << err.what();
+	const auto &aggs = qr.GetAggregationResults();
+	ASSERT_EQ(aggs.size(), 5u);
+	double sum = 0;
+	for (int i = 0; i < 2000; ++i) sum += i % 10 == 3 ? Price(i) : 0;
+	EXPECT_EQ(aggs[0].value, sum);
+	EXPECT_EQ(aggs[1].value, sum / 200);
+	EXPECT_EQ(aggs[2].value, 3);
+	EXPECT_EQ(aggs[3].value, 93);
+	ASSERT_EQ(aggs[4].facets.size(), 10u);
+	for (auto &facet : aggs[4].facets) {
+		EXPECT_EQ(std::stoi(facet.value) % 10, 3) << facet.value;
+		EXPECT_EQ(facet.count, 20) << facet.value;
+	}
+}
@@ -28,6 +28,8 @@ std::unordered_map<int, const char *> kRPCCodes = {
 	{kCmdGetMeta, "GetMeta"},
 	{kCmdPutMeta, "PutMeta"},
 	{kCmdEnumMeta, "EnumMeta"},
+	{kCmdBackup, "Backup"},
+	{kCmdRestore, "Restore"},
 	{kCmdSubscribeUpdates, "SubscribeUpdates"},
 	{kCmdUpdates, "Updates"},
 };
@@ -37,6 +37,9 @@ enum CmdCode {
 	kCmdPutMeta = 65,
 	kCmdEnumMeta = 66,
 
+	kCmdBackup = 70,
+	kCmdRestore = 71,
+
 	kCmdSubscribeUpdates = 90,
 	kCmdUpdates = 91,
 
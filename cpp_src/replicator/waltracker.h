@@ -76,7 +76,7 @@ protected:
 	/// @param rec - Record to be added
 	void put(int64_t lsn, const WALRecord &rec);
 	/// check if lsn is available. e.g. in range of ring buffer
-	bool available(int64_t lsn) const { return lsn < lsnCounter_ && lsnCounter_ - lsn < walSize_; }
+	bool available(int64_t lsn) const { return lsn >= 0 && lsn < lsnCounter_ && lsnCounter_ - lsn < walSize_; }
 
 	void writeToStorage(int64_t lsn);
 	std::vector<std::pair<int64_t, std::string>> readFromStorage(int64_t &maxLsn);
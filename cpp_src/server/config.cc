@@ -71,6 +71,8 @@ Error ServerConfig::ParseCmd(int argc, char *argv[]) {
 
 	args::Group dbGroup(parser, "Database options");
 	args::ValueFlag<string> storageF(dbGroup, "PATH", "path to 'reindexer' storage", {'s', "db"}, StoragePath, args::Options::Single);
+	args::ValueFlag<string> engineF(dbGroup, "NAME", "storage engine for new databases (leveldb, logstorage)", {'e', "engine"},
+									StorageEngine, args::Options::Single);
 
 	args::Group netGroup(parser, "Network options");
 	args::ValueFlag<string> httpAddrF(netGroup, "PORT", "http listen host:port", {'p', "httpaddr"}, HTTPAddr, args::Options::Single);
@@ -113,6 +115,7 @@ Error ServerConfig::ParseCmd(int argc, char *argv[]) {
 	}
 
 	if (storageF) StoragePath = args::get(storageF);
+	if (engineF) StorageEngine = args::get(engineF);
 	if (logLevelF) LogLevel = args::get(logLevelF);
 	if (httpAddrF) HTTPAddr = args::get(httpAddrF);
 	if (rpcAddrF) RPCAddr = args::get(rpcAddrF);
@@ -140,6 +143,7 @@ Error ServerConfig::ParseCmd(int argc, char *argv[]) {
 reindexer::Error ServerConfig::fromYaml(Yaml::Node &root) {
 	try {
 		StoragePath = root["storage"]["path"].As<std::string>(StoragePath);
+		StorageEngine = root["storage"]["engine"].As<std::string>(StorageEngine);
 		LogLevel = root["logger"]["loglevel"].As<std::string>(LogLevel);
 		ServerLog = root["logger"]["serverlog"].As<std::string>(ServerLog);
 		CoreLog = root["logger"]["corelog"].As<std::string>(CoreLog);
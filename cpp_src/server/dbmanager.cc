@@ -10,7 +10,8 @@
 #include "tools/stringstools.h"
 
 namespace reindexer_server {
-DBManager::DBManager(const string &dbpath, bool noSecurity) : dbpath_(dbpath), noSecurity_(noSecurity) {}
+DBManager::DBManager(const string &dbpath, bool noSecurity, const string &storageEngine)
+	: dbpath_(dbpath), storageEngine_(storageEngine), noSecurity_(noSecurity) {}
 
 Error DBManager::Init() {
 	auto status = readUsers();
@@ -79,7 +80,8 @@ Error DBManager::loadOrCreateDatabase(const string &dbName) {
 
 	logPrintf(LogInfo, "Loading database %s", dbName);
 	auto db = std::make_shared<reindexer::Reindexer>();
-	auto status = db->Connect(storagePath);
+	// Engine is applied only to new databases. Existing ones are opened with engine from their placeholder
+	auto status = db->Connect(storagePath + "?engine=" + storageEngine_);
 	if (status.ok()) {
 		dbs_[dbName] = db;
 	}
@@ -87,7 +87,8 @@ public:
 	/// Construct DBManager
 	/// @param dbpath - path to database on file system
 	/// @param noSecurity - if true, then disable all security validations and users authentication
-	DBManager(const string &dbpath, bool noSecurity);
+	/// @param storageEngine - name of storage engine for new databases
+	DBManager(const string &dbpath, bool noSecurity, const string &storageEngine = "leveldb");
 	/// Initialize database:
 	/// Read all found databases to RAM
 	/// Read user's database
@@ -122,6 +123,7 @@ private:
 	unordered_map<string, shared_ptr<Reindexer>, nocase_hash_str, nocase_equal_str> dbs_;
 	unordered_map<string, UserRecord> users_;
 	string dbpath_;
+	string storageEngine_;
 	shared_timed_mutex mtx_;
 	bool noSecurity_;
 };
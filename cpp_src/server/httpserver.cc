@@ -223,6 +223,34 @@ int HTTPServer::DeleteDatabase(http::Context &ctx) {
 	return jsonStatus(ctx);
 }
 
+int HTTPServer::PostBackup(http::Context &ctx) {
+	shared_ptr<Reindexer> db = getDB(ctx, kRoleOwner);
+	string path = getNameFromJson(ctx.body->Read(), "path");
+	if (path.empty()) {
+		return jsonStatus(ctx, http::HttpStatus(http::StatusBadRequest, "Backup path is not specified"));
+	}
+
+	auto status = db->Backup(path);
+	if (!status.ok()) {
+		return jsonStatus(ctx, http::HttpStatus(status));
+	}
+	return jsonStatus(ctx);
+}
+
+int HTTPServer::PostRestore(http::Context &ctx) {
+	shared_ptr<Reindexer> db = getDB(ctx, kRoleOwner);
+	string path = getNameFromJson(ctx.body->Read(), "path");
+	if (path.empty()) {
+		return jsonStatus(ctx, http::HttpStatus(http::StatusBadRequest, "Backup path is not specified"));
+	}
+
+	auto status = db->Restore(path);
+	if (!status.ok()) {
+		return jsonStatus(ctx, http::HttpStatus(status));
+	}
+	return jsonStatus(ctx);
+}
+
 int HTTPServer::GetNamespaces(http::Context &ctx) {
 	shared_ptr<Reindexer> db = getDB(ctx, kRoleDataRead);
 
@@ -586,6 +614,8 @@ bool HTTPServer::Start(const string &addr, ev::dynamic_loop &loop) {
 	router_.GET<HTTPServer, &HTTPServer::GetDatabases>("/api/v1/db", this);
 	router_.POST<HTTPServer, &HTTPServer::PostDatabase>("/api/v1/db", this);
 	router_.DELETE<HTTPServer, &HTTPServer::DeleteDatabase>("/api/v1/db/:db", this);
+	router_.POST<HTTPServer, &HTTPServer::PostBackup>("/api/v1/db/:db/backup", this);
+	router_.POST<HTTPServer, &HTTPServer::PostRestore>("/api/v1/db/:db/restore", this);
 
 	router_.GET<HTTPServer, &HTTPServer::GetNamespaces>("/api/v1/db/:db/namespaces", this);
 	router_.GET<HTTPServer, &HTTPServer::GetNamespace>("/api/v1/db/:db/namespaces/:ns", this);
@@ -785,7 +815,7 @@ shared_ptr<Reindexer> HTTPServer::getDB(http::Context &ctx, UserRole role) {
 	return db;
 }
 
-string HTTPServer::getNameFromJson(string json) {
+string HTTPServer::getNameFromJson(string json, const char *field) {
 	JsonAllocator jalloc;
 	JsonValue jvalue;
 	char *endp;
@@ -801,7 +831,7 @@ string HTTPServer::getNameFromJson(string json) {
 
 	string dbName;
 	for (auto elem : jvalue) {
-		if (elem->value.getTag() == JSON_STRING && !strcmp(elem->key, "name")) {
+		if (elem->value.getTag() == JSON_STRING && !strcmp(elem->key, field)) {
 			dbName = elem->value.toString();
 			break;
 		}
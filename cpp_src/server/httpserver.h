@@ -37,6 +37,8 @@ public:
 	int GetDatabases(http::Context &ctx);
 	int PostDatabase(http::Context &ctx);
 	int DeleteDatabase(http::Context &ctx);
+	int PostBackup(http::Context &ctx);
+	int PostRestore(http::Context &ctx);
 	int GetNamespaces(http::Context &ctx);
 	int GetNamespace(http::Context &ctx);
 	int PostNamespace(http::Context &ctx);
@@ -61,7 +63,7 @@ protected:
 	unsigned prepareOffset(const string_view &offsetParam, int offsetDefault = kDefaultOffset);
 
 	shared_ptr<Reindexer> getDB(http::Context &ctx, UserRole role);
-	string getNameFromJson(string json);
+	string getNameFromJson(string json, const char *field = "name");
 
 	DBManager &dbMgr_;
 	Pprof pprof_;
@@ -549,6 +549,10 @@ Error RPCServer::SubscribeUpdates(cproto::Context &ctx, int flag) {
 	return ret;
 }
 
+Error RPCServer::Backup(cproto::Context &ctx, p_string path) { return getDB(ctx, kRoleOwner)->Backup(path.toString()); }
+
+Error RPCServer::Restore(cproto::Context &ctx, p_string path) { return getDB(ctx, kRoleOwner)->Restore(path.toString()); }
+
 bool RPCServer::Start(const string &addr, ev::dynamic_loop &loop) {
 	dispatcher.Register(cproto::kCmdPing, this, &RPCServer::Ping);
 	dispatcher.Register(cproto::kCmdLogin, this, &RPCServer::Login);
@@ -582,6 +586,8 @@ bool RPCServer::Start(const string &addr, ev::dynamic_loop &loop) {
 	dispatcher.Register(cproto::kCmdPutMeta, this, &RPCServer::PutMeta);
 	dispatcher.Register(cproto::kCmdEnumMeta, this, &RPCServer::EnumMeta);
 	dispatcher.Register(cproto::kCmdSubscribeUpdates, this, &RPCServer::SubscribeUpdates);
+	dispatcher.Register(cproto::kCmdBackup, this, &RPCServer::Backup);
+	dispatcher.Register(cproto::kCmdRestore, this, &RPCServer::Restore);
 	dispatcher.Middleware(this, &RPCServer::CheckAuth);
 	dispatcher.OnClose(this, &RPCServer::OnClose);
 
@@ -74,6 +74,8 @@ public:
 	Error PutMeta(cproto::Context &ctx, p_string ns, p_string key, p_string data);
 	Error EnumMeta(cproto::Context &ctx, p_string ns);
 	Error SubscribeUpdates(cproto::Context &ctx, int subscribe);
+	Error Backup(cproto::Context &ctx, p_string path);
+	Error Restore(cproto::Context &ctx, p_string path);
 
 	Error CheckAuth(cproto::Context &ctx);
 	void Logger(cproto::Context &ctx, const Error &err, const cproto::Args &ret);
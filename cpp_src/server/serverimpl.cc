@@ -200,7 +200,7 @@ int ServerImpl::run() {
 
 	initCoreLogger();
 	try {
-		dbMgr_.reset(new DBManager(config_.StoragePath, !config_.EnableSecurity));
+		dbMgr_.reset(new DBManager(config_.StoragePath, !config_.EnableSecurity, config_.StorageEngine));
 
 		auto status = dbMgr_->Init();
 		if (!status.ok()) {
@@ -220,6 +220,54 @@ bool iequals(const string_view &lhs, const string_view &rhs) {
 	return true;
 }
 
+static inline uint32_t foldCase(uint32_t ch, CollateMode mode) {
+	switch (mode) {
+		case CollateASCII:
+			return ch < 128 ? uint32_t(tolower(char(ch))) : ch;
+		case CollateUTF8:
+			return ToLower(wchar_t(ch));
+		default:
+			return ch;
+	}
+}
+
+bool matchLikePattern(string_view str, string_view pattern, CollateMode mode) {
+	const char *s = str.data(), *sEnd = str.data() + str.size();
+	const char *p = pattern.data(), *pEnd = pattern.data() + pattern.size();
+	// Position after the last '%' in pattern and position in string, where it's match started
+	const char *pBack = nullptr, *sBack = nullptr;
+
+	while (s < sEnd) {
+		if (p != pEnd && *p == '%') {
+			pBack = ++p;
+			sBack = s;
+			continue;
+		}
+		if (p != pEnd) {
+			const char *pNext = p, *sNext = s;
+			uint32_t pch = utf8::unchecked::next(pNext);
+			uint32_t sch = utf8::unchecked::next(sNext);
+			if (pch == '_' || foldCase(pch, mode) == foldCase(sch, mode)) {
+				p = pNext;
+				s = sNext;
+				continue;
+			}
+		}
+		if (!pBack) return false;
+		// Mismatch: the last '%' consumes one more symbol
+		utf8::unchecked::next(sBack);
+		s = sBack;
+		p = pBack;
+	}
+	while (p != pEnd && *p == '%') ++p;
+	return p == pEnd;
+}
+
+string_view likePatternPrefix(string_view pattern) {
+	size_t pos = pattern.find_first_of("%_", 0);
+	return pos == string_view::npos ? pattern : pattern.substr(0, pos);
+}
+
 int collateCompare(const string_view &lhs, const string_view &rhs, const CollateOpts &collateOpts) {
 	if (collateOpts.mode == CollateASCII) {
 		auto itl = lhs.begin();
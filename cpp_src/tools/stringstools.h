@@ -56,6 +56,12 @@ protected:
 string lower(string s);
 int collateCompare(const string_view& lhs, const string_view& rhs, const CollateOpts& collateOpts);
 
+// Matches string with pattern of LIKE condition: '%' - any sequence of symbols, '_' - any single symbol.
+// Case of symbols is ignored for CollateASCII and CollateUTF8 modes
+bool matchLikePattern(string_view str, string_view pattern, CollateMode mode);
+// Literal prefix of LIKE pattern (part before the first wildcard)
+string_view likePatternPrefix(string_view pattern);
+
 wstring utf8_to_utf16(const string& src);
 string utf16_to_utf8(const wstring& src);
 wstring& utf8_to_utf16(const string_view& src, wstring& dst);
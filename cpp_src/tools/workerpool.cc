@@ -0,0 +1,91 @@
+#include "workerpool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace reindexer {
+
+struct WorkerPool::Job {
+	Job(size_t count, const std::function<void(size_t)> &task) : count(count), task(task) {}
+
+	const size_t count;
+	const std::function<void(size_t)> &task;
+	std::atomic<size_t> next{0};
+	size_t done = 0;
+	std::exception_ptr error;
+	std::mutex mtx;
+	std::condition_variable cond;
+};
+
+WorkerPool &WorkerPool::Instance() {
+	static WorkerPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+	return pool;
+}
+
+WorkerPool::WorkerPool(size_t threads) {
+	for (size_t i = 0; i < threads; ++i) threads_.emplace_back([this]() { loop(); });
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lck(mtx_);
+		terminate_ = true;
+	}
+	cond_.notify_all();
+	for (auto &t : threads_) t.join();
+}
+
+void WorkerPool::Run(size_t count, size_t maxThreads, const std::function<void(size_t)> &task) {
+	if (count <= 1 || maxThreads <= 1 || threads_.empty()) {
+		for (size_t i = 0; i < count; ++i) task(i);
+		return;
+	}
+	auto job = std::make_shared<Job>(count, task);
+	size_t helpers = std::min(std::min(count, maxThreads) - 1, threads_.size());
+	{
+		std::lock_guard<std::mutex> lck(mtx_);
+		for (size_t i = 0; i < helpers; ++i) queue_.push_back(job);
+	}
+	if (helpers > 1) {
+		cond_.notify_all();
+	} else {
+		cond_.notify_one();
+	}
+
+	work(*job);
+
+	std::unique_lock<std::mutex> lck(job->mtx);
+	job->cond.wait(lck, [&job]() { return job->done == job->count; });
+	if (job->error) std::rethrow_exception(job->error);
+}
+
+// Executes tasks of job, until all of them are taken. Workers, which take job too late, find no tasks
+void WorkerPool::work(Job &job) {
+	for (size_t i = job.next++; i < job.count; i = job.next++) {
+		std::exception_ptr error;
+		try {
+			job.task(i);
+		} catch (...) {
+			error = std::current_exception();
+		}
+		std::lock_guard<std::mutex> lck(job.mtx);
+		if (error && !job.error) job.error = error;
+		if (++job.done == job.count) job.cond.notify_all();
+	}
+}
+
+void WorkerPool::loop() {
+	for (;;) {
+		std::shared_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lck(mtx_);
+			cond_.wait(lck, [this]() { return terminate_ || !queue_.empty(); });
+			if (terminate_) return;
+			job = std::move(queue_.front());
+			queue_.pop_front();
+		}
+		work(*job);
+	}
+}
+
+}  // namespace reindexer
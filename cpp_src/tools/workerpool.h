@@ -0,0 +1,40 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace reindexer {
+
+// Threads, which are shared by parallel parts of queries. Thread, which runs tasks, executes them too,
+// so it doesn't wait for busy workers, and count of threads is not more than count of CPU cores
+class WorkerPool {
+public:
+	static WorkerPool &Instance();
+
+	WorkerPool(size_t threads);
+	~WorkerPool();
+	WorkerPool(const WorkerPool &) = delete;
+	WorkerPool &operator=(const WorkerPool &) = delete;
+
+	// Runs task(i) for each i in [0, count) with not more than maxThreads threads, including the current one.
+	// Returns, when all the tasks are done. The first exception of tasks is rethrown
+	void Run(size_t count, size_t maxThreads, const std::function<void(size_t)> &task);
+
+protected:
+	struct Job;
+	static void work(Job &job);
+	void loop();
+
+	std::vector<std::thread> threads_;
+	std::deque<std::shared_ptr<Job>> queue_;
+	std::mutex mtx_;
+	std::condition_variable cond_;
+	bool terminate_ = false;
+};
+
+}  // namespace reindexer
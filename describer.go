@@ -14,16 +14,19 @@ const (
 
 // Map from cond name to index type
 var queryTypes = map[string]int{
-	"EQ":     EQ,
-	"GT":     GT,
-	"LT":     LT,
-	"GE":     GE,
-	"LE":     LE,
-	"SET":    SET,
-	"RANGE":  RANGE,
-	"ANY":    ANY,
-	"EMPTY":  EMPTY,
-	"ALLSET": ALLSET,
+	"EQ":      EQ,
+	"GT":      GT,
+	"LT":      LT,
+	"GE":      GE,
+	"LE":      LE,
+	"SET":     SET,
+	"RANGE":   RANGE,
+	"ANY":     ANY,
+	"EMPTY":   EMPTY,
+	"ALLSET":  ALLSET,
+	"DWITHIN": DWITHIN,
+	"INBOX":   INBOX,
+	"LIKE":    LIKE,
 }
 
 func GetCondType(name string) (int, error) {
@@ -76,6 +79,22 @@ type NamespaceMemStat struct {
 		IndexesSize int `json:"indexes_size"`
 		CacheSize   int `json:"cache_size"`
 	}
+	StorageCompression struct {
+		Enabled    bool    `json:"enabled"`
+		DictSize   int64   `json:"dict_size"`
+		RawSize    int64   `json:"raw_size"`
+		StoredSize int64   `json:"stored_size"`
+		Ratio      float64 `json:"ratio"`
+	} `json:"storage_compression"`
+	TieredStorage struct {
+		MemoryLimit       int64 `json:"memory_limit"`
+		ResidentSize      int64 `json:"resident_size"`
+		EvictedItemsCount int64 `json:"evicted_items_count"`
+		Cache             struct {
+			TotalSize  int64 `json:"total_size"`
+			ItemsCount int64 `json:"items_count"`
+		} `json:"cache"`
+	} `json:"tiered_storage"`
 }
 
 type PerfStat struct {
@@ -102,6 +121,7 @@ type DBConfigItem struct {
 	Type       string                `json:"type"`
 	Profiling  *DBProfilingConfig    `json:"profiling,omitempty"`
 	Namespaces *[]DBNamespacesConfig `json:"namespaces,omitempty"`
+	Storage    *DBStorageConfig      `json:"storage,omitempty"`
 }
 
 type DBProfilingConfig struct {
@@ -112,11 +132,19 @@ type DBProfilingConfig struct {
 }
 
 type DBNamespacesConfig struct {
-	Namespace           string `json:"namespace"`
-	LogLevel            string `json:"log_level"`
-	JoinCacheMode       string `json:"join_cache_mode"`
-	Lazyload            bool   `json:"lazyload"`
-	UnloadIdleThreshold int    `json:"unload_idle_threshold"`
+	Namespace            string `json:"namespace"`
+	LogLevel             string `json:"log_level"`
+	JoinCacheMode        string `json:"join_cache_mode"`
+	Lazyload             bool   `json:"lazyload"`
+	UnloadIdleThreshold  int    `json:"unload_idle_threshold"`
+	StorageCompression   bool   `json:"storage_compression"`
+	DocumentsMemoryLimit int64  `json:"documents_memory_limit"`
+	OnlineIndexBuild     bool   `json:"online_index_build"`
+}
+
+type DBStorageConfig struct {
+	FlushMode      string `json:"flush_mode"`
+	SyncIntervalMs int    `json:"sync_interval_ms"`
 }
 
 // DescribeNamespaces makes a 'SELECT * FROM #namespaces' query to database.
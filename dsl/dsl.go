@@ -100,7 +100,7 @@ func (f *Filter) ParseValue(data string) error {
 	}
 
 	switch f.Cond {
-	case "EQ", "GT", "LT", "GE", "LE":
+	case "EQ", "GT", "LT", "GE", "LE", "LIKE":
 		if len(data) == 0 || data == `""` || data == "null" {
 			f.Value = nil
 			break
@@ -134,7 +134,7 @@ func (f *Filter) ParseValue(data string) error {
 		} else {
 			f.Value = v
 		}
-	case "SET", "RANGE", "ALLSET":
+	case "SET", "RANGE", "ALLSET", "DWITHIN", "INBOX":
 		if len(data) == 0 || data == `[]` || data == "null" {
 			f.Value = nil
 			break
@@ -29,10 +29,14 @@ type FtFastConfig struct {
 	MaxTyposInWord int `json:"max_typos_in_word"`
 	// Maximum word length for building and matching variants with typos. Default value is 15
 	MaxTypoLen int `json:"max_typo_len"`
-	// Maximum commit steps - set it 1 for always full rebuild - it can be from 1 to 500
+	// Maximum commit steps - set it 1 for always full rebuild - it can be from 1 to 500. Count of steps can't be more than 15
 	MaxRebuildSteps int `json:"max_rebuild_steps"`
-	// Maximum words in one commit - it can be from 5 to DOUBLE_MAX
+	// Steps with less unique words are always merged with the new step - it can be from 5 to DOUBLE_MAX
 	MaxStepSize int `json:"max_step_size"`
+	// Build fulltext data in background thread. Queries use previous built data, until the new data are ready
+	EnableBackgroundCommit bool `json:"enable_background_commit"`
+	// With background commit queries wait for fulltext data, which contain all the previous updates
+	ReadYourWrites bool `json:"read_your_writes"`
 	// Maximum documents which will be processed in merge query results
 	// Default value is 20000. Increasing this value may refine ranking
 	// of queries with high frequency words
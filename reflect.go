@@ -31,6 +31,7 @@ type indexOptions struct {
 	isDense     bool
 	isPk        bool
 	isSparse    bool
+	isBloom     bool
 }
 
 func (db *Reindexer) parseIndex(namespace string, st reflect.Type, joined *map[string][]int) (indexDefs []bindings.IndexDef, err error) {
@@ -185,6 +186,8 @@ func parseOpts(idxSettingsBuf *[]string) indexOptions {
 			opts.isSparse = true
 		case "appendable":
 			opts.isAppenable = true
+		case "bloom":
+			opts.isBloom = true
 		default:
 			newIdxSettingsBuf = append(newIdxSettingsBuf, idxSetting)
 		}
@@ -317,6 +320,7 @@ func makeIndexDef(index string, jsonPaths []string, indexType, fieldType string,
 		IsPK:        opts.isPk,
 		IsDense:     opts.isDense,
 		IsSparse:    opts.isSparse,
+		IsBloom:     opts.isBloom,
 		CollateMode: cm,
 		SortOrder:   sortOrder,
 	}
@@ -41,6 +41,12 @@ const (
 	ANY = bindings.ANY
 	// Empty value (usualy zero len array)
 	EMPTY = bindings.EMPTY
+	// Point is within radius from center: [lat, lon, radius in meters]. Requires geo index
+	DWITHIN = bindings.DWITHIN
+	// Point is within box: [south-west lat, south-west lon, north-east lat, north-east lon]. Requires geo index
+	INBOX = bindings.INBOX
+	// String matches pattern: '%' - any sequence of symbols, '_' - any single symbol. Requires string index
+	LIKE = bindings.LIKE
 )
 
 const (